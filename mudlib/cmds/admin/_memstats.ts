@@ -72,6 +72,29 @@ function showMemoryStats(
     rssMb?: number;
     external?: number;
     arrayBuffers?: number;
+    rooms?: {
+      lazyWorld: boolean;
+      loaded: number;
+      loadedOnDemand: number;
+      prefetched: number;
+      prefetchFailures: number;
+      onDemandHeapMb: number;
+    };
+    idleCleanup?: {
+      reclaimed: number;
+      reloaded: number;
+      destroyed: number;
+      saved: number;
+      unloaded: number;
+      lastSweepMs: number;
+    };
+    moduleVersions?: {
+      loaded: number;
+      live: number;
+      collected: number;
+      pinned: number;
+      filesWithOldVersions: number;
+    };
   }
 ): void {
   ctx.sendLine('{yellow}Memory Usage:{/}');
@@ -87,6 +110,53 @@ function showMemoryStats(
     const bar = '\u2588'.repeat(filledLength) + '\u2591'.repeat(barLength - filledLength);
     ctx.sendLine(`  Usage:      {dim}[{/}{cyan}${bar}{/}{dim}]{/} ${usagePercent}%`);
   }
+
+  const rooms = stats.rooms;
+  if (rooms) {
+    ctx.sendLine('');
+    ctx.sendLine(`{yellow}Rooms:{/} {dim}(${rooms.lazyWorld ? 'lazy world' : 'preloaded world'}){/}`);
+    ctx.sendLine(`  Loaded:     {cyan}${rooms.loaded}{/}`);
+    if (rooms.loadedOnDemand > 0 || rooms.prefetched > 0) {
+      ctx.sendLine(
+        `  On demand:  {cyan}${rooms.loadedOnDemand}{/}  Prefetched: {cyan}${rooms.prefetched}{/}` +
+          (rooms.prefetchFailures > 0 ? `  {red}${rooms.prefetchFailures} failed{/}` : '')
+      );
+      ctx.sendLine(`  Heap added: {cyan}~${rooms.onDemandHeapMb.toFixed(2)} MB{/}`);
+    }
+  }
+
+  const cleanup = stats.idleCleanup;
+  if (cleanup) {
+    ctx.sendLine('');
+    ctx.sendLine('{yellow}Idle Cleanup:{/}');
+    ctx.sendLine(
+      `  Unloaded:   {cyan}${cleanup.reclaimed}{/}  Reloaded: {cyan}${cleanup.reloaded}{/}  ` +
+        `Still out: {cyan}${cleanup.unloaded}{/}`
+    );
+    ctx.sendLine(
+      `  Destroyed:  {cyan}${cleanup.destroyed}{/} objects  Saved states: {cyan}${cleanup.saved}{/}`
+    );
+    ctx.sendLine(`  Last sweep: {dim}${cleanup.lastSweepMs}ms{/}`);
+  }
+
+  const modules = stats.moduleVersions;
+  if (modules && modules.loaded > 0) {
+    ctx.sendLine('');
+    ctx.sendLine('{yellow}Reloaded Modules:{/}');
+    ctx.sendLine(
+      `  Versions:   {cyan}${modules.loaded}{/}  Live: {cyan}${modules.live}{/}  ` +
+        `Freed: {cyan}${modules.collected}{/}`
+    );
+    if (modules.filesWithOldVersions > 0) {
+      ctx.sendLine(
+        `  Old versions in use: {yellow}${modules.filesWithOldVersions} files{/} ` +
+          '{dim}(existing clones or commands){/}'
+      );
+    }
+    if (modules.pinned > 0) {
+      ctx.sendLine(`  Pinned:     {red}${modules.pinned}{/} {dim}(top-level await, never freed){/}`);
+    }
+  }
 }
 
 /**
@@ -99,6 +169,8 @@ function showObjectStats(
     blueprints?: number;
     clones?: number;
     byType?: Record<string, number>;
+    byCategory?: Record<string, number>;
+    rootObjects?: number;
     largestInventories?: Array<{ objectId: string; count: number }>;
     blueprintCloneCounts?: Array<{ path: string; clones: number }>;
   }
@@ -107,6 +179,19 @@ function showObjectStats(
   ctx.sendLine(`  Total Objects: {cyan}${stats.totalObjects}{/}`);
   ctx.sendLine(`  Blueprints:    {cyan}${stats.blueprints}{/}`);
   ctx.sendLine(`  Clones:        {cyan}${stats.clones}{/}`);
+  if (stats.rootObjects !== undefined) {
+    ctx.sendLine(`  No environment: {cyan}${stats.rootObjects}{/} {dim}(rooms, daemons, strays){/}`);
+  }
+
+  // Show by category
+  if (stats.byCategory && Object.keys(stats.byCategory).length > 0) {
+    ctx.sendLine('');
+    ctx.sendLine('{yellow}Objects by Category:{/}');
+    const sorted = Object.entries(stats.byCategory).sort((a, b) => b[1] - a[1]);
+    for (const [category, count] of sorted) {
+      ctx.sendLine(`  ${category.padEnd(20)} {cyan}${count}{/}`);
+    }
+  }
 
   // Show by type
   if (stats.byType && Object.keys(stats.byType).length > 0) {
@@ -155,8 +240,16 @@ function showResetStats(ctx: CommandContext): void {
 
     ctx.sendLine('{yellow}Reset Daemon:{/}');
     ctx.sendLine(`  Status:         ${isRunning ? '{green}Running{/}' : '{red}Stopped{/}'}`);
-    ctx.sendLine(`  Total Resets:   {cyan}${stats.totalResets}{/}`);
+    ctx.sendLine(`  Rooms Tracked:  {cyan}${stats.roomsTracked}{/}`);
+    ctx.sendLine(`  Rooms Reset:    {cyan}${stats.totalResets}{/}`);
     ctx.sendLine(`  Items Cleaned:  {cyan}${stats.itemsCleaned}{/}`);
+    ctx.sendLine(
+      `  Batches:        {cyan}${stats.batches}{/}  ` +
+        `{dim}last ${stats.lastBatchMs}ms, avg ${stats.avgBatchMs}ms, max ${stats.maxBatchMs}ms{/}`
+    );
+    if (stats.roomsBacklog > 0) {
+      ctx.sendLine(`  Backlog:        {yellow}${stats.roomsBacklog} rooms overdue{/}`);
+    }
 
     if (stats.lastResetTime > 0) {
       const lastReset = new Date(stats.lastResetTime);
@@ -165,7 +258,7 @@ function showResetStats(ctx: CommandContext): void {
 
     if (timeUntil > 0) {
       const minutes = Math.ceil(timeUntil / 60000);
-      ctx.sendLine(`  Next Reset:     {dim}in ${minutes} minute${minutes !== 1 ? 's' : ''}{/}`);
+      ctx.sendLine(`  Next Room Due:  {dim}in ${minutes} minute${minutes !== 1 ? 's' : ''}{/}`);
     }
   } catch {
     ctx.sendLine('{yellow}Reset Daemon:{/}');
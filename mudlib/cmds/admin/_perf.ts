@@ -7,6 +7,8 @@
  *   perf clear      - Clear all metrics
  *   perf efun on    - Enable detailed efun timing
  *   perf efun off   - Disable detailed efun timing
+ *   perf traces [recent]        - Show slow (or recent) command traces by phase
+ *   perf traces export [recent] - Save traces for ui.perfetto.dev / chrome://tracing
  */
 
 import type { MudObject } from '../../lib/std.js';
@@ -20,7 +22,7 @@ interface CommandContext {
 
 export const name = ['perf', 'performance'];
 export const description = 'Display performance metrics (admin only)';
-export const usage = 'perf [slow|clear|efun on|efun off]';
+export const usage = 'perf [slow|clear|efun on|efun off|traces [export] [recent]]';
 
 export async function execute(ctx: CommandContext): Promise<void> {
   const args = ctx.args.trim().toLowerCase();
@@ -34,6 +36,17 @@ export async function execute(ctx: CommandContext): Promise<void> {
   }
 
   // Handle subcommands
+  if (args === 'traces' || args.startsWith('traces ')) {
+    const words = args.split(/\s+/).slice(1);
+    const which = words.includes('recent') ? 'recent' : 'slow';
+    if (words.includes('export')) {
+      await exportTraces(ctx, which);
+    } else {
+      showTraces(ctx, which);
+    }
+    return;
+  }
+
   if (args === 'slow') {
     showSlowOperations(ctx, metrics);
     return;
@@ -117,12 +130,40 @@ function showAllMetrics(
   ctx: CommandContext,
   metrics: {
     heartbeats?: { avg: number; p95: number; p99: number; max: number; count: number };
+    heartbeatTicks?: { avg: number; p95: number; p99: number; max: number; count: number };
+    heartbeatSlots?: {
+      mode: string;
+      slots: number;
+      minObjects: number;
+      maxObjects: number;
+      maxTickMs: number;
+      yields: number;
+    };
     callOuts?: { avg: number; p95: number; p99: number; max: number; count: number };
+    callOutLateness?: { avg: number; p95: number; p99: number; max: number; count: number };
     commands?: { avg: number; p95: number; p99: number; max: number; count: number };
+    scriptRuns?: { avg: number; p95: number; p99: number; max: number; count: number };
+    playerSaveBatches?: { avg: number; p95: number; p99: number; max: number; count: number };
+    playerSaves?: {
+      queueDepth: number;
+      requested: number;
+      coalesced: number;
+      written: number;
+      failed: number;
+      batches: number;
+      maxQueuedMs: number;
+    };
     isolateAcquireWaits?: number;
     isolateQueueLength?: number;
     backpressureEvents?: number;
     droppedMessages?: number;
+    output?: {
+      messages: number;
+      frames: number;
+      messagesPerFrame: number;
+      messagesPerCommand: number;
+      framesPerCommand: number;
+    };
     slowOperations?: Array<{
       timestamp: number;
       type: string;
@@ -143,15 +184,63 @@ function showAllMetrics(
   if (metrics.heartbeats) {
     ctx.sendLine(formatTimingStat('Heartbeats', metrics.heartbeats));
   }
+  if (metrics.heartbeatTicks) {
+    ctx.sendLine(formatTimingStat('HB ticks', metrics.heartbeatTicks));
+  }
   if (metrics.callOuts) {
     ctx.sendLine(formatTimingStat('CallOuts', metrics.callOuts));
   }
+  if (metrics.callOutLateness) {
+    ctx.sendLine(formatTimingStat('CO lateness', metrics.callOutLateness));
+  }
   if (metrics.commands) {
     ctx.sendLine(formatTimingStat('Commands', metrics.commands));
   }
+  if (metrics.scriptRuns && metrics.scriptRuns.count > 0) {
+    ctx.sendLine(formatTimingStat('Scripts', metrics.scriptRuns));
+  }
+  if (metrics.playerSaveBatches && metrics.playerSaveBatches.count > 0) {
+    ctx.sendLine(formatTimingStat('Saves', metrics.playerSaveBatches));
+  }
 
   ctx.sendLine('');
 
+  // Heartbeat slot load
+  const slots = metrics.heartbeatSlots;
+  if (slots) {
+    ctx.sendLine(`{yellow}Heartbeat Slots:{/} {dim}(${slots.mode}){/}`);
+    ctx.sendLine(`  Slots:          {cyan}${slots.slots}{/}`);
+    ctx.sendLine(`  Objects/slot:   {cyan}${slots.minObjects}-${slots.maxObjects}{/}`);
+    ctx.sendLine(`  Max tick:       {cyan}${slots.maxTickMs}ms{/}`);
+    ctx.sendLine(`  Yields:         {cyan}${slots.yields}{/}`);
+    ctx.sendLine('');
+  }
+
+  // Heartbeat cost per rate class
+  const classes = metrics.heartbeatClasses ?? [];
+  if (classes.length > 0) {
+    ctx.sendLine('{yellow}Heartbeat Classes:{/}');
+    for (const cls of classes) {
+      const label = `${cls.name} (${cls.intervalMs / 1000}s):`.padEnd(16);
+      ctx.sendLine(
+        `  ${label}{cyan}${cls.objects}{/} objs  avg={cyan}${cls.avg}ms{/}  max={cyan}${cls.max}ms{/}  total={cyan}${cls.totalMs}ms{/} {dim}(${cls.count} runs){/}`
+      );
+    }
+    ctx.sendLine('');
+  }
+
+  // Player save pipeline
+  const saves = metrics.playerSaves;
+  if (saves && saves.requested > 0) {
+    ctx.sendLine('{yellow}Player Saves:{/}');
+    ctx.sendLine(`  Queued:         {cyan}${saves.queueDepth}{/}`);
+    ctx.sendLine(`  Requested:      {cyan}${saves.requested}{/} {dim}(${saves.coalesced} coalesced){/}`);
+    ctx.sendLine(`  Written:        {cyan}${saves.written}{/} {dim}in ${saves.batches} batches{/}`);
+    ctx.sendLine(`  Failed:         {cyan}${saves.failed}{/}`);
+    ctx.sendLine(`  Max queued:     {cyan}${saves.maxQueuedMs}ms{/}`);
+    ctx.sendLine('');
+  }
+
   // Isolate pool stats
   ctx.sendLine('{yellow}Isolate Pool:{/}');
   ctx.sendLine(`  Acquire waits:  {cyan}${metrics.isolateAcquireWaits ?? 0}{/}`);
@@ -164,6 +253,19 @@ function showAllMetrics(
   ctx.sendLine(`  Events:         {cyan}${metrics.backpressureEvents ?? 0}{/}`);
   ctx.sendLine(`  Dropped msgs:   {cyan}${metrics.droppedMessages ?? 0}{/}`);
 
+  // Output coalescing: without it every message is a frame
+  const output = metrics.output;
+  if (output && output.frames > 0) {
+    ctx.sendLine('');
+    ctx.sendLine('{yellow}Output:{/}');
+    ctx.sendLine(
+      `  Frames:         {cyan}${output.frames}{/} {dim}(${output.messages} messages, ${output.messagesPerFrame} per frame){/}`
+    );
+    ctx.sendLine(
+      `  Per command:    {cyan}${output.framesPerCommand}{/} frames {dim}(${output.messagesPerCommand} without coalescing){/}`
+    );
+  }
+
   // Slow operations summary
   const slowOps = metrics.slowOperations ?? [];
   if (slowOps.length > 0) {
@@ -230,4 +332,80 @@ function showSlowOperations(
   }
 }
 
+/**
+ * Show command traces with their per-phase breakdown.
+ */
+function showTraces(ctx: CommandContext, which: 'slow' | 'recent'): void {
+  const result = efuns.getCommandTraces(which);
+  if (!result.success || !result.traces || !result.stats) {
+    ctx.sendLine(`{red}Error: ${result.error || 'Command traces unavailable.'}{/}`);
+    return;
+  }
+
+  const { traces, stats } = result;
+  const title =
+    which === 'slow'
+      ? `Slow Command Traces (>=${stats.slowThresholdMs}ms)`
+      : 'Recent Command Traces';
+  ctx.sendLine(
+    `{cyan}${title}{/} {dim}(sampling ${stats.samplePercent}%, ${stats.traced} traced, ${stats.slow} slow){/}`
+  );
+  ctx.sendLine('{dim}' + '\u2500'.repeat(60) + '{/}');
+
+  if (traces.length === 0) {
+    ctx.sendLine(
+      stats.samplePercent > 0
+        ? '{green}No traces recorded.{/}'
+        : '{dim}Command tracing is disabled (COMMAND_TRACE_SAMPLE_PERCENT=0).{/}'
+    );
+    return;
+  }
+
+  // Newest first, at most 10
+  for (const trace of traces.slice(-10).reverse()) {
+    const time = new Date(trace.timestamp).toLocaleTimeString('en-US', {
+      hour12: false,
+      hour: '2-digit',
+      minute: '2-digit',
+      second: '2-digit',
+    });
+    const color = trace.durationMs >= 100 ? 'red' : 'yellow';
+    ctx.sendLine(
+      `  {dim}[${time}]{/} {bold}${trace.player}{/} ${trace.input} {${color}}(${Math.round(trace.durationMs)}ms){/}`
+    );
+    const p = trace.phases;
+    ctx.sendLine(
+      `    {dim}parse{/} ${p.parse.toFixed(1)}ms  {dim}resolve{/} ${p.resolve.toFixed(1)}ms  {dim}execute{/} ${p.execute.toFixed(1)}ms  {dim}send{/} ${p.send.toFixed(1)}ms {dim}(${trace.sends.count} msgs in ${trace.sends.frames} frames, ${trace.sends.bytes}B){/}`
+    );
+    if (trace.handledBy) {
+      ctx.sendLine(`    {dim}handled by ${trace.handledBy}{/}`);
+    }
+  }
+  if (traces.length > 10) {
+    ctx.sendLine(`  {dim}... and ${traces.length - 10} more. Use "perf traces export" to save them all.{/}`);
+  }
+}
+
+/**
+ * Save command traces as a Chrome Trace Event Format file.
+ */
+async function exportTraces(ctx: CommandContext, which: 'slow' | 'recent'): Promise<void> {
+  const result = efuns.exportCommandTraces(which);
+  if (!result.success || !result.json) {
+    ctx.sendLine(`{red}Error: ${result.error || 'Command traces unavailable.'}{/}`);
+    return;
+  }
+
+  const stamp = new Date().toISOString().replace(/[:.]/g, '-');
+  const path = `/data/traces/commands-${which}-${stamp}.json`;
+  try {
+    await efuns.writeFile(path, result.json);
+  } catch (error) {
+    ctx.sendLine(`{red}Error: ${error instanceof Error ? error.message : String(error)}{/}`);
+    return;
+  }
+  ctx.sendLine(`{green}Saved ${result.count} traces to ${path}.{/}`);
+  ctx.sendLine('{dim}Open it in ui.perfetto.dev or chrome://tracing.{/}');
+}
+
 export default { name, description, usage, execute };
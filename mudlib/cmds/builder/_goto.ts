@@ -76,14 +76,14 @@ export async function execute(ctx: CommandContext): Promise<void> {
       roomPath = resolvePath(currentCwd, roomPath, '/');
     }
 
-    destination = typeof efuns !== 'undefined' ? efuns.findObject(roomPath) : undefined;
     targetDescription = roomPath;
 
-    // If not loaded, try to load it from disk
-    if (!destination && typeof efuns !== 'undefined' && efuns.reloadObject) {
-      const result = await efuns.reloadObject(roomPath);
-      if (result.success) {
-        destination = efuns.findObject(roomPath);
+    // Load it from disk if it isn't loaded (lazy world, or unloaded as idle)
+    if (typeof efuns !== 'undefined') {
+      try {
+        destination = await efuns.loadBlueprint(roomPath);
+      } catch {
+        destination = undefined;
       }
     }
 
@@ -41,15 +41,11 @@ export async function execute(ctx: CommandContext): Promise<void> {
   let workroom: MudObject | undefined;
 
   if (typeof efuns !== 'undefined') {
-    // First check if already loaded
-    workroom = efuns.findObject(workroomPath);
-
-    // If not loaded, try to load it from disk
-    if (!workroom && efuns.reloadObject) {
-      const result = await efuns.reloadObject(workroomPath);
-      if (result.success) {
-        workroom = efuns.findObject(workroomPath);
-      }
+    // Load it from disk if it isn't loaded (or was unloaded as idle)
+    try {
+      workroom = await efuns.loadBlueprint(workroomPath);
+    } catch {
+      workroom = undefined;
     }
   }
 
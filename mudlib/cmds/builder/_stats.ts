@@ -119,6 +119,7 @@ export function execute(ctx: CommandContext): void {
     const sched = result.scheduler;
     ctx.sendLine('{bold}{cyan}║{/} {bold}Scheduler{/}                                                    {bold}{cyan}║{/}');
     ctx.sendLine(`{bold}{cyan}║{/}   Heartbeats:  {magenta}${sched.heartbeats}{/}  {dim}(active objects with heartbeat){/}`);
+    ctx.sendLine(`{bold}{cyan}║{/}   Dormant:     {dim}${sched.dormantHeartbeats}{/}  {dim}(parked, no players nearby){/}`);
     ctx.sendLine(`{bold}{cyan}║{/}   Call-outs:   {yellow}${sched.callouts}{/}  {dim}(pending scheduled callbacks){/}`);
     ctx.sendLine(`{bold}{cyan}║{/}   Interval:    {dim}${sched.heartbeatInterval}ms{/}`);
 
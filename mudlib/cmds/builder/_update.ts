@@ -13,6 +13,8 @@
  *   update cmds       - Rehash all commands
  *   update *.ts       - Reload all .ts files in current directory (wildcard)
  *   update *_armor.ts - Reload all files ending in _armor.ts
+ *   update -r <path>  - Reload an object and everything that imports it
+ *   update -r -n <path> - Show what -r would reload, without reloading
  */
 
 import type { MudObject } from '../../lib/std.js';
@@ -31,7 +33,8 @@ interface CommandContext {
 
 export const name = ['update'];
 export const description = 'Reload an object or command from disk (hot-reload)';
-export const usage = 'update [path|pattern] | update _command | update here | update cmds';
+export const usage =
+  'update [-r [-n]] [path|pattern] | update _command | update here | update cmds';
 
 /**
  * Convert a glob pattern to a RegExp.
@@ -55,6 +58,16 @@ function hasWildcard(path: string): boolean {
 export async function execute(ctx: CommandContext): Promise<void> {
   let objectPath = ctx.args.trim();
 
+  // Flags: -r reloads dependents too, -n only shows the plan
+  let cascade = false;
+  let dryRun = false;
+  let flag: RegExpMatchArray | null;
+  while ((flag = objectPath.match(/^-([rn])(\s+|$)/))) {
+    if (flag[1] === 'r') cascade = true;
+    else dryRun = true;
+    objectPath = objectPath.slice(flag[0].length);
+  }
+
   // Handle "cmds" - rehash all commands
   if (objectPath === 'cmds' || objectPath === 'commands') {
     ctx.sendLine('{cyan}Rehashing all commands...{/}');
@@ -101,6 +114,15 @@ export async function execute(ctx: CommandContext): Promise<void> {
   // Remove .ts extension if provided
   objectPath = objectPath.replace(/\.ts$/, '');
 
+  if (cascade || dryRun) {
+    if (!objectPath.startsWith('/')) {
+      const player = ctx.player as PlayerWithCwd;
+      objectPath = resolvePath(player.cwd || '/', objectPath, '/');
+    }
+    await handleCascadeUpdate(ctx, objectPath, dryRun);
+    return;
+  }
+
   // Check if this is a command (starts with _ and no slashes, or /cmds/ path)
   const isCommand = objectPath.startsWith('_') && !objectPath.includes('/');
   const isCommandPath = objectPath.includes('/cmds/') || objectPath.startsWith('cmds/');
@@ -188,6 +210,74 @@ export async function execute(ctx: CommandContext): Promise<void> {
   }
 }
 
+/**
+ * Reload an object with every loaded blueprint and command that imports it.
+ */
+async function handleCascadeUpdate(
+  ctx: CommandContext,
+  objectPath: string,
+  dryRun: boolean
+): Promise<void> {
+  if (typeof efuns === 'undefined' || !efuns.reloadWithDependents) {
+    ctx.sendLine('{red}Error: reloadWithDependents efun not available.{/}');
+    return;
+  }
+
+  ctx.sendLine(`{cyan}${dryRun ? 'Planning' : 'Reloading'} ${objectPath} and its dependents...{/}`);
+  const result = await efuns.reloadWithDependents(objectPath, { dryRun });
+  const plan = result.plan;
+
+  if (plan) {
+    plan.levels.forEach((level, index) => {
+      ctx.sendLine(`  {dim}${index + 1}.{/} ${level.join(', ')}`);
+    });
+    if (plan.levels.length === 0) {
+      ctx.sendLine('  {dim}Nothing loaded uses it; it will be reloaded when next loaded.{/}');
+    }
+    if (plan.stale.length > 0) {
+      ctx.sendLine(
+        `  {dim}${plan.stale.length} unloaded dependent(s) will use the new code when loaded.{/}`
+      );
+    }
+    if (plan.excluded.length > 0) {
+      ctx.sendLine(`  {yellow}Not reloaded (update them separately): ${plan.excluded.join(', ')}{/}`);
+    }
+  }
+
+  if (!result.success) {
+    ctx.sendLine(`{red}Failed: ${result.error ?? 'Unknown error'}{/}`);
+    ctx.sendLine('{dim}Nothing was replaced.{/}');
+    return;
+  }
+
+  if (dryRun) {
+    const modules = plan ? plan.levels.flat().length : 0;
+    ctx.sendLine(
+      `{green}Would reload ${modules} module(s): ${plan?.blueprints.length ?? 0} blueprint(s), ` +
+        `${plan?.commands.length ?? 0} command(s).{/}`
+    );
+    return;
+  }
+
+  const clones = (result.blueprints ?? []).reduce((sum, bp) => sum + bp.rebasedClones, 0);
+  ctx.sendLine(
+    `{green}Reloaded ${result.blueprints?.length ?? 0} blueprint(s) and ${result.commandsReplaced ?? 0} command(s).{/}`
+  );
+  const timing = result.timing;
+  if (timing) {
+    ctx.sendLine(
+      `{dim}compile ${timing.compileMs.toFixed(1)}ms, evaluate ${timing.evaluateMs.toFixed(1)}ms, ` +
+        `swap ${timing.swapMs.toFixed(1)}ms, total ${timing.totalMs.toFixed(1)}ms{/}`
+    );
+  }
+  if (clones > 0) {
+    ctx.sendLine(`{cyan}Moved ${clones} existing clone(s) onto the new code.{/}`);
+  }
+  for (const warning of result.warnings ?? []) {
+    ctx.sendLine(`{yellow}${warning}{/}`);
+  }
+}
+
 /**
  * Handle wildcard pattern updates.
  * Finds all matching files and reloads them.
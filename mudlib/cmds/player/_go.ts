@@ -23,7 +23,7 @@ interface Exit {
 
 interface Room extends MudObject {
   getExit?(direction: string): Exit | undefined;
-  resolveExit?(exit: Exit): MudObject | undefined;
+  resolveExit?(exit: Exit, mover?: MudObject): Promise<MudObject | undefined>;
   look?(viewer: MudObject): void;
   glance?(viewer: MudObject): void;
   getTerrain?(): TerrainType;
@@ -180,7 +180,7 @@ export async function execute(ctx: CommandContext): Promise<boolean> {
     return true;
   }
 
-  const destination = await room.resolveExit(exit);
+  const destination = await room.resolveExit(exit, player);
   if (!destination) {
     ctx.sendLine(`The way ${direction} seems blocked.`);
     return true;
@@ -28,7 +28,7 @@ export async function execute(ctx: CommandContext): Promise<void> {
   }
 
   try {
-    await efuns.savePlayer(ctx.player);
+    await efuns.savePlayer(ctx.player, { flush: true });
     ctx.sendLine('{green}Character saved.{/}');
   } catch (error) {
     ctx.sendLine(`{red}Error saving character: ${error}{/}`);
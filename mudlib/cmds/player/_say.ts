@@ -64,7 +64,7 @@ export function execute(ctx: CommandContext): void {
   if (room) {
     const speakerLiving = player as Living;
 
-    for (const obj of room.inventory) {
+    for (const obj of room.listeners) {
       if (obj !== player) {
         const other = obj as PlayerLike;
         const listenerLiving = other as Living;
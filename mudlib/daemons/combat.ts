@@ -1456,18 +1456,13 @@ export class CombatDaemon extends MudObject {
     verboseMessage: string,
     briefMessage: string
   ): void {
-    const room = attacker.environment as (MudObject & { inventory?: MudObject[] }) | null;
-    if (!room?.inventory) {
+    const room = attacker.environment as MudObject | null;
+    if (!room?.listeners) {
       return;
     }
 
-    const excludeSet = new Set<MudObject>([
-      attacker as unknown as MudObject,
-      defender as unknown as MudObject,
-    ]);
-
-    for (const obj of room.inventory) {
-      if (excludeSet.has(obj)) {
+    for (const obj of room.listeners) {
+      if (obj === (attacker as unknown as MudObject) || obj === (defender as unknown as MudObject)) {
         continue;
       }
 
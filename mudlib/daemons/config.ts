@@ -74,6 +74,13 @@ const DEFAULT_SETTINGS: Record<string, ConfigSetting> = {
     description: 'Clean up non-player-owned items during room reset',
     type: 'boolean',
   },
+  'reset.batchBudgetMs': {
+    value: 10,
+    description: 'Milliseconds of room resets to run per batch (resets are spread over the interval)',
+    type: 'number',
+    min: 1,
+    max: 100,
+  },
   'giphy.enabled': {
     value: true,
     description: 'Enable Giphy GIF sharing on channels',
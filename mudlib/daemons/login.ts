@@ -612,7 +612,7 @@ ${'='.repeat(bannerWidth)}
         // Restore previous location if player is in void
         const previousLocation = player.previousLocation;
         if (previousLocation && player.environment?.objectPath === '/areas/void/void') {
-          const destination = efuns.findObject(previousLocation);
+          const destination = await this.loadRoom(previousLocation);
           if (destination) {
             await player.moveTo(destination);
             player.previousLocation = null;
@@ -787,13 +787,13 @@ ${'='.repeat(bannerWidth)}
         console.error('[TUTORIAL] Failed to resolve tutorial instance room:', e);
       }
     } else {
-      room = typeof efuns !== 'undefined' ? efuns.findObject(startLocation) : undefined;
+      room = await this.loadRoom(startLocation);
     }
 
     // If the saved room doesn't exist, fall back to default
     if (!room && startLocation !== DEFAULT_LOCATION) {
       console.warn(`[LOGIN] Saved location "${startLocation}" not found, using default`);
-      room = typeof efuns !== 'undefined' ? efuns.findObject(DEFAULT_LOCATION) : undefined;
+      room = await this.loadRoom(DEFAULT_LOCATION);
     }
     if (room) {
       await player.moveTo(room);
@@ -918,6 +918,21 @@ ${'='.repeat(bannerWidth)}
     this._sessions.delete(session.connection);
   }
 
+  /**
+   * Load a room to place a player in. Rooms aren't preloaded in a lazy
+   * world and idle ones may have been unloaded, so a lookup isn't enough.
+   * @returns The room, or undefined if it doesn't exist or failed to load
+   */
+  private async loadRoom(path: string): Promise<MudObject | undefined> {
+    if (typeof efuns === 'undefined') return undefined;
+    try {
+      return await efuns.loadBlueprint(path);
+    } catch (error) {
+      console.warn(`[LOGIN] Failed to load room "${path}":`, error);
+      return undefined;
+    }
+  }
+
   /**
    * Execute a player's login alias if defined.
    */
@@ -258,8 +258,9 @@ export class MapDaemon extends MudObject {
       if (visited.has(path)) continue;
       visited.add(path);
 
+      // Only rooms already in memory; drawing a map never loads rooms
       if (typeof efuns === 'undefined') continue;
-      const room = (efuns.findObject(path) || efuns.loadObject?.(path)) as MapRoom | undefined;
+      const room = efuns.findObject(path) as MapRoom | undefined;
       if (!room) continue;
 
       const coords = this.getRoomCoordinates(room);
@@ -6,27 +6,66 @@
  * - Re-clone room default items (if missing)
  * - Call room.onReset() for custom reset behavior
  *
+ * Resets are incremental: every room has its own due time, first spread
+ * randomly across one interval and then pushed back a full interval each
+ * time the room resets. Once a second the daemon resets the rooms that are
+ * due, oldest first, until the batch's time budget is used up, so the world
+ * resets a few rooms at a time instead of in one stall.
+ *
+ * Rooms are read from the driver's category index once, then kept up to
+ * date through efuns.onObjectCategoryChange('room'). Due times sit in a
+ * min-heap; a rescheduled or unloaded room leaves its old entry behind, and
+ * stale entries are dropped as they reach the top, so a batch only touches
+ * rooms that are actually due.
+ *
  * Configuration (via config daemon):
- *   reset.intervalMinutes - Minutes between resets (default: 15)
+ *   reset.intervalMinutes - Minutes between resets of a room (default: 15)
  *   reset.cleanupDroppedItems - Clean up non-player items (default: true)
+ *   reset.batchBudgetMs - Milliseconds of resets per batch (default: 10)
  */
 
 import { MudObject } from '../std/object.js';
 import { Room } from '../std/room.js';
 import { getConfigDaemon } from './config.js';
 
+/** How often a reset batch runs */
+const BATCH_TICK_MS = 1000;
+
+/** Batch durations kept for the batch metrics */
+const BATCH_HISTORY = 60;
+
+/**
+ * A room's place in the due-time heap.
+ */
+interface DueEntry {
+  at: number;
+  objectId: string;
+}
+
 /**
  * Statistics tracked by the reset daemon.
  */
 export interface ResetStats {
-  /** Total number of resets performed */
+  /** Total number of room resets performed */
   totalResets: number;
   /** Total items cleaned up */
   itemsCleaned: number;
-  /** Last reset timestamp */
+  /** Last room reset timestamp */
   lastResetTime: number;
-  /** Next scheduled reset timestamp */
+  /** Next room reset due timestamp */
   nextResetTime: number;
+  /** Rooms with a reset due time */
+  roomsTracked: number;
+  /** Rooms past their due time left for the next batch */
+  roomsBacklog: number;
+  /** Batches that reset at least one room */
+  batches: number;
+  /** Duration of the last batch in milliseconds */
+  lastBatchMs: number;
+  /** Average duration of recent batches in milliseconds */
+  avgBatchMs: number;
+  /** Longest recent batch in milliseconds */
+  maxBatchMs: number;
 }
 
 /**
@@ -39,8 +78,25 @@ export class ResetDaemon extends MudObject {
     itemsCleaned: 0,
     lastResetTime: 0,
     nextResetTime: 0,
+    roomsTracked: 0,
+    roomsBacklog: 0,
+    batches: 0,
+    lastBatchMs: 0,
+    avgBatchMs: 0,
+    maxBatchMs: 0,
   };
   private _started: boolean = false;
+  private _inBatch: boolean = false;
+  /** Reset due time per room objectId; heap entries that disagree are stale */
+  private _dueTimes: Map<string, number> = new Map();
+  /** Loaded rooms by objectId */
+  private _rooms: Map<string, Room> = new Map();
+  /** Min-heap of due times, earliest first */
+  private _dueHeap: DueEntry[] = [];
+  /** Stops the room category listener, set while rooms are tracked */
+  private _stopTracking: (() => void) | null = null;
+  /** Recent batch durations, oldest first */
+  private _batchDurations: number[] = [];
 
   constructor() {
     super();
@@ -70,6 +126,14 @@ export class ResetDaemon extends MudObject {
     return config.get<boolean>('reset.cleanupDroppedItems') ?? true;
   }
 
+  /**
+   * Get the time budget for one batch of resets.
+   */
+  private getBatchBudgetMs(): number {
+    const config = getConfigDaemon();
+    return config.get<number>('reset.batchBudgetMs') ?? 10;
+  }
+
   /**
    * Start the reset daemon.
    */
@@ -77,8 +141,8 @@ export class ResetDaemon extends MudObject {
     if (this._started) return;
     this._started = true;
 
-    console.log('[ResetDaemon] Starting periodic room resets');
-    this.scheduleNextReset();
+    console.log('[ResetDaemon] Starting incremental room resets');
+    this.scheduleNextBatch();
   }
 
   /**
@@ -92,82 +156,262 @@ export class ResetDaemon extends MudObject {
       efuns.removeCallOut(this._resetTimerId);
       this._resetTimerId = 0;
     }
+    this.stopTracking();
 
     console.log('[ResetDaemon] Stopped');
   }
 
   /**
-   * Schedule the next reset.
+   * Schedule the next batch.
    */
-  private scheduleNextReset(): void {
+  private scheduleNextBatch(): void {
     if (!this._started) return;
 
-    const intervalMs = this.getIntervalMs();
-    this._stats.nextResetTime = Date.now() + intervalMs;
-
     if (typeof efuns !== 'undefined' && efuns.callOut) {
-      this._resetTimerId = efuns.callOut(() => {
-        this.performReset();
-      }, intervalMs);
+      this._resetTimerId = efuns.callOut(async () => {
+        this._resetTimerId = 0;
+        try {
+          await this.runBatch();
+        } finally {
+          this.scheduleNextBatch();
+        }
+      }, BATCH_TICK_MS);
     }
   }
 
   /**
-   * Perform a full reset cycle on all loaded rooms.
+   * Reset rooms that are due, oldest first, until the batch budget is used.
+   * At least one due room is reset per batch.
+   * @returns Number of rooms reset
    */
-  async performReset(): Promise<void> {
-    const startTime = Date.now();
+  async runBatch(): Promise<number> {
+    if (this._inBatch || !this.trackRooms()) return 0;
+    this._inBatch = true;
+
+    const startTime = performance.now();
+    const budgetMs = this.getBatchBudgetMs();
+    const intervalMs = this.getIntervalMs();
+    const now = Date.now();
     let roomsReset = 0;
     let itemsCleaned = 0;
+    let overBudget = false;
+
+    try {
+      for (let room = this.popDueRoom(now); room; room = this.popDueRoom(now)) {
+        // Reschedule first so a failing room does not retry every batch
+        this.schedule(room.objectId, Date.now() + intervalMs);
+        try {
+          itemsCleaned += (await this.resetRoom(room)).itemsCleaned;
+        } catch (error) {
+          console.error(`[ResetDaemon] Error resetting room ${room.objectId}:`, error);
+        }
+        roomsReset++;
+        if (performance.now() - startTime >= budgetMs) {
+          overBudget = true;
+          break;
+        }
+      }
+    } finally {
+      this._inBatch = false;
+    }
 
-    // Get all loaded objects
-    if (typeof efuns === 'undefined' || !efuns.getAllObjects) {
-      this.scheduleNextReset();
-      return;
+    // Counting the backlog walks the heap, so only do it when one can exist
+    this._stats.roomsBacklog = overBudget ? this.countDue(now) : 0;
+    this._stats.nextResetTime =
+      this._stats.roomsBacklog > 0 ? Date.now() : this.earliestDueTime();
+    if (roomsReset === 0) return 0;
+
+    const duration = performance.now() - startTime;
+    this.recordBatch(duration);
+    this._stats.totalResets += roomsReset;
+    this._stats.lastResetTime = Date.now();
+
+    // Only slow batches are worth a log line
+    if (duration >= 50) {
+      console.log(
+        `[ResetDaemon] Slow reset batch: ${roomsReset} rooms, ${itemsCleaned} items cleaned ` +
+          `(${Math.round(duration)}ms, ${this._stats.roomsBacklog} still due)`
+      );
     }
+    return roomsReset;
+  }
 
-    const allObjects = efuns.getAllObjects();
+  /**
+   * Reset every loaded room now, in budgeted batches.
+   */
+  async performReset(): Promise<void> {
+    if (!this.trackRooms()) return;
 
-    for (const obj of allObjects) {
-      // Only process rooms
-      if (!(obj instanceof Room)) continue;
+    for (const objectId of this._rooms.keys()) {
+      this.schedule(objectId, 0);
+    }
+    while ((await this.runBatch()) > 0 && this._stats.roomsBacklog > 0) {
+      // Let other work run between batches
+      await new Promise((resolve) => setTimeout(resolve, 0));
+    }
+  }
 
-      const room = obj as Room;
+  /**
+   * Start tracking loaded rooms if not already: read the room category once,
+   * then follow rooms loading and unloading through the category listener.
+   * @returns false if the driver cannot report rooms
+   */
+  private trackRooms(): boolean {
+    if (this._stopTracking) return true;
+    if (
+      typeof efuns === 'undefined' ||
+      !efuns.getObjectsByCategory ||
+      !efuns.onObjectCategoryChange
+    ) {
+      return false;
+    }
 
-      // Clean up dropped items if enabled
-      if (this.shouldCleanupItems()) {
-        const cleaned = await this.cleanupRoomItems(room);
-        itemsCleaned += cleaned;
+    this._stopTracking = efuns.onObjectCategoryChange('room', (room, added) => {
+      if (added) {
+        this.addRoom(room as Room);
+      } else {
+        this.removeRoom(room.objectId);
       }
+    });
+    for (const room of efuns.getObjectsByCategory('room')) {
+      this.addRoom(room as Room);
+    }
+    return true;
+  }
 
-      // Call the room's onReset hook
-      try {
-        await room.onReset();
-        roomsReset++;
-      } catch (error) {
-        console.error(`[ResetDaemon] Error resetting room ${room.objectId}:`, error);
-      }
+  /**
+   * Stop following rooms and forget their due times.
+   */
+  private stopTracking(): void {
+    this._stopTracking?.();
+    this._stopTracking = null;
+    this._rooms.clear();
+    this._dueTimes.clear();
+    this._dueHeap = [];
+    this._stats.roomsTracked = 0;
+  }
+
+  /**
+   * Track a newly loaded room, with its first reset spread randomly over one
+   * interval.
+   */
+  private addRoom(room: Room): void {
+    if (this._rooms.has(room.objectId)) return;
+    this._rooms.set(room.objectId, room);
+    this.schedule(room.objectId, Date.now() + Math.random() * this.getIntervalMs());
+    this._stats.roomsTracked = this._rooms.size;
+  }
+
+  /**
+   * Forget an unloaded room. Its heap entry goes stale and is dropped when it
+   * reaches the top.
+   */
+  private removeRoom(objectId: string): void {
+    if (!this._rooms.delete(objectId)) return;
+    this._dueTimes.delete(objectId);
+    this._stats.roomsTracked = this._rooms.size;
+  }
+
+  /**
+   * Set a room's due time. Any older heap entry for it becomes stale.
+   */
+  private schedule(objectId: string, at: number): void {
+    if (this._dueTimes.get(objectId) === at) return;
+    this._dueTimes.set(objectId, at);
+    const heap = this._dueHeap;
+    heap.push({ at, objectId });
+
+    let i = heap.length - 1;
+    while (i > 0) {
+      const parent = (i - 1) >> 1;
+      if (heap[parent].at <= heap[i].at) break;
+      [heap[parent], heap[i]] = [heap[i], heap[parent]];
+      i = parent;
     }
+  }
 
-    // Update stats
-    this._stats.totalResets++;
-    this._stats.itemsCleaned += itemsCleaned;
-    this._stats.lastResetTime = startTime;
-
-    const duration = Date.now() - startTime;
-    // Keep reset logging informative without spamming routine no-op runs.
-    const shouldLog =
-      itemsCleaned > 0 ||
-      duration >= 50 ||
-      this._stats.totalResets % 20 === 0;
-    if (shouldLog) {
-      console.log(
-        `[ResetDaemon] Reset complete: ${roomsReset} rooms, ${itemsCleaned} items cleaned (${duration}ms)`
-      );
+  /**
+   * Whether a heap entry still matches its room's due time.
+   */
+  private isCurrent(entry: DueEntry): boolean {
+    return this._dueTimes.get(entry.objectId) === entry.at;
+  }
+
+  /**
+   * Drop stale entries from the top of the heap.
+   * @returns The earliest current entry, if any
+   */
+  private peekDue(): DueEntry | undefined {
+    while (this._dueHeap.length > 0 && !this.isCurrent(this._dueHeap[0])) {
+      this.popHeap();
     }
+    return this._dueHeap[0];
+  }
 
-    // Schedule next reset
-    this.scheduleNextReset();
+  /**
+   * Take the earliest room due at or before now off the heap.
+   */
+  private popDueRoom(now: number): Room | undefined {
+    const entry = this.peekDue();
+    if (!entry || entry.at > now) return undefined;
+    this.popHeap();
+    return this._rooms.get(entry.objectId);
+  }
+
+  /**
+   * Remove the top of the heap.
+   */
+  private popHeap(): void {
+    const heap = this._dueHeap;
+    const last = heap.pop();
+    if (!last || heap.length === 0) return;
+    heap[0] = last;
+
+    let i = 0;
+    for (;;) {
+      const left = 2 * i + 1;
+      const right = left + 1;
+      let smallest = i;
+      if (left < heap.length && heap[left].at < heap[smallest].at) smallest = left;
+      if (right < heap.length && heap[right].at < heap[smallest].at) smallest = right;
+      if (smallest === i) break;
+      [heap[smallest], heap[i]] = [heap[i], heap[smallest]];
+      i = smallest;
+    }
+  }
+
+  /**
+   * Count rooms due at or before now.
+   */
+  private countDue(now: number): number {
+    let count = 0;
+    for (const entry of this._dueHeap) {
+      if (entry.at <= now && this.isCurrent(entry)) count++;
+    }
+    return count;
+  }
+
+  /**
+   * Earliest due time among tracked rooms (0 if none).
+   */
+  private earliestDueTime(): number {
+    return this.peekDue()?.at ?? 0;
+  }
+
+  /**
+   * Add a batch duration to the batch metrics.
+   */
+  private recordBatch(durationMs: number): void {
+    this._batchDurations.push(durationMs);
+    if (this._batchDurations.length > BATCH_HISTORY) {
+      this._batchDurations.shift();
+    }
+
+    const total = this._batchDurations.reduce((sum, ms) => sum + ms, 0);
+    this._stats.batches++;
+    this._stats.lastBatchMs = Math.round(durationMs * 100) / 100;
+    this._stats.avgBatchMs = Math.round((total / this._batchDurations.length) * 100) / 100;
+    this._stats.maxBatchMs = Math.round(Math.max(...this._batchDurations) * 100) / 100;
   }
 
   /**
@@ -229,13 +473,6 @@ export class ResetDaemon extends MudObject {
    * Useful for admin commands.
    */
   async forceReset(): Promise<void> {
-    // Cancel scheduled reset
-    if (this._resetTimerId && typeof efuns !== 'undefined' && efuns.removeCallOut) {
-      efuns.removeCallOut(this._resetTimerId);
-      this._resetTimerId = 0;
-    }
-
-    // Perform reset now
     await this.performReset();
   }
 
@@ -433,7 +433,7 @@ export class SoulDaemon extends MudObject {
    */
   private _findTarget(
     name: string,
-    objects: MudObject[],
+    objects: ReadonlyArray<MudObject>,
     exclude?: MudObject
   ): MudObject | null {
     const lowerName = name.toLowerCase();
@@ -486,8 +486,8 @@ export class SoulDaemon extends MudObject {
     // Send to others in the room (skip sleeping)
     const env = typeof efuns !== 'undefined' ? efuns.environment(actor) : null;
     if (env) {
-      const inventory = typeof efuns !== 'undefined' ? efuns.allInventory(env) : [];
-      for (const obj of inventory) {
+      const listeners = (env as MudObject).listeners ?? efuns.allInventory(env);
+      for (const obj of listeners) {
         if (obj === actor || obj === target) continue;
 
         const objLiving = obj as MudObject & { receive?: (msg: string) => void; isSleeping?: () => boolean };
@@ -567,7 +567,13 @@ You earned: {yellow}50 experience points{/}\n`
   private async teleportToTown(player: TutorialPlayer): Promise<void> {
     if (typeof efuns === 'undefined') return;
 
-    const room = efuns.findObject(DEFAULT_LOCATION);
+    // Town may not be loaded yet in a lazy world
+    let room: MudObject | undefined;
+    try {
+      room = await efuns.loadBlueprint(DEFAULT_LOCATION);
+    } catch (error) {
+      console.error(`[TUTORIAL] Failed to load ${DEFAULT_LOCATION}:`, error);
+    }
     if (room) {
       await player.moveTo(room as MudObject);
 
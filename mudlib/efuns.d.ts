@@ -161,13 +161,62 @@ declare global {
     /** Load an object (get blueprint) */
     loadObject(path: string): MudObject | undefined;
 
-    /** Find an object by path or ID */
+    /**
+     * Find a loaded object by path or ID. Rooms not yet loaded (LAZY_WORLD) or
+     * unloaded as idle are not found; use loadBlueprint when the room is needed.
+     */
     findObject(pathOrId: string): MudObject | undefined;
 
+    /** Load a blueprint from disk if not already loaded */
+    loadBlueprint(path: string): Promise<MudObject | undefined>;
+
+    /** Whether rooms are loaded on first entry rather than preloaded at boot (LAZY_WORLD) */
+    isLazyWorld(): boolean;
+
+    /**
+     * Load blueprints in the background without waiting. Loaded paths are
+     * skipped and failures are ignored.
+     */
+    prefetchObjects(paths: string[]): void;
+
+    /**
+     * Get loaded objects in a category, in load order, without scanning every
+     * object. Built-in categories: 'room', 'player', 'npc', 'living', 'corpse',
+     * 'vehicle'; tags added with tagObject() work too.
+     */
+    getObjectsByCategory(category: string): MudObject[];
+
+    /** Count loaded objects in a category or tag */
+    countObjectsByCategory(category: string): number;
+
+    /**
+     * Listen for objects joining (added true) or leaving a category or tag.
+     * Returns a function that stops listening.
+     */
+    onObjectCategoryChange(
+      category: string,
+      callback: (object: MudObject, added: boolean) => void
+    ): () => void;
+
+    /** Add a loaded object to a tag (false if not loaded) */
+    tagObject(object: MudObject, tag: string): boolean;
+
+    /** Remove an object from a tag (true if it had the tag) */
+    untagObject(object: MudObject, tag: string): boolean;
+
+    /** Get the live clones of a blueprint */
+    getClones(path: string): MudObject[];
+
+    /** Get loaded objects with no environment (rooms, daemons, strays) */
+    getRootObjects(): MudObject[];
+
+    /** Update the driver's environment index (called by MudObject.moveTo) */
+    noteEnvironmentChange(object: MudObject): void;
+
     // ========== Hierarchy Efuns ==========
 
-    /** Get all objects in an object's inventory */
-    allInventory(object: MudObject): MudObject[];
+    /** Get all objects in an object's inventory (read-only snapshot) */
+    allInventory(object: MudObject): ReadonlyArray<MudObject>;
 
     /** Get an object's environment */
     environment(object: MudObject): MudObject | null;
@@ -497,8 +546,23 @@ declare global {
 
     // ========== Scheduler Efuns ==========
 
-    /** Set heartbeat for an object */
-    setHeartbeat(object: MudObject, enable: boolean): void;
+    /**
+     * Set heartbeat for an object.
+     * @param rate Rate class ('normal' = driver interval, 'slow' = 10s, 'idle' = 60s)
+     *             or an explicit interval in ms (minimum 250). Defaults to 'normal'.
+     * @returns false if the rate is invalid
+     */
+    setHeartbeat(
+      object: MudObject,
+      enable: boolean,
+      rate?: 'normal' | 'slow' | 'idle' | number
+    ): boolean;
+
+    /** Get an object's heartbeat interval in ms (0 if it has no heartbeat) */
+    getHeartbeatInterval(object: MudObject): number;
+
+    /** Wake dormant heartbeats in and near an object's room; returns the number woken */
+    wakeHeartbeatsNear(object: MudObject): number;
 
     /** Schedule a delayed callback */
     callOut(callback: () => void | Promise<void>, delayMs: number): number;
@@ -531,8 +595,11 @@ declare global {
 
     // ========== Persistence Efuns ==========
 
-    /** Save a player to disk */
-    savePlayer(player: MudObject): Promise<void>;
+    /**
+     * Save a player. State is captured now and written in the background
+     * within the save window; pass { flush: true } to wait for the write.
+     */
+    savePlayer(player: MudObject, options?: { flush?: boolean }): Promise<void>;
 
     /** Load a player's saved data */
     loadPlayerData(name: string): Promise<PlayerSaveData | null>;
@@ -570,6 +637,42 @@ declare global {
       migratedObjects?: number;
     }>;
 
+    /** Reload an object with every loaded blueprint and command that imports it */
+    reloadWithDependents(
+      path: string,
+      options?: { dryRun?: boolean }
+    ): Promise<{
+      success: boolean;
+      error?: string;
+      failedPath?: string;
+      plan?: {
+        root: string;
+        levels: string[][];
+        blueprints: string[];
+        commands: string[];
+        stale: string[];
+        excluded: string[];
+        cycles: string[];
+      };
+      blueprints?: Array<{
+        path: string;
+        existingClones: number;
+        migratedObjects: number;
+        rebasedClones: number;
+      }>;
+      commandsReplaced?: number;
+      warnings?: string[];
+      timing?: {
+        scanMs: number;
+        planMs: number;
+        compileMs: number;
+        evaluateMs: number;
+        swapMs: number;
+        createMs: number;
+        totalMs: number;
+      };
+    }>;
+
     /** Reload a command from disk */
     reloadCommand(path: string): Promise<{
       success: boolean;
@@ -782,6 +885,7 @@ declare global {
       };
       scheduler?: {
         heartbeats: number;
+        dormantHeartbeats: number;
         callouts: number;
         heartbeatInterval: number;
       };
@@ -808,6 +912,8 @@ declare global {
       blueprints?: number;
       clones?: number;
       byType?: Record<string, number>;
+      byCategory?: Record<string, number>;
+      rootObjects?: number;
       largestInventories?: Array<{ objectId: string; count: number }>;
       blueprintCloneCounts?: Array<{ path: string; clones: number }>;
     };
@@ -828,6 +934,31 @@ declare global {
       heapUsedMb?: number;
       heapTotalMb?: number;
       rssMb?: number;
+      rooms?: {
+        lazyWorld: boolean;
+        loaded: number;
+        loadedOnDemand: number;
+        prefetched: number;
+        prefetchFailures: number;
+        onDemandHeapMb: number;
+      };
+      /** Present when OBJECT_CLEANUP is on */
+      idleCleanup?: {
+        reclaimed: number;
+        reloaded: number;
+        destroyed: number;
+        saved: number;
+        unloaded: number;
+        lastSweepMs: number;
+      };
+      /** Module versions created by hot reload (update) */
+      moduleVersions?: {
+        loaded: number;
+        live: number;
+        collected: number;
+        pinned: number;
+        filesWithOldVersions: number;
+      };
     };
 
     /**
@@ -839,12 +970,50 @@ declare global {
       success: boolean;
       error?: string;
       heartbeats?: { avg: number; p95: number; p99: number; max: number; count: number };
+      heartbeatTicks?: { avg: number; p95: number; p99: number; max: number; count: number };
+      heartbeatSlots?: {
+        mode: string;
+        slots: number;
+        minObjects: number;
+        maxObjects: number;
+        maxTickMs: number;
+        yields: number;
+      };
+      heartbeatClasses?: Array<{
+        name: string;
+        intervalMs: number;
+        objects: number;
+        avg: number;
+        p95: number;
+        max: number;
+        count: number;
+        totalMs: number;
+      }>;
       callOuts?: { avg: number; p95: number; p99: number; max: number; count: number };
+      callOutLateness?: { avg: number; p95: number; p99: number; max: number; count: number };
       commands?: { avg: number; p95: number; p99: number; max: number; count: number };
+      scriptRuns?: { avg: number; p95: number; p99: number; max: number; count: number };
+      playerSaveBatches?: { avg: number; p95: number; p99: number; max: number; count: number };
+      playerSaves?: {
+        queueDepth: number;
+        requested: number;
+        coalesced: number;
+        written: number;
+        failed: number;
+        batches: number;
+        maxQueuedMs: number;
+      };
       isolateAcquireWaits?: number;
       isolateQueueLength?: number;
       backpressureEvents?: number;
       droppedMessages?: number;
+      output?: {
+        messages: number;
+        frames: number;
+        messagesPerFrame: number;
+        messagesPerCommand: number;
+        framesPerCommand: number;
+      };
       slowOperations?: Array<{
         timestamp: number;
         type: string;
@@ -874,6 +1043,55 @@ declare global {
      */
     clearPerformanceMetrics(): { success: boolean; error?: string };
 
+    /**
+     * Get per-phase command traces (parse, resolve, execute, send).
+     * Requires admin permission (level 3).
+     * @param which 'slow' (default) for traces over the slow threshold, 'recent' for the latest sampled ones
+     * @returns Traces, oldest first, and tracer statistics
+     */
+    getCommandTraces(which?: 'slow' | 'recent'): {
+      success: boolean;
+      error?: string;
+      traces?: Array<{
+        id: number;
+        player: string;
+        input: string;
+        timestamp: number;
+        durationMs: number;
+        handledBy: string | null;
+        spans: Array<{
+          phase: 'parse' | 'resolve' | 'execute' | 'send';
+          name: string;
+          startMs: number;
+          durationMs: number;
+          depth: number;
+        }>;
+        phases: { parse: number; resolve: number; execute: number; send: number };
+        sends: { count: number; frames: number; bytes: number };
+      }>;
+      stats?: {
+        traced: number;
+        skipped: number;
+        slow: number;
+        samplePercent: number;
+        slowThresholdMs: number;
+      };
+    };
+
+    /**
+     * Export command traces as Chrome Trace Event Format JSON (open in
+     * ui.perfetto.dev or chrome://tracing).
+     * Requires admin permission (level 3).
+     * @param which 'slow' (default) or 'recent' traces
+     * @returns The JSON document and the number of traces in it
+     */
+    exportCommandTraces(which?: 'slow' | 'recent'): {
+      success: boolean;
+      error?: string;
+      json?: string;
+      count?: number;
+    };
+
     // ========== AI Efuns ==========
 
     /** Check if Claude AI is configured and available */
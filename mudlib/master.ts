@@ -75,7 +75,8 @@ export class Master extends MudObject {
     preloadList.push(...daemons);
 
     // 3. Auto-discover areas (rooms, NPCs, items)
-    const areas = await this.discoverFiles('/areas');
+    // In a lazy world rooms load on first entry instead
+    const areas = efuns.isLazyWorld() ? [] : await this.discoverFiles('/areas');
     preloadList.push(...areas);
 
     console.log(
@@ -129,17 +129,12 @@ export function tell_room(room: MudObject | string, message: string, exclude: Mu
 
   if (!roomObj) return;
 
-  const excludeSet = new Set(exclude);
-
-  for (const obj of roomObj.inventory) {
-    if (excludeSet.has(obj)) continue;
+  // Only objects with receive() are listeners, so items are never visited
+  for (const obj of roomObj.listeners) {
+    if (exclude.includes(obj)) continue;
 
     const receiver = obj as MudObject & { receive?: (msg: string) => void };
-    if (typeof receiver.receive === 'function') {
-      receiver.receive(message);
-    } else if (typeof efuns !== 'undefined') {
-      efuns.send(obj, message);
-    }
+    receiver.receive?.(message);
   }
 }
 
@@ -29,7 +29,8 @@ export const FIREWOOD_FUEL = 600;
 export const TINDER_FUEL = 300;
 
 /**
- * Heartbeat interval in milliseconds.
+ * Fallback heartbeat interval in milliseconds, used when the driver
+ * can't report the actual one.
  */
 const HEARTBEAT_INTERVAL = 2000;
 
@@ -121,7 +122,7 @@ export class Campfire extends Item {
 
   /**
    * Process fuel consumption and state changes.
-   * Called every heartbeat (approximately every 2 seconds).
+   * Called every heartbeat (slow rate class, approximately every 10 seconds).
    */
   private processFuel(): void {
     if (!this._isLit) return;
@@ -132,9 +133,12 @@ export class Campfire extends Item {
       this._maxFuel = DEFAULT_FUEL_DURATION;
     }
 
-    // Consume fuel (2 seconds per heartbeat interval)
-    // This assumes heartbeat runs every ~2 seconds
-    const fuelToConsume = HEARTBEAT_INTERVAL / 1000;
+    // Consume one second of fuel per second of heartbeat interval
+    const interval =
+      typeof efuns !== 'undefined' && efuns.getHeartbeatInterval
+        ? efuns.getHeartbeatInterval(this) || HEARTBEAT_INTERVAL
+        : HEARTBEAT_INTERVAL;
+    const fuelToConsume = interval / 1000;
     this._fuelRemaining = Math.max(0, this._fuelRemaining - fuelToConsume);
 
     // Warn when fuel is low
@@ -317,7 +321,8 @@ export class Campfire extends Item {
   private startHeartbeat(): void {
     if (this._heartbeatId !== null) return;
     if (typeof efuns !== 'undefined' && efuns.setHeartbeat) {
-      efuns.setHeartbeat(this, true);
+      // Fuel only needs coarse accounting; no reason to tick at player rate
+      efuns.setHeartbeat(this, true, 'slow');
     }
   }
 
@@ -28,6 +28,8 @@ function getDecayTimeMs(isPlayer: boolean): number {
  * Corpse class for dead entities.
  */
 export class Corpse extends Container {
+  readonly isCorpse: boolean = true;
+
   /** Name of the deceased */
   private _ownerName: string = 'someone';
 
@@ -202,6 +202,7 @@ export class Item extends MudObject {
     fuelRemaining?: number;
     activeWhenDropped?: boolean;
   }): void {
+    const wasLightSource = this._isLightSource;
     this._isLightSource = true;
     if (options.lightRadius !== undefined) {
       this._lightRadius = Math.max(0, Math.min(50, options.lightRadius));
@@ -212,6 +213,9 @@ export class Item extends MudObject {
     if (options.activeWhenDropped !== undefined) {
       this._activeWhenDropped = options.activeWhenDropped;
     }
+    if (!wasLightSource) {
+      this.updateOccupantCategories();
+    }
   }
 
   /**
@@ -731,7 +731,7 @@ export class Living extends MudObject {
     }
 
     // Get destination room
-    const dest = await env.resolveExit(exit);
+    const dest = await env.resolveExit(exit, this);
     if (!dest) {
       this.receive("That exit leads nowhere.");
       return false;
@@ -758,7 +758,7 @@ export class Living extends MudObject {
       }
 
       // Notify NPCs in the room that someone entered
-      for (const obj of newEnv.inventory) {
+      for (const obj of newEnv.listeners) {
         if (obj !== this && obj instanceof Living) {
           // Check if the living has an onEnter method (NPCs do)
           const npc = obj as Living & { onEnter?: (who: Living, from?: Room) => void | Promise<void> };
@@ -498,6 +498,16 @@ export class Mercenary extends NPC {
 
   // ========== Heartbeat Override ==========
 
+  /**
+   * Keep hired mercenaries awake even with no player nearby.
+   * The heartbeat rejoins a separated owner and dismisses the mercenary
+   * once the owner logs off, both of which happen away from players.
+   */
+  override allowsHeartbeatDormancy(): boolean {
+    if (this._ownerName || this._following) return false;
+    return super.allowsHeartbeatDormancy();
+  }
+
   /**
    * Override heartbeat to ensure mercenary combat AI runs.
    * Unlike regular NPCs, mercenaries should also act when their owner
@@ -1499,6 +1499,14 @@ export class NPC extends Living {
 
   // ========== Heartbeat ==========
 
+  /**
+   * Allow the driver to park this NPC's heartbeat while no player is nearby.
+   * NPCs stay awake while fighting or while effects are ticking.
+   */
+  allowsHeartbeatDormancy(): boolean {
+    return !this.inCombat && this.getEffects().length === 0;
+  }
+
   /**
    * Heartbeat handler.
    * Processes chat, wandering, aggression, and other periodic behaviors.
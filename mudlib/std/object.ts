@@ -19,6 +19,36 @@ export interface Action {
   priority: number;
 }
 
+/**
+ * Categories of inventory members tracked by every container.
+ * - listener: has a receive() method (players, NPCs)
+ * - living, player, npc: flagged with isLiving, isPlayer or isNPC
+ * - lightSource: configured as a light source (lit or not)
+ * - item: anything that is not a living (items, containers, corpses, gold)
+ */
+export type OccupantCategory = 'listener' | 'living' | 'player' | 'npc' | 'lightSource' | 'item';
+
+const EMPTY_OBJECTS: ReadonlyArray<MudObject> = Object.freeze([]);
+
+/**
+ * Work out which occupant categories an object belongs to.
+ */
+function classifyOccupant(obj: MudObject): OccupantCategory[] {
+  const flags = obj as MudObject & {
+    receive?: unknown;
+    isLiving?: boolean;
+    isPlayer?: boolean;
+    isNPC?: boolean;
+    isLightSource?: boolean;
+  };
+  const categories: OccupantCategory[] = [flags.isLiving === true ? 'living' : 'item'];
+  if (typeof flags.receive === 'function') categories.push('listener');
+  if (flags.isPlayer === true) categories.push('player');
+  if (flags.isNPC === true) categories.push('npc');
+  if (flags.isLightSource === true) categories.push('lightSource');
+  return categories;
+}
+
 /**
  * Base class for all MUD objects.
  */
@@ -36,7 +66,16 @@ export class MudObject {
 
   // Hierarchy
   private _environment: MudObject | null = null;
-  private _inventory: MudObject[] = [];
+  // Insertion-ordered for O(1) add/remove/has
+  private _inventory: Set<MudObject> = new Set();
+  // Frozen array view of _inventory, rebuilt after the next change
+  private _inventoryView: ReadonlyArray<MudObject> | null = null;
+  // Inventory members by category (created on first arrival)
+  private _occupants: Map<OccupantCategory, Set<MudObject>> | null = null;
+  // Frozen array views of _occupants, rebuilt after a category changes
+  private _occupantViews: Map<OccupantCategory, ReadonlyArray<MudObject>> | null = null;
+  // Categories this object is filed under in its environment
+  private _occupantCategories: OccupantCategory[] = [];
 
   // Spawn tracking (set when object is spawned by a room)
   private _spawnRoom: MudObject | null = null;
@@ -46,6 +85,11 @@ export class MudObject {
 
   // Properties (for arbitrary data storage)
   private _properties: Map<string, unknown> = new Map();
+  // Properties changed since load (see hasDirtyState)
+  private _stateDirty: boolean = false;
+
+  // Last time a player arrived in or left this object
+  private _lastPlayerActivity: number = Date.now();
 
   /**
    * Get the object's virtual path.
@@ -115,14 +159,72 @@ export class MudObject {
   }
 
   /**
-   * Get the object's inventory (contents).
+   * Get the object's inventory (contents), in arrival order.
    * Automatically wraps all items with shadow proxies.
+   * The array is a snapshot: moving objects while iterating it is safe.
    */
   get inventory(): ReadonlyArray<MudObject> {
-    if (typeof efuns !== 'undefined' && efuns.wrapShadowedObjects) {
-      return efuns.wrapShadowedObjects(this._inventory);
+    const view = (this._inventoryView ??=
+      this._inventory.size > 0 ? Object.freeze(Array.from(this._inventory)) : EMPTY_OBJECTS);
+    if (view.length > 0 && typeof efuns !== 'undefined' && efuns.wrapShadowedObjects) {
+      return efuns.wrapShadowedObjects(view as MudObject[]);
+    }
+    return view;
+  }
+
+  /**
+   * Check whether an object is directly inside this one. O(1).
+   * @param obj The object (or its shadow proxy)
+   */
+  contains(obj: MudObject): boolean {
+    // Shadow proxies forward _environment to the original object
+    return this._inventory.has(obj) || obj._environment === this;
+  }
+
+  /**
+   * Get the inventory members in one category, in arrival order.
+   * Buckets are maintained by moveTo(), so this costs O(category size)
+   * instead of a scan of the whole inventory.
+   * @param category The occupant category
+   */
+  getOccupants(category: OccupantCategory): ReadonlyArray<MudObject> {
+    let view = this._occupantViews?.get(category);
+    if (!view) {
+      const members = this._occupants?.get(category);
+      view = members && members.size > 0 ? Object.freeze(Array.from(members)) : EMPTY_OBJECTS;
+      (this._occupantViews ??= new Map()).set(category, view);
+    }
+    if (view.length > 0 && typeof efuns !== 'undefined' && efuns.wrapShadowedObjects) {
+      return efuns.wrapShadowedObjects(view as MudObject[]);
     }
-    return this._inventory;
+    return view;
+  }
+
+  /**
+   * Get the inventory members that can receive messages (players, NPCs and
+   * anything else with a receive() method), in arrival order.
+   */
+  get listeners(): ReadonlyArray<MudObject> {
+    return this.getOccupants('listener');
+  }
+
+  /**
+   * Get the living beings in this object's inventory.
+   */
+  getLivings(): ReadonlyArray<MudObject> {
+    return this.getOccupants('living');
+  }
+
+  /**
+   * Re-file this object in its environment's occupant buckets.
+   * Call after changing something the categories depend on, such as
+   * becoming a light source while already on the ground.
+   */
+  updateOccupantCategories(): void {
+    const env = this._environment;
+    if (!env) return;
+    env._unfileOccupant(this);
+    env._fileOccupant(this);
   }
 
   /**
@@ -244,12 +346,14 @@ export class MudObject {
    * @returns true if move succeeded
    */
   moveTo(destination: MudObject | null): boolean | Promise<boolean> {
+    const wasInWorld = this._environment !== null;
+
     // Remove from current environment
     if (this._environment) {
-      const idx = this._environment._inventory.indexOf(this);
-      if (idx >= 0) {
-        this._environment._inventory.splice(idx, 1);
+      if (this._environment._inventory.delete(this)) {
+        this._environment._inventoryView = null;
       }
+      this._environment._unfileOccupant(this);
     }
 
     // Set new environment
@@ -257,12 +361,72 @@ export class MudObject {
 
     // Add to new environment's inventory
     if (destination) {
-      destination._inventory.push(this);
+      destination._inventory.add(this);
+      destination._inventoryView = null;
+      destination._fileOccupant(this);
+    }
+
+    // Keep the driver's index of environment-less objects current
+    if (wasInWorld !== (destination !== null) && typeof efuns !== 'undefined') {
+      efuns.noteEnvironmentChange?.(this);
     }
 
     return true;
   }
 
+  /**
+   * Add an object to this object's inventory without running movement hooks.
+   * Used by the driver to move occupants onto a reloaded blueprint.
+   */
+  _addToInventory(obj: MudObject): void {
+    this._inventory.add(obj);
+    this._inventoryView = null;
+    this._fileOccupant(obj);
+  }
+
+  /**
+   * Remove an object from this object's inventory without running movement hooks.
+   * Used by the driver to move occupants off a replaced blueprint.
+   */
+  _removeFromInventory(obj: MudObject): void {
+    if (this._inventory.delete(obj)) {
+      this._inventoryView = null;
+    }
+    this._unfileOccupant(obj);
+  }
+
+  /**
+   * Add an arriving object to this container's occupant buckets.
+   */
+  private _fileOccupant(obj: MudObject): void {
+    const categories = classifyOccupant(obj);
+    obj._occupantCategories = categories;
+    if (categories.includes('player')) this._lastPlayerActivity = Date.now();
+    const buckets = (this._occupants ??= new Map());
+    for (const category of categories) {
+      let members = buckets.get(category);
+      if (!members) {
+        members = new Set();
+        buckets.set(category, members);
+      }
+      members.add(obj);
+      this._occupantViews?.delete(category);
+    }
+  }
+
+  /**
+   * Remove a departing object from this container's occupant buckets.
+   */
+  private _unfileOccupant(obj: MudObject): void {
+    if (obj._occupantCategories.includes('player')) this._lastPlayerActivity = Date.now();
+    for (const category of obj._occupantCategories) {
+      if (this._occupants?.get(category)?.delete(obj)) {
+        this._occupantViews?.delete(category);
+      }
+    }
+    obj._occupantCategories = [];
+  }
+
   // ========== Actions ==========
 
   /**
@@ -310,6 +474,7 @@ export class MudObject {
    */
   setProperty(key: string, value: unknown): void {
     this._properties.set(key, value);
+    this._stateDirty = true;
   }
 
   /**
@@ -333,7 +498,9 @@ export class MudObject {
    * @param key Property name
    */
   deleteProperty(key: string): boolean {
-    return this._properties.delete(key);
+    const deleted = this._properties.delete(key);
+    if (deleted) this._stateDirty = true;
+    return deleted;
   }
 
   /**
@@ -343,6 +510,30 @@ export class MudObject {
     return Array.from(this._properties.keys());
   }
 
+  /**
+   * Whether properties changed since the object was loaded.
+   * The driver saves dirty state before unloading an idle object.
+   */
+  hasDirtyState(): boolean {
+    return this._stateDirty;
+  }
+
+  /**
+   * Treat the current properties as the freshly loaded state.
+   * Called by the driver once onCreate() has run.
+   */
+  markStateClean(): void {
+    this._stateDirty = false;
+  }
+
+  /**
+   * Last time (ms since epoch) a player arrived in or left this object,
+   * or when the object was created if no player ever has.
+   */
+  get lastPlayerActivity(): number {
+    return this._lastPlayerActivity;
+  }
+
   // ========== Utility ==========
 
   /**
@@ -381,10 +572,11 @@ export class MudObject {
   /**
    * Enable or disable heartbeat for this object.
    * @param enable Whether to enable heartbeat
+   * @param rate Rate class ('normal', 'slow', 'idle') or interval in ms
    */
-  setHeartbeat(enable: boolean): void {
+  setHeartbeat(enable: boolean, rate?: 'normal' | 'slow' | 'idle' | number): void {
     if (typeof efuns !== 'undefined') {
-      efuns.setHeartbeat(this, enable);
+      efuns.setHeartbeat(this, enable, rate);
     }
   }
 
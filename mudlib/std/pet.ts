@@ -612,6 +612,8 @@ export class Pet extends NPC {
 
   /**
    * Override heartbeat to disable NPC wandering and chat for pets.
+   * Owner following is driven by the pet daemon on movement, not by the
+   * heartbeat, so pets can still go dormant like other NPCs.
    */
   override async heartbeat(): Promise<void> {
     // Pets don't wander or chat on their own
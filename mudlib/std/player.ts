@@ -3124,6 +3124,20 @@ export class Player extends Living {
     return true;
   }
 
+  // ========== Movement ==========
+
+  /**
+   * Move the player, then wake any dormant heartbeats around the destination
+   * so nearby NPCs notice the arrival right away.
+   */
+  override async moveTo(destination: MudObject | null): Promise<boolean> {
+    const moved = await super.moveTo(destination);
+    if (moved && destination && typeof efuns !== 'undefined' && efuns.wakeHeartbeatsNear) {
+      efuns.wakeHeartbeatsNear(this);
+    }
+    return moved;
+  }
+
   // ========== Lifecycle ==========
 
   /**
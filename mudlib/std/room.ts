@@ -73,6 +73,7 @@ export class Room extends MudObject {
   private _terrain: TerrainType = getDefaultTerrain();
   private _mapData: RoomMapData = {};
   private _lightLevel: LightLevel = DEFAULT_ROOM_LIGHT;
+  private _noCleanUp: boolean = false;
 
   constructor() {
     super();
@@ -474,42 +475,67 @@ export class Room extends MudObject {
 
   /**
    * Resolve an exit destination to a room object.
-   * Loads the room on demand if not already loaded.
+   * Loads the room on demand if not already loaded. In a lazy world, when a
+   * player is the one moving, the destination's own exits are prefetched in
+   * the background so the next step is usually already loaded.
    * @param exit The exit to resolve
+   * @param mover The living about to take the exit, if known
    */
-  async resolveExit(exit: Exit): Promise<MudObject | undefined> {
+  async resolveExit(exit: Exit, mover?: MudObject): Promise<MudObject | undefined> {
+    let room: MudObject | undefined;
     if (typeof exit.destination === 'string') {
       if (typeof efuns !== 'undefined') {
-        // First try to find already-loaded room
-        let room = efuns.findObject(exit.destination);
-        if (room) return room;
-
-        // If not found, load the blueprint (not clone - rooms are singletons)
-        if (efuns.loadBlueprint) {
+        // First try to find already-loaded room, else load the blueprint
+        // (not clone - rooms are singletons)
+        room = efuns.findObject(exit.destination);
+        if (!room && efuns.loadBlueprint) {
           room = await efuns.loadBlueprint(exit.destination);
-          return room;
         }
       }
-      return undefined;
+    } else {
+      room = exit.destination;
+    }
+
+    const lazyWorld = typeof efuns !== 'undefined' && efuns.isLazyWorld?.();
+    if (room && mover && lazyWorld && efuns.isPlayer(mover)) {
+      (room as Room).prefetchExits?.();
+    }
+    return room;
+  }
+
+  /**
+   * Start loading every not-yet-loaded room this room's exits lead to,
+   * without waiting for them.
+   */
+  prefetchExits(): void {
+    if (typeof efuns === 'undefined' || !efuns.prefetchObjects) return;
+    const paths: string[] = [];
+    for (const exit of this._exits.values()) {
+      if (typeof exit.destination === 'string') {
+        paths.push(exit.destination);
+      }
+    }
+    if (paths.length > 0) {
+      efuns.prefetchObjects(paths);
     }
-    return exit.destination;
   }
 
   // ========== Broadcasting ==========
 
   /**
-   * Send a message to all objects in this room.
+   * Send a message to all listeners in this room.
    * By default, sleeping players are excluded from room broadcasts.
    * Use includeSleeping: true for system messages that should reach sleeping players.
    * @param message The message to send
    * @param options Broadcast options
    */
   broadcast(message: string, options: BroadcastOptions = {}): void {
-    const { exclude = [], filter, includeSleeping = false } = options;
-    const excludeSet = new Set(exclude);
+    const { exclude, filter, includeSleeping = false } = options;
 
-    for (const obj of this.inventory) {
-      if (excludeSet.has(obj)) {
+    // Only objects with receive() are indexed; items and corpses are never visited
+    for (const obj of this.listeners) {
+      // exclude is usually one or two objects, a linear scan beats building a Set
+      if (exclude && exclude.includes(obj)) {
         continue;
       }
 
@@ -525,14 +551,9 @@ export class Room extends MudObject {
         }
       }
 
-      // Check if object has a receive method
       // Note: Living.receive() and Player.receive() handle snoop forwarding
       const receiver = obj as MudObject & { receive?: (msg: string) => void };
-      if (typeof receiver.receive === 'function') {
-        receiver.receive(message);
-      } else if (typeof efuns !== 'undefined') {
-        efuns.send(obj, message);
-      }
+      receiver.receive?.(message);
     }
   }
 
@@ -708,6 +729,57 @@ export class Room extends MudObject {
     return this._spawnedNpcIds;
   }
 
+  // ========== Idle Cleanup ==========
+
+  /**
+   * Keep this room loaded even when idle (e.g. rooms that run their own
+   * timers or hold state outside properties).
+   * @param noCleanUp true to never unload the room
+   */
+  setNoCleanUp(noCleanUp: boolean = true): void {
+    this._noCleanUp = noCleanUp;
+  }
+
+  /**
+   * Called by the driver when idle object cleanup is enabled. Agrees to be
+   * unloaded once no player has been here for idleMs, nothing this room
+   * spawned is near a player, and every item here is one the room spawned.
+   * The room is reloaded on next use, with its properties restored and its
+   * items and NPCs respawned by onCreate().
+   * @param idleMs How long the room must have been without players
+   */
+  cleanUp(idleMs: number): boolean {
+    if (this._noCleanUp || this.isClone) return false;
+    if (this.getOccupants('player').length > 0) return false;
+    if (Date.now() - this.lastPlayerActivity < idleMs) return false;
+
+    // Dropped items are destroyed with the room and not saved; wait for the
+    // reset daemon to clear them (or their owner to pick them up)
+    for (const item of this.getOccupants('item')) {
+      if (item.spawnRoom !== this) return false;
+    }
+
+    for (const npc of this.getCleanupDependents()) {
+      const env = npc.environment;
+      if (env && env !== this && env.getOccupants('player').length > 0) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Objects the driver destroys along with this room: the NPCs it spawned,
+   * wherever they have wandered.
+   */
+  getCleanupDependents(): MudObject[] {
+    if (typeof efuns === 'undefined') return [];
+    const npcs: MudObject[] = [];
+    for (const npcId of this._spawnedNpcIds) {
+      const npc = efuns.findObject(npcId);
+      if (npc) npcs.push(npc);
+    }
+    return npcs;
+  }
+
   /**
    * Set a message to display when the room resets.
    * @param message The reset message
@@ -736,6 +808,20 @@ export class Room extends MudObject {
 
   // ========== Description ==========
 
+  /**
+   * Visit room contents grouped for display: players, NPCs, other livings,
+   * then items, each group in arrival order.
+   */
+  private forEachOccupantInDisplayOrder(visit: (obj: MudObject) => void): void {
+    for (const obj of this.getOccupants('player')) visit(obj);
+    for (const obj of this.getOccupants('npc')) visit(obj);
+    for (const obj of this.getOccupants('living')) {
+      const flags = obj as MudObject & { isPlayer?: boolean; isNPC?: boolean };
+      if (!flags.isPlayer && !flags.isNPC) visit(obj);
+    }
+    for (const obj of this.getOccupants('item')) visit(obj);
+  }
+
   /**
    * Get the full room description including exits and contents.
    * @param viewer Optional viewer to exclude from contents list
@@ -770,9 +856,9 @@ export class Room extends MudObject {
     // Filter by visibility if viewer is a Living
     const visibleContents: { obj: MudObject; isPartiallyVisible: boolean }[] = [];
 
-    for (const obj of this.inventory) {
+    const addIfVisible = (obj: MudObject): void => {
       // Exclude the viewer from the list
-      if (viewer && obj === viewer) continue;
+      if (viewer && obj === viewer) return;
 
       // Check visibility for Living entities
       const objLiving = obj as Living & { isLiving?: boolean };
@@ -786,33 +872,20 @@ export class Room extends MudObject {
         // Non-living objects are always visible
         visibleContents.push({ obj, isPartiallyVisible: false });
       }
-    }
+    };
+
+    // Players first, NPCs second, other livings and items last.
+    // The occupant buckets already hold each group in arrival order.
+    this.forEachOccupantInDisplayOrder(addIfVisible);
 
     if (visibleContents.length > 0) {
-      // Sort: players first, NPCs second, items last
       const isPlayer = (obj: MudObject): boolean => {
         const p = obj as MudObject & { isConnected?: () => boolean };
         return typeof p.isConnected === 'function';
       };
 
-      const sortedContents = [...visibleContents].sort((a, b) => {
-        const aIsPlayer = isPlayer(a.obj);
-        const bIsPlayer = isPlayer(b.obj);
-        const aIsNPC = a.obj instanceof NPC;
-        const bIsNPC = b.obj instanceof NPC;
-
-        // Players first
-        if (aIsPlayer && !bIsPlayer) return -1;
-        if (!aIsPlayer && bIsPlayer) return 1;
-        // NPCs second
-        if (aIsNPC && !bIsNPC) return -1;
-        if (!aIsNPC && bIsNPC) return 1;
-        // Items last (same category, no change)
-        return 0;
-      });
-
       lines.push('');
-      for (const { obj, isPartiallyVisible } of sortedContents) {
+      for (const { obj, isPartiallyVisible } of visibleContents) {
         let desc = obj.shortDesc;
 
         // Capitalize first letter of description
@@ -945,9 +1018,9 @@ export class Room extends MudObject {
       const npcs: string[] = [];
       const items: string[] = [];
 
-      for (const obj of this.inventory) {
+      this.forEachOccupantInDisplayOrder((obj) => {
         // Exclude the viewer
-        if (viewer && obj === viewer) continue;
+        if (viewer && obj === viewer) return;
 
         // Check visibility for Living entities
         const objLiving = obj as Living & { isLiving?: boolean };
@@ -957,7 +1030,7 @@ export class Room extends MudObject {
           isVisible = visResult.canSee;
         }
 
-        if (!isVisible) continue;
+        if (!isVisible) return;
 
         // Get short description
         let desc = obj.shortDesc || 'something';
@@ -986,7 +1059,7 @@ export class Room extends MudObject {
         } else {
           items.push(desc);
         }
-      }
+      });
 
       // Build contents line (players first, NPCs second, items last)
       const allContents = [...players, ...npcs, ...items];
@@ -40,6 +40,8 @@ export class Vehicle extends Room {
     super();
     this.shortDesc = 'A vehicle';
     this.longDesc = 'You are aboard a vehicle.';
+    // Vehicles move between rooms on their own schedule
+    this.setNoCleanUp();
   }
 
   // ========== Properties ==========
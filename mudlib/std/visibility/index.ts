@@ -23,7 +23,7 @@ import {
 import type { Living } from '../living.js';
 import type { Room } from '../room.js';
 import type { Item } from '../item.js';
-import type { MudObject } from '../object.js';
+import type { MudObject, OccupantCategory } from '../object.js';
 import type { Effect } from '../combat/types.js';
 import { isOutdoorTerrain } from '../../lib/terrain.js';
 import { getTimeDaemon } from '../../daemons/time.js';
@@ -102,15 +102,29 @@ export function getVisibilityState(target: Living): VisibilityState {
   };
 }
 
+/**
+ * Get the members of one occupant category of a container. Falls back to
+ * the whole inventory for containers without occupant buckets, so callers
+ * must still check each object.
+ */
+function occupantsOf(
+  container: MudObject,
+  category: OccupantCategory
+): ReadonlyArray<MudObject> {
+  if (typeof container.getOccupants === 'function') {
+    return container.getOccupants(category);
+  }
+  return container.inventory ?? [];
+}
+
 /**
  * Calculate the carried light from a living's inventory.
  * Returns a value from 0-50.
  */
 export function calculateCarriedLight(living: Living): number {
   let totalLight = 0;
-  const inventory = living.inventory ?? [];
 
-  for (const obj of inventory) {
+  for (const obj of occupantsOf(living, 'lightSource')) {
     const item = obj as LightBearingItem;
     if (item.isLightSource && item.lightRadius && item.lightRadius > 0) {
       // Check fuel
@@ -135,8 +149,7 @@ export function calculateRoomLight(room: Room | null): LightLevel {
   let baseLight = lightRoom.lightLevel ?? DEFAULT_ROOM_LIGHT;
 
   // Add light from dropped items
-  const contents = room.inventory ?? [];
-  for (const obj of contents) {
+  for (const obj of occupantsOf(room, 'lightSource')) {
     const item = obj as LightBearingItem;
     if (item.isLightSource && item.activeWhenDropped && item.lightRadius) {
       // Check fuel
@@ -364,7 +377,7 @@ export function getVisibleBeings(viewer: Living, location?: MudObject | null): L
   const room = env as Room;
   const visible: Living[] = [];
 
-  for (const obj of room.inventory ?? []) {
+  for (const obj of occupantsOf(room, 'living')) {
     // Check if object is a Living
     const living = obj as Living & { isLiving?: boolean };
     if (!living.isLiving) continue;
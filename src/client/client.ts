@@ -579,9 +579,10 @@ class MudClient {
     });
 
     // Tab completion handler - only active for builders+
-    this.inputHandler.setTabCompleteHandler((prefix: string) => {
+    // The first word completes against commands, later words against files
+    this.inputHandler.setTabCompleteHandler((prefix: string, cursorPosition: number) => {
       if (this.permissionLevel >= 1) {
-        this.wsClient.sendCompletionRequest(prefix);
+        this.wsClient.sendCompletionRequest(prefix, prefix.length === cursorPosition);
       }
     });
   }
@@ -650,14 +650,15 @@ export class WebSocketClient {
 
   /**
    * Send a completion request to the server.
+   * @param verb Whether the prefix is the command verb rather than a file argument
    */
-  sendCompletionRequest(prefix: string): void {
+  sendCompletionRequest(prefix: string, verb: boolean = false): void {
     if (!this.isConnected) {
       return; // Silently fail - not an error condition
     }
 
     try {
-      const message = { prefix };
+      const message = verb ? { prefix, verb } : { prefix };
       const jsonStr = JSON.stringify(message);
       const socket = this.requireSocket();
       socket.send(`\x00[COMPLETE]${jsonStr}\n`);
@@ -7,6 +7,37 @@
 
 import type { MudObject, Action, ActionHandler } from './types.js';
 import { getShadowRegistry } from './shadow-registry.js';
+import { getRegistry } from './object-registry.js';
+
+/**
+ * Categories of inventory members tracked by every container.
+ * - listener: has a receive() method
+ * - living, player, npc: flagged with isLiving, isPlayer or isNPC
+ * - lightSource: flagged with isLightSource
+ * - item: anything that is not a living
+ */
+export type OccupantCategory = 'listener' | 'living' | 'player' | 'npc' | 'lightSource' | 'item';
+
+const EMPTY_OCCUPANTS: ReadonlyArray<MudObject> = Object.freeze([]);
+
+/**
+ * Work out which occupant categories an object belongs to.
+ */
+export function classifyOccupant(object: MudObject): OccupantCategory[] {
+  const flags = object as MudObject & {
+    receive?: unknown;
+    isLiving?: boolean;
+    isPlayer?: boolean;
+    isNPC?: boolean;
+    isLightSource?: boolean;
+  };
+  const categories: OccupantCategory[] = [flags.isLiving === true ? 'living' : 'item'];
+  if (typeof flags.receive === 'function') categories.push('listener');
+  if (flags.isPlayer === true) categories.push('player');
+  if (flags.isNPC === true) categories.push('npc');
+  if (flags.isLightSource === true) categories.push('lightSource');
+  return categories;
+}
 
 /**
  * Base implementation of MudObject.
@@ -40,6 +71,12 @@ export class BaseMudObject implements MudObject {
 
   private _environment: MudObject | null = null;
   private _inventory: MudObject[] = [];
+  /** Inventory members by category (created on first arrival) */
+  private _occupants: Map<OccupantCategory, Set<MudObject>> | null = null;
+  /** Frozen array views of _occupants, rebuilt after a category changes */
+  private _occupantViews: Map<OccupantCategory, ReadonlyArray<MudObject>> | null = null;
+  /** Categories this object is filed under in its environment */
+  private _occupantCategories: OccupantCategory[] = [];
 
   get environment(): MudObject | null {
     // Wrap with shadow proxy if environment has shadows
@@ -61,9 +98,27 @@ export class BaseMudObject implements MudObject {
   get inventory(): ReadonlyArray<MudObject> {
     // Wrap all inventory items with shadow proxies
     const registry = getShadowRegistry();
+    if (!registry.hasAnyShadows()) return this._inventory.slice();
     return this._inventory.map((obj) => registry.wrapWithProxy(obj));
   }
 
+  /**
+   * Get the inventory members in one category, in arrival order.
+   * Maintained incrementally by moveTo(), so this is O(category size).
+   */
+  getOccupants(category: OccupantCategory): ReadonlyArray<MudObject> {
+    let view = this._occupantViews?.get(category);
+    if (!view) {
+      const members = this._occupants?.get(category);
+      view = members && members.size > 0 ? Object.freeze(Array.from(members)) : EMPTY_OCCUPANTS;
+      (this._occupantViews ??= new Map()).set(category, view);
+    }
+    // The cached view is frozen, so it is safe to hand out when unshadowed
+    const registry = getShadowRegistry();
+    if (view.length === 0 || !registry.hasAnyShadows()) return view;
+    return view.map((obj) => registry.wrapWithProxy(obj));
+  }
+
   // ========== Description ==========
 
   shortDesc: string = 'an object';
@@ -118,6 +173,8 @@ export class BaseMudObject implements MudObject {
   // ========== Movement ==========
 
   moveTo(destination: MudObject | null): boolean | Promise<boolean> {
+    const wasInWorld = this._environment !== null;
+
     // Remove from current environment
     if (this._environment) {
       const envBase = this._environment as BaseMudObject;
@@ -125,6 +182,7 @@ export class BaseMudObject implements MudObject {
       if (index !== -1) {
         envBase._inventory.splice(index, 1);
       }
+      envBase._unfileOccupant(this);
     }
 
     // Set new environment
@@ -134,11 +192,28 @@ export class BaseMudObject implements MudObject {
     if (destination) {
       const destBase = destination as BaseMudObject;
       destBase._inventory.push(this);
+      destBase._fileOccupant(this);
+    }
+
+    // Keep the registry's index of environment-less objects current
+    if (wasInWorld !== (destination !== null)) {
+      getRegistry().updateEnvironment(this);
     }
 
     return true;
   }
 
+  /**
+   * Re-file this object in its environment's occupant buckets after
+   * something its categories depend on has changed.
+   */
+  updateOccupantCategories(): void {
+    if (!this._environment) return;
+    const envBase = this._environment as BaseMudObject;
+    envBase._unfileOccupant(this);
+    envBase._fileOccupant(this);
+  }
+
   // ========== Interaction ==========
 
   id(name: string): boolean {
@@ -177,6 +252,7 @@ export class BaseMudObject implements MudObject {
    */
   _addToInventory(object: MudObject): void {
     this._inventory.push(object);
+    this._fileOccupant(object);
   }
 
   /**
@@ -188,5 +264,43 @@ export class BaseMudObject implements MudObject {
     if (index !== -1) {
       this._inventory.splice(index, 1);
     }
+    this._unfileOccupant(object);
+  }
+
+  /**
+   * Add an arriving object to the occupant buckets.
+   */
+  private _fileOccupant(object: MudObject): void {
+    const categories = classifyOccupant(object);
+    if (object instanceof BaseMudObject) {
+      object._occupantCategories = categories;
+    }
+    const buckets = (this._occupants ??= new Map());
+    for (const category of categories) {
+      let members = buckets.get(category);
+      if (!members) {
+        members = new Set();
+        buckets.set(category, members);
+      }
+      members.add(object);
+      this._occupantViews?.delete(category);
+    }
+  }
+
+  /**
+   * Remove a departing object from the occupant buckets.
+   */
+  private _unfileOccupant(object: MudObject): void {
+    // Objects that aren't BaseMudObjects don't remember their categories
+    const categories =
+      object instanceof BaseMudObject ? object._occupantCategories : this._occupants?.keys() ?? [];
+    for (const category of categories) {
+      if (this._occupants?.get(category)?.delete(object)) {
+        this._occupantViews?.delete(category);
+      }
+    }
+    if (object instanceof BaseMudObject) {
+      object._occupantCategories = [];
+    }
   }
 }
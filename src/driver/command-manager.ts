@@ -9,15 +9,22 @@
  *
  * Command files are prefixed with "_" (e.g., _look.ts, _goto.ts)
  * and export a standard Command interface.
+ *
+ * Dispatch goes through resolved command tables (see command-table.ts), one
+ * per set of effective command paths, so a verb is a single map lookup.
+ * Tables are rebuilt lazily after a command file or a path grant changes.
  */
 
 import { watch, type FSWatcher } from 'fs';
 import { readdir, stat } from 'fs/promises';
-import { join, resolve } from 'path';
+import { basename, join, resolve } from 'path';
 import { pathToFileURL } from 'url';
 import type { MudObject } from './types.js';
 import type { Logger } from 'pino';
-import { getPermissions } from './permissions.js';
+import { getPermissions, type Permissions } from './permissions.js';
+import { getModuleReloader } from './module-reloader.js';
+import { buildCommandTable, type CommandTable } from './command-table.js';
+import { getCommandTracer } from './command-tracer.js';
 
 /**
  * Permission levels matching the mudlib's PermissionLevel enum.
@@ -74,6 +81,18 @@ interface LoadedCommand {
   level: PermissionLevel;
   filePath: string;
   names: string[];
+  /** Command directory relative to cmds/ (e.g. 'player', 'guilds/fighter') */
+  directory: string;
+}
+
+/**
+ * A player's resolved table, valid while their level and the path grants
+ * are unchanged.
+ */
+interface PlayerTable {
+  level: PermissionLevel;
+  pathsRevision: number;
+  table: CommandTable<LoadedCommand>;
 }
 
 /**
@@ -122,9 +141,17 @@ export class CommandManager {
   private logger: Logger | undefined;
   private commands: Map<string, LoadedCommand[]> = new Map();
   private commandsByFile: Map<string, LoadedCommand> = new Map();
+  /** Files imported at least once; later loads go through the module reloader */
+  private importedFiles: Set<string> = new Set();
   private watchers: FSWatcher[] = [];
   private initialized: boolean = false;
   private savePlayerCallback: ((player: MudObject) => Promise<void>) | undefined;
+  /** Profile key (effective paths, or level for unnamed objects) -> resolved table */
+  private tables: Map<string, CommandTable<LoadedCommand>> = new Map();
+  /** Lowercase player name -> their profile's table */
+  private playerTables: Map<string, PlayerTable> = new Map();
+  /** Permissions instance the player tables were resolved against */
+  private tablesPermissions: Permissions | null = null;
 
   constructor(config: CommandManagerConfig) {
     this.config = {
@@ -185,32 +212,60 @@ export class CommandManager {
   }
 
   /**
-   * Resolve the best command for a player from a list of candidates.
-   * Returns the first command whose directory is in the player's allowed paths.
+   * Get the resolved command table for a player.
+   * Players with the same effective command paths share a table; objects
+   * without names (NPCs, etc.) get one per permission level.
    */
-  private resolveCommand(
-    candidates: LoadedCommand[],
+  private tableFor(
     playerName: string | undefined,
-    playerLevel: PermissionLevel,
-  ): LoadedCommand | undefined {
-    if (playerName) {
-      const permissions = getPermissions();
-      const allowedPaths = permissions.getEffectiveCommandPaths(playerName, playerLevel);
-      for (const candidate of candidates) {
-        const cmdDir = this.getCommandDirectory(candidate.filePath);
-        if (allowedPaths.includes(cmdDir)) {
-          return candidate;
-        }
-      }
-    } else {
-      // Fallback for objects without names (NPCs, etc.)
-      for (const candidate of candidates) {
-        if (playerLevel >= candidate.level) {
-          return candidate;
-        }
-      }
+    playerLevel: PermissionLevel
+  ): CommandTable<LoadedCommand> {
+    if (!playerName) {
+      return this.profileTable(`level:${playerLevel}`, (loaded) => playerLevel >= loaded.level);
+    }
+
+    const permissions = getPermissions();
+    if (permissions !== this.tablesPermissions) {
+      this.playerTables.clear();
+      this.tablesPermissions = permissions;
+    }
+
+    const name = playerName.toLowerCase();
+    const pathsRevision = permissions.getCommandPathsRevision();
+    const cached = this.playerTables.get(name);
+    if (cached && cached.level === playerLevel && cached.pathsRevision === pathsRevision) {
+      return cached.table;
+    }
+
+    const allowedPaths = new Set(permissions.getEffectiveCommandPaths(playerName, playerLevel));
+    const table = this.profileTable(`paths:${[...allowedPaths].sort().join(',')}`, (loaded) =>
+      allowedPaths.has(loaded.directory)
+    );
+    this.playerTables.set(name, { level: playerLevel, pathsRevision, table });
+    return table;
+  }
+
+  /**
+   * Get or build the table for a permission profile.
+   */
+  private profileTable(
+    key: string,
+    allowed: (loaded: LoadedCommand) => boolean
+  ): CommandTable<LoadedCommand> {
+    let table = this.tables.get(key);
+    if (!table) {
+      table = buildCommandTable(this.commands, allowed);
+      this.tables.set(key, table);
     }
-    return undefined;
+    return table;
+  }
+
+  /**
+   * Drop resolved tables after the loaded commands change.
+   */
+  private invalidateTables(): void {
+    this.tables.clear();
+    this.playerTables.clear();
   }
 
   /**
@@ -269,59 +324,103 @@ export class CommandManager {
     const absolutePath = resolve(filePath);
 
     try {
-      // Clear from Node's module cache for hot-reload
-      const fileUrl = pathToFileURL(absolutePath).href;
+      // Node's ESM cache keeps the first version of a file forever, so
+      // reloads evaluate the current file as a new, collectable version
+      // (including after a failed import, which Node also caches).
+      const reload = this.importedFiles.has(absolutePath);
+      this.importedFiles.add(absolutePath);
+      const module = reload
+        ? await getModuleReloader().load(absolutePath)
+        : await import(pathToFileURL(absolutePath).href);
+      this.register(absolutePath, level, module);
+    } catch (error) {
+      this.logger?.error({ error, filePath }, 'Failed to load command');
+    }
+  }
 
-      // Add cache-busting query parameter for hot-reload
-      const urlWithCacheBust = `${fileUrl}?t=${Date.now()}`;
+  /**
+   * Whether a command file is loaded.
+   */
+  hasCommandFile(filePath: string): boolean {
+    return this.commandsByFile.has(resolve(filePath));
+  }
 
-      const module = await import(urlWithCacheBust);
-      const command: Command = module.default || module;
+  /**
+   * Replace a loaded command file with an already evaluated module version,
+   * keeping its permission level. Synchronous, so it can be part of a batch
+   * swap (see HotReload.reloadWithDependents).
+   * @returns false if the file is not a loaded command or the module is not a command
+   */
+  installModule(filePath: string, module: Record<string, unknown>): boolean {
+    const absolutePath = resolve(filePath);
+    const existing = this.commandsByFile.get(absolutePath);
+    if (!existing) return false;
+    this.importedFiles.add(absolutePath);
+    return this.register(absolutePath, existing.level, module);
+  }
 
-      if (!command || !command.name || !command.execute) {
-        this.logger?.warn({ filePath }, 'Invalid command file - missing name or execute');
-        return;
-      }
+  /**
+   * Check that a module exports a command (a name and an execute function)
+   * without registering it.
+   */
+  isCommandModule(module: Record<string, unknown>): boolean {
+    const command = (module.default || module) as Partial<Command> | undefined;
+    return Boolean(command && command.name && command.execute);
+  }
 
-      // Get all names for this command
-      const names = Array.isArray(command.name) ? command.name : [command.name];
+  /**
+   * Register a command module, replacing the file's previous version.
+   */
+  private register(
+    absolutePath: string,
+    level: PermissionLevel,
+    module: Record<string, unknown>
+  ): boolean {
+    if (!this.isCommandModule(module)) {
+      this.logger?.warn({ filePath: absolutePath }, 'Invalid command file - missing name or execute');
+      return false;
+    }
+    const command = (module.default || module) as Command;
 
-      const loaded: LoadedCommand = {
-        command,
-        level,
-        filePath: absolutePath,
-        names,
-      };
+    // Get all names for this command
+    const names = Array.isArray(command.name) ? command.name : [command.name];
 
-      // Remove old command if reloading
-      const existingByFile = this.commandsByFile.get(absolutePath);
-      if (existingByFile) {
-        for (const name of existingByFile.names) {
-          const list = this.commands.get(name.toLowerCase());
-          if (list) {
-            const idx = list.indexOf(existingByFile);
-            if (idx >= 0) list.splice(idx, 1);
-            if (list.length === 0) this.commands.delete(name.toLowerCase());
-          }
-        }
-      }
+    const loaded: LoadedCommand = {
+      command,
+      level,
+      filePath: absolutePath,
+      names,
+      directory: this.getCommandDirectory(absolutePath),
+    };
 
-      // Register new command
-      this.commandsByFile.set(absolutePath, loaded);
-      for (const name of names) {
-        const key = name.toLowerCase();
-        const list = this.commands.get(key);
+    // Remove old command if reloading
+    const existingByFile = this.commandsByFile.get(absolutePath);
+    if (existingByFile) {
+      for (const name of existingByFile.names) {
+        const list = this.commands.get(name.toLowerCase());
         if (list) {
-          list.push(loaded);
-        } else {
-          this.commands.set(key, [loaded]);
+          const idx = list.indexOf(existingByFile);
+          if (idx >= 0) list.splice(idx, 1);
+          if (list.length === 0) this.commands.delete(name.toLowerCase());
         }
       }
+    }
 
-      this.logger?.debug({ names, level, filePath }, 'Loaded command');
-    } catch (error) {
-      this.logger?.error({ error, filePath }, 'Failed to load command');
+    // Register new command
+    this.commandsByFile.set(absolutePath, loaded);
+    for (const name of names) {
+      const key = name.toLowerCase();
+      const list = this.commands.get(key);
+      if (list) {
+        list.push(loaded);
+      } else {
+        this.commands.set(key, [loaded]);
+      }
     }
+    this.invalidateTables();
+
+    this.logger?.debug({ names, level, filePath: absolutePath }, 'Loaded command');
+    return true;
   }
 
   /**
@@ -341,6 +440,7 @@ export class CommandManager {
         }
       }
       this.commandsByFile.delete(absolutePath);
+      this.invalidateTables();
       this.logger?.debug({ filePath }, 'Unloaded command');
     }
   }
@@ -466,19 +566,21 @@ export class CommandManager {
       args = trimmed.substring(1).trim();
     }
 
-    // Find candidates for this verb
-    const candidates = this.commands.get(verb.toLowerCase());
-    if (!candidates || candidates.length === 0) {
-      return false;
-    }
-
     // Resolve to the best command the player has access to
+    const tracer = getCommandTracer();
+    const endResolve = tracer.span('resolve', 'command table');
     const playerWithName = player as MudObject & { name?: string };
-    const loaded = this.resolveCommand(candidates, playerWithName.name, playerLevel);
+    const loaded = this.tableFor(playerWithName.name, playerLevel).verbs.get(verb.toLowerCase());
+    endResolve();
     if (!loaded) {
       return false;
     }
 
+    const trace = tracer.current();
+    if (trace && trace.handledBy === null) {
+      trace.handledBy = `/cmds/${loaded.directory}/${basename(loaded.filePath, '.ts')}`;
+    }
+
     // Create context
     const playerWithReceive = player as MudObject & { receive?: (msg: string) => void };
     const savePlayerCallback = this.savePlayerCallback;
@@ -505,6 +607,7 @@ export class CommandManager {
     };
 
     // Execute
+    const endExecute = tracer.span('execute', verb.toLowerCase());
     try {
       const result = await loaded.command.execute(ctx);
       // If command explicitly returns false, it failed
@@ -514,6 +617,8 @@ export class CommandManager {
       this.logger?.error({ error, verb }, 'Error executing command');
       ctx.sendLine(`Error executing command: ${error instanceof Error ? error.message : String(error)}`);
       return false; // Command errored = failure
+    } finally {
+      endExecute();
     }
   }
 
@@ -523,45 +628,35 @@ export class CommandManager {
    * @param playerName Optional player name for path-based filtering
    */
   getAvailableCommands(level: PermissionLevel, playerName?: string): Command[] {
-    const result: Command[] = [];
-    const seen = new Set<Command>();
-
-    // Get allowed paths for this player
-    let allowedPaths: string[] | null = null;
-    if (playerName) {
-      const permissions = getPermissions();
-      allowedPaths = permissions.getEffectiveCommandPaths(playerName, level);
+    const result = new Set<Command>();
+    for (const loaded of this.tableFor(playerName, level).usable) {
+      result.add(loaded.command);
     }
 
-    for (const candidates of this.commands.values()) {
-      for (const loaded of candidates) {
-        if (seen.has(loaded.command)) continue;
-
-        // Check access using path-based system if player name provided
-        if (allowedPaths) {
-          const cmdDir = this.getCommandDirectory(loaded.filePath);
-          if (!allowedPaths.includes(cmdDir)) {
-            continue;
-          }
-        } else {
-          // Fallback to level-based check
-          if (loaded.level > level) {
-            continue;
-          }
-        }
-
-        seen.add(loaded.command);
-        result.push(loaded.command);
-      }
-    }
-
-    return result.sort((a, b) => {
+    return [...result].sort((a, b) => {
       const nameA = Array.isArray(a.name) ? (a.name[0] ?? '') : a.name;
       const nameB = Array.isArray(b.name) ? (b.name[0] ?? '') : b.name;
       return nameA.localeCompare(nameB);
     });
   }
 
+  /**
+   * Complete a partial verb against the commands a player can use.
+   * @param prefix The partial verb
+   * @param playerName Optional player name for path-based filtering
+   * @param level The player's permission level
+   * @param limit Maximum number of verbs to return
+   * @returns Matching verbs in alphabetical order
+   */
+  completeVerb(
+    prefix: string,
+    playerName: string | undefined,
+    level: PermissionLevel,
+    limit: number = 50
+  ): string[] {
+    return this.tableFor(playerName, level).trie.withPrefix(prefix.toLowerCase(), limit);
+  }
+
   /**
    * Check if a command exists.
    */
@@ -583,6 +678,7 @@ export class CommandManager {
   async reload(): Promise<void> {
     this.commands.clear();
     this.commandsByFile.clear();
+    this.invalidateTables();
 
     for (const [dirName, level] of Object.entries(LEVEL_DIRS)) {
       const dirPath = join(this.config.cmdsPath, dirName);
@@ -670,7 +766,7 @@ export class CommandManager {
     const candidates = this.commands.get(name.toLowerCase());
     if (!candidates || candidates.length === 0) return undefined;
 
-    // Return the first candidate (caller can use resolveCommand for path-aware lookup)
+    // Return the first candidate (execute resolves per player through their command table)
     const loaded = candidates[0];
     if (!loaded) return undefined;
 
@@ -701,6 +797,7 @@ export class CommandManager {
     this.stopWatching();
     this.commands.clear();
     this.commandsByFile.clear();
+    this.invalidateTables();
     this.initialized = false;
   }
 }
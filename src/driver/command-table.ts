@@ -0,0 +1,121 @@
+/**
+ * Command tables - Resolved verb dispatch for a permission profile.
+ *
+ * Which command a verb runs depends only on the player's effective command
+ * paths (their level directories plus any granted guild or custom paths),
+ * so players with the same paths share one table. A table maps each verb
+ * straight to the command that wins for that profile, and keeps a trie of
+ * its verbs for prefix lookups (tab completion). CommandManager builds
+ * tables lazily and drops them when a command file or a permission grant
+ * changes.
+ */
+
+interface TrieNode<T> {
+  children: Map<string, TrieNode<T>>;
+  value?: T;
+}
+
+/**
+ * Prefix tree over verbs.
+ */
+export class VerbTrie<T> {
+  private root: TrieNode<T> = { children: new Map() };
+  private count = 0;
+
+  /**
+   * Add or replace a verb.
+   */
+  set(verb: string, value: T): void {
+    let node = this.root;
+    for (const char of verb) {
+      let child = node.children.get(char);
+      if (!child) {
+        child = { children: new Map() };
+        node.children.set(char, child);
+      }
+      node = child;
+    }
+    if (node.value === undefined) this.count++;
+    node.value = value;
+  }
+
+  /**
+   * Look up an exact verb.
+   */
+  get(verb: string): T | undefined {
+    return this.find(verb)?.value;
+  }
+
+  /**
+   * Verbs starting with a prefix, in alphabetical order.
+   * @param limit Maximum number of verbs to return
+   */
+  withPrefix(prefix: string, limit: number = Infinity): string[] {
+    const start = this.find(prefix);
+    const verbs: string[] = [];
+    if (!start) return verbs;
+
+    const visit = (node: TrieNode<T>, verb: string): void => {
+      if (verbs.length >= limit) return;
+      if (node.value !== undefined) verbs.push(verb);
+      for (const char of [...node.children.keys()].sort()) {
+        visit(node.children.get(char)!, verb + char);
+      }
+    };
+    visit(start, prefix);
+    return verbs;
+  }
+
+  /**
+   * Number of verbs.
+   */
+  get size(): number {
+    return this.count;
+  }
+
+  private find(prefix: string): TrieNode<T> | undefined {
+    let node: TrieNode<T> | undefined = this.root;
+    for (const char of prefix) {
+      node = node.children.get(char);
+      if (!node) return undefined;
+    }
+    return node;
+  }
+}
+
+/**
+ * Resolved commands for one permission profile.
+ */
+export interface CommandTable<T> {
+  /** Lowercase verb -> command */
+  verbs: Map<string, T>;
+  /** The same verbs, for prefix lookups */
+  trie: VerbTrie<T>;
+  /** Every command the profile may use, including ones shadowed for a verb */
+  usable: T[];
+}
+
+/**
+ * Resolve every verb to the first candidate the profile may use.
+ * @param candidates Lowercase verb -> commands in priority order
+ * @param allowed Whether the profile may use a command
+ */
+export function buildCommandTable<T>(
+  candidates: Map<string, T[]>,
+  allowed: (command: T) => boolean
+): CommandTable<T> {
+  const verbs = new Map<string, T>();
+  const trie = new VerbTrie<T>();
+  const usable = new Set<T>();
+  for (const [verb, list] of candidates) {
+    for (const command of list) {
+      if (!allowed(command)) continue;
+      usable.add(command);
+      if (!verbs.has(verb)) {
+        verbs.set(verb, command);
+        trie.set(verb, command);
+      }
+    }
+  }
+  return { verbs, trie, usable: [...usable] };
+}
@@ -0,0 +1,407 @@
+/**
+ * CommandTracer - Per-phase latency traces of player commands.
+ *
+ * The commands histogram says a `look` took 80ms but not where. A traced
+ * command records spans for each phase it passes through:
+ *
+ * - parse:   alias expansion
+ * - resolve: command table lookup, and the mudlib's fallback to channels
+ *            and room/item actions when no command or emote matched
+ * - execute: the command or emote body
+ * - send:    time spent writing output to connections
+ *
+ * The trace follows the command across awaits (AsyncLocalStorage), so the
+ * driver, the command manager and connections can add spans without
+ * passing it around. Commands are sampled; sampled traces go to a ring of
+ * recent traces, and those slower than the threshold also go to a ring of
+ * slow traces for admins. Traces export in the Chrome Trace Event format,
+ * which Perfetto (ui.perfetto.dev) and chrome://tracing load directly.
+ *
+ * Traces keep only the verb of the input line: the rest can be tell, say
+ * or channel text, which has no place in perf output or exported files.
+ */
+
+import { AsyncLocalStorage } from 'async_hooks';
+
+export type TracePhase = 'parse' | 'resolve' | 'execute' | 'send';
+
+/**
+ * One timed step of a command. Offsets are relative to command start.
+ */
+export interface TraceSpan {
+  phase: TracePhase;
+  name: string;
+  startMs: number;
+  durationMs: number;
+  /** Spans open when this one started (0 = top level) */
+  depth: number;
+}
+
+/**
+ * A finished command trace.
+ */
+export interface CommandTraceRecord {
+  id: number;
+  player: string;
+  /** The verb of the input line; arguments are not kept */
+  input: string;
+  /** Epoch time the command started */
+  timestamp: number;
+  durationMs: number;
+  /** What handled the command (command file, 'emote', 'mudlib'), if known */
+  handledBy: string | null;
+  /** Spans in start order */
+  spans: TraceSpan[];
+  /**
+   * Time per phase from top-level spans. send is the summed output write
+   * time, which is also part of whichever span did the writing.
+   */
+  phases: Record<TracePhase, number>;
+  /** Output messages during the command and the frames they went out in */
+  sends: { count: number; frames: number; bytes: number };
+}
+
+export interface CommandTracerConfig {
+  /** Percentage of commands traced (0 disables tracing) */
+  samplePercent: number;
+  /** Traces at least this slow are kept in the slow ring */
+  slowThresholdMs: number;
+  /** Slow traces kept */
+  maxSlowTraces: number;
+  /** Recent sampled traces kept */
+  maxRecentTraces: number;
+}
+
+export interface CommandTracerStats {
+  /** Commands traced */
+  traced: number;
+  /** Commands skipped by sampling */
+  skipped: number;
+  /** Traced commands at or over the slow threshold */
+  slow: number;
+  samplePercent: number;
+  slowThresholdMs: number;
+}
+
+/**
+ * Chrome Trace Event Format document.
+ */
+export interface ChromeTrace {
+  traceEvents: Array<{
+    name: string;
+    cat: string;
+    ph: 'X' | 'M';
+    ts: number;
+    dur?: number;
+    pid: number;
+    tid: number;
+    args: Record<string, unknown>;
+  }>;
+  displayTimeUnit: 'ms';
+}
+
+const PHASES: TracePhase[] = ['parse', 'resolve', 'execute', 'send'];
+
+/**
+ * A command being traced.
+ */
+export class CommandTrace {
+  readonly id: number;
+  readonly player: string;
+  readonly input: string;
+  readonly timestamp: number = Date.now();
+  /** Set once the command manager has been asked to run the command */
+  dispatched: boolean = false;
+  handledBy: string | null = null;
+  private started: number = performance.now();
+  private spans: TraceSpan[] = [];
+  private open: Set<TraceSpan> = new Set();
+  private sendCount = 0;
+  private sendFrames = 0;
+  private sendBytes = 0;
+  private sendMs = 0;
+  private firstSendMs = -1;
+
+  constructor(id: number, player: string, input: string) {
+    this.id = id;
+    this.player = player;
+    this.input = input.trim().split(/\s/, 1)[0] ?? '';
+  }
+
+  /**
+   * Start a span.
+   * @returns Ends the span; spans still open when the command finishes end with it
+   */
+  span(phase: TracePhase, name: string): () => void {
+    const span: TraceSpan = {
+      phase,
+      name,
+      startMs: performance.now() - this.started,
+      durationMs: 0,
+      depth: this.open.size,
+    };
+    this.spans.push(span);
+    this.open.add(span);
+    return () => {
+      if (!this.open.delete(span)) return;
+      span.durationMs = performance.now() - this.started - span.startMs;
+    };
+  }
+
+  /**
+   * Record one output frame.
+   * @param messages Messages coalesced into the frame
+   */
+  recordSend(bytes: number, durationMs: number, messages: number = 1): void {
+    if (this.firstSendMs < 0) {
+      this.firstSendMs = performance.now() - this.started - durationMs;
+    }
+    this.sendCount += messages;
+    this.sendFrames++;
+    this.sendBytes += bytes;
+    this.sendMs += durationMs;
+  }
+
+  /**
+   * Close the trace.
+   */
+  finish(): CommandTraceRecord {
+    const durationMs = performance.now() - this.started;
+    for (const span of this.open) {
+      span.durationMs = durationMs - span.startMs;
+    }
+    this.open.clear();
+
+    const spans = [...this.spans];
+    if (this.sendFrames > 0) {
+      // Writes are interleaved with everything else; show them as one span
+      // of their summed time starting at the first write
+      spans.push({
+        phase: 'send',
+        name: `output (${this.sendCount} messages, ${this.sendFrames} frames)`,
+        startMs: this.firstSendMs,
+        durationMs: this.sendMs,
+        depth: 0,
+      });
+    }
+
+    const phases = { parse: 0, resolve: 0, execute: 0, send: this.sendMs };
+    for (const span of this.spans) {
+      if (span.depth === 0) phases[span.phase] += span.durationMs;
+    }
+
+    return {
+      id: this.id,
+      player: this.player,
+      input: this.input,
+      timestamp: this.timestamp,
+      durationMs,
+      handledBy: this.handledBy,
+      spans,
+      phases,
+      sends: { count: this.sendCount, frames: this.sendFrames, bytes: this.sendBytes },
+    };
+  }
+}
+
+/**
+ * Samples commands and keeps recent and slow traces.
+ */
+export class CommandTracer {
+  private config: CommandTracerConfig;
+  private storage = new AsyncLocalStorage<CommandTrace>();
+  private nextId = 1;
+  private recent: CommandTraceRecord[] = [];
+  private slow: CommandTraceRecord[] = [];
+  private stats = { traced: 0, skipped: 0, slow: 0 };
+
+  constructor(config: Partial<CommandTracerConfig> = {}) {
+    this.config = {
+      samplePercent: config.samplePercent ?? 5,
+      slowThresholdMs: config.slowThresholdMs ?? 50,
+      maxSlowTraces: config.maxSlowTraces ?? 50,
+      maxRecentTraces: config.maxRecentTraces ?? 100,
+    };
+  }
+
+  /**
+   * Run a command, tracing it if sampled.
+   * @param player Name of the player running the command
+   * @param input The command line (only its verb is kept)
+   * @param run Runs the command
+   * @returns The finished trace, if the command was sampled
+   */
+  async trace(
+    player: string,
+    input: string,
+    run: () => Promise<void>
+  ): Promise<CommandTraceRecord | null> {
+    if (!this.sample()) {
+      this.stats.skipped++;
+      await run();
+      return null;
+    }
+
+    const trace = new CommandTrace(this.nextId++, player, input);
+    try {
+      await this.storage.run(trace, run);
+    } catch (error) {
+      this.store(trace.finish());
+      throw error;
+    }
+    return this.store(trace.finish());
+  }
+
+  /**
+   * The trace of the command running in the current async context.
+   */
+  current(): CommandTrace | undefined {
+    return this.storage.getStore();
+  }
+
+  /**
+   * Start a span on the current command, if it is traced.
+   * @returns Ends the span
+   */
+  span(phase: TracePhase, name: string): () => void {
+    return this.storage.getStore()?.span(phase, name) ?? noop;
+  }
+
+  /**
+   * Traces at or over the slow threshold, oldest first.
+   */
+  getSlowTraces(): CommandTraceRecord[] {
+    return [...this.slow];
+  }
+
+  /**
+   * Recent sampled traces, oldest first.
+   */
+  getRecentTraces(): CommandTraceRecord[] {
+    return [...this.recent];
+  }
+
+  getStats(): CommandTracerStats {
+    return {
+      ...this.stats,
+      samplePercent: this.config.samplePercent,
+      slowThresholdMs: this.config.slowThresholdMs,
+    };
+  }
+
+  /**
+   * Change the sampling rate at runtime.
+   */
+  setSamplePercent(percent: number): void {
+    this.config.samplePercent = Math.min(100, Math.max(0, percent));
+  }
+
+  /**
+   * Drop kept traces and counters.
+   */
+  clear(): void {
+    this.recent = [];
+    this.slow = [];
+    this.stats = { traced: 0, skipped: 0, slow: 0 };
+  }
+
+  private sample(): boolean {
+    const percent = this.config.samplePercent;
+    return percent >= 100 || (percent > 0 && Math.random() * 100 < percent);
+  }
+
+  private store(record: CommandTraceRecord): CommandTraceRecord {
+    this.stats.traced++;
+    this.recent.push(record);
+    if (this.recent.length > this.config.maxRecentTraces) {
+      this.recent.shift();
+    }
+    if (record.durationMs >= this.config.slowThresholdMs) {
+      this.stats.slow++;
+      this.slow.push(record);
+      if (this.slow.length > this.config.maxSlowTraces) {
+        this.slow.shift();
+      }
+    }
+    return record;
+  }
+}
+
+function noop(): void {}
+
+/**
+ * Convert traces to the Chrome Trace Event Format. Each player is a thread;
+ * a command is a complete event with its spans nested inside it.
+ */
+export function toChromeTrace(traces: CommandTraceRecord[]): ChromeTrace {
+  const threads = new Map<string, number>();
+  const events: ChromeTrace['traceEvents'] = [];
+
+  for (const trace of traces) {
+    let tid = threads.get(trace.player);
+    if (tid === undefined) {
+      tid = threads.size + 1;
+      threads.set(trace.player, tid);
+      events.push({
+        name: 'thread_name',
+        cat: '__metadata',
+        ph: 'M',
+        ts: 0,
+        pid: 1,
+        tid,
+        args: { name: trace.player },
+      });
+    }
+
+    const start = trace.timestamp * 1000;
+    events.push({
+      name: trace.input,
+      cat: 'command',
+      ph: 'X',
+      ts: start,
+      dur: trace.durationMs * 1000,
+      pid: 1,
+      tid,
+      args: {
+        id: trace.id,
+        handledBy: trace.handledBy,
+        sends: trace.sends,
+        ...Object.fromEntries(PHASES.map((phase) => [`${phase}Ms`, trace.phases[phase]])),
+      },
+    });
+    for (const span of trace.spans) {
+      events.push({
+        name: span.name,
+        cat: span.phase,
+        ph: 'X',
+        ts: start + span.startMs * 1000,
+        dur: span.durationMs * 1000,
+        pid: 1,
+        tid,
+        args: {},
+      });
+    }
+  }
+
+  return { traceEvents: events, displayTimeUnit: 'ms' };
+}
+
+// Singleton instance
+let tracerInstance: CommandTracer | null = null;
+
+/**
+ * Get the global CommandTracer instance.
+ */
+export function getCommandTracer(config?: Partial<CommandTracerConfig>): CommandTracer {
+  if (!tracerInstance) {
+    tracerInstance = new CommandTracer(config);
+  }
+  return tracerInstance;
+}
+
+/**
+ * Reset the global tracer. Used for testing.
+ */
+export function resetCommandTracer(): void {
+  tracerInstance = null;
+}
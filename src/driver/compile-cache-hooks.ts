@@ -0,0 +1,84 @@
+/**
+ * Module loader hooks that serve mudlib TypeScript from the compile cache.
+ *
+ * Registered by registerCompileCacheHooks(); runs on Node's loader thread.
+ * Only .ts files under the mudlib are handled. Anything else - and any file
+ * that fails to transform - falls through to the next loader (tsx), so
+ * error messages are unchanged.
+ */
+
+import { readFile } from 'fs/promises';
+import { fileURLToPath } from 'url';
+import type { MessagePort } from 'worker_threads';
+import {
+  CompileCache,
+  mudlibTransformOptions,
+  type CompileCacheHookEvent,
+} from './compile-cache.js';
+
+interface HookData {
+  cacheDir: string;
+  maxBytes: number;
+  mudlibPath: string;
+  mudlibUrl: string;
+  port: MessagePort;
+}
+
+interface LoadContext {
+  format?: string | null;
+  [key: string]: unknown;
+}
+
+interface LoadResult {
+  format: string;
+  source: string;
+  shortCircuit?: boolean;
+}
+
+type NextLoad = (url: string, context: LoadContext) => Promise<unknown>;
+
+let state: {
+  cache: CompileCache;
+  mudlibUrl: string;
+  options: ReturnType<typeof mudlibTransformOptions>;
+  port: MessagePort;
+} | null = null;
+
+export async function initialize(data: HookData): Promise<void> {
+  state = {
+    cache: new CompileCache({ cacheDir: data.cacheDir, enabled: true, maxBytes: data.maxBytes }),
+    mudlibUrl: data.mudlibUrl,
+    options: mudlibTransformOptions(data.mudlibPath),
+    port: data.port,
+  };
+}
+
+export async function load(url: string, context: LoadContext, nextLoad: NextLoad): Promise<unknown> {
+  if (!state || !url.startsWith(state.mudlibUrl)) {
+    return nextLoad(url, context);
+  }
+
+  // Strip hot-reload cache busting (?update=..., ?t=...) before reading
+  const fileUrl = new URL(url);
+  fileUrl.search = '';
+  if (!fileUrl.pathname.endsWith('.ts') || fileUrl.pathname.endsWith('.d.ts')) {
+    return nextLoad(url, context);
+  }
+
+  try {
+    const path = fileURLToPath(fileUrl);
+    const source = await readFile(path, 'utf-8');
+    const output = await state.cache.transform(source, path, state.options);
+
+    const event: CompileCacheHookEvent = { cached: output.cached, compileMs: output.compileMs };
+    state.port.postMessage(event);
+
+    const map = output.map
+      ? `\n//# sourceMappingURL=data:application/json;base64,${Buffer.from(output.map).toString('base64')}`
+      : '';
+    const result: LoadResult = { format: 'module', source: output.code + map, shortCircuit: true };
+    return result;
+  } catch {
+    return nextLoad(url, context);
+  }
+}
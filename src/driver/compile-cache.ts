@@ -0,0 +1,425 @@
+/**
+ * CompileCache - Content-hash keyed on-disk cache of transpiled mudlib code.
+ *
+ * Entries hold the compiled JavaScript and its source map, keyed by a hash of
+ * the source text, file name, esbuild version and transform options, so an
+ * unchanged file is never transpiled twice - across hot reloads and across
+ * restarts.
+ *
+ * The Compiler uses the cache directly. Mudlib modules imported by the
+ * MudlibLoader and CommandManager go through a module loader hook (see
+ * compile-cache-hooks.ts) that serves .ts files under the mudlib from the
+ * same cache and reports hits back to this thread.
+ *
+ * An entry's modification time is refreshed on every hit, so it doubles as
+ * the last-use time. prune() keeps the directory under maxBytes by deleting
+ * the least recently used entries first; it runs at startup and again after
+ * every tenth of maxBytes written.
+ */
+
+import * as esbuild from 'esbuild';
+import { createHash } from 'crypto';
+import { mkdir, readFile, readdir, rename, stat, unlink, utimes, writeFile } from 'fs/promises';
+import { existsSync, readFileSync } from 'fs';
+import { dirname, join, resolve } from 'path';
+import { pathToFileURL } from 'url';
+import { MessageChannel } from 'worker_threads';
+import { register } from 'module';
+
+/** Bump to invalidate every existing entry after a format change */
+const CACHE_FORMAT_VERSION = 1;
+
+/** Temp files older than this were left by an interrupted write */
+const STALE_TMP_MS = 60 * 1000;
+
+export interface CompileCacheConfig {
+  /** Directory holding cache entries */
+  cacheDir: string;
+  /** When false, every transform goes straight to esbuild */
+  enabled: boolean;
+  /** Size the cache is pruned back to, in bytes (0 = unlimited) */
+  maxBytes: number;
+}
+
+/**
+ * Output of a (possibly cached) transform.
+ */
+export interface CompileOutput {
+  /** Compiled JavaScript */
+  code: string;
+  /** Source map JSON (empty when source maps are off or inline) */
+  map: string;
+  /** Warnings from the original transform */
+  warnings: esbuild.Message[];
+  /** How long the original transform took, in milliseconds */
+  compileMs: number;
+  /** Whether this result came from the cache */
+  cached: boolean;
+}
+
+export interface CompileCacheStats {
+  enabled: boolean;
+  hits: number;
+  misses: number;
+  /** Hits as a percentage of lookups */
+  hitRate: number;
+  /** Transform time skipped thanks to hits, in milliseconds */
+  savedMs: number;
+  /** Transform time spent on misses, in milliseconds */
+  compileMs: number;
+  /** Entries that could not be written */
+  writeErrors: number;
+}
+
+export interface CompileCachePruneResult {
+  /** Files deleted */
+  removed: number;
+  /** Bytes freed */
+  removedBytes: number;
+  /** Bytes left in the cache */
+  keptBytes: number;
+}
+
+/**
+ * Message posted by the loader hook for each mudlib module it serves.
+ */
+export interface CompileCacheHookEvent {
+  cached: boolean;
+  compileMs: number;
+}
+
+interface CacheEntry {
+  code: string;
+  map: string;
+  warnings: esbuild.Message[];
+  compileMs: number;
+}
+
+/**
+ * On-disk transpilation cache.
+ */
+export class CompileCache {
+  private config: CompileCacheConfig;
+  private hits: number = 0;
+  private misses: number = 0;
+  private savedMs: number = 0;
+  private compileMs: number = 0;
+  private writeErrors: number = 0;
+  private bytesSincePrune: number = 0;
+  private pruning: Promise<CompileCachePruneResult> | null = null;
+
+  constructor(config: Partial<CompileCacheConfig> = {}) {
+    this.config = {
+      cacheDir: resolve(config.cacheDir ?? './.cache/compile'),
+      enabled: config.enabled ?? true,
+      maxBytes: config.maxBytes ?? 256 * 1024 * 1024,
+    };
+  }
+
+  /**
+   * Transform TypeScript with esbuild, reusing a cached result for identical
+   * input. Transform errors are thrown exactly as esbuild throws them.
+   */
+  async transform(
+    source: string,
+    filename: string,
+    options: esbuild.TransformOptions
+  ): Promise<CompileOutput> {
+    if (!this.config.enabled) {
+      return this.runTransform(source, filename, options);
+    }
+
+    const key = this.keyFor(source, filename, options);
+    const file = this.entryPath(key);
+
+    const entry = await this.readEntry(file);
+    if (entry) {
+      // Mark the entry as recently used so prune() keeps it
+      const now = new Date();
+      utimes(file, now, now).catch(() => {});
+      this.recordLookup(true, entry.compileMs);
+      return { ...entry, cached: true };
+    }
+
+    const output = await this.runTransform(source, filename, options);
+    this.recordLookup(false, output.compileMs);
+    await this.writeEntry(file, {
+      code: output.code,
+      map: output.map,
+      warnings: output.warnings,
+      compileMs: output.compileMs,
+    });
+    return output;
+  }
+
+  /**
+   * Count a lookup made here or reported by the loader hook.
+   */
+  recordLookup(cached: boolean, compileMs: number): void {
+    if (cached) {
+      this.hits++;
+      this.savedMs += compileMs;
+    } else {
+      this.misses++;
+      this.compileMs += compileMs;
+    }
+  }
+
+  /**
+   * Get hit/miss statistics since startup (or the last resetStats()).
+   */
+  getStats(): CompileCacheStats {
+    const lookups = this.hits + this.misses;
+    return {
+      enabled: this.config.enabled,
+      hits: this.hits,
+      misses: this.misses,
+      hitRate: lookups > 0 ? Math.round((this.hits / lookups) * 1000) / 10 : 0,
+      savedMs: Math.round(this.savedMs),
+      compileMs: Math.round(this.compileMs),
+      writeErrors: this.writeErrors,
+    };
+  }
+
+  /**
+   * Reset statistics.
+   */
+  resetStats(): void {
+    this.hits = 0;
+    this.misses = 0;
+    this.savedMs = 0;
+    this.compileMs = 0;
+    this.writeErrors = 0;
+  }
+
+  /**
+   * Delete the least recently used entries until the cache fits in maxBytes,
+   * along with temp files left behind by interrupted writes. Concurrent
+   * calls share one pass.
+   */
+  prune(): Promise<CompileCachePruneResult> {
+    if (!this.pruning) {
+      this.pruning = this.runPrune().finally(() => {
+        this.pruning = null;
+      });
+    }
+    return this.pruning;
+  }
+
+  /**
+   * Get the cache directory.
+   */
+  get cacheDir(): string {
+    return this.config.cacheDir;
+  }
+
+  /**
+   * Get the size the cache is pruned back to, in bytes (0 = unlimited).
+   */
+  get maxBytes(): number {
+    return this.config.maxBytes;
+  }
+
+  /**
+   * Whether caching is enabled.
+   */
+  get enabled(): boolean {
+    return this.config.enabled;
+  }
+
+  private keyFor(source: string, filename: string, options: esbuild.TransformOptions): string {
+    return createHash('sha256')
+      .update(`${CACHE_FORMAT_VERSION}\0${esbuild.version}\0${JSON.stringify(options)}\0${filename}\0`)
+      .update(source)
+      .digest('hex');
+  }
+
+  private entryPath(key: string): string {
+    return join(this.config.cacheDir, key.slice(0, 2), `${key}.json`);
+  }
+
+  private async runTransform(
+    source: string,
+    filename: string,
+    options: esbuild.TransformOptions
+  ): Promise<CompileOutput> {
+    const start = performance.now();
+    const result = await esbuild.transform(source, { ...options, sourcefile: filename });
+    return {
+      code: result.code,
+      map: result.map,
+      warnings: result.warnings,
+      compileMs: performance.now() - start,
+      cached: false,
+    };
+  }
+
+  private async runPrune(): Promise<CompileCachePruneResult> {
+    this.bytesSincePrune = 0;
+    const result: CompileCachePruneResult = { removed: 0, removedBytes: 0, keptBytes: 0 };
+    if (!this.config.enabled) return result;
+
+    let shards: string[];
+    try {
+      shards = await readdir(this.config.cacheDir);
+    } catch {
+      return result;
+    }
+
+    const now = Date.now();
+    const entries: Array<{ file: string; size: number; usedAt: number }> = [];
+    for (const shard of shards) {
+      let names: string[];
+      try {
+        names = await readdir(join(this.config.cacheDir, shard));
+      } catch {
+        continue;
+      }
+      for (const name of names) {
+        const file = join(this.config.cacheDir, shard, name);
+        try {
+          const info = await stat(file);
+          if (!name.endsWith('.tmp')) {
+            entries.push({ file, size: info.size, usedAt: info.mtimeMs });
+          } else if (now - info.mtimeMs > STALE_TMP_MS) {
+            await unlink(file);
+            result.removed++;
+            result.removedBytes += info.size;
+          }
+        } catch {
+          // Removed by another process in the meantime
+        }
+      }
+    }
+
+    let total = entries.reduce((sum, entry) => sum + entry.size, 0);
+    if (this.config.maxBytes > 0 && total > this.config.maxBytes) {
+      entries.sort((a, b) => a.usedAt - b.usedAt);
+      for (const entry of entries) {
+        if (total <= this.config.maxBytes) break;
+        try {
+          await unlink(entry.file);
+        } catch {
+          continue;
+        }
+        total -= entry.size;
+        result.removed++;
+        result.removedBytes += entry.size;
+      }
+    }
+    result.keptBytes = total;
+    return result;
+  }
+
+  private async readEntry(file: string): Promise<CacheEntry | null> {
+    try {
+      const entry = JSON.parse(await readFile(file, 'utf-8')) as CacheEntry;
+      return typeof entry.code === 'string' ? entry : null;
+    } catch {
+      // Missing or corrupt entries are treated as misses
+      return null;
+    }
+  }
+
+  private async writeEntry(file: string, entry: CacheEntry): Promise<void> {
+    // Write then rename so concurrent readers never see a partial entry
+    const tmp = `${file}.${process.pid}.${Date.now()}.tmp`;
+    const data = JSON.stringify(entry);
+    try {
+      await mkdir(dirname(file), { recursive: true });
+      await writeFile(tmp, data);
+      await rename(tmp, file);
+    } catch {
+      this.writeErrors++;
+      return;
+    }
+
+    this.bytesSincePrune += Buffer.byteLength(data);
+    if (this.config.maxBytes > 0 && this.bytesSincePrune >= this.config.maxBytes / 10) {
+      this.prune().catch(() => {});
+    }
+  }
+}
+
+/**
+ * esbuild options used for mudlib modules loaded at runtime. Mirrors what
+ * tsx would do, using the mudlib's own tsconfig.json when present.
+ */
+export function mudlibTransformOptions(mudlibPath: string): esbuild.TransformOptions {
+  const tsconfigPath = join(mudlibPath, 'tsconfig.json');
+  return {
+    loader: 'ts',
+    format: 'esm',
+    target: `node${process.versions.node}`,
+    sourcemap: 'external',
+    ...(existsSync(tsconfigPath) ? { tsconfigRaw: readFileSync(tsconfigPath, 'utf-8') } : {}),
+  };
+}
+
+/** Cache receiving loader hook events (hooks can only be registered once) */
+let hookTarget: CompileCache | null = null;
+
+/**
+ * Serve mudlib .ts modules from the compile cache when they are imported.
+ * Covers every dynamic import of mudlib files (objects and commands).
+ * Hooks are process-wide, so later calls only redirect hook statistics to
+ * the given cache.
+ * @returns false if the cache is disabled or loader hooks are unavailable
+ */
+export function registerCompileCacheHooks(cache: CompileCache, mudlibPath: string): boolean {
+  if (!cache.enabled || typeof register !== 'function') {
+    return false;
+  }
+  if (hookTarget) {
+    hookTarget = cache;
+    return true;
+  }
+
+  const { port1, port2 } = new MessageChannel();
+  port1.on('message', (event: CompileCacheHookEvent) => {
+    hookTarget?.recordLookup(event.cached, event.compileMs);
+  });
+  port1.unref();
+
+  const root = resolve(mudlibPath);
+  register('./compile-cache-hooks.js', import.meta.url, {
+    data: {
+      cacheDir: cache.cacheDir,
+      maxBytes: cache.maxBytes,
+      mudlibPath: root,
+      mudlibUrl: pathToFileURL(root + '/').href,
+      port: port2,
+    },
+    transferList: [port2],
+  });
+  hookTarget = cache;
+  return true;
+}
+
+// Singleton instance
+let cacheInstance: CompileCache | null = null;
+
+/**
+ * Get the global CompileCache. Disabled until initializeCompileCache() runs.
+ */
+export function getCompileCache(): CompileCache {
+  if (!cacheInstance) {
+    cacheInstance = new CompileCache({ enabled: false });
+  }
+  return cacheInstance;
+}
+
+/**
+ * Initialize the global CompileCache.
+ */
+export function initializeCompileCache(config: Partial<CompileCacheConfig>): CompileCache {
+  cacheInstance = new CompileCache(config);
+  return cacheInstance;
+}
+
+/**
+ * Reset the global CompileCache. Used for testing.
+ */
+export function resetCompileCache(): void {
+  cacheInstance = null;
+}
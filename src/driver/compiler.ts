@@ -1,13 +1,15 @@
 /**
  * Compiler - TypeScript-to-JavaScript compilation for mudlib objects.
  *
- * Uses esbuild for fast transpilation with source map support.
+ * Uses esbuild for fast transpilation with source map support. Single-file
+ * compiles go through the shared on-disk compile cache.
  */
 
 import * as esbuild from 'esbuild';
 import { readFile } from 'fs/promises';
 import { existsSync } from 'fs';
 import { resolve, join } from 'path';
+import { type CompileCache, getCompileCache } from './compile-cache.js';
 
 export interface CompileResult {
   /** Whether compilation succeeded */
@@ -38,6 +40,8 @@ export interface CompilerConfig {
   sourceMaps: boolean;
   /** Target JavaScript version */
   target: string;
+  /** Compile cache to use (defaults to the global cache) */
+  cache?: CompileCache | undefined;
 }
 
 /**
@@ -51,6 +55,7 @@ export class Compiler {
       mudlibPath: config.mudlibPath ?? './mudlib',
       sourceMaps: config.sourceMaps ?? true,
       target: config.target ?? 'es2022',
+      cache: config.cache,
     };
   }
 
@@ -86,11 +91,11 @@ export class Compiler {
    */
   async compileSource(source: string, filename: string = 'script.ts'): Promise<CompileResult> {
     try {
-      const result = await esbuild.transform(source, {
+      const cache = this.config.cache ?? getCompileCache();
+      const result = await cache.transform(source, filename, {
         loader: 'ts',
         target: this.config.target,
         sourcemap: this.config.sourceMaps ? 'inline' : false,
-        sourcefile: filename,
         format: 'esm',
       });
 
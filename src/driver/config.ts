@@ -12,11 +12,15 @@ export interface DriverConfig {
   // Mudlib
   mudlibPath: string;
   masterObject: string;
+  preloadConcurrency: number;
+  lazyWorld: boolean;
 
   // Logging
   logLevel: 'trace' | 'debug' | 'info' | 'warn' | 'error' | 'fatal';
   logPretty: boolean;
   logHttpRequests: boolean;
+  commandTraceSamplePercent: number;
+  commandTraceSlowMs: number;
 
   // Isolation/Sandbox
   isolateMemoryMb: number;
@@ -25,17 +29,40 @@ export interface DriverConfig {
 
   // Scheduler
   heartbeatIntervalMs: number;
+  heartbeatMode: 'batch' | 'staggered';
+  heartbeatSlots: number;
+  heartbeatSliceBudgetMs: number;
+  heartbeatDormancy: boolean;
+  heartbeatDormancyRadius: number;
+  heartbeatDormancySweepMs: number;
+
+  // Idle object cleanup
+  objectCleanup: boolean;
+  objectCleanupIdleMs: number;
+  objectCleanupSweepMs: number;
 
   // Persistence
   persistenceAdapter: 'filesystem' | 'supabase';
   autoSaveIntervalMs: number;
+  playerSaveWindowMs: number;
+  playerSaveBatchSize: number;
+  playerSaveEncoding: 'json' | 'msgpack';
+  playerSaveCompression: 'none' | 'gzip' | 'brotli';
+  playerSaveJournal: boolean;
+  playerSaveJournalCompact: number;
   dataPath: string;
   supabaseUrl: string;
   supabaseServiceKey: string;
+  supabaseWriteWindowMs: number;
+  supabaseCacheSize: number;
 
   // Development
   devMode: boolean;
   hotReload: boolean;
+  hotReloadCascade: boolean;
+  compileCache: boolean;
+  compileCacheDir: string;
+  compileCacheMaxMb: number;
 
   // Claude AI
   claudeApiKey: string;
@@ -87,6 +114,8 @@ export interface DriverConfig {
   // WebSocket reliability
   wsHeartbeatIntervalMs: number;
   wsMaxMissedPongs: number;
+  wsOutputCoalesce: boolean;
+  wsOutputCoalesceMs: number;
   wsSessionTokenTtlMs: number;
   wsSessionSecret: string;
   wsSessionValidateIp: boolean;
@@ -110,6 +139,11 @@ function parseBoolean(value: string | undefined, defaultValue: boolean): boolean
   return lower === 'true' || lower === '1' || lower === 'yes';
 }
 
+function parseCompression(value: string | undefined): 'none' | 'gzip' | 'brotli' {
+  const lower = value?.toLowerCase();
+  return lower === 'gzip' || lower === 'brotli' ? lower : 'none';
+}
+
 function parseNumber(value: string | undefined, defaultValue: number): number {
   if (!value) return defaultValue;
   const parsed = parseInt(value, 10);
@@ -130,6 +164,8 @@ export function loadConfig(): DriverConfig {
     // Mudlib
     mudlibPath: process.env['MUDLIB_PATH'] ?? './mudlib',
     masterObject: process.env['MASTER_OBJECT'] ?? '/master',
+    preloadConcurrency: parseNumber(process.env['PRELOAD_CONCURRENCY'], 8),
+    lazyWorld: parseBoolean(process.env['LAZY_WORLD'], false),
 
     // Logging
     logLevel: parseLogLevel(process.env['LOG_LEVEL'], 'info'),
@@ -137,6 +173,8 @@ export function loadConfig(): DriverConfig {
     logPretty: parseBoolean(process.env['LOG_PRETTY'], process.env['NODE_ENV'] !== 'production'),
     // HTTP request logging (default off to reduce noise)
     logHttpRequests: parseBoolean(process.env['LOG_HTTP_REQUESTS'], false),
+    commandTraceSamplePercent: parseNumber(process.env['COMMAND_TRACE_SAMPLE_PERCENT'], 5),
+    commandTraceSlowMs: parseNumber(process.env['COMMAND_TRACE_SLOW_MS'], 50),
 
     // Isolation/Sandbox (lower defaults for memory-constrained environments like Render free tier)
     isolateMemoryMb: parseNumber(process.env['ISOLATE_MEMORY_MB'], 64),
@@ -145,17 +183,40 @@ export function loadConfig(): DriverConfig {
 
     // Scheduler
     heartbeatIntervalMs: parseNumber(process.env['HEARTBEAT_INTERVAL_MS'], 2000),
+    heartbeatMode: process.env['HEARTBEAT_MODE'] === 'batch' ? 'batch' : 'staggered',
+    heartbeatSlots: parseNumber(process.env['HEARTBEAT_SLOTS'], 20),
+    heartbeatSliceBudgetMs: parseNumber(process.env['HEARTBEAT_SLICE_BUDGET_MS'], 10),
+    heartbeatDormancy: parseBoolean(process.env['HEARTBEAT_DORMANCY'], true),
+    heartbeatDormancyRadius: parseNumber(process.env['HEARTBEAT_DORMANCY_RADIUS'], 1),
+    heartbeatDormancySweepMs: parseNumber(process.env['HEARTBEAT_DORMANCY_SWEEP_MS'], 5000),
+
+    // Idle object cleanup
+    objectCleanup: parseBoolean(process.env['OBJECT_CLEANUP'], false),
+    objectCleanupIdleMs: parseNumber(process.env['OBJECT_CLEANUP_IDLE_MS'], 3600000),
+    objectCleanupSweepMs: parseNumber(process.env['OBJECT_CLEANUP_SWEEP_MS'], 60000),
 
     // Persistence
     persistenceAdapter: (process.env['PERSISTENCE_ADAPTER'] as 'filesystem' | 'supabase') ?? 'filesystem',
     autoSaveIntervalMs: parseNumber(process.env['AUTO_SAVE_INTERVAL_MS'], 300000),
+    playerSaveWindowMs: parseNumber(process.env['PLAYER_SAVE_WINDOW_MS'], 1000),
+    playerSaveBatchSize: parseNumber(process.env['PLAYER_SAVE_BATCH_SIZE'], 50),
+    playerSaveEncoding: process.env['PLAYER_SAVE_ENCODING'] === 'msgpack' ? 'msgpack' : 'json',
+    playerSaveCompression: parseCompression(process.env['PLAYER_SAVE_COMPRESSION']),
+    playerSaveJournal: parseBoolean(process.env['PLAYER_SAVE_JOURNAL'], false),
+    playerSaveJournalCompact: parseNumber(process.env['PLAYER_SAVE_JOURNAL_COMPACT'], 50),
     dataPath: process.env['DATA_PATH'] ?? './mudlib/data',
     supabaseUrl: process.env['SUPABASE_URL'] ?? '',
     supabaseServiceKey: process.env['SUPABASE_SERVICE_KEY'] ?? '',
+    supabaseWriteWindowMs: parseNumber(process.env['SUPABASE_WRITE_WINDOW_MS'], 50),
+    supabaseCacheSize: parseNumber(process.env['SUPABASE_CACHE_SIZE'], 1000),
 
     // Development
     devMode: parseBoolean(process.env['DEV_MODE'], true),
     hotReload: parseBoolean(process.env['HOT_RELOAD'], true),
+    hotReloadCascade: parseBoolean(process.env['HOT_RELOAD_CASCADE'], false),
+    compileCache: parseBoolean(process.env['COMPILE_CACHE'], true),
+    compileCacheDir: process.env['COMPILE_CACHE_DIR'] ?? './.cache/compile',
+    compileCacheMaxMb: parseNumber(process.env['COMPILE_CACHE_MAX_MB'], 256),
 
     // Claude AI
     claudeApiKey: process.env['CLAUDE_API_KEY'] ?? '',
@@ -211,6 +272,8 @@ export function loadConfig(): DriverConfig {
     // WebSocket reliability
     wsHeartbeatIntervalMs: parseNumber(process.env['WS_HEARTBEAT_INTERVAL_MS'], 25000),
     wsMaxMissedPongs: parseNumber(process.env['WS_MAX_MISSED_PONGS'], 20),
+    wsOutputCoalesce: parseBoolean(process.env['WS_OUTPUT_COALESCE'], true),
+    wsOutputCoalesceMs: parseNumber(process.env['WS_OUTPUT_COALESCE_MS'], 0),
     wsSessionTokenTtlMs: parseNumber(process.env['WS_SESSION_TOKEN_TTL_MS'], 15 * 60 * 1000), // 15 minutes
     wsSessionSecret: process.env['WS_SESSION_SECRET'] ?? '', // Auto-generated if empty
     wsSessionValidateIp: parseBoolean(process.env['WS_SESSION_VALIDATE_IP'], false),
@@ -243,6 +306,83 @@ export function validateConfig(config: DriverConfig): string[] {
     errors.push(`Heartbeat interval too low: ${config.heartbeatIntervalMs}ms. Minimum is 100ms.`);
   }
 
+  if (config.objectCleanup && config.objectCleanupSweepMs < 1000) {
+    errors.push(
+      `Object cleanup sweep interval too low: ${config.objectCleanupSweepMs}ms. Minimum is 1000ms.`
+    );
+  }
+
+  if (config.playerSaveWindowMs < 0) {
+    errors.push(`Player save window too low: ${config.playerSaveWindowMs}ms. Minimum is 0ms.`);
+  }
+
+  if (config.playerSaveBatchSize < 1) {
+    errors.push(`Player save batch size too low: ${config.playerSaveBatchSize}. Minimum is 1.`);
+  }
+
+  if (config.supabaseWriteWindowMs < 0) {
+    errors.push(`Supabase write window too low: ${config.supabaseWriteWindowMs}ms. Minimum is 0ms.`);
+  }
+
+  if (config.supabaseCacheSize < 0) {
+    errors.push(`Supabase cache size too low: ${config.supabaseCacheSize}. Minimum is 0.`);
+  }
+
+  if (config.playerSaveJournalCompact < 1) {
+    errors.push(
+      `Player save journal compaction too low: ${config.playerSaveJournalCompact}. Minimum is 1.`
+    );
+  }
+
+  if (config.commandTraceSamplePercent < 0 || config.commandTraceSamplePercent > 100) {
+    errors.push(
+      `Invalid command trace sample percent: ${config.commandTraceSamplePercent}. Must be between 0 and 100.`
+    );
+  }
+
+  if (config.commandTraceSlowMs < 0) {
+    errors.push(
+      `Command trace slow threshold too low: ${config.commandTraceSlowMs}ms. Minimum is 0ms.`
+    );
+  }
+
+  if (config.wsOutputCoalesceMs < 0 || config.wsOutputCoalesceMs > 100) {
+    errors.push(
+      `Invalid output coalescing window: ${config.wsOutputCoalesceMs}ms. Must be between 0 and 100ms.`
+    );
+  }
+
+  if (config.compileCacheMaxMb < 0) {
+    errors.push(`Compile cache size too low: ${config.compileCacheMaxMb}MB. Minimum is 0.`);
+  }
+
+  if (config.preloadConcurrency < 1) {
+    errors.push(`Preload concurrency too low: ${config.preloadConcurrency}. Minimum is 1.`);
+  }
+
+  if (config.heartbeatSlots < 1) {
+    errors.push(`Heartbeat slots too low: ${config.heartbeatSlots}. Minimum is 1.`);
+  }
+
+  if (config.heartbeatSliceBudgetMs < 1) {
+    errors.push(
+      `Heartbeat slice budget too low: ${config.heartbeatSliceBudgetMs}ms. Minimum is 1ms.`
+    );
+  }
+
+  if (config.heartbeatDormancy) {
+    if (config.heartbeatDormancyRadius < 0) {
+      errors.push(
+        `Heartbeat dormancy radius too low: ${config.heartbeatDormancyRadius}. Minimum is 0.`
+      );
+    }
+    if (config.heartbeatDormancySweepMs < 100) {
+      errors.push(
+        `Heartbeat dormancy sweep too low: ${config.heartbeatDormancySweepMs}ms. Minimum is 100ms.`
+      );
+    }
+  }
+
   // Intermud 3 validation
   if (config.i3Enabled) {
     if (!config.i3AdminEmail) {
@@ -11,17 +11,36 @@
 import { loadConfig, validateConfig, type DriverConfig } from './config.js';
 import { ObjectRegistry, getRegistry, resetRegistry } from './object-registry.js';
 import { Scheduler, getScheduler, resetScheduler } from './scheduler.js';
+import {
+  getHeartbeatDormancy,
+  initializeHeartbeatDormancy,
+  resetHeartbeatDormancy,
+} from './heartbeat-dormancy.js';
+import {
+  getIdleReclaimer,
+  initializeIdleReclaimer,
+  resetIdleReclaimer,
+} from './idle-reclaimer.js';
 import { EfunBridge, getEfunBridge, resetEfunBridge } from './efun-bridge.js';
 import { MudlibLoader, getMudlibLoader, resetMudlibLoader } from './mudlib-loader.js';
+import type { PreloadReport } from './preload-engine.js';
 import { initializeClaudeClient } from './claude-client.js';
 import { initializeGeminiClient } from './gemini-client.js';
 import { initializeGitHubClient } from './github-client.js';
 import { initializeGiphyClient } from './giphy-client.js';
 import { initializePromptManager, resetPromptManager } from './prompt-manager.js';
 import { CommandManager, getCommandManager, resetCommandManager } from './command-manager.js';
+import { getCommandTracer, resetCommandTracer } from './command-tracer.js';
+import { getMetrics } from './metrics.js';
 import { getPermissions } from './permissions.js';
 import { createAdapter, getAdapter } from './persistence/adapter-factory.js';
+import {
+  getSavePipeline,
+  initializeSavePipeline,
+  resetSavePipeline,
+} from './persistence/save-pipeline.js';
 import { Compiler } from './compiler.js';
+import { initializeCompileCache, registerCompileCacheHooks } from './compile-cache.js';
 import { HotReload } from './hot-reload.js';
 import { getIsolatePool, resetIsolatePool } from '../isolation/isolate-pool.js';
 import { resetScriptRunner } from '../isolation/script-runner.js';
@@ -108,6 +127,7 @@ export class Driver {
   private master: MasterObject | null = null;
   private loginDaemon: LoginDaemon | null = null;
   private state: DriverState = 'stopped';
+  private preloadReport: PreloadReport | null = null;
 
   // Track connections to their handlers (login daemon or player)
   private connectionHandlers: Map<Connection, MudObject> = new Map();
@@ -141,9 +161,13 @@ export class Driver {
     this.registry = getRegistry();
     this.scheduler = getScheduler({
       heartbeatIntervalMs: this.config.heartbeatIntervalMs,
+      heartbeatMode: this.config.heartbeatMode,
+      heartbeatSlots: this.config.heartbeatSlots,
+      heartbeatSliceBudgetMs: this.config.heartbeatSliceBudgetMs,
     });
     this.efunBridge = getEfunBridge({
       mudlibPath: this.config.mudlibPath,
+      lazyWorld: this.config.lazyWorld,
     });
 
     // Load game configuration (name, version, tagline)
@@ -235,6 +259,10 @@ export class Driver {
       watchEnabled: this.config.hotReload,
       savePlayer: (player) => this.efunBridge.savePlayer(player),
     });
+    getCommandTracer({
+      samplePercent: this.config.commandTraceSamplePercent,
+      slowThresholdMs: this.config.commandTraceSlowMs,
+    });
 
     // Set up the execute command callback so mudlib can use the command system
     this.efunBridge.setExecuteCommandCallback(async (player, input, level) => {
@@ -244,16 +272,36 @@ export class Driver {
 
       // Set efun context so commands can use efuns that need player context
       this.efunBridge.setContext({ thisPlayer: player, thisObject: player });
+      const tracer = getCommandTracer();
+      const trace = tracer.current();
+      const topLevel = trace !== undefined && !trace.dispatched;
+      if (trace) trace.dispatched = true;
       try {
         // Resolve aliases before executing (but not for alias/unalias commands)
+        const endAlias = tracer.span('parse', 'alias');
         const resolvedInput = this.resolveAlias(player, input);
+        endAlias();
 
         // First try normal commands
         const handled = await this.commandManager.execute(player, resolvedInput, level);
         if (handled) return true;
 
         // Fall back to emotes (soul daemon)
-        return await this.tryEmote(player, resolvedInput);
+        const endEmote = tracer.span('execute', 'emote');
+        const emoted = await this.tryEmote(player, resolvedInput);
+        endEmote();
+        if (emoted) {
+          if (topLevel) trace.handledBy = 'emote';
+          return true;
+        }
+
+        // The mudlib goes on to channels and room/item actions; that span
+        // stays open until the command finishes
+        if (topLevel) {
+          trace.handledBy = 'mudlib';
+          tracer.span('resolve', 'channels and actions');
+        }
+        return false;
       } finally {
         // Restore previous context (or clear if there wasn't one)
         if (savedContext.thisPlayer || savedContext.thisObject) {
@@ -272,9 +320,15 @@ export class Driver {
         mudlibPath: this.config.mudlibPath,
         watchEnabled: this.config.hotReload,
         safelist: ['/std/player', '/master', '/daemons/login'],
+        cascadeOnChange: this.config.hotReloadCascade,
       },
       this.registry
     );
+    this.hotReload.setLoader(this.mudlibLoader);
+    this.hotReload.setCommandManager(this.commandManager);
+    this.efunBridge.setReloadWithDependentsCallback((objectPath, options) =>
+      this.hotReload.reloadWithDependents(objectPath, options)
+    );
 
     // Initialize session manager for WebSocket reconnection
     this.sessionManager = getSessionManager({
@@ -302,10 +356,55 @@ export class Driver {
         dataPath: this.config.dataPath,
         supabaseUrl: this.config.supabaseUrl,
         supabaseServiceKey: this.config.supabaseServiceKey,
+        supabaseWriteWindowMs: this.config.supabaseWriteWindowMs,
+        supabaseCacheSize: this.config.supabaseCacheSize,
+        playerFormat: {
+          encoding: this.config.playerSaveEncoding,
+          compression: this.config.playerSaveCompression,
+        },
+        playerJournal: this.config.playerSaveJournal,
+        playerJournalCompactEntries: this.config.playerSaveJournalCompact,
       });
       await adapter.initialize();
       this.logger.info({ adapter: this.config.persistenceAdapter }, 'Persistence adapter initialized');
 
+      // Player saves are coalesced and written in batches
+      initializeSavePipeline({
+        windowMs: this.config.playerSaveWindowMs,
+        batchSize: this.config.playerSaveBatchSize,
+      });
+
+      // Unload idle objects; state saved by a previous run is restored on load
+      if (this.config.objectCleanup) {
+        await initializeIdleReclaimer(this.registry, adapter, {
+          idleMs: this.config.objectCleanupIdleMs,
+          sweepIntervalMs: this.config.objectCleanupSweepMs,
+        }).initialize();
+      }
+
+      // Serve mudlib modules from the on-disk compile cache
+      const compileCache = initializeCompileCache({
+        cacheDir: this.config.compileCacheDir,
+        enabled: this.config.compileCache,
+        maxBytes: this.config.compileCacheMaxMb * 1024 * 1024,
+      });
+      if (compileCache.enabled) {
+        // Keep the cache under its size limit without holding up boot
+        compileCache
+          .prune()
+          .then((pruned) => {
+            if (pruned.removed > 0) {
+              this.logger.info(pruned, `Compile cache: pruned ${pruned.removed} least recently used files`);
+            }
+          })
+          .catch((error) => this.logger.warn({ error }, 'Compile cache prune failed'));
+      }
+      try {
+        registerCompileCacheHooks(compileCache, this.config.mudlibPath);
+      } catch (error) {
+        this.logger.warn({ error }, 'Compile cache loader hooks unavailable');
+      }
+
       // Initialize isolate pool (for future sandbox use)
       getIsolatePool({
         memoryLimitMb: this.config.isolateMemoryMb,
@@ -336,12 +435,41 @@ export class Driver {
       // Initialize command manager
       await this.commandManager.initialize();
 
+      if (compileCache.enabled) {
+        const stats = compileCache.getStats();
+        this.logger.info(
+          {
+            hits: stats.hits,
+            misses: stats.misses,
+            savedMs: stats.savedMs,
+            compileMs: stats.compileMs,
+          },
+          `Compile cache: ${stats.hitRate}% hit rate, ~${stats.savedMs}ms of transpilation skipped`
+        );
+      }
+
       // Load permissions from disk
       await this.loadPermissions();
 
       // Start scheduler
       this.scheduler.start();
 
+      // Park heartbeats of idle objects far away from players
+      if (this.config.heartbeatDormancy) {
+        initializeHeartbeatDormancy(
+          this.scheduler,
+          {
+            radius: this.config.heartbeatDormancyRadius,
+            sweepIntervalMs: this.config.heartbeatDormancySweepMs,
+          },
+          {
+            getPlayers: () => this.getAllPlayers(),
+            findObject: (path) => this.registry.find(path),
+          }
+        ).start();
+      }
+      getIdleReclaimer()?.start();
+
       // Initialize I3 if enabled
       if (this.config.i3Enabled) {
         await this.initializeI3();
@@ -428,22 +556,30 @@ export class Driver {
       // Save all active players
       if (this.activePlayers.size > 0) {
         this.logger.info({ count: this.activePlayers.size }, 'Saving all active players before shutdown...');
-        const savePromises: Promise<void>[] = [];
         for (const [name, player] of this.activePlayers) {
-          savePromises.push(
-            this.efunBridge.savePlayer(player)
-              .then(() => this.logger.info({ name }, 'Player saved on shutdown'))
-              .catch((error) => this.logger.error({ error, name }, 'Failed to save player on shutdown'))
-          );
+          try {
+            await this.efunBridge.savePlayer(player);
+          } catch (error) {
+            this.logger.error({ error, name }, 'Failed to save player on shutdown');
+          }
         }
-        await Promise.all(savePromises);
-        this.logger.info('All player saves completed');
       }
 
+      // Write every queued player save before storage goes away
+      try {
+        await getSavePipeline().flush();
+        this.logger.info(getSavePipeline().getStats(), 'All player saves completed');
+      } catch (error) {
+        this.logger.error({ error }, 'Failed to write player saves on shutdown');
+      }
+      getSavePipeline().stop();
+
       // Stop file watcher
       this.hotReload.stopWatching();
 
       // Stop scheduler
+      getHeartbeatDormancy()?.stop();
+      getIdleReclaimer()?.stop();
       this.scheduler.stop();
 
       // Shutdown persistence adapter
@@ -884,16 +1020,49 @@ export class Driver {
    * Preload objects from the preload list.
    */
   private async preloadObjects(paths: string[]): Promise<void> {
-    this.logger.info({ count: paths.length }, 'Preloading objects');
+    this.logger.info(
+      { count: paths.length, concurrency: this.config.preloadConcurrency },
+      'Preloading objects'
+    );
 
-    for (const path of paths) {
-      try {
-        await this.mudlibLoader.loadObject(path);
-        this.logger.debug({ path }, 'Preloaded object');
-      } catch (error) {
-        this.logger.warn({ path, error }, 'Failed to preload object');
-      }
+    const report = await this.mudlibLoader.preload(paths, {
+      concurrency: this.config.preloadConcurrency,
+    });
+    this.preloadReport = report;
+
+    for (const entry of report.entries) {
+      this.logger.debug(
+        {
+          path: entry.path,
+          importMs: Math.round(entry.importMs),
+          createMs: Math.round(entry.createMs),
+        },
+        entry.success ? 'Preloaded object' : 'Failed to preload object'
+      );
     }
+
+    const slowest = [...report.entries]
+      .sort((a, b) => b.importMs + b.createMs - (a.importMs + a.createMs))
+      .slice(0, 5)
+      .map((entry) => `${entry.path} (${Math.round(entry.importMs + entry.createMs)}ms)`);
+
+    this.logger.info(
+      {
+        loaded: report.loaded,
+        failed: report.failed,
+        serialMs: Math.round(report.serialMs),
+        slowest,
+        criticalPath: report.criticalPath,
+      },
+      `Preloaded ${report.loaded} objects in ${Math.round(report.totalMs)}ms`
+    );
+  }
+
+  /**
+   * Get the startup timeline from the last preload, if any.
+   */
+  getPreloadReport(): PreloadReport | null {
+    return this.preloadReport;
   }
 
   /**
@@ -1008,7 +1177,7 @@ export class Driver {
           // Set efun context so input handlers can use efuns that need player context
           this.efunBridge.setContext({ thisPlayer: player, thisObject: player });
           try {
-            await player.processInput(input);
+            await this.traceInput(connection, player, input);
           } finally {
             this.efunBridge.clearContext();
           }
@@ -1383,8 +1552,9 @@ ${allLogs || 'No logs captured'}
     }
 
     try {
-      const request = JSON.parse(jsonStr) as { prefix: string };
+      const request = JSON.parse(jsonStr) as { prefix: string; verb?: boolean };
       const player = handler as MudObject & {
+        name?: string;
         getPermissionLevel?: () => number;
         getCwd?: () => string;
       };
@@ -1398,8 +1568,12 @@ ${allLogs || 'No logs captured'}
       const cwd = player.getCwd?.() ?? '/';
       const prefix = request.prefix || '';
 
-      // Get completions from the file system
-      const completions = await this.getFileCompletions(cwd, prefix);
+      // Complete a verb from the player's command table, anything else
+      // from the file system
+      const completions =
+        request.verb && prefix && !prefix.includes('/')
+          ? this.commandManager.completeVerb(prefix, player.name, permLevel)
+          : await this.getFileCompletions(cwd, prefix);
 
       // Send response
       connection.sendCompletion({
@@ -1528,7 +1702,8 @@ ${allLogs || 'No logs captured'}
 
           // Move player to void
           try {
-            const voidRoom = this.efunBridge.findObject('/areas/void/void');
+            // Load it if needed: a lazy world doesn't preload areas
+            const voidRoom = await this.efunBridge.loadBlueprint('/areas/void/void');
             if (voidRoom) {
               await player.moveTo(voidRoom);
               this.logger.info({ name: player.name }, 'Player moved to void on disconnect');
@@ -1795,16 +1970,43 @@ ${allLogs || 'No logs captured'}
   }
 
   /**
-   * Try to execute input as an emote via the soul daemon.
-   * Called as a fallback when no command matches.
-   *
-   * Supports remote emotes with @player syntax:
-   *   smile @bob  -> remote emote to bob
-   *
-   * @param player The player executing the emote
-   * @param input The full input string
-   * @returns true if an emote was executed, false otherwise
+   * Run a player's input line, timing it and tracing its phases if sampled.
+   * The command's output is sent as soon as it finishes.
    */
+  private async traceInput(
+    connection: Connection,
+    player: MudObject & {
+      name?: string;
+      processInput?: (input: string) => void | Promise<void>;
+      getInputHandler?: () => unknown;
+    },
+    input: string
+  ): Promise<void> {
+    const started = performance.now();
+    // Input handlers read things like passwords; don't keep their lines
+    const handled = Boolean(player.getInputHandler?.());
+    const line = handled ? '(prompt)' : input.trim();
+    const output = connection.getOutputStats();
+    try {
+      await getCommandTracer().trace(player.name ?? 'unknown', line, async () => {
+        try {
+          await player.processInput?.(input);
+        } finally {
+          connection.flush();
+        }
+      });
+    } finally {
+      // Input handler lines are prompt answers, not commands
+      const verb = handled ? undefined : line.split(' ', 1)[0];
+      if (verb) getMetrics().recordCommand(performance.now() - started, verb);
+      const sent = connection.getOutputStats();
+      getMetrics().recordCommandOutput(
+        sent.messages - output.messages,
+        sent.frames - output.frames
+      );
+    }
+  }
+
   /**
    * Resolve an alias to its command.
    * Returns the original input if no alias matches or if the command is alias/unalias.
@@ -1843,6 +2045,17 @@ ${allLogs || 'No logs captured'}
     return aliasedCommand;
   }
 
+  /**
+   * Try to execute input as an emote via the soul daemon.
+   * Called as a fallback when no command matches.
+   *
+   * Supports remote emotes with @player syntax:
+   *   smile @bob  -> remote emote to bob
+   *
+   * @param player The player executing the emote
+   * @param input The full input string
+   * @returns true if an emote was executed, false otherwise
+   */
   private async tryEmote(player: MudObject, input: string): Promise<boolean> {
     const trimmed = input.trim();
     if (!trimmed) return false;
@@ -2030,12 +2243,16 @@ export function resetDriver(): void {
 
   // Reset all subsystems
   resetRegistry();
+  resetHeartbeatDormancy();
+  resetIdleReclaimer();
+  resetSavePipeline();
   resetScheduler();
   resetEfunBridge();
   resetIsolatePool();
   resetScriptRunner();
   resetMudlibLoader();
   resetCommandManager();
+  resetCommandTracer();
   resetSessionManager();
   resetPromptManager();
 }
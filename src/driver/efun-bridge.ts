@@ -6,12 +6,20 @@
  * mudlib code cannot implement itself.
  */
 
-import { getRegistry, type ObjectRegistry } from './object-registry.js';
-import { getScheduler, type Scheduler } from './scheduler.js';
+import { getRegistry, isRoom, type ObjectRegistry } from './object-registry.js';
+import { getScheduler, type Scheduler, type HeartbeatRate } from './scheduler.js';
+import { getHeartbeatDormancy } from './heartbeat-dormancy.js';
 import { getMetrics } from './metrics.js';
+import {
+  getCommandTracer,
+  toChromeTrace,
+  type CommandTraceRecord,
+  type CommandTracerStats,
+} from './command-tracer.js';
 import { getPermissions, resetPermissions, type Permissions, PermissionLevel } from './permissions.js';
 import { getAdapter } from './persistence/adapter-factory.js';
 import { getSerializer } from './persistence/serializer.js';
+import { getSavePipeline, type SavePipelineStats } from './persistence/save-pipeline.js';
 import { getCommandManager } from './command-manager.js';
 import { getClaudeClient, type ClaudeMessage } from './claude-client.js';
 import { getGeminiClient } from './gemini-client.js';
@@ -39,6 +47,9 @@ import {
 import { getGitHubClient } from './github-client.js';
 import { getGiphyClient, type CachedGif } from './giphy-client.js';
 import { getShadowRegistry, type ShadowRegistry } from './shadow-registry.js';
+import { getIdleReclaimer, type IdleReclaimerStats } from './idle-reclaimer.js';
+import { getModuleReloader, type ModuleVersionStats } from './module-reloader.js';
+import type { CascadeReloadResult } from './hot-reload.js';
 import type { Shadow, AddShadowResult } from './shadow-types.js';
 import { getPromptManager } from './prompt-manager.js';
 import { randomBytes, scrypt, timingSafeEqual } from 'crypto';
@@ -214,6 +225,8 @@ export interface AINpcResponseResult {
 export interface EfunBridgeConfig {
   /** Root path for file operations */
   mudlibPath: string;
+  /** Load rooms on first entry instead of preloading areas */
+  lazyWorld: boolean;
 }
 
 /**
@@ -239,6 +252,14 @@ type BindPlayerCallback = (connection: unknown, player: MudObject) => void;
  */
 type ExecuteCommandCallback = (player: MudObject, input: string, level: number) => Promise<boolean>;
 
+/**
+ * Callback to reload a module with its dependents (set by Driver).
+ */
+type ReloadWithDependentsCallback = (
+  objectPath: string,
+  options: { dryRun?: boolean }
+) => Promise<CascadeReloadResult>;
+
 /**
  * Callback to get all connected players (set by Driver).
  */
@@ -467,6 +488,7 @@ export class EfunBridge {
   private context: EfunContext = { thisObject: null, thisPlayer: null };
   private bindPlayerCallback: BindPlayerCallback | null = null;
   private executeCommandCallback: ExecuteCommandCallback | null = null;
+  private reloadWithDependentsCallback: ReloadWithDependentsCallback | null = null;
   private allPlayersCallback: AllPlayersCallback | null = null;
   private findConnectedPlayerCallback: FindConnectedPlayerCallback | null = null;
   private transferConnectionCallback: TransferConnectionCallback | null = null;
@@ -487,9 +509,16 @@ export class EfunBridge {
   /** Shadow registry for object overlays */
   private shadowRegistry: ShadowRegistry;
 
+  /** Frozen, pre-bound efun table handed to the mudlib (built on first use) */
+  private efunTable: Readonly<Record<string, unknown>> | null = null;
+
+  /** Rooms loaded after boot, and heap growth measured across those loads */
+  private roomLoads = { onDemand: 0, prefetched: 0, prefetchFailures: 0, heapBytes: 0 };
+
   constructor(config: Partial<EfunBridgeConfig> = {}) {
     this.config = {
       mudlibPath: config.mudlibPath ?? './mudlib',
+      lazyWorld: config.lazyWorld ?? false,
     };
     this.registry = getRegistry();
     this.scheduler = getScheduler();
@@ -510,8 +539,10 @@ export class EfunBridge {
 
   /**
    * Wrap an array of objects with shadow proxies.
+   * Returns the array itself when nothing in the world is shadowed.
    */
   private wrapObjects(objs: MudObject[]): MudObject[] {
+    if (!this.shadowRegistry.hasAnyShadows()) return objs;
     return objs.map((obj) => this.shadowRegistry.wrapWithProxy(obj));
   }
 
@@ -531,6 +562,14 @@ export class EfunBridge {
     this.executeCommandCallback = callback;
   }
 
+  /**
+   * Set the callback for cascading reloads.
+   * Called by the Driver after initialization.
+   */
+  setReloadWithDependentsCallback(callback: ReloadWithDependentsCallback): void {
+    this.reloadWithDependentsCallback = callback;
+  }
+
   /**
    * Set the callback for getting all connected players.
    * Called by the Driver after initialization.
@@ -649,11 +688,13 @@ export class EfunBridge {
    * @param path The object path
    */
   loadObject(path: string): MudObject | undefined {
-    return this.wrapObject(this.registry.find(path));
+    return this.findObject(path);
   }
 
   /**
-   * Find an object by path or ID.
+   * Find a loaded object by path or ID. Never loads anything: objects not
+   * loaded yet or unloaded as idle are not found. Use loadBlueprint when the
+   * object is needed, or prefetchObjects to load it in the background.
    * @param pathOrId The object path or clone ID
    */
   findObject(pathOrId: string): MudObject | undefined {
@@ -674,9 +715,60 @@ export class EfunBridge {
     }
 
     // Load from disk
+    const obj = await this.loadFromDisk(path, false);
+    return this.wrapObject(obj);
+  }
+
+  /**
+   * Whether the world is loaded lazily (rooms on first entry, not at boot).
+   */
+  isLazyWorld(): boolean {
+    return this.config.lazyWorld;
+  }
+
+  /**
+   * Start loading blueprints in the background without waiting for them.
+   * Paths that are already loaded are skipped and failures are only logged,
+   * so callers can prefetch likely destinations (e.g. a room's exits)
+   * without delaying the current action.
+   * @param paths Object paths to load
+   */
+  prefetchObjects(paths: string[]): void {
+    const missing = paths.filter((path) => !this.registry.find(path));
+    if (missing.length === 0 || !this.objectLoader) {
+      return;
+    }
+
+    // Let the current command finish before competing for the event loop
+    setImmediate(() => {
+      for (const path of missing) {
+        if (this.registry.find(path)) continue;
+        this.loadFromDisk(path, true).catch((error) => {
+          this.roomLoads.prefetchFailures++;
+          logger.debug({ path, error }, 'Prefetch failed');
+        });
+      }
+    });
+  }
+
+  /**
+   * Load a blueprint through the object loader, tracking rooms loaded after
+   * boot for getMemoryStats().
+   */
+  private async loadFromDisk(path: string, prefetch: boolean): Promise<MudObject> {
     const loader = this.requireObjectLoader();
+    const heapBefore = process.memoryUsage().heapUsed;
     const obj = await loader.loadObject(path);
-    return this.wrapObject(obj);
+
+    if (isRoom(obj)) {
+      if (prefetch) {
+        this.roomLoads.prefetched++;
+      } else {
+        this.roomLoads.onDemand++;
+      }
+      this.roomLoads.heapBytes += Math.max(0, process.memoryUsage().heapUsed - heapBefore);
+    }
+    return obj;
   }
 
   /**
@@ -688,16 +780,105 @@ export class EfunBridge {
     return this.wrapObjects(Array.from(this.registry.getAllObjects()));
   }
 
+  /**
+   * Get the loaded objects in a category, from the registry's index.
+   * Built-in categories are 'room', 'player', 'npc', 'living', 'corpse' and
+   * 'vehicle'; any tag added with tagObject() works too.
+   * @param category The category or tag
+   * @returns Array of matching objects, in load order
+   */
+  getObjectsByCategory(category: string): MudObject[] {
+    return this.wrapObjects(Array.from(this.registry.getByCategory(category)));
+  }
+
+  /**
+   * Count the loaded objects in a category or tag.
+   * @param category The category or tag
+   */
+  countObjectsByCategory(category: string): number {
+    return this.registry.countByCategory(category);
+  }
+
+  /**
+   * Listen for objects joining or leaving a category or tag, so a daemon can
+   * track it without calling getObjectsByCategory() on every tick.
+   * @param category The category or tag
+   * @param callback Called with the object and whether it joined
+   * @returns A function that stops listening
+   */
+  onObjectCategoryChange(
+    category: string,
+    callback: (object: MudObject, added: boolean) => void
+  ): () => void {
+    return this.registry.onCategoryChange(category, (object, added) => {
+      try {
+        callback(this.wrapObject(object), added);
+      } catch (error) {
+        logger.error(
+          { category, objectId: object.objectId, error: String(error) },
+          'Category listener failed'
+        );
+      }
+    });
+  }
+
+  /**
+   * Add an object to a tag, queryable with getObjectsByCategory().
+   * @param object The object to tag
+   * @param tag The tag name
+   * @returns false if the object is not loaded
+   */
+  tagObject(object: MudObject, tag: string): boolean {
+    return this.registry.addTag(object, tag);
+  }
+
+  /**
+   * Remove an object from a tag.
+   * @param object The tagged object
+   * @param tag The tag name
+   * @returns true if the object had the tag
+   */
+  untagObject(object: MudObject, tag: string): boolean {
+    return this.registry.removeTag(object, tag);
+  }
+
+  /**
+   * Get the live clones of a blueprint.
+   * @param path The blueprint path
+   */
+  getClones(path: string): MudObject[] {
+    return this.wrapObjects(this.registry.getClones(path));
+  }
+
+  /**
+   * Get loaded objects with no environment (rooms, daemons, and objects
+   * moved out of the world without being destroyed).
+   */
+  getRootObjects(): MudObject[] {
+    return this.wrapObjects(Array.from(this.registry.getRootObjects()));
+  }
+
+  /**
+   * Tell the registry an object entered the world from nowhere or left it
+   * for nowhere. Called by MudObject.moveTo().
+   * @param object The object that moved
+   */
+  noteEnvironmentChange(object: MudObject): void {
+    this.registry.updateEnvironment(object);
+  }
+
   // ========== Hierarchy Efuns ==========
 
   /**
    * Get all objects in an object's inventory.
+   * The inventory getter already wraps shadowed members, so this returns it
+   * as-is (a read-only snapshot) rather than copying it.
    * @param object The container object
    */
-  allInventory(object: MudObject): MudObject[] {
+  allInventory(object: MudObject): ReadonlyArray<MudObject> {
     // Get original object if this is a proxy
     const original = this.shadowRegistry.getOriginal(object);
-    return this.wrapObjects([...original.inventory]);
+    return original.inventory;
   }
 
   /**
@@ -2148,9 +2329,41 @@ export class EfunBridge {
    * Set heartbeat for an object.
    * @param object The object
    * @param enable Whether to enable heartbeat
+   * @param rate Rate class ('normal', 'slow', 'idle') or interval in ms
+   * @returns false if the rate is invalid
    */
-  setHeartbeat(object: MudObject, enable: boolean): void {
-    this.scheduler.setHeartbeat(object, enable);
+  setHeartbeat(object: MudObject, enable: boolean, rate?: HeartbeatRate): boolean {
+    try {
+      this.scheduler.setHeartbeat(object, enable, rate);
+      return true;
+    } catch (error) {
+      getLogger().warn(
+        { objectId: object.objectId, rate, error: error instanceof Error ? error.message : error },
+        'Invalid heartbeat rate'
+      );
+      return false;
+    }
+  }
+
+  /**
+   * Get the heartbeat interval of an object.
+   * @param object The object
+   * @returns Interval in milliseconds, or 0 if the object has no heartbeat
+   */
+  getHeartbeatInterval(object: MudObject): number {
+    return this.scheduler.getHeartbeatInterval(object);
+  }
+
+  /**
+   * Wake dormant heartbeats in and around an object's room.
+   * Called when a player arrives so nearby NPCs react immediately.
+   * @param object The object (typically a player) that moved
+   * @returns Number of objects woken
+   */
+  wakeHeartbeatsNear(object: MudObject): number {
+    const dormancy = getHeartbeatDormancy();
+    if (!dormancy) return 0;
+    return dormancy.wakeNear(this.getOriginalObject(object));
   }
 
   /**
@@ -2259,22 +2472,29 @@ export class EfunBridge {
   // ========== Persistence Efuns ==========
 
   /**
-   * Save a player to disk.
+   * Save a player. The player's state is captured now and written by the
+   * save pipeline within the save window, coalesced with other saves.
    * @param player The player object to save
+   * @param options flush: wait until the save is written to storage
    */
-  async savePlayer(player: MudObject): Promise<void> {
+  async savePlayer(player: MudObject, options: { flush?: boolean } = {}): Promise<void> {
     const serializer = getSerializer();
     const data = serializer.serializePlayer(player);
-    const adapter = getAdapter();
-    await adapter.savePlayer(data);
+    const pipeline = getSavePipeline();
+    pipeline.enqueue(data);
+    if (options.flush) {
+      await pipeline.flushPlayer(data.name);
+    }
   }
 
   /**
-   * Load a player's saved data.
+   * Load a player's saved data, including saves not yet written.
    * @param name The player's name
    * @returns The player save data, or null if not found
    */
   async loadPlayerData(name: string): Promise<PlayerSaveData | null> {
+    const queued = getSavePipeline().peek(name);
+    if (queued) return queued;
     const adapter = getAdapter();
     return adapter.loadPlayer(name);
   }
@@ -2284,6 +2504,7 @@ export class EfunBridge {
    * @param name The player's name
    */
   async playerExists(name: string): Promise<boolean> {
+    if (getSavePipeline().peek(name)) return true;
     const adapter = getAdapter();
     return adapter.playerExists(name);
   }
@@ -2294,7 +2515,9 @@ export class EfunBridge {
    */
   async listPlayers(): Promise<string[]> {
     const adapter = getAdapter();
-    return adapter.listPlayers();
+    const saved = await adapter.listPlayers();
+    const queued = getSavePipeline().queuedNames();
+    return queued.length > 0 ? [...new Set([...saved, ...queued])] : saved;
   }
 
   /**
@@ -2370,7 +2593,11 @@ export class EfunBridge {
         }
       }
 
-      details.playerSaveDeleted = await adapter.deletePlayer(normalizedName);
+      // Drop unwritten saves and let an in-flight write land before deleting
+      const savePipeline = getSavePipeline();
+      const discarded = savePipeline.discard(normalizedName);
+      await savePipeline.flushPlayer(normalizedName).catch(() => {});
+      details.playerSaveDeleted = (await adapter.deletePlayer(normalizedName)) || discarded;
 
       const userDirPath = `/users/${normalizedName}`;
       try {
@@ -3208,6 +3435,29 @@ export class EfunBridge {
     return loader.reloadObject(objectPath);
   }
 
+  /**
+   * Reload an object together with every loaded blueprint and command that
+   * imports it (e.g. /std/living with npc, player and their subclasses).
+   * All-or-nothing: if any module fails to compile or evaluate, nothing is
+   * replaced. Requires builder permission or higher.
+   *
+   * @param objectPath The mudlib path of the changed module
+   * @param options.dryRun Only report the reload plan
+   * @returns The plan, swapped blueprints and phase timings
+   */
+  async reloadWithDependents(
+    objectPath: string,
+    options: { dryRun?: boolean } = {}
+  ): Promise<CascadeReloadResult | { success: false; error: string }> {
+    if (!this.isBuilder()) {
+      return { success: false, error: 'Permission denied: builder required' };
+    }
+    if (!this.reloadWithDependentsCallback) {
+      return { success: false, error: 'Cascading reload not available' };
+    }
+    return this.reloadWithDependentsCallback(objectPath, options);
+  }
+
   /**
    * Reload a single command from disk.
    * Commands are modules with execute functions, not class-based objects.
@@ -3435,6 +3685,7 @@ export class EfunBridge {
     };
     scheduler?: {
       heartbeats: number;
+      dormantHeartbeats: number;
       callouts: number;
       heartbeatInterval: number;
     };
@@ -3503,8 +3754,9 @@ export class EfunBridge {
         },
         scheduler: {
           heartbeats: scheduler.heartbeatCount,
+          dormantHeartbeats: scheduler.dormantHeartbeatCount,
           callouts: scheduler.callOutCount,
-          heartbeatInterval: 2000, // Default, could be made configurable
+          heartbeatInterval: scheduler.heartbeatIntervalMs,
         },
         commands: {
           total: commandManager.commandCount,
@@ -4163,8 +4415,28 @@ export class EfunBridge {
 
   /**
    * Get all efuns as an object for exposing to sandbox.
+   * The table is built and frozen once; use refreshEfuns() to rebuild it.
+   */
+  getEfuns(): Readonly<Record<string, unknown>> {
+    if (!this.efunTable) {
+      this.efunTable = Object.freeze(this.buildEfunTable());
+    }
+    return this.efunTable;
+  }
+
+  /**
+   * Discard the cached efun table and build a new one. Needed only when
+   * bridge methods are replaced at runtime (e.g. after a driver hot reload).
+   */
+  refreshEfuns(): Readonly<Record<string, unknown>> {
+    this.efunTable = null;
+    return this.getEfuns();
+  }
+
+  /**
+   * Bind every efun to this bridge.
    */
-  getEfuns(): Record<string, unknown> {
+  private buildEfunTable(): Record<string, unknown> {
     return {
       // Object
       cloneObject: this.cloneObject.bind(this),
@@ -4172,7 +4444,17 @@ export class EfunBridge {
       loadObject: this.loadObject.bind(this),
       findObject: this.findObject.bind(this),
       loadBlueprint: this.loadBlueprint.bind(this),
+      isLazyWorld: this.isLazyWorld.bind(this),
+      prefetchObjects: this.prefetchObjects.bind(this),
       getAllObjects: this.getAllObjects.bind(this),
+      getObjectsByCategory: this.getObjectsByCategory.bind(this),
+      countObjectsByCategory: this.countObjectsByCategory.bind(this),
+      onObjectCategoryChange: this.onObjectCategoryChange.bind(this),
+      tagObject: this.tagObject.bind(this),
+      untagObject: this.untagObject.bind(this),
+      getClones: this.getClones.bind(this),
+      getRootObjects: this.getRootObjects.bind(this),
+      noteEnvironmentChange: this.noteEnvironmentChange.bind(this),
 
       // Hierarchy
       allInventory: this.allInventory.bind(this),
@@ -4265,6 +4547,8 @@ export class EfunBridge {
 
       // Scheduler
       setHeartbeat: this.setHeartbeat.bind(this),
+      getHeartbeatInterval: this.getHeartbeatInterval.bind(this),
+      wakeHeartbeatsNear: this.wakeHeartbeatsNear.bind(this),
       callOut: this.callOut.bind(this),
       removeCallOut: this.removeCallOut.bind(this),
 
@@ -4293,6 +4577,7 @@ export class EfunBridge {
 
       // Hot Reload
       reloadObject: this.reloadObject.bind(this),
+      reloadWithDependents: this.reloadWithDependents.bind(this),
       reloadCommand: this.reloadCommand.bind(this),
       rehashCommands: this.rehashCommands.bind(this),
       getCommandInfo: this.getCommandInfo.bind(this),
@@ -4338,6 +4623,8 @@ export class EfunBridge {
       getPerformanceMetrics: this.getPerformanceMetrics.bind(this),
       setPerformanceMetricsOption: this.setPerformanceMetricsOption.bind(this),
       clearPerformanceMetrics: this.clearPerformanceMetrics.bind(this),
+      getCommandTraces: this.getCommandTraces.bind(this),
+      exportCommandTraces: this.exportCommandTraces.bind(this),
 
       // AI
       aiAvailable: this.aiAvailable.bind(this),
@@ -4440,6 +4727,8 @@ export class EfunBridge {
     blueprints?: number;
     clones?: number;
     byType?: Record<string, number>;
+    byCategory?: Record<string, number>;
+    rootObjects?: number;
     largestInventories?: Array<{ objectId: string; count: number }>;
     blueprintCloneCounts?: Array<{ path: string; clones: number }>;
   } {
@@ -4482,6 +4771,16 @@ export class EfunBridge {
     heapUsedMb?: number;
     heapTotalMb?: number;
     rssMb?: number;
+    rooms?: {
+      lazyWorld: boolean;
+      loaded: number;
+      loadedOnDemand: number;
+      prefetched: number;
+      prefetchFailures: number;
+      onDemandHeapMb: number;
+    };
+    idleCleanup?: IdleReclaimerStats;
+    moduleVersions?: ModuleVersionStats;
   } {
     // Check builder permission
     if (!this.isBuilder()) {
@@ -4493,6 +4792,7 @@ export class EfunBridge {
 
     try {
       const memUsage = process.memoryUsage();
+      const reclaimer = getIdleReclaimer();
       return {
         success: true,
         heapUsed: memUsage.heapUsed,
@@ -4503,6 +4803,16 @@ export class EfunBridge {
         heapUsedMb: Math.round(memUsage.heapUsed / 1024 / 1024 * 100) / 100,
         heapTotalMb: Math.round(memUsage.heapTotal / 1024 / 1024 * 100) / 100,
         rssMb: Math.round(memUsage.rss / 1024 / 1024 * 100) / 100,
+        rooms: {
+          lazyWorld: this.config.lazyWorld,
+          loaded: this.registry.countByCategory('room'),
+          loadedOnDemand: this.roomLoads.onDemand,
+          prefetched: this.roomLoads.prefetched,
+          prefetchFailures: this.roomLoads.prefetchFailures,
+          onDemandHeapMb: Math.round(this.roomLoads.heapBytes / 1024 / 1024 * 100) / 100,
+        },
+        ...(reclaimer ? { idleCleanup: reclaimer.getStats() } : {}),
+        moduleVersions: getModuleReloader().getStats(),
       };
     } catch (error) {
       return {
@@ -4522,12 +4832,42 @@ export class EfunBridge {
     success: boolean;
     error?: string;
     heartbeats?: { avg: number; p95: number; p99: number; max: number; count: number };
+    heartbeatTicks?: { avg: number; p95: number; p99: number; max: number; count: number };
+    heartbeatSlots?: {
+      mode: string;
+      slots: number;
+      minObjects: number;
+      maxObjects: number;
+      maxTickMs: number;
+      yields: number;
+    };
+    heartbeatClasses?: Array<{
+      name: string;
+      intervalMs: number;
+      objects: number;
+      avg: number;
+      p95: number;
+      max: number;
+      count: number;
+      totalMs: number;
+    }>;
     callOuts?: { avg: number; p95: number; p99: number; max: number; count: number };
+    callOutLateness?: { avg: number; p95: number; p99: number; max: number; count: number };
     commands?: { avg: number; p95: number; p99: number; max: number; count: number };
+    scriptRuns?: { avg: number; p95: number; p99: number; max: number; count: number };
+    playerSaveBatches?: { avg: number; p95: number; p99: number; max: number; count: number };
+    playerSaves?: SavePipelineStats;
     isolateAcquireWaits?: number;
     isolateQueueLength?: number;
     backpressureEvents?: number;
     droppedMessages?: number;
+    output?: {
+      messages: number;
+      frames: number;
+      messagesPerFrame: number;
+      messagesPerCommand: number;
+      framesPerCommand: number;
+    };
     slowOperations?: Array<{
       timestamp: number;
       type: string;
@@ -4547,15 +4887,37 @@ export class EfunBridge {
 
     try {
       const metrics = getMetrics().getFormattedMetrics();
+      const scheduler = getScheduler();
+      const slotStats = scheduler.getHeartbeatSlotStats();
+      const slotObjects = slotStats.map((slot) => slot.objects);
+      const heartbeatClasses = scheduler.getHeartbeatClassStats().map((stats) => ({
+        ...stats,
+        ...(metrics.heartbeatClasses[stats.name] ?? { avg: 0, p95: 0, max: 0, count: 0, totalMs: 0 }),
+      }));
       return {
         success: true,
         heartbeats: metrics.heartbeats,
+        heartbeatTicks: metrics.heartbeatTicks,
+        heartbeatSlots: {
+          mode: scheduler.heartbeatMode,
+          slots: slotStats.length,
+          minObjects: slotObjects.length > 0 ? Math.min(...slotObjects) : 0,
+          maxObjects: slotObjects.length > 0 ? Math.max(...slotObjects) : 0,
+          maxTickMs: Math.max(0, ...slotStats.map((slot) => slot.maxDurationMs)),
+          yields: slotStats.reduce((sum, slot) => sum + slot.yields, 0),
+        },
+        heartbeatClasses,
         callOuts: metrics.callOuts,
+        callOutLateness: metrics.callOutLateness,
         commands: metrics.commands,
+        scriptRuns: metrics.scriptRuns,
+        playerSaveBatches: metrics.playerSaveBatches,
+        playerSaves: getSavePipeline().getStats(),
         isolateAcquireWaits: metrics.isolateAcquireWaits,
         isolateQueueLength: metrics.isolateQueueLength,
         backpressureEvents: metrics.backpressureEvents,
         droppedMessages: metrics.droppedMessages,
+        output: metrics.output,
         slowOperations: metrics.slowOperations,
         uptimeMs: metrics.uptimeMs,
         efunTimingEnabled: getMetrics().isEfunTimingEnabled(),
@@ -4622,6 +4984,7 @@ export class EfunBridge {
 
     try {
       getMetrics().clear();
+      getCommandTracer().clear();
       return { success: true };
     } catch (error) {
       return {
@@ -4631,6 +4994,59 @@ export class EfunBridge {
     }
   }
 
+  /**
+   * Get per-phase command traces.
+   * Requires admin permission.
+   *
+   * @param which 'slow' for traces over the slow threshold, 'recent' for the latest sampled ones
+   * @returns Traces (oldest first) and tracer statistics
+   */
+  getCommandTraces(which: 'slow' | 'recent' = 'slow'): {
+    success: boolean;
+    error?: string;
+    traces?: CommandTraceRecord[];
+    stats?: CommandTracerStats;
+  } {
+    if (!this.isAdmin()) {
+      return {
+        success: false,
+        error: 'Permission denied: admin required',
+      };
+    }
+
+    const tracer = getCommandTracer();
+    return {
+      success: true,
+      traces: which === 'recent' ? tracer.getRecentTraces() : tracer.getSlowTraces(),
+      stats: tracer.getStats(),
+    };
+  }
+
+  /**
+   * Export command traces as Chrome Trace Event Format JSON, which
+   * Perfetto (ui.perfetto.dev) and chrome://tracing can open.
+   * Requires admin permission.
+   *
+   * @param which 'slow' or 'recent' traces
+   * @returns The JSON document and the number of traces in it
+   */
+  exportCommandTraces(which: 'slow' | 'recent' = 'slow'): {
+    success: boolean;
+    error?: string;
+    json?: string;
+    count?: number;
+  } {
+    const result = this.getCommandTraces(which);
+    if (!result.success || !result.traces) {
+      return { success: false, error: result.error ?? 'No traces' };
+    }
+    return {
+      success: true,
+      json: JSON.stringify(toChromeTrace(result.traces)),
+      count: result.traces.length,
+    };
+  }
+
   // ========== Intermud 3 Efuns ==========
 
   /**
@@ -0,0 +1,305 @@
+/**
+ * HeartbeatDormancy - Parks heartbeats of objects far away from any player.
+ *
+ * Periodically computes the set of "active" rooms: every room holding an
+ * interactive player plus the rooms within a configurable number of exits.
+ * Heartbeat objects that opt in (by implementing allowsHeartbeatDormancy())
+ * and sit in an inactive room are moved out of the scheduler's hot set.
+ * They are woken again - with a catch-up tick - on the next sweep that finds
+ * their room active, or immediately when a player arrives nearby.
+ *
+ * Rooms are tracked by objectId so shadow proxies and raw objects match.
+ */
+
+import type { MudObject } from './types.js';
+import type { Scheduler } from './scheduler.js';
+import { getLogger } from './logger.js';
+
+export interface HeartbeatDormancyConfig {
+  /** Rooms within this many exits of a player stay awake */
+  radius: number;
+  /** How often to re-evaluate which objects should sleep, in milliseconds */
+  sweepIntervalMs: number;
+}
+
+/**
+ * World lookups the dormancy manager needs from the driver.
+ */
+export interface HeartbeatDormancyHooks {
+  /** All interactive players */
+  getPlayers: () => MudObject[];
+  /** Find an already-loaded object by path (must not load anything) */
+  findObject: (path: string) => MudObject | undefined;
+}
+
+/**
+ * Result of a single sweep.
+ */
+export interface DormancySweepResult {
+  /** Number of rooms considered active */
+  activeRooms: number;
+  /** Objects put to sleep this sweep */
+  slept: number;
+  /** Objects woken this sweep */
+  woken: number;
+}
+
+interface ExitLike {
+  destination: string | MudObject;
+}
+
+/**
+ * Get the outermost environment (normally the room) of an object.
+ */
+function outermostEnvironment(object: MudObject): MudObject | null {
+  let env = object.environment;
+  if (!env) return null;
+  while (env.environment) {
+    env = env.environment;
+  }
+  return env;
+}
+
+/**
+ * Manages heartbeat dormancy for objects in unpopulated rooms.
+ */
+export class HeartbeatDormancy {
+  private scheduler: Scheduler;
+  private config: HeartbeatDormancyConfig;
+  private hooks: HeartbeatDormancyHooks;
+  /** Dormant object -> objectId of the room it fell asleep in */
+  private roomOf: Map<MudObject, string> = new Map();
+  /** Room objectId -> dormant objects in it */
+  private byRoom: Map<string, Set<MudObject>> = new Map();
+  private timer: NodeJS.Timeout | null = null;
+  private running: boolean = false;
+
+  constructor(
+    scheduler: Scheduler,
+    config: Partial<HeartbeatDormancyConfig>,
+    hooks: HeartbeatDormancyHooks
+  ) {
+    this.scheduler = scheduler;
+    this.config = {
+      radius: Math.max(0, config.radius ?? 1),
+      sweepIntervalMs: config.sweepIntervalMs ?? 5000,
+    };
+    this.hooks = hooks;
+  }
+
+  /**
+   * Start periodic sweeps.
+   */
+  start(): void {
+    if (this.running) return;
+    this.running = true;
+    this.scheduleSweep();
+  }
+
+  /**
+   * Stop periodic sweeps. Dormant objects stay dormant.
+   */
+  stop(): void {
+    this.running = false;
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+  }
+
+  /**
+   * Wake every dormant object.
+   */
+  wakeAll(): void {
+    for (const object of Array.from(this.roomOf.keys())) {
+      this.wake(object);
+    }
+  }
+
+  /**
+   * Number of objects this manager has put to sleep.
+   */
+  get dormantCount(): number {
+    return this.roomOf.size;
+  }
+
+  /**
+   * Re-evaluate which objects should be dormant.
+   */
+  sweep(): DormancySweepResult {
+    const active = new Set<string>();
+    for (const player of this.hooks.getPlayers()) {
+      const room = outermostEnvironment(player);
+      if (room) {
+        this.collectNearbyRooms(room, active);
+      }
+    }
+
+    // Wake objects whose room is active again, or that were moved while asleep
+    let woken = 0;
+    for (const [object, roomId] of this.roomOf) {
+      if (!this.scheduler.isHeartbeatDormant(object)) {
+        // Unregistered or destroyed while dormant
+        this.forget(object);
+        continue;
+      }
+      const room = outermostEnvironment(object);
+      if (active.has(roomId) || !room || room.objectId !== roomId) {
+        this.wake(object);
+        woken++;
+      }
+    }
+
+    // Put idle objects to sleep
+    let slept = 0;
+    for (const object of this.scheduler.activeHeartbeatObjects()) {
+      if (!this.canSleep(object)) continue;
+      const room = outermostEnvironment(object);
+      if (!room || active.has(room.objectId)) continue;
+      if (this.scheduler.setHeartbeatDormant(object, true)) {
+        this.remember(object, room.objectId);
+        slept++;
+      }
+    }
+
+    return { activeRooms: active.size, slept, woken };
+  }
+
+  /**
+   * Wake dormant objects near an object (typically a player that just moved).
+   * @returns Number of objects woken
+   */
+  wakeNear(object: MudObject): number {
+    const room = outermostEnvironment(object) ?? object;
+    const nearby = new Set<string>();
+    this.collectNearbyRooms(room, nearby);
+
+    let woken = 0;
+    for (const roomId of nearby) {
+      const sleepers = this.byRoom.get(roomId);
+      if (!sleepers) continue;
+      for (const sleeper of Array.from(sleepers)) {
+        this.wake(sleeper);
+        woken++;
+      }
+    }
+    return woken;
+  }
+
+  /**
+   * Check whether an object has opted into dormancy and currently allows it.
+   */
+  private canSleep(object: MudObject): boolean {
+    const candidate = object as MudObject & { allowsHeartbeatDormancy?: () => boolean };
+    if (typeof candidate.allowsHeartbeatDormancy !== 'function') return false;
+    try {
+      return candidate.allowsHeartbeatDormancy() === true;
+    } catch (error) {
+      getLogger().error({ error, objectId: object.objectId }, 'allowsHeartbeatDormancy error');
+      return false;
+    }
+  }
+
+  /**
+   * Breadth-first walk over loaded rooms, up to the configured radius.
+   */
+  private collectNearbyRooms(start: MudObject, into: Set<string>): void {
+    let frontier: MudObject[] = [start];
+    into.add(start.objectId);
+
+    for (let depth = 0; depth < this.config.radius && frontier.length > 0; depth++) {
+      const next: MudObject[] = [];
+      for (const room of frontier) {
+        const withExits = room as MudObject & { getExits?: () => ExitLike[] };
+        if (typeof withExits.getExits !== 'function') continue;
+
+        for (const exit of withExits.getExits()) {
+          const dest =
+            typeof exit.destination === 'string'
+              ? this.hooks.findObject(exit.destination)
+              : exit.destination;
+          // Unloaded rooms have nothing to wake
+          if (!dest || into.has(dest.objectId)) continue;
+          into.add(dest.objectId);
+          next.push(dest);
+        }
+      }
+      frontier = next;
+    }
+  }
+
+  private wake(object: MudObject): void {
+    this.forget(object);
+    this.scheduler.setHeartbeatDormant(object, false);
+  }
+
+  private remember(object: MudObject, roomId: string): void {
+    this.roomOf.set(object, roomId);
+    let sleepers = this.byRoom.get(roomId);
+    if (!sleepers) {
+      sleepers = new Set();
+      this.byRoom.set(roomId, sleepers);
+    }
+    sleepers.add(object);
+  }
+
+  private forget(object: MudObject): void {
+    const roomId = this.roomOf.get(object);
+    if (roomId === undefined) return;
+    this.roomOf.delete(object);
+    const sleepers = this.byRoom.get(roomId);
+    if (sleepers) {
+      sleepers.delete(object);
+      if (sleepers.size === 0) {
+        this.byRoom.delete(roomId);
+      }
+    }
+  }
+
+  private scheduleSweep(): void {
+    if (!this.running) return;
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      try {
+        this.sweep();
+      } catch (error) {
+        getLogger().error({ error }, 'Heartbeat dormancy sweep error');
+      }
+      this.scheduleSweep();
+    }, this.config.sweepIntervalMs);
+  }
+}
+
+// Singleton instance
+let dormancyInstance: HeartbeatDormancy | null = null;
+
+/**
+ * Get the heartbeat dormancy manager, if dormancy is enabled.
+ */
+export function getHeartbeatDormancy(): HeartbeatDormancy | null {
+  return dormancyInstance;
+}
+
+/**
+ * Initialize the heartbeat dormancy manager.
+ */
+export function initializeHeartbeatDormancy(
+  scheduler: Scheduler,
+  config: Partial<HeartbeatDormancyConfig>,
+  hooks: HeartbeatDormancyHooks
+): HeartbeatDormancy {
+  if (dormancyInstance) {
+    dormancyInstance.stop();
+    dormancyInstance.wakeAll();
+  }
+  dormancyInstance = new HeartbeatDormancy(scheduler, config, hooks);
+  return dormancyInstance;
+}
+
+/**
+ * Reset the heartbeat dormancy manager. Used for testing.
+ */
+export function resetHeartbeatDormancy(): void {
+  dormancyInstance?.stop();
+  dormancyInstance = null;
+}
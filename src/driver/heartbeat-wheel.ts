@@ -0,0 +1,251 @@
+/**
+ * HeartbeatWheel - Spreads heartbeat objects across phase slots.
+ *
+ * Instead of running every heartbeat at the same instant once per interval,
+ * the interval is divided into slots and each object is assigned to one slot
+ * by hashing its objectId. Every slot tick runs only that slot's objects,
+ * yielding to the event loop whenever the per-slice time budget is used up,
+ * so heartbeat cost is spread evenly across the interval.
+ */
+
+import type { MudObject } from './types.js';
+
+/**
+ * Maximum number of heartbeats to execute in parallel within a slice.
+ */
+export const HEARTBEAT_CONCURRENCY = 10;
+
+export interface HeartbeatWheelConfig {
+  /** Interval between heartbeats of the same object in milliseconds */
+  intervalMs: number;
+  /** Number of phase slots the interval is divided into */
+  slotCount: number;
+  /** Maximum milliseconds of heartbeat work before yielding to the event loop */
+  sliceBudgetMs: number;
+}
+
+/**
+ * Load statistics for a single slot.
+ */
+export interface HeartbeatSlotStats {
+  /** Slot index */
+  slot: number;
+  /** Objects currently assigned to this slot */
+  objects: number;
+  /** Duration of the most recent tick in milliseconds */
+  lastDurationMs: number;
+  /** Longest tick observed in milliseconds */
+  maxDurationMs: number;
+  /** Times this slot yielded to the event loop mid-tick */
+  yields: number;
+}
+
+/**
+ * Runs a single object's heartbeat.
+ */
+export type HeartbeatRunner = (object: MudObject) => Promise<void>;
+
+/**
+ * Hash an objectId into a slot (32-bit FNV-1a).
+ */
+export function hashToSlot(objectId: string, slotCount: number): number {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < objectId.length; i++) {
+    hash ^= objectId.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return (hash >>> 0) % slotCount;
+}
+
+/**
+ * Yield to the event loop so pending I/O (player input) can be processed.
+ */
+function yieldToEventLoop(): Promise<void> {
+  return new Promise((resolve) => setImmediate(resolve));
+}
+
+/**
+ * Phase-slotted heartbeat dispatcher.
+ */
+export class HeartbeatWheel {
+  private config: HeartbeatWheelConfig;
+  private slots: Set<MudObject>[];
+  private slotOf: Map<MudObject, number> = new Map();
+  private stats: HeartbeatSlotStats[];
+  private runner: HeartbeatRunner;
+  private cursor: number = 0;
+  private nextTickAt: number = 0;
+  private timer: NodeJS.Timeout | null = null;
+  private running: boolean = false;
+
+  /** Called after each slot tick with the tick's duration */
+  onTick: ((durationMs: number) => void) | null = null;
+
+  constructor(config: HeartbeatWheelConfig, runner: HeartbeatRunner) {
+    this.config = {
+      intervalMs: config.intervalMs,
+      slotCount: Math.max(1, Math.floor(config.slotCount)),
+      sliceBudgetMs: Math.max(1, config.sliceBudgetMs),
+    };
+    this.runner = runner;
+    this.slots = Array.from({ length: this.config.slotCount }, () => new Set<MudObject>());
+    this.stats = this.slots.map((_, slot) => ({
+      slot,
+      objects: 0,
+      lastDurationMs: 0,
+      maxDurationMs: 0,
+      yields: 0,
+    }));
+  }
+
+  /**
+   * Milliseconds between consecutive slot ticks.
+   */
+  get slotMs(): number {
+    return this.config.intervalMs / this.config.slotCount;
+  }
+
+  /**
+   * Number of phase slots.
+   */
+  get slotCount(): number {
+    return this.config.slotCount;
+  }
+
+  /**
+   * Number of objects on the wheel.
+   */
+  get size(): number {
+    return this.slotOf.size;
+  }
+
+  /**
+   * Add an object to its hashed slot.
+   */
+  add(object: MudObject): void {
+    if (this.slotOf.has(object)) return;
+    const slot = hashToSlot(object.objectId, this.config.slotCount);
+    this.slots[slot]!.add(object);
+    this.slotOf.set(object, slot);
+  }
+
+  /**
+   * Remove an object from the wheel.
+   * @returns true if the object was on the wheel
+   */
+  remove(object: MudObject): boolean {
+    const slot = this.slotOf.get(object);
+    if (slot === undefined) return false;
+    this.slots[slot]!.delete(object);
+    this.slotOf.delete(object);
+    return true;
+  }
+
+  /**
+   * Check if an object is on the wheel.
+   */
+  has(object: MudObject): boolean {
+    return this.slotOf.has(object);
+  }
+
+  /**
+   * Iterate all objects on the wheel.
+   */
+  objects(): IterableIterator<MudObject> {
+    return this.slotOf.keys();
+  }
+
+  /**
+   * Remove all objects.
+   */
+  clear(): void {
+    for (const slot of this.slots) {
+      slot.clear();
+    }
+    this.slotOf.clear();
+  }
+
+  /**
+   * Start ticking slots.
+   */
+  start(): void {
+    if (this.running) return;
+    this.running = true;
+    this.nextTickAt = Date.now() + this.slotMs;
+    this.scheduleTick();
+  }
+
+  /**
+   * Stop ticking slots.
+   */
+  stop(): void {
+    this.running = false;
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+  }
+
+  /**
+   * Get per-slot load statistics.
+   */
+  getSlotStats(): HeartbeatSlotStats[] {
+    return this.stats.map((stat) => ({ ...stat, objects: this.slots[stat.slot]!.size }));
+  }
+
+  /**
+   * Run every object in one slot, yielding whenever the slice budget is exceeded.
+   * @returns Total duration of the tick in milliseconds
+   */
+  async runSlot(slot: number): Promise<number> {
+    const members = this.slots[slot];
+    const stat = this.stats[slot];
+    if (!members || !stat) return 0;
+
+    const start = Date.now();
+    const objects = Array.from(members);
+    let sliceStart = start;
+
+    for (let i = 0; i < objects.length; i += HEARTBEAT_CONCURRENCY) {
+      const chunk = objects.slice(i, i + HEARTBEAT_CONCURRENCY);
+      // Skip objects removed (or destroyed) since the snapshot was taken
+      await Promise.all(
+        chunk.filter((obj) => this.slotOf.get(obj) === slot).map((obj) => this.runner(obj))
+      );
+
+      const more = i + HEARTBEAT_CONCURRENCY < objects.length;
+      if (more && Date.now() - sliceStart >= this.config.sliceBudgetMs) {
+        stat.yields++;
+        await yieldToEventLoop();
+        sliceStart = Date.now();
+      }
+    }
+
+    const elapsed = Date.now() - start;
+    stat.lastDurationMs = elapsed;
+    stat.maxDurationMs = Math.max(stat.maxDurationMs, elapsed);
+    return elapsed;
+  }
+
+  private scheduleTick(): void {
+    if (!this.running) return;
+
+    const delay = Math.max(0, this.nextTickAt - Date.now());
+    this.timer = setTimeout(async () => {
+      this.timer = null;
+      const slot = this.cursor;
+      this.cursor = (this.cursor + 1) % this.config.slotCount;
+
+      const elapsed = await this.runSlot(slot);
+      this.onTick?.(elapsed);
+
+      // Keep ticks on a fixed cadence, but don't burst to catch up after a long stall
+      this.nextTickAt += this.slotMs;
+      const now = Date.now();
+      if (now - this.nextTickAt > this.config.intervalMs) {
+        this.nextTickAt = now;
+      }
+      this.scheduleTick();
+    }, delay);
+  }
+}
@@ -3,18 +3,31 @@
  *
  * Allows updating object code at runtime without restarting the server.
  * Existing clones get new methods while preserving their state.
+ *
+ * reloadWithDependents() reloads a module together with everything built
+ * on it (see reload-planner.ts): the plan is compiled in parallel,
+ * evaluated level by level so each module binds to the new versions of
+ * its imports, and only if every module succeeds are the blueprints and
+ * commands swapped, synchronously, in one event-loop turn.
  */
 
 import { watch, type FSWatcher } from 'fs';
 import { stat } from 'fs/promises';
-import { join } from 'path';
+import { join, resolve } from 'path';
 import { Compiler } from './compiler.js';
 import { ObjectRegistry, getRegistry } from './object-registry.js';
-import type { BlueprintInfo, MudObject } from './types.js';
+import type { BlueprintInfo, MudObject, MudObjectConstructor } from './types.js';
 import { getLogger } from './logger.js';
+import type { MudlibLoader } from './mudlib-loader.js';
+import type { CommandManager } from './command-manager.js';
+import { getModuleReloader, type CompiledModule } from './module-reloader.js';
+import { ImportScanner, planReload, type ReloadPlan } from './reload-planner.js';
 
 const logger = getLogger();
 
+/** Room players are moved to when their room is deleted */
+const VOID_ROOM = '/areas/void/void';
+
 export interface HotReloadConfig {
   /** Root directory for mudlib files */
   mudlibPath: string;
@@ -24,6 +37,13 @@ export interface HotReloadConfig {
   debounceMs: number;
   /** Object paths that should never be auto-unloaded on file deletion */
   safelist?: string[];
+  /** Reload modified files and their dependents automatically */
+  cascadeOnChange: boolean;
+  /**
+   * Paths a cascade never reloads (a trailing slash matches a directory).
+   * Daemons hold game state in module-level singletons.
+   */
+  cascadeExclude: string[];
 }
 
 export interface UpdateResult {
@@ -39,6 +59,43 @@ export interface UpdateResult {
   warnings?: string[] | undefined;
 }
 
+/**
+ * Result of reloading a module with its dependents.
+ */
+export interface CascadeReloadResult {
+  /** Whether every planned module was reloaded */
+  success: boolean;
+  /** The changed module */
+  objectPath: string;
+  /** Error message (if failed; nothing was swapped) */
+  error?: string | undefined;
+  /** Module that failed to compile or evaluate */
+  failedPath?: string | undefined;
+  /** Modules reloaded, in evaluation order */
+  plan: ReloadPlan;
+  /** Blueprints swapped; rebasedClones existing clones were moved onto the new class */
+  blueprints: Array<{
+    path: string;
+    existingClones: number;
+    migratedObjects: number;
+    rebasedClones: number;
+  }>;
+  /** Commands swapped */
+  commandsReplaced: number;
+  /** Problems after the swap (e.g. onCreate errors); the new versions stay */
+  warnings: string[];
+  /** Phase timings in ms */
+  timing: {
+    scanMs: number;
+    planMs: number;
+    compileMs: number;
+    evaluateMs: number;
+    swapMs: number;
+    createMs: number;
+    totalMs: number;
+  };
+}
+
 /**
  * Dependency information for an object.
  */
@@ -49,6 +106,15 @@ interface DependencyInfo {
   dependents: Set<string>;
 }
 
+/**
+ * A blueprint swapped by a cascade, with what to put back if it fails.
+ */
+interface SwappedBlueprint {
+  path: string;
+  ObjectClass: MudObjectConstructor;
+  previous: { ObjectClass: MudObjectConstructor; instance: MudObject } | undefined;
+}
+
 /**
  * Manages hot-reloading of mudlib objects.
  */
@@ -59,6 +125,11 @@ export class HotReload {
   private watcher: FSWatcher | null = null;
   private dependencies: Map<string, DependencyInfo> = new Map();
   private debounceTimers: Map<string, NodeJS.Timeout> = new Map();
+  private scanner: ImportScanner;
+  private loader: MudlibLoader | null = null;
+  private commandManager: CommandManager | null = null;
+  /** Cascades run one at a time */
+  private cascadeChain: Promise<unknown> = Promise.resolve();
 
   constructor(config: Partial<HotReloadConfig> = {}, registry?: ObjectRegistry) {
     this.config = {
@@ -66,10 +137,27 @@ export class HotReload {
       watchEnabled: config.watchEnabled ?? false,
       debounceMs: config.debounceMs ?? 100,
       safelist: config.safelist ?? [],
+      cascadeOnChange: config.cascadeOnChange ?? false,
+      cascadeExclude: config.cascadeExclude ?? ['/master', '/simul_efun', '/daemons/'],
     };
 
     this.compiler = new Compiler({ mudlibPath: this.config.mudlibPath });
     this.registry = registry ?? getRegistry();
+    this.scanner = new ImportScanner(this.config.mudlibPath);
+  }
+
+  /**
+   * Set the loader whose blueprints and modules cascading reloads replace.
+   */
+  setLoader(loader: MudlibLoader): void {
+    this.loader = loader;
+  }
+
+  /**
+   * Set the command manager whose commands cascading reloads replace.
+   */
+  setCommandManager(commandManager: CommandManager): void {
+    this.commandManager = commandManager;
   }
 
   /**
@@ -122,12 +210,13 @@ export class HotReload {
   /**
    * Handle a file deletion event.
    * Only processes 'rename' events (which indicate deletion when file no longer exists).
-   * File modifications are ignored - use 'update' command for hot-reload.
+   * File modifications are ignored - use 'update' command for hot-reload - unless
+   * cascadeOnChange is set.
    */
   private handleFileChange(eventType: string, filename: string): void {
     try {
-      // Only handle 'rename' events - 'change' events are modifications which we ignore
-      if (eventType !== 'rename') {
+      // 'change' events are modifications, which we ignore unless cascading
+      if (eventType !== 'rename' && !(eventType === 'change' && this.config.cascadeOnChange)) {
         return;
       }
 
@@ -146,7 +235,7 @@ export class HotReload {
         return;
       }
 
-      logger.debug({ filename }, 'File rename event');
+      logger.debug({ eventType, filename }, 'File event');
 
       // Debounce rapid changes
       const existing = this.debounceTimers.get(filename);
@@ -168,23 +257,27 @@ export class HotReload {
   }
 
   /**
-   * Process a file event - only handles deletions.
-   * File modifications still require the manual 'update' command.
+   * Process a file event - handles deletions, and modifications when
+   * cascadeOnChange is set. Otherwise modifications still require the
+   * manual 'update' command.
    */
   private async processFileEvent(eventType: string, filename: string): Promise<void> {
-    // Only handle 'rename' events which indicate file creation or deletion
-    // 'change' events (modifications) are ignored - use 'update' command instead
-    if (eventType !== 'rename') {
-      return;
-    }
-
     const fullPath = join(this.config.mudlibPath, filename);
     const objectPath = this.fileToObjectPath(filename);
 
+    if (eventType === 'change') {
+      await this.cascadeFileChange(objectPath);
+      return;
+    }
+
     try {
       // Check if file still exists
       await stat(fullPath);
-      // File exists - this is a creation or rename, not a deletion
+      // File exists - this is a creation or rename (editors often save this way)
+      if (this.config.cascadeOnChange) {
+        await this.cascadeFileChange(objectPath);
+        return;
+      }
       // Do nothing - modifications require manual 'update' command
       logger.debug({ objectPath }, 'File created/renamed (ignored)');
     } catch {
@@ -193,6 +286,22 @@ export class HotReload {
     }
   }
 
+  /**
+   * Reload a modified file and its dependents.
+   */
+  private async cascadeFileChange(objectPath: string): Promise<void> {
+    // The command manager watches and reloads its own files
+    if (objectPath.startsWith('/cmds/')) return;
+
+    const result = await this.reloadWithDependents(objectPath);
+    if (!result.success) {
+      logger.warn(
+        { objectPath, failedPath: result.failedPath, error: result.error },
+        'Cascading reload failed'
+      );
+    }
+  }
+
   /**
    * Convert a filename to an object path.
    */
@@ -276,8 +385,14 @@ export class HotReload {
       return;
     }
 
-    // Try to find a void room to evacuate to
-    const voidRoom = this.registry.find('/areas/void/void');
+    // Evacuate to the void, loading it if needed (a lazy world doesn't preload areas)
+    let voidRoom = this.registry.find(VOID_ROOM);
+    if (!voidRoom && this.loader && objectPath !== VOID_ROOM) {
+      voidRoom = await this.loader.loadObject(VOID_ROOM).catch((error: unknown) => {
+        logger.error({ error }, 'Failed to load void room for evacuation');
+        return undefined;
+      });
+    }
 
     // Copy inventory array since we'll be modifying it
     for (const item of [...obj.inventory]) {
@@ -456,6 +571,244 @@ export class HotReload {
     return results;
   }
 
+  /**
+   * Rescan the mudlib's imports and update the dependency graph.
+   */
+  async refreshDependencies(): Promise<void> {
+    const { changed, removed } = await this.scanner.scan();
+    for (const [objectPath, imports] of changed) {
+      this.trackDependencies(objectPath, imports);
+    }
+    for (const objectPath of removed) {
+      this.trackDependencies(objectPath, []);
+    }
+  }
+
+  /**
+   * Reload a module and every loaded blueprint and command that imports it,
+   * directly or transitively. All-or-nothing: if any planned module fails to
+   * compile or evaluate, a command module is invalid, or a blueprint swap
+   * throws, nothing is left swapped.
+   * @param objectPath The changed module (e.g. "/std/living")
+   * @param options.dryRun Only plan the reload
+   */
+  async reloadWithDependents(
+    objectPath: string,
+    options: { dryRun?: boolean } = {}
+  ): Promise<CascadeReloadResult> {
+    const run = this.cascadeChain.then(() => this.cascade(objectPath, options.dryRun ?? false));
+    this.cascadeChain = run.catch(() => undefined);
+    return run;
+  }
+
+  private async cascade(objectPath: string, dryRun: boolean): Promise<CascadeReloadResult> {
+    const start = performance.now();
+    let mark = start;
+    const lap = (): number => {
+      const now = performance.now();
+      const elapsed = now - mark;
+      mark = now;
+      return elapsed;
+    };
+
+    await this.refreshDependencies();
+    const scanMs = lap();
+    const plan = this.plan(objectPath);
+    const planMs = lap();
+    const result: CascadeReloadResult = {
+      success: false,
+      objectPath,
+      plan,
+      blueprints: [],
+      commandsReplaced: 0,
+      warnings: [],
+      timing: { scanMs, planMs, compileMs: 0, evaluateMs: 0, swapMs: 0, createMs: 0, totalMs: 0 },
+    };
+    const fail = (path: string, error: unknown): CascadeReloadResult => {
+      result.failedPath = path;
+      result.error = `${path}: ${error instanceof Error ? error.message : String(error)}`;
+      result.timing.totalMs = performance.now() - start;
+      return result;
+    };
+
+    if (dryRun) {
+      result.success = true;
+      result.timing.totalMs = performance.now() - start;
+      return result;
+    }
+    if (!this.loader) {
+      return fail(objectPath, new Error('Loader not configured'));
+    }
+    const loader = this.loader;
+    const reloader = getModuleReloader();
+    const modules = plan.levels.flat();
+
+    // Recompile everything in parallel
+    const compiled = new Map<string, CompiledModule>();
+    const compileErrors = await Promise.all(
+      modules.map(async (path) => {
+        try {
+          compiled.set(path, await reloader.compile(this.fileFor(path)));
+          return null;
+        } catch (error) {
+          return { path, error };
+        }
+      })
+    );
+    result.timing.compileMs = lap();
+    const compileError = compileErrors.find((entry) => entry !== null);
+    if (compileError) return fail(compileError.path, compileError.error);
+
+    // Evaluate level by level; each level binds to the new versions before it
+    const exports = new Map<string, Record<string, unknown>>();
+    for (const level of plan.levels) {
+      const errors = await Promise.all(
+        level.map(async (path) => {
+          try {
+            exports.set(this.fileFor(path), await reloader.evaluate(compiled.get(path)!, exports));
+            return null;
+          } catch (error) {
+            return { path, error };
+          }
+        })
+      );
+      const error = errors.find((entry) => entry !== null);
+      if (error) {
+        result.timing.evaluateMs = lap();
+        return fail(error.path, error.error);
+      }
+    }
+
+    // Check the reloaded commands before touching anything live
+    for (const path of plan.commands) {
+      if (!this.commandManager?.isCommandModule(exports.get(this.fileFor(path))!)) {
+        result.timing.evaluateMs = lap();
+        return fail(path, new Error('not a valid command (missing name or execute)'));
+      }
+    }
+
+    // Instantiate the new blueprints before touching anything live
+    const created: Array<{ path: string; ObjectClass: MudObjectConstructor; instance: MudObject }> =
+      [];
+    for (const path of plan.blueprints) {
+      try {
+        created.push({ path, ...loader.createBlueprint(path, exports.get(this.fileFor(path))!) });
+      } catch (error) {
+        result.timing.evaluateMs = lap();
+        return fail(path, error);
+      }
+    }
+    result.timing.evaluateMs = lap();
+
+    // Swap everything in one synchronous pass. Blueprints go first: swapping
+    // one is the only step that can throw, and any already swapped are put
+    // back if it does. Reloaded commands and subclasses check instanceof
+    // against the new classes, so existing clones move onto them too (base
+    // classes first).
+    const swapped: SwappedBlueprint[] = [];
+    for (const { path, ObjectClass, instance } of created) {
+      const existing = this.registry.findBlueprint(path);
+      const entry: SwappedBlueprint = {
+        path,
+        ObjectClass,
+        previous: existing && { ObjectClass: existing.constructor, instance: existing.instance },
+      };
+      swapped.push(entry);
+      try {
+        const rebasedClones = entry.previous
+          ? this.registry.rebaseClones(path, entry.previous.ObjectClass, ObjectClass)
+          : 0;
+        result.blueprints.push({
+          path,
+          ...this.registry.swapBlueprint(path, ObjectClass, instance),
+          rebasedClones,
+        });
+      } catch (error) {
+        this.restoreBlueprints(swapped);
+        result.blueprints = [];
+        result.timing.swapMs = lap();
+        return fail(path, error);
+      }
+    }
+    reloader.invalidate(plan.stale.map((path) => this.fileFor(path)));
+    for (const path of modules) {
+      loader.adoptModule(path, exports.get(this.fileFor(path))!);
+    }
+    for (const path of plan.commands) {
+      if (this.commandManager?.installModule(this.fileFor(path), exports.get(this.fileFor(path))!)) {
+        result.commandsReplaced++;
+      } else {
+        result.warnings.push(`${path}: not a valid command`);
+      }
+    }
+    result.timing.swapMs = lap();
+    result.success = true;
+
+    // Base classes were planned first, so their onCreate runs first too
+    for (const { path, instance } of created) {
+      try {
+        if (typeof instance.onCreate === 'function') {
+          await instance.onCreate();
+        }
+      } catch (error) {
+        result.warnings.push(
+          `${path}: onCreate failed: ${error instanceof Error ? error.message : String(error)}`
+        );
+      }
+    }
+    result.timing.createMs = lap();
+    result.timing.totalMs = performance.now() - start;
+
+    logger.info(
+      {
+        objectPath,
+        levels: plan.levels.length,
+        modules: modules.length,
+        blueprints: result.blueprints.length,
+        commands: result.commandsReplaced,
+        stale: plan.stale.length,
+        timing: result.timing,
+      },
+      'Cascading reload complete'
+    );
+    return result;
+  }
+
+  /**
+   * Undo blueprint swaps made by a cascade, newest first.
+   */
+  private restoreBlueprints(swapped: SwappedBlueprint[]): void {
+    for (const { path, ObjectClass, previous } of [...swapped].reverse()) {
+      if (!previous) continue;
+      try {
+        this.registry.rebaseClones(path, ObjectClass, previous.ObjectClass);
+        if (this.registry.findBlueprint(path)?.instance !== previous.instance) {
+          this.registry.swapBlueprint(path, previous.ObjectClass, previous.instance);
+        }
+      } catch (error) {
+        logger.error({ path, error }, 'Failed to restore blueprint after a failed cascade');
+      }
+    }
+  }
+
+  private plan(objectPath: string): ReloadPlan {
+    return planReload(objectPath, this, {
+      isBlueprint: (path) => this.registry.findBlueprint(path) !== undefined,
+      isCommand: (path) => this.commandManager?.hasCommandFile(this.fileFor(path)) ?? false,
+      isExcluded: (path) =>
+        this.config.cascadeExclude.some((entry) =>
+          entry.endsWith('/') ? path.startsWith(entry) : path === entry
+        ),
+    });
+  }
+
+  /**
+   * Absolute path of the file for a mudlib path.
+   */
+  private fileFor(objectPath: string): string {
+    return resolve(this.config.mudlibPath, objectPath.slice(1) + '.ts');
+  }
+
   /**
    * Get the compiler instance.
    */
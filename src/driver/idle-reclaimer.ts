@@ -0,0 +1,369 @@
+/**
+ * IdleReclaimer - Unloads blueprint objects nobody has used for a while.
+ *
+ * Objects opt in by implementing cleanUp(idleMs), which returns true when
+ * the object agrees to be unloaded (e.g. a room no player has entered for
+ * idleMs). On each sweep the reclaimer asks every opted-in blueprint; for
+ * each one that agrees it saves dirty state with the Serializer, destroys
+ * the object together with its contents and dependents (spawned NPCs), and
+ * unregisters the blueprint so memory tracks the active part of the world.
+ *
+ * The next load of the path (MudlibLoader.loadObject, e.g. through
+ * efuns.loadBlueprint or an exit) creates a fresh instance and restores the
+ * saved state into it after onCreate(). findObject never loads, so an
+ * unloaded path stays unloaded until something calls loadBlueprint or takes
+ * an exit into it; callers that must get the object (start rooms, the void,
+ * goto) use loadBlueprint.
+ */
+
+import type { MudObject } from './types.js';
+import type { ObjectRegistry } from './object-registry.js';
+import type { PersistenceAdapter } from './persistence/adapter.js';
+import { getSerializer, type SerializedState } from './persistence/serializer.js';
+import { getLogger } from './logger.js';
+
+/** Persistence namespace holding state of unloaded objects */
+const STATE_NAMESPACE = 'reclaimed';
+
+export interface IdleReclaimerConfig {
+  /** How long an object must be unused before it is asked to clean up */
+  idleMs: number;
+  /** How often to look for idle objects, in milliseconds */
+  sweepIntervalMs: number;
+}
+
+/**
+ * Hooks an object implements to take part in idle reclamation.
+ */
+export interface Reclaimable {
+  /**
+   * Decide whether the object can be unloaded now.
+   * @param idleMs The configured idle period
+   */
+  cleanUp(idleMs: number): boolean | Promise<boolean>;
+  /** Other objects to destroy along with this one (e.g. spawned NPCs) */
+  getCleanupDependents?(): MudObject[];
+  /** Whether the object holds state that differs from a fresh load */
+  hasDirtyState?(): boolean;
+  /** Mark the current state as the fresh-load baseline */
+  markStateClean?(): void;
+}
+
+/**
+ * Storage operations used for unloaded object state.
+ */
+export type ReclaimStore = Pick<
+  PersistenceAdapter,
+  'saveData' | 'loadData' | 'deleteData' | 'listKeys'
+>;
+
+export interface ReclaimSweepResult {
+  /** Opted-in blueprints asked to clean up */
+  checked: number;
+  /** Blueprints unloaded */
+  reclaimed: number;
+  /** Objects destroyed, including contents and dependents */
+  destroyed: number;
+}
+
+export interface IdleReclaimerStats {
+  /** Blueprints unloaded since startup */
+  reclaimed: number;
+  /** Unloaded blueprints loaded again */
+  reloaded: number;
+  /** Objects destroyed, including contents and dependents */
+  destroyed: number;
+  /** Unloaded objects whose state was saved */
+  saved: number;
+  /** Unloaded blueprints not loaded again yet */
+  unloaded: number;
+  /** Duration of the last sweep in milliseconds */
+  lastSweepMs: number;
+}
+
+function isReclaimable(object: MudObject): object is MudObject & Reclaimable {
+  return typeof (object as Partial<Reclaimable>).cleanUp === 'function';
+}
+
+/**
+ * Whether destroying this object would take down something that must stay:
+ * a player, or a blueprint (such as a docked vehicle) that lives elsewhere.
+ */
+function isPinned(object: MudObject): boolean {
+  if ((object as { isPlayer?: boolean }).isPlayer === true || !object.isClone) return true;
+  return object.inventory.some(isPinned);
+}
+
+/**
+ * Storage keys must survive adapter key sanitizing, so paths are base64url
+ * encoded (alphanumerics, '-' and '_' only).
+ */
+function keyFor(path: string): string {
+  return Buffer.from(path).toString('base64url');
+}
+
+function pathFor(key: string): string {
+  return Buffer.from(key, 'base64url').toString();
+}
+
+/**
+ * Unloads idle blueprints and restores them on demand.
+ */
+export class IdleReclaimer {
+  private registry: ObjectRegistry;
+  private store: ReclaimStore;
+  private config: IdleReclaimerConfig;
+  /** Unloaded paths not loaded again yet */
+  private unloaded: Set<string> = new Set();
+  /** Paths with saved state waiting to be restored */
+  private saved: Set<string> = new Set();
+  /** Snapshots not yet written to the store */
+  private pending: Map<string, SerializedState> = new Map();
+  private stats = { reclaimed: 0, reloaded: 0, destroyed: 0, lastSweepMs: 0 };
+  private timer: NodeJS.Timeout | null = null;
+  private running: boolean = false;
+  private sweeping: boolean = false;
+
+  constructor(registry: ObjectRegistry, store: ReclaimStore, config: Partial<IdleReclaimerConfig>) {
+    this.registry = registry;
+    this.store = store;
+    this.config = {
+      idleMs: config.idleMs ?? 60 * 60 * 1000,
+      sweepIntervalMs: config.sweepIntervalMs ?? 60 * 1000,
+    };
+  }
+
+  /**
+   * Find state saved by a previous run, so it is restored on next load.
+   */
+  async initialize(): Promise<void> {
+    for (const key of await this.store.listKeys(STATE_NAMESPACE)) {
+      this.saved.add(pathFor(key));
+    }
+  }
+
+  /**
+   * Start periodic sweeps.
+   */
+  start(): void {
+    if (this.running) return;
+    this.running = true;
+    this.scheduleSweep();
+  }
+
+  /**
+   * Stop periodic sweeps.
+   */
+  stop(): void {
+    this.running = false;
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+  }
+
+  /**
+   * Ask every opted-in blueprint to clean up and unload those that agree.
+   */
+  async sweep(): Promise<ReclaimSweepResult> {
+    const result: ReclaimSweepResult = { checked: 0, reclaimed: 0, destroyed: 0 };
+    if (this.sweeping) return result;
+    this.sweeping = true;
+    const start = performance.now();
+
+    try {
+      for (const info of Array.from(this.registry.getAllBlueprints())) {
+        const instance = info.instance;
+        // Clones keep references to their blueprint, so it must stay loaded
+        if (info.clones.size > 0 || !isReclaimable(instance)) continue;
+
+        result.checked++;
+        let agreed = false;
+        try {
+          agreed = (await instance.cleanUp(this.config.idleMs)) === true;
+        } catch (error) {
+          getLogger().error({ error, objectId: instance.objectId }, 'cleanUp error');
+        }
+        if (!agreed) continue;
+
+        const destroyed = await this.reclaim(info.path);
+        if (destroyed > 0) {
+          result.reclaimed++;
+          result.destroyed += destroyed;
+        }
+      }
+    } finally {
+      this.sweeping = false;
+      this.stats.lastSweepMs = performance.now() - start;
+    }
+
+    if (result.reclaimed > 0) {
+      getLogger().debug(result, 'Reclaimed idle objects');
+    }
+    return result;
+  }
+
+  /**
+   * Unload a blueprint now, saving its state first.
+   * @returns Number of objects destroyed (0 if the blueprint was kept)
+   */
+  async reclaim(path: string): Promise<number> {
+    const info = this.registry.findBlueprint(path);
+    if (!info || info.clones.size > 0) return 0;
+
+    const instance = info.instance as MudObject & Partial<Reclaimable>;
+    const dependents = (instance.getCleanupDependents?.() ?? []).filter(
+      (dependent) => dependent.isClone && this.registry.find(dependent.objectId) === dependent
+    );
+
+    // Never take a player or another blueprint down with the object
+    if (instance.inventory.some(isPinned) || dependents.some(isPinned)) return 0;
+
+    // Snapshot first: destroying runs onDestroy hooks that may change state
+    if (instance.hasDirtyState?.() !== false) {
+      const state = getSerializer().serialize(instance, false);
+      if (Object.keys(state.properties).length > 0) {
+        this.pending.set(path, state);
+        this.saved.add(path);
+      }
+    }
+
+    let destroyed = 0;
+    for (const dependent of dependents) {
+      destroyed += await this.destroyTree(dependent);
+    }
+    for (const item of [...instance.inventory]) {
+      destroyed += await this.destroyTree(item);
+    }
+    await this.registry.unregisterBlueprint(path);
+    destroyed++;
+
+    this.unloaded.add(path);
+    this.stats.reclaimed++;
+    this.stats.destroyed += destroyed;
+
+    const state = this.pending.get(path);
+    if (state) {
+      try {
+        await this.store.saveData(STATE_NAMESPACE, keyFor(path), state);
+        if (this.pending.get(path) === state) {
+          this.pending.delete(path);
+        } else if (!this.saved.has(path)) {
+          // Loaded and restored from memory while the write was in flight
+          await this.store.deleteData(STATE_NAMESPACE, keyFor(path));
+        }
+      } catch (error) {
+        // The in-memory snapshot still restores it this run
+        getLogger().error({ error, path }, 'Failed to save reclaimed object state');
+      }
+    }
+    return destroyed;
+  }
+
+  /**
+   * Called by the loader after a blueprint's onCreate(). Restores state saved
+   * when the path was unloaded.
+   */
+  async onLoaded(object: MudObject): Promise<void> {
+    if (!isReclaimable(object)) return;
+    const path = object.objectPath;
+    if (this.unloaded.delete(path)) {
+      this.stats.reloaded++;
+    }
+
+    if (!this.saved.has(path)) {
+      object.markStateClean?.();
+      return;
+    }
+
+    this.saved.delete(path);
+    let state: SerializedState | null | undefined = this.pending.get(path);
+    this.pending.delete(path);
+    try {
+      state ??= await this.store.loadData<SerializedState>(STATE_NAMESPACE, keyFor(path));
+      if (state) {
+        getSerializer().restore(state, object);
+      }
+      await this.store.deleteData(STATE_NAMESPACE, keyFor(path));
+    } catch (error) {
+      getLogger().error({ error, path }, 'Failed to restore reclaimed object state');
+    }
+  }
+
+  /**
+   * Whether a path was unloaded and has not been loaded again.
+   */
+  isUnloaded(path: string): boolean {
+    return this.unloaded.has(path);
+  }
+
+  /**
+   * Get reclamation statistics.
+   */
+  getStats(): IdleReclaimerStats {
+    return {
+      reclaimed: this.stats.reclaimed,
+      reloaded: this.stats.reloaded,
+      destroyed: this.stats.destroyed,
+      saved: this.saved.size,
+      unloaded: this.unloaded.size,
+      lastSweepMs: Math.round(this.stats.lastSweepMs * 100) / 100,
+    };
+  }
+
+  /**
+   * Destroy an object and everything inside it.
+   */
+  private async destroyTree(object: MudObject): Promise<number> {
+    let destroyed = 0;
+    for (const item of [...object.inventory]) {
+      destroyed += await this.destroyTree(item);
+    }
+    if (this.registry.find(object.objectId) === object) {
+      await this.registry.destroy(object);
+      destroyed++;
+    }
+    return destroyed;
+  }
+
+  private scheduleSweep(): void {
+    if (!this.running) return;
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      this.sweep()
+        .catch((error) => getLogger().error({ error }, 'Idle reclaim sweep error'))
+        .finally(() => this.scheduleSweep());
+    }, this.config.sweepIntervalMs);
+  }
+}
+
+// Singleton instance
+let reclaimerInstance: IdleReclaimer | null = null;
+
+/**
+ * Get the idle reclaimer, if object cleanup is enabled.
+ */
+export function getIdleReclaimer(): IdleReclaimer | null {
+  return reclaimerInstance;
+}
+
+/**
+ * Initialize the idle reclaimer.
+ */
+export function initializeIdleReclaimer(
+  registry: ObjectRegistry,
+  store: ReclaimStore,
+  config: Partial<IdleReclaimerConfig>
+): IdleReclaimer {
+  reclaimerInstance?.stop();
+  reclaimerInstance = new IdleReclaimer(registry, store, config);
+  return reclaimerInstance;
+}
+
+/**
+ * Reset the idle reclaimer. Used for testing.
+ */
+export function resetIdleReclaimer(): void {
+  reclaimerInstance?.stop();
+  reclaimerInstance = null;
+}
@@ -66,6 +66,8 @@ async function main(): Promise<void> {
     logHttpRequests: config.logHttpRequests,
     wsHeartbeatIntervalMs: config.wsHeartbeatIntervalMs,
     wsMaxMissedPongs: config.wsMaxMissedPongs,
+    wsOutputCoalesce: config.wsOutputCoalesce,
+    wsOutputCoalesceMs: config.wsOutputCoalesceMs,
   });
 
   // Wire up server events to driver with error handling
@@ -34,8 +34,8 @@ export interface TimingHistogram {
 export interface SlowOperation {
   /** When this operation occurred */
   timestamp: number;
-  /** Type of operation (heartbeat, callOut, command, efun) */
-  type: 'heartbeat' | 'callOut' | 'command' | 'efun';
+  /** Type of operation (heartbeat, callOut, command, efun, script, save) */
+  type: 'heartbeat' | 'callOut' | 'command' | 'efun' | 'script' | 'save';
   /** Identifier (object path, command name, efun name) */
   identifier: string;
   /** Duration in milliseconds */
@@ -48,10 +48,20 @@ export interface SlowOperation {
 export interface MetricsSnapshot {
   /** Heartbeat timing histogram */
   heartbeats: TimingHistogram;
+  /** Heartbeat tick (one slot or batch pass) timing histogram */
+  heartbeatTicks: TimingHistogram;
+  /** Per-rate-class heartbeat timing histograms */
+  heartbeatClasses: Record<string, TimingHistogram>;
   /** CallOut timing histogram */
   callOuts: TimingHistogram;
+  /** CallOut lateness histogram (actual fire time minus scheduled time) */
+  callOutLateness: TimingHistogram;
   /** Command timing histogram */
   commands: TimingHistogram;
+  /** Sandboxed script run latency histogram (acquire to release) */
+  scriptRuns: TimingHistogram;
+  /** Player save batch write time histogram */
+  playerSaveBatches: TimingHistogram;
   /** Per-efun timing histograms (when enabled) */
   efuns: Record<string, TimingHistogram>;
   /** Number of times an acquire had to wait for an isolate */
@@ -62,6 +72,10 @@ export interface MetricsSnapshot {
   backpressureEvents: number;
   /** Number of dropped messages due to backpressure */
   droppedMessages: number;
+  /** Output messages and the frames they were coalesced into, all connections */
+  output: { messages: number; frames: number };
+  /** Output messages and frames sent to players for their own commands */
+  commandOutput: { commands: number; messages: number; frames: number };
   /** Recent slow operations (>50ms) */
   slowOperations: SlowOperation[];
   /** When metrics collection started */
@@ -148,19 +162,34 @@ function average(histogram: TimingHistogram): number {
   return histogram.sum / histogram.count;
 }
 
+/**
+ * Divide, rounded to two places (0 when there is nothing to divide by).
+ */
+function ratio(total: number, count: number): number {
+  if (count === 0) return 0;
+  return Math.round((total / count) * 100) / 100;
+}
+
 /**
  * Metrics collector singleton.
  */
 class MetricsCollector {
   private heartbeats: TimingHistogram = createHistogram();
+  private heartbeatTicks: TimingHistogram = createHistogram();
+  private heartbeatClasses: Map<string, TimingHistogram> = new Map();
   private callOuts: TimingHistogram = createHistogram();
+  private callOutLateness: TimingHistogram = createHistogram();
   private commands: TimingHistogram = createHistogram();
+  private scriptRuns: TimingHistogram = createHistogram();
+  private playerSaveBatches: TimingHistogram = createHistogram();
   private efuns: Map<string, TimingHistogram> = new Map();
 
   private isolateAcquireWaits: number = 0;
   private isolateQueueLength: number = 0;
   private backpressureEvents: number = 0;
   private droppedMessages: number = 0;
+  private output = { messages: 0, frames: 0 };
+  private commandOutput = { commands: 0, messages: 0, frames: 0 };
 
   private slowOperations: SlowOperation[] = [];
   private startTime: number = Date.now();
@@ -169,12 +198,28 @@ class MetricsCollector {
 
   /**
    * Record a heartbeat execution time.
+   * @param rateClass Heartbeat rate class, for per-class cost tracking
    */
-  recordHeartbeat(durationMs: number, objectPath: string): void {
+  recordHeartbeat(durationMs: number, objectPath: string, rateClass?: string): void {
     recordTiming(this.heartbeats, durationMs);
+    if (rateClass !== undefined) {
+      let histogram = this.heartbeatClasses.get(rateClass);
+      if (!histogram) {
+        histogram = createHistogram();
+        this.heartbeatClasses.set(rateClass, histogram);
+      }
+      recordTiming(histogram, durationMs);
+    }
     this.maybeRecordSlow('heartbeat', objectPath, durationMs);
   }
 
+  /**
+   * Record the total duration of one heartbeat tick.
+   */
+  recordHeartbeatTick(durationMs: number): void {
+    recordTiming(this.heartbeatTicks, durationMs);
+  }
+
   /**
    * Record a callOut execution time.
    */
@@ -183,6 +228,13 @@ class MetricsCollector {
     this.maybeRecordSlow('callOut', identifier, durationMs);
   }
 
+  /**
+   * Record how late a callOut fired relative to its scheduled time.
+   */
+  recordCallOutLateness(latenessMs: number): void {
+    recordTiming(this.callOutLateness, Math.max(0, latenessMs));
+  }
+
   /**
    * Record a command execution time.
    */
@@ -191,6 +243,22 @@ class MetricsCollector {
     this.maybeRecordSlow('command', commandName, durationMs);
   }
 
+  /**
+   * Record the end-to-end latency of a sandboxed script run.
+   */
+  recordScriptRun(durationMs: number, identifier: string): void {
+    recordTiming(this.scriptRuns, durationMs);
+    this.maybeRecordSlow('script', identifier, durationMs);
+  }
+
+  /**
+   * Record the time to write one batch of player saves.
+   */
+  recordPlayerSaveBatch(durationMs: number, players: number): void {
+    recordTiming(this.playerSaveBatches, durationMs);
+    this.maybeRecordSlow('save', `${players} player(s)`, durationMs);
+  }
+
   /**
    * Record an efun execution time (only when enabled).
    */
@@ -234,6 +302,25 @@ class MetricsCollector {
     this.droppedMessages++;
   }
 
+  /**
+   * Record one output frame written to a connection.
+   * @param messages Messages coalesced into the frame
+   */
+  recordOutputFrame(messages: number): void {
+    this.output.messages += messages;
+    this.output.frames++;
+  }
+
+  /**
+   * Record the output a command sent to the player who ran it.
+   * Without coalescing every message would have been its own frame.
+   */
+  recordCommandOutput(messages: number, frames: number): void {
+    this.commandOutput.commands++;
+    this.commandOutput.messages += messages;
+    this.commandOutput.frames += frames;
+  }
+
   /**
    * Enable or disable detailed efun timing.
    */
@@ -261,15 +348,30 @@ class MetricsCollector {
       efunData[name] = { ...histogram, buckets: [...histogram.buckets] };
     }
 
+    const heartbeatClassData: Record<string, TimingHistogram> = {};
+    for (const [name, histogram] of this.heartbeatClasses) {
+      heartbeatClassData[name] = { ...histogram, buckets: [...histogram.buckets] };
+    }
+
     return {
       heartbeats: { ...this.heartbeats, buckets: [...this.heartbeats.buckets] },
+      heartbeatTicks: { ...this.heartbeatTicks, buckets: [...this.heartbeatTicks.buckets] },
+      heartbeatClasses: heartbeatClassData,
       callOuts: { ...this.callOuts, buckets: [...this.callOuts.buckets] },
+      callOutLateness: { ...this.callOutLateness, buckets: [...this.callOutLateness.buckets] },
       commands: { ...this.commands, buckets: [...this.commands.buckets] },
+      scriptRuns: { ...this.scriptRuns, buckets: [...this.scriptRuns.buckets] },
+      playerSaveBatches: {
+        ...this.playerSaveBatches,
+        buckets: [...this.playerSaveBatches.buckets],
+      },
       efuns: efunData,
       isolateAcquireWaits: this.isolateAcquireWaits,
       isolateQueueLength: this.isolateQueueLength,
       backpressureEvents: this.backpressureEvents,
       droppedMessages: this.droppedMessages,
+      output: { ...this.output },
+      commandOutput: { ...this.commandOutput },
       slowOperations: [...this.slowOperations],
       startTime: this.startTime,
       currentTime: Date.now(),
@@ -282,15 +384,44 @@ class MetricsCollector {
    */
   getFormattedMetrics(): {
     heartbeats: { avg: number; p95: number; p99: number; max: number; count: number };
+    heartbeatTicks: { avg: number; p95: number; p99: number; max: number; count: number };
+    heartbeatClasses: Record<
+      string,
+      { avg: number; p95: number; max: number; count: number; totalMs: number }
+    >;
     callOuts: { avg: number; p95: number; p99: number; max: number; count: number };
+    callOutLateness: { avg: number; p95: number; p99: number; max: number; count: number };
     commands: { avg: number; p95: number; p99: number; max: number; count: number };
+    scriptRuns: { avg: number; p95: number; p99: number; max: number; count: number };
+    playerSaveBatches: { avg: number; p95: number; p99: number; max: number; count: number };
     isolateAcquireWaits: number;
     isolateQueueLength: number;
     backpressureEvents: number;
     droppedMessages: number;
+    output: {
+      messages: number;
+      frames: number;
+      messagesPerFrame: number;
+      messagesPerCommand: number;
+      framesPerCommand: number;
+    };
     slowOperations: SlowOperation[];
     uptimeMs: number;
   } {
+    const heartbeatClasses: Record<
+      string,
+      { avg: number; p95: number; max: number; count: number; totalMs: number }
+    > = {};
+    for (const [name, histogram] of this.heartbeatClasses) {
+      heartbeatClasses[name] = {
+        avg: Math.round(average(histogram)),
+        p95: Math.round(percentile(histogram, 95)),
+        max: Math.round(histogram.max),
+        count: histogram.count,
+        totalMs: Math.round(histogram.sum),
+      };
+    }
+
     return {
       heartbeats: {
         avg: Math.round(average(this.heartbeats)),
@@ -299,6 +430,14 @@ class MetricsCollector {
         max: Math.round(this.heartbeats.max === 0 ? 0 : this.heartbeats.max),
         count: this.heartbeats.count,
       },
+      heartbeatTicks: {
+        avg: Math.round(average(this.heartbeatTicks)),
+        p95: Math.round(percentile(this.heartbeatTicks, 95)),
+        p99: Math.round(percentile(this.heartbeatTicks, 99)),
+        max: Math.round(this.heartbeatTicks.max === 0 ? 0 : this.heartbeatTicks.max),
+        count: this.heartbeatTicks.count,
+      },
+      heartbeatClasses,
       callOuts: {
         avg: Math.round(average(this.callOuts)),
         p95: Math.round(percentile(this.callOuts, 95)),
@@ -306,6 +445,13 @@ class MetricsCollector {
         max: Math.round(this.callOuts.max === 0 ? 0 : this.callOuts.max),
         count: this.callOuts.count,
       },
+      callOutLateness: {
+        avg: Math.round(average(this.callOutLateness)),
+        p95: Math.round(percentile(this.callOutLateness, 95)),
+        p99: Math.round(percentile(this.callOutLateness, 99)),
+        max: Math.round(this.callOutLateness.max === 0 ? 0 : this.callOutLateness.max),
+        count: this.callOutLateness.count,
+      },
       commands: {
         avg: Math.round(average(this.commands)),
         p95: Math.round(percentile(this.commands, 95)),
@@ -313,10 +459,31 @@ class MetricsCollector {
         max: Math.round(this.commands.max === 0 ? 0 : this.commands.max),
         count: this.commands.count,
       },
+      scriptRuns: {
+        avg: Math.round(average(this.scriptRuns)),
+        p95: Math.round(percentile(this.scriptRuns, 95)),
+        p99: Math.round(percentile(this.scriptRuns, 99)),
+        max: Math.round(this.scriptRuns.max === 0 ? 0 : this.scriptRuns.max),
+        count: this.scriptRuns.count,
+      },
+      playerSaveBatches: {
+        avg: Math.round(average(this.playerSaveBatches)),
+        p95: Math.round(percentile(this.playerSaveBatches, 95)),
+        p99: Math.round(percentile(this.playerSaveBatches, 99)),
+        max: Math.round(this.playerSaveBatches.max === 0 ? 0 : this.playerSaveBatches.max),
+        count: this.playerSaveBatches.count,
+      },
       isolateAcquireWaits: this.isolateAcquireWaits,
       isolateQueueLength: this.isolateQueueLength,
       backpressureEvents: this.backpressureEvents,
       droppedMessages: this.droppedMessages,
+      output: {
+        messages: this.output.messages,
+        frames: this.output.frames,
+        messagesPerFrame: ratio(this.output.messages, this.output.frames),
+        messagesPerCommand: ratio(this.commandOutput.messages, this.commandOutput.commands),
+        framesPerCommand: ratio(this.commandOutput.frames, this.commandOutput.commands),
+      },
       slowOperations: this.slowOperations.slice(-20), // Last 20
       uptimeMs: Date.now() - this.startTime,
     };
@@ -327,13 +494,20 @@ class MetricsCollector {
    */
   clear(): void {
     this.heartbeats = createHistogram();
+    this.heartbeatTicks = createHistogram();
+    this.heartbeatClasses.clear();
     this.callOuts = createHistogram();
+    this.callOutLateness = createHistogram();
     this.commands = createHistogram();
+    this.scriptRuns = createHistogram();
+    this.playerSaveBatches = createHistogram();
     this.efuns.clear();
     this.isolateAcquireWaits = 0;
     this.isolateQueueLength = 0;
     this.backpressureEvents = 0;
     this.droppedMessages = 0;
+    this.output = { messages: 0, frames: 0 };
+    this.commandOutput = { commands: 0, messages: 0, frames: 0 };
     this.slowOperations = [];
     this.startTime = Date.now();
   }
@@ -0,0 +1,361 @@
+/**
+ * ModuleReloader - Evaluates new versions of mudlib modules for hot reload.
+ *
+ * Re-importing a changed file under a cache-busting URL (`room.ts?update=1`)
+ * creates a new ESM module record, and Node never evicts module records, so
+ * every reload used to leak the previous version for the life of the process.
+ *
+ * Instead, a reload transpiles the file to CommonJS (through the compile
+ * cache) and evaluates it with vm.compileFunction in the main context. Its
+ * static imports resolve to the modules already in Node's ESM cache - the
+ * same ones a cache-busted import would have bound to - so classes keep
+ * extending the same base classes. Only the returned exports reference the
+ * new version, so a superseded version is garbage collected once no
+ * blueprint, clone or command uses it. Live versions are counted with a
+ * FinalizationRegistry.
+ *
+ * A cascading reload (HotReload.reloadWithDependents) adopts the versions it
+ * evaluated as current and marks the remaining dependents stale. Later
+ * reloads bind to current versions instead of the ESM cache, and a stale
+ * file is evaluated again the first time it is loaded or imported.
+ *
+ * CommonJS has no top-level await; such modules fall back to a cache-busted
+ * import, which is counted as pinned.
+ */
+
+import { readFile } from 'fs/promises';
+import { dirname, resolve } from 'path';
+import { fileURLToPath, pathToFileURL } from 'url';
+import { compileFunction, constants as vmConstants } from 'vm';
+import type { TransformOptions } from 'esbuild';
+import { getCompileCache, mudlibTransformOptions } from './compile-cache.js';
+import { getLogger } from './logger.js';
+
+export interface ModuleVersionStats {
+  /** Module versions evaluated by the reloader */
+  loaded: number;
+  /** Versions still reachable */
+  live: number;
+  /** Versions garbage collected */
+  collected: number;
+  /** Reloads that fell back to a cache-busted import and can never be freed */
+  pinned: number;
+  /** Files with more than one live version (old clones or commands still in use) */
+  filesWithOldVersions: number;
+}
+
+/**
+ * One evaluated version of a file. Collected once every exported value
+ * registered for it has been collected.
+ */
+interface ModuleVersion {
+  path: string;
+  remaining: number;
+}
+
+/**
+ * A transpiled module, ready to evaluate.
+ */
+export interface CompiledModule {
+  /** Absolute path to the .ts file */
+  filePath: string;
+  /** CommonJS code, or null when the module needs a cache-busted import */
+  code: string | null;
+}
+
+/** Replacement exports for dependencies, keyed by absolute .ts path */
+export type ModuleOverrides = ReadonlyMap<string, Record<string, unknown>>;
+
+/** Parameters of the CommonJS module wrapper */
+const WRAPPER_PARAMS = ['exports', 'require', 'module', '__filename', '__dirname'];
+
+/** Static imports in esbuild's CommonJS output */
+const REQUIRE_PATTERN = /\brequire\(("(?:[^"\\]|\\.)*")\)/g;
+
+/** Dynamic import() left in the output */
+const DYNAMIC_IMPORT_PATTERN = /\bimport\s*\(/;
+
+/**
+ * Loads fresh, collectable versions of mudlib modules.
+ */
+export class ModuleReloader {
+  private transformOptions: TransformOptions;
+  /** Absolute path -> live versions */
+  private liveVersions: Map<string, number> = new Map();
+  /** Absolute path -> version that replaced the one in Node's ESM cache */
+  private current: Map<string, Record<string, unknown>> = new Map();
+  /** Files whose ESM cache version is out of date but which have no current version yet */
+  private stale: Set<string> = new Set();
+  /** Stale files being evaluated, so concurrent importers share one version */
+  private refreshing: Map<string, Promise<Record<string, unknown>>> = new Map();
+  private stats = { loaded: 0, collected: 0, pinned: 0 };
+  private finalizer = new FinalizationRegistry<ModuleVersion>((version) => {
+    version.remaining--;
+    if (version.remaining === 0) this.onCollected(version.path);
+  });
+
+  constructor(mudlibPath: string = './mudlib') {
+    this.transformOptions = {
+      ...mudlibTransformOptions(mudlibPath),
+      format: 'cjs',
+      sourcemap: 'inline',
+    };
+  }
+
+  /**
+   * Evaluate the current contents of a module file.
+   * @param filePath Path to the .ts file
+   * @param overrides Exports to use for these dependencies instead of the cached ones
+   * @returns The module's exports
+   */
+  async load(filePath: string, overrides?: ModuleOverrides): Promise<Record<string, unknown>> {
+    return this.evaluate(await this.compile(filePath), overrides);
+  }
+
+  /**
+   * Transpile a module file (through the compile cache) without running it.
+   */
+  async compile(filePath: string): Promise<CompiledModule> {
+    const absolutePath = resolve(filePath);
+    const source = await readFile(absolutePath, 'utf-8');
+    try {
+      const result = await getCompileCache().transform(source, absolutePath, this.transformOptions);
+      return { filePath: absolutePath, code: result.code };
+    } catch (error) {
+      if (!isTopLevelAwaitError(error)) throw error;
+      return { filePath: absolutePath, code: null };
+    }
+  }
+
+  /**
+   * Run a compiled module and return its exports. Dependencies resolve to
+   * the overrides, then to current versions, then to Node's ESM cache.
+   */
+  async evaluate(
+    compiled: CompiledModule,
+    overrides?: ModuleOverrides,
+    chain: ReadonlySet<string> = new Set()
+  ): Promise<Record<string, unknown>> {
+    const { filePath, code } = compiled;
+    const fileUrl = pathToFileURL(filePath).href;
+
+    if (code === null) {
+      this.stats.pinned++;
+      getLogger().warn(
+        { filePath },
+        'Module uses top-level await; reloading it with an import that is never freed'
+      );
+      return import(`${fileUrl}?update=${Date.now()}`) as Promise<Record<string, unknown>>;
+    }
+
+    const dependencies = await this.importDependencies(
+      code,
+      fileUrl,
+      overrides,
+      new Set([...chain, filePath])
+    );
+    const run = compileFunction(code, WRAPPER_PARAMS, {
+      filename: filePath,
+      // Only when needed: the main-context loader option is still experimental
+      ...(DYNAMIC_IMPORT_PATTERN.test(code)
+        ? { importModuleDynamically: vmConstants.USE_MAIN_CONTEXT_DEFAULT_LOADER }
+        : {}),
+    });
+
+    const module = { exports: {} as Record<string, unknown> };
+    const requireDependency = (specifier: string): unknown => {
+      const dependency = dependencies.get(specifier);
+      if (!dependency) {
+        throw new Error(`Cannot find module '${specifier}' imported from ${filePath}`);
+      }
+      if (dependency.error) throw dependency.error;
+      return dependency.exports;
+    };
+    run(module.exports, requireDependency, module, filePath, dirname(filePath));
+
+    this.track(filePath, module.exports);
+    return module.exports;
+  }
+
+  /**
+   * The newest version of a file when Node's ESM cache no longer has it:
+   * the current version, or a fresh one if the file is stale.
+   * @returns undefined when the ESM cache version is up to date
+   */
+  async latest(filePath: string): Promise<Record<string, unknown> | undefined> {
+    const absolutePath = resolve(filePath);
+    const current = this.current.get(absolutePath);
+    if (current) return current;
+    return this.stale.has(absolutePath)
+      ? this.refresh(absolutePath, undefined, new Set())
+      : undefined;
+  }
+
+  /**
+   * Make a version the one that importers of the file bind to.
+   */
+  adopt(filePath: string, exports: Record<string, unknown>): void {
+    const absolutePath = resolve(filePath);
+    this.current.set(absolutePath, exports);
+    this.stale.delete(absolutePath);
+  }
+
+  /**
+   * Mark files as out of date. They are evaluated again the next time they
+   * are loaded or imported by a reloaded module.
+   */
+  invalidate(filePaths: Iterable<string>): void {
+    for (const filePath of filePaths) {
+      const absolutePath = resolve(filePath);
+      this.current.delete(absolutePath);
+      this.stale.add(absolutePath);
+    }
+  }
+
+  /**
+   * Get module version statistics.
+   */
+  getStats(): ModuleVersionStats {
+    let live = 0;
+    let filesWithOldVersions = 0;
+    for (const count of this.liveVersions.values()) {
+      live += count;
+      if (count > 1) filesWithOldVersions++;
+    }
+    return { ...this.stats, live, filesWithOldVersions };
+  }
+
+  /**
+   * Evaluate and adopt a stale file.
+   */
+  private refresh(
+    filePath: string,
+    overrides: ModuleOverrides | undefined,
+    chain: ReadonlySet<string>
+  ): Promise<Record<string, unknown>> {
+    let pending = this.refreshing.get(filePath);
+    if (!pending) {
+      pending = this.compile(filePath)
+        .then((compiled) => this.evaluate(compiled, overrides, chain))
+        .then((exports) => {
+          this.adopt(filePath, exports);
+          return exports;
+        })
+        .finally(() => this.refreshing.delete(filePath));
+      this.refreshing.set(filePath, pending);
+    }
+    return pending;
+  }
+
+  /**
+   * Import every module the code requires, from the ESM cache where loaded.
+   * Failures are kept and thrown only if the module is actually required.
+   */
+  private async importDependencies(
+    code: string,
+    fileUrl: string,
+    overrides: ModuleOverrides | undefined,
+    chain: ReadonlySet<string>
+  ): Promise<Map<string, { exports?: unknown; error?: unknown }>> {
+    const specifiers = new Set<string>();
+    for (const match of code.matchAll(REQUIRE_PATTERN)) {
+      specifiers.add(JSON.parse(match[1]!) as string);
+    }
+
+    const dependencies = new Map<string, { exports?: unknown; error?: unknown }>();
+    await Promise.all(
+      [...specifiers].map(async (specifier) => {
+        const target =
+          specifier.startsWith('.') || specifier.startsWith('/')
+            ? new URL(specifier, fileUrl).href
+            : specifier;
+        const file = target.startsWith('file:')
+          ? fileURLToPath(target).replace(/\.js$/, '.ts')
+          : null;
+        try {
+          const replacement = file ? (overrides?.get(file) ?? this.current.get(file)) : undefined;
+          if (replacement) {
+            dependencies.set(specifier, { exports: replacement });
+          } else if (file && this.stale.has(file) && !chain.has(file)) {
+            // Circular imports of a stale file keep the ESM cache version
+            dependencies.set(specifier, { exports: await this.refresh(file, overrides, chain) });
+          } else {
+            const namespace = (await import(target)) as Record<string, unknown>;
+            dependencies.set(specifier, { exports: toCommonJs(namespace) });
+          }
+        } catch (error) {
+          dependencies.set(specifier, { error });
+        }
+      })
+    );
+    return dependencies;
+  }
+
+  /**
+   * Count a version as live until its exported values are collected.
+   * Classes and functions are what blueprints, clones and commands keep.
+   */
+  private track(path: string, exports: Record<string, unknown>): void {
+    const targets = Object.values(exports).filter(
+      (value): value is object =>
+        typeof value === 'function' || (typeof value === 'object' && value !== null)
+    );
+    if (targets.length === 0) targets.push(exports);
+
+    const version: ModuleVersion = { path, remaining: targets.length };
+    for (const target of targets) {
+      this.finalizer.register(target, version);
+    }
+    this.stats.loaded++;
+    this.liveVersions.set(path, (this.liveVersions.get(path) ?? 0) + 1);
+  }
+
+  private onCollected(path: string): void {
+    this.stats.collected++;
+    const count = (this.liveVersions.get(path) ?? 1) - 1;
+    if (count > 0) {
+      this.liveVersions.set(path, count);
+    } else {
+      this.liveVersions.delete(path);
+    }
+  }
+}
+
+/**
+ * Present an ES module namespace the way esbuild's CommonJS interop expects
+ * (flagged __esModule, so default imports read the default export).
+ * Getters keep live bindings.
+ */
+function toCommonJs(namespace: Record<string, unknown>): Record<string, unknown> {
+  const exports: Record<string, unknown> = {};
+  Object.defineProperty(exports, '__esModule', { value: true });
+  for (const key of Object.keys(namespace)) {
+    Object.defineProperty(exports, key, { enumerable: true, get: () => namespace[key] });
+  }
+  return exports;
+}
+
+function isTopLevelAwaitError(error: unknown): boolean {
+  const errors = (error as { errors?: Array<{ text?: string }> } | null)?.errors;
+  return Array.isArray(errors) && errors.some((e) => /top-level await/i.test(e.text ?? ''));
+}
+
+// Singleton instance
+let reloaderInstance: ModuleReloader | null = null;
+
+/**
+ * Get the global ModuleReloader instance.
+ */
+export function getModuleReloader(mudlibPath?: string): ModuleReloader {
+  if (!reloaderInstance) {
+    reloaderInstance = new ModuleReloader(mudlibPath);
+  }
+  return reloaderInstance;
+}
+
+/**
+ * Reset the global reloader. Used for testing.
+ */
+export function resetModuleReloader(): void {
+  reloaderInstance = null;
+}
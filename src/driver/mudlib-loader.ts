@@ -9,9 +9,9 @@ import { resolve } from 'path';
 import { pathToFileURL } from 'url';
 import type { MudObject, MudObjectConstructor } from './types.js';
 import { getRegistry, type ObjectRegistry } from './object-registry.js';
-import { getLogger } from './logger.js';
-
-const logger = getLogger();
+import { getIdleReclaimer } from './idle-reclaimer.js';
+import { PreloadEngine, type PreloadOptions, type PreloadReport } from './preload-engine.js';
+import { getModuleReloader, resetModuleReloader, type ModuleReloader } from './module-reloader.js';
 
 export interface MudlibLoaderConfig {
   mudlibPath: string;
@@ -26,6 +26,9 @@ export class MudlibLoader {
   private registry: ObjectRegistry;
   private efunsProvider: (() => Record<string, unknown>) | null;
   private loadedModules: Map<string, unknown> = new Map();
+  /** Blueprint loads in progress, so concurrent callers share one instance */
+  private loading: Map<string, Promise<MudObject>> = new Map();
+  private reloader: ModuleReloader;
 
   constructor(config: Partial<MudlibLoaderConfig> = {}) {
     this.config = {
@@ -34,6 +37,7 @@ export class MudlibLoader {
     };
     this.registry = getRegistry();
     this.efunsProvider = this.config.efunsProvider ?? null;
+    this.reloader = getModuleReloader(this.config.mudlibPath);
 
     // Set up global efuns for mudlib code
     this.setupGlobalEfuns();
@@ -59,13 +63,19 @@ export class MudlibLoader {
    * Resolve a mudlib path to a file URL.
    */
   private resolvePath(mudlibPath: string): string {
+    return pathToFileURL(this.resolveFile(mudlibPath)).href;
+  }
+
+  /**
+   * Resolve a mudlib path to an absolute file path.
+   */
+  private resolveFile(mudlibPath: string): string {
     // Handle paths like "/master" or "/std/object"
     const relativePath = mudlibPath.startsWith('/')
       ? mudlibPath.slice(1)
       : mudlibPath;
 
-    const fullPath = resolve(this.config.mudlibPath, relativePath + '.ts');
-    return pathToFileURL(fullPath).href;
+    return resolve(this.config.mudlibPath, relativePath + '.ts');
   }
 
   /**
@@ -77,14 +87,17 @@ export class MudlibLoader {
       return this.loadedModules.get(mudlibPath) as Record<string, unknown>;
     }
 
-    const fileUrl = this.resolvePath(mudlibPath);
-
+    const file = this.resolveFile(mudlibPath);
     try {
-      // Dynamic import of the TypeScript file (tsx handles transpilation)
-      const module = await import(fileUrl);
+      // Dynamic import of the TypeScript file (tsx handles transpilation),
+      // unless a reload replaced the version in Node's ESM cache
+      const module =
+        (await this.reloader.latest(file)) ?? (await import(this.resolvePath(mudlibPath)));
       this.loadedModules.set(mudlibPath, module);
       return module;
     } catch (error) {
+      // Node caches the failed import too; retry from the current file
+      this.reloader.invalidate([file]);
       throw new Error(
         `Failed to load mudlib module ${mudlibPath}: ${error instanceof Error ? error.message : String(error)}`
       );
@@ -103,9 +116,52 @@ export class MudlibLoader {
       return existing as T;
     }
 
+    // Join a load already in progress (e.g. during concurrent preload)
+    const inFlight = this.loading.get(mudlibPath);
+    if (inFlight) {
+      return inFlight as Promise<T>;
+    }
+
+    const promise = this.instantiate<T>(mudlibPath);
+    this.loading.set(mudlibPath, promise);
+    try {
+      return await promise;
+    } finally {
+      this.loading.delete(mudlibPath);
+    }
+  }
+
+  /**
+   * Instantiate, register and create a blueprint.
+   */
+  private async instantiate<T extends MudObject>(mudlibPath: string): Promise<T> {
     // Load the module
     const module = await this.loadModule(mudlibPath);
+    const { ObjectClass, instance } = this.createBlueprint<T>(mudlibPath, module);
 
+    // Register as blueprint
+    this.registry.registerBlueprint(mudlibPath, ObjectClass, instance);
+
+    // Call onCreate lifecycle hook if it exists
+    if (typeof instance.onCreate === 'function') {
+      await instance.onCreate();
+    }
+
+    // Restore state saved when the object was last unloaded as idle
+    await getIdleReclaimer()?.onLoaded(instance);
+
+    return instance;
+  }
+
+  /**
+   * Instantiate a module's class as the blueprint for a path, without
+   * registering it.
+   * @throws If the module exports no class
+   */
+  createBlueprint<T extends MudObject>(
+    mudlibPath: string,
+    module: Record<string, unknown>
+  ): { ObjectClass: MudObjectConstructor; instance: T } {
     // Find the default export or the main class
     let ObjectClass: MudObjectConstructor | undefined;
 
@@ -141,15 +197,16 @@ export class MudlibLoader {
       (instance as unknown as { _objectId: string })._objectId = mudlibPath;
     }
 
-    // Register as blueprint
-    this.registry.registerBlueprint(mudlibPath, ObjectClass, instance);
-
-    // Call onCreate lifecycle hook if it exists
-    if (typeof instance.onCreate === 'function') {
-      await instance.onCreate();
-    }
+    return { ObjectClass, instance };
+  }
 
-    return instance;
+  /**
+   * Make a reloaded module version the one this loader, and modules
+   * reloaded later, use instead of Node's ESM cache version.
+   */
+  adoptModule(mudlibPath: string, module: Record<string, unknown>): void {
+    this.reloader.adopt(this.resolveFile(mudlibPath), module);
+    this.loadedModules.set(mudlibPath, module);
   }
 
   /**
@@ -183,62 +240,35 @@ export class MudlibLoader {
       // Clear the module from our cache
       this.loadedModules.delete(mudlibPath);
 
-      // Bust the Node module cache by using a unique query param
-      const fileUrl = this.resolvePath(mudlibPath);
-      const cacheBustUrl = `${fileUrl}?update=${Date.now()}`;
-
-      // Dynamic import with cache busting
-      const module = await import(cacheBustUrl);
-
-      // Find the class to instantiate
-      let ObjectClass: MudObjectConstructor | undefined;
-
-      if (module.default && typeof module.default === 'function') {
-        ObjectClass = module.default as MudObjectConstructor;
-      } else {
-        for (const key of Object.keys(module)) {
-          const value = module[key];
-          if (typeof value === 'function' && value.prototype) {
-            ObjectClass = value as MudObjectConstructor;
-            break;
-          }
-        }
-      }
+      // Evaluate the current file as a new, collectable module version
+      const module = await this.reloader.load(this.resolveFile(mudlibPath));
 
-      if (!ObjectClass) {
+      // Find the class and create the new instance
+      let ObjectClass: MudObjectConstructor;
+      let instance: MudObject;
+      try {
+        ({ ObjectClass, instance } = this.createBlueprint(mudlibPath, module));
+      } catch (error) {
         return {
           success: false,
-          error: `No class found in mudlib module: ${mudlibPath}`,
+          error: error instanceof Error ? error.message : String(error),
           existingClones: 0,
           migratedObjects: 0,
         };
       }
 
-      // Create new instance
-      const instance = new ObjectClass() as MudObject;
-
-      // Set up object path
-      const instanceWithPath = instance as MudObject & {
-        _setupAsBlueprint?: (objectPath: string) => void;
-      };
-      if (instanceWithPath._setupAsBlueprint) {
-        instanceWithPath._setupAsBlueprint(mudlibPath);
-      } else {
-        (instance as unknown as { _objectPath: string })._objectPath = mudlibPath;
-        (instance as unknown as { _objectId: string })._objectId = mudlibPath;
-      }
-
       // Update (or register) the blueprint - this also migrates objects from old to new instance
       const updateResult = await this.registry.updateBlueprint(mudlibPath, ObjectClass, instance);
 
+      // Store in our cache (so subsequent calls use this version until next reload).
+      // Importers keep binding to the original, so instanceof checks still match.
+      this.loadedModules.set(mudlibPath, module);
+
       // Call onCreate lifecycle hook
       if (typeof instance.onCreate === 'function') {
         await instance.onCreate();
       }
 
-      // Store in our cache (so subsequent calls use this version until next reload)
-      this.loadedModules.set(mudlibPath, module);
-
       return {
         success: true,
         existingClones: updateResult.existingClones,
@@ -255,16 +285,14 @@ export class MudlibLoader {
   }
 
   /**
-   * Preload a list of mudlib objects.
+   * Preload a list of mudlib objects. Independent objects load concurrently;
+   * an object waits for the preloaded objects it imports. Failures are
+   * logged and reported rather than thrown.
+   * @returns Startup timeline for the preload
    */
-  async preload(paths: string[]): Promise<void> {
-    for (const path of paths) {
-      try {
-        await this.loadObject(path);
-      } catch (error) {
-        logger.error({ error, path }, 'Failed to preload');
-      }
-    }
+  async preload(paths: string[], options: Partial<PreloadOptions> = {}): Promise<PreloadReport> {
+    const engine = new PreloadEngine(this, this.config.mudlibPath, options);
+    return engine.run(paths);
   }
 
   /**
@@ -303,4 +331,5 @@ export function resetMudlibLoader(): void {
     loaderInstance.clearCache();
   }
   loaderInstance = null;
+  resetModuleReloader();
 }
@@ -2,12 +2,73 @@
  * ObjectRegistry - Central registry for all MUD objects.
  *
  * Manages object storage, lookup, cloning, and lifecycle.
+ *
+ * Besides the id map, the registry keeps secondary indexes so daemons never
+ * need to scan every object: clones per blueprint, objects per category
+ * (built-in categories such as 'room' and 'player', plus tags added by the
+ * mudlib), objects without an environment, and counts per type.
  */
 
 import type { MudObject, BlueprintInfo, MudObjectConstructor } from './types.js';
 import { getScheduler } from './scheduler.js';
 import { getShadowRegistry } from './shadow-registry.js';
 
+/**
+ * Inventory hooks that both BaseMudObject and the mudlib MudObject provide
+ * for moving contents without running movement hooks.
+ */
+type InventoryContainer = MudObject & {
+  _addToInventory(object: MudObject): void;
+  _removeFromInventory(object: MudObject): void;
+};
+
+/**
+ * Whether an object provides the inventory hooks.
+ */
+function hasInventoryHooks(obj: MudObject): obj is InventoryContainer {
+  const container = obj as Partial<InventoryContainer>;
+  return (
+    typeof container._addToInventory === 'function' &&
+    typeof container._removeFromInventory === 'function'
+  );
+}
+
+/**
+ * Called when an object joins (added true) or leaves a category or tag.
+ */
+export type CategoryListener = (object: MudObject, added: boolean) => void;
+
+/**
+ * Whether an object is a room (rooms resolve exits; nothing else does).
+ */
+export function isRoom(obj: MudObject): boolean {
+  return typeof (obj as { resolveExit?: unknown }).resolveExit === 'function';
+}
+
+/**
+ * Work out the built-in categories an object belongs to when registered.
+ * - room: resolves exits
+ * - player, npc, living, corpse, vehicle: flagged with isPlayer, isNPC,
+ *   isLiving, isCorpse or isVehicle
+ */
+export function builtInCategories(obj: MudObject): string[] {
+  const flags = obj as MudObject & {
+    isPlayer?: boolean;
+    isNPC?: boolean;
+    isLiving?: boolean;
+    isCorpse?: boolean;
+    isVehicle?: boolean;
+  };
+  const categories: string[] = [];
+  if (isRoom(obj)) categories.push('room');
+  if (flags.isPlayer === true) categories.push('player');
+  if (flags.isNPC === true) categories.push('npc');
+  if (flags.isLiving === true) categories.push('living');
+  if (flags.isCorpse === true) categories.push('corpse');
+  if (flags.isVehicle === true) categories.push('vehicle');
+  return categories;
+}
+
 /**
  * Central registry for all MUD objects in the driver.
  */
@@ -18,6 +79,21 @@ export class ObjectRegistry {
   /** Map of blueprint path to blueprint info */
   private blueprints: Map<string, BlueprintInfo> = new Map();
 
+  /** Category or tag -> objects in it, in registration order */
+  private categories: Map<string, Set<MudObject>> = new Map();
+
+  /** Object -> categories it is filed under */
+  private categoriesOf: Map<MudObject, Set<string>> = new Map();
+
+  /** Category or tag -> listeners told when its members change */
+  private categoryListeners: Map<string, Set<CategoryListener>> = new Map();
+
+  /** Registered objects with no environment */
+  private roots: Set<MudObject> = new Set();
+
+  /** Constructor name -> number of registered objects */
+  private typeCounts: Map<string, number> = new Map();
+
   /**
    * Register a blueprint (non-clone) object.
    * @param path The object path (e.g., "/std/sword")
@@ -43,6 +119,7 @@ export class ObjectRegistry {
 
     this.blueprints.set(path, info);
     this.objects.set(path, instance);
+    this.addToIndexes(instance);
   }
 
   /**
@@ -55,6 +132,7 @@ export class ObjectRegistry {
       throw new Error(`Object already registered: ${object.objectId}`);
     }
     this.objects.set(object.objectId, object);
+    this.addToIndexes(object);
 
     // Track clone in blueprint info
     if (object.isClone && object.blueprint) {
@@ -160,7 +238,11 @@ export class ObjectRegistry {
     }
 
     // Remove from registry
-    this.objects.delete(object.objectId);
+    const registered = this.objects.get(object.objectId);
+    if (registered) {
+      this.objects.delete(object.objectId);
+      this.removeFromIndexes(registered);
+    }
 
     // Remove from blueprint's clone tracking
     if (object.isClone && object.blueprint) {
@@ -211,35 +293,46 @@ export class ObjectRegistry {
     constructor: MudObjectConstructor,
     instance: MudObject
   ): Promise<{ existingClones: number; migratedObjects: number }> {
+    return this.swapBlueprint(path, constructor, instance);
+  }
+
+  /**
+   * Synchronous form of updateBlueprint, so a batch of blueprints can be
+   * swapped within one event-loop turn. Throws before changing anything if
+   * the contents can't be moved; once it starts, it can't fail.
+   */
+  swapBlueprint(
+    path: string,
+    constructor: MudObjectConstructor,
+    instance: MudObject
+  ): { existingClones: number; migratedObjects: number } {
     const existing = this.blueprints.get(path);
 
     if (existing) {
       const oldInstance = existing.instance;
 
-      // Migrate all objects from old instance to new instance (live reload)
-      const objectsToMigrate = [...oldInstance.inventory];
+      // Migrate all objects from old instance to new instance (live reload).
+      // The containers' own hooks keep their inventory indexes in step and
+      // skip the exit/enter hooks moveTo() would run.
+      const from = oldInstance as InventoryContainer;
+      const to = instance as InventoryContainer;
+      const shadows = getShadowRegistry();
+      const objectsToMigrate = oldInstance.inventory.map((obj) => shadows.getOriginal(obj));
+      if (objectsToMigrate.length > 0 && !(hasInventoryHooks(from) && hasInventoryHooks(to))) {
+        throw new Error(`Cannot move the contents of ${path} onto its new instance`);
+      }
       let migratedCount = 0;
 
       for (const obj of objectsToMigrate) {
-        // Directly update the object's environment reference
-        // This avoids triggering exit/enter hooks during reload
-        const objWithEnv = obj as MudObject & { _environment?: MudObject | null };
-
-        // Remove from old instance's inventory
-        const oldInv = oldInstance.inventory as MudObject[];
-        const idx = oldInv.indexOf(obj);
-        if (idx >= 0) {
-          oldInv.splice(idx, 1);
-        }
-
-        // Add to new instance's inventory
-        objWithEnv._environment = instance;
-        (instance.inventory as MudObject[]).push(obj);
+        from._removeFromInventory(obj);
+        (obj as MudObject & { _environment: MudObject | null })._environment = instance;
+        to._addToInventory(obj);
         migratedCount++;
       }
 
       // Remove old blueprint instance from objects map
       this.objects.delete(path);
+      this.removeFromIndexes(oldInstance);
 
       // Update the blueprint info with new constructor and instance
       // but preserve the clone tracking
@@ -248,6 +341,7 @@ export class ObjectRegistry {
 
       // Register new instance
       this.objects.set(path, instance);
+      this.addToIndexes(instance);
 
       return { existingClones: existing.clones.size, migratedObjects: migratedCount };
     } else {
@@ -257,6 +351,37 @@ export class ObjectRegistry {
     }
   }
 
+  /**
+   * Move a blueprint's existing clones onto a new constructor's prototype,
+   * so they pass instanceof checks against reloaded classes. Their own
+   * state is kept. Clones whose prototype was already changed (e.g. by an
+   * earlier reload) are left alone, as are frozen clones. Never throws.
+   * @param path The blueprint path
+   * @param from The constructor the clones were created with
+   * @param to The new constructor
+   * @returns Number of clones moved
+   */
+  rebaseClones(path: string, from: MudObjectConstructor, to: MudObjectConstructor): number {
+    const blueprintInfo = this.blueprints.get(path);
+    if (!blueprintInfo || from === to) {
+      return 0;
+    }
+
+    let rebased = 0;
+    for (const cloneId of blueprintInfo.clones) {
+      const clone = this.objects.get(cloneId);
+      // Reflect.setPrototypeOf reports non-extensible objects instead of throwing
+      if (
+        clone &&
+        Object.getPrototypeOf(clone) === from.prototype &&
+        Reflect.setPrototypeOf(clone, to.prototype)
+      ) {
+        rebased++;
+      }
+    }
+    return rebased;
+  }
+
   /**
    * Get all registered objects.
    */
@@ -264,6 +389,127 @@ export class ObjectRegistry {
     return this.objects.values();
   }
 
+  /**
+   * Get the objects in a category or tag, in registration order.
+   * @param category A built-in category (see builtInCategories) or a tag
+   */
+  getByCategory(category: string): IterableIterator<MudObject> {
+    return (this.categories.get(category) ?? new Set<MudObject>()).values();
+  }
+
+  /**
+   * Listen for objects joining or leaving a category or tag, so a daemon can
+   * keep its own view of the category up to date without rescanning it.
+   * Blueprint reloads report the old instance leaving and the new one joining.
+   * @param category A built-in category or a tag
+   * @param listener Called with the object and whether it joined
+   * @returns A function that removes the listener
+   */
+  onCategoryChange(category: string, listener: CategoryListener): () => void {
+    let listeners = this.categoryListeners.get(category);
+    if (!listeners) {
+      listeners = new Set();
+      this.categoryListeners.set(category, listeners);
+    }
+    listeners.add(listener);
+    return () => {
+      listeners.delete(listener);
+      if (listeners.size === 0 && this.categoryListeners.get(category) === listeners) {
+        this.categoryListeners.delete(category);
+      }
+    };
+  }
+
+  /**
+   * Count the objects in a category or tag.
+   * @param category A built-in category or a tag
+   */
+  countByCategory(category: string): number {
+    return this.categories.get(category)?.size ?? 0;
+  }
+
+  /**
+   * Get the number of objects in every non-empty category and tag.
+   */
+  getCategoryCounts(): Record<string, number> {
+    const counts: Record<string, number> = {};
+    for (const [category, members] of this.categories) {
+      counts[category] = members.size;
+    }
+    return counts;
+  }
+
+  /**
+   * File a registered object under a tag (e.g. 'shop', 'quest-giver').
+   * @param object The object to tag
+   * @param tag The tag name
+   * @returns false if the object is not registered
+   */
+  addTag(object: MudObject, tag: string): boolean {
+    const registered = this.objects.get(object.objectId);
+    if (!registered) return false;
+    this.fileUnder(registered, tag);
+    return true;
+  }
+
+  /**
+   * Remove a tag from a registered object.
+   * @param object The tagged object
+   * @param tag The tag name
+   * @returns true if the object had the tag
+   */
+  removeTag(object: MudObject, tag: string): boolean {
+    const registered = this.objects.get(object.objectId);
+    if (!registered || !this.categoriesOf.get(registered)?.has(tag)) return false;
+    this.unfileFrom(registered, tag);
+    return true;
+  }
+
+  /**
+   * Get the live clones of a blueprint.
+   * @param path The blueprint path
+   */
+  getClones(path: string): MudObject[] {
+    const info = this.blueprints.get(path);
+    if (!info) return [];
+    const clones: MudObject[] = [];
+    for (const cloneId of info.clones) {
+      const clone = this.objects.get(cloneId);
+      if (clone) clones.push(clone);
+    }
+    return clones;
+  }
+
+  /**
+   * Get registered objects with no environment: rooms, daemons, and
+   * anything that was moved out of the world without being destroyed.
+   */
+  getRootObjects(): IterableIterator<MudObject> {
+    return this.roots.values();
+  }
+
+  /**
+   * Get count of registered objects with no environment.
+   */
+  get rootCount(): number {
+    return this.roots.size;
+  }
+
+  /**
+   * Update the environment index after an object moved. Objects call this
+   * when they enter the world from nowhere or leave it for nowhere.
+   * @param object The object that moved
+   */
+  updateEnvironment(object: MudObject): void {
+    const registered = this.objects.get(object.objectId);
+    if (!registered) return;
+    if (registered.environment) {
+      this.roots.delete(registered);
+    } else {
+      this.roots.add(registered);
+    }
+  }
+
   /**
    * Get all registered blueprints.
    */
@@ -291,6 +537,78 @@ export class ObjectRegistry {
   clear(): void {
     this.objects.clear();
     this.blueprints.clear();
+    this.categories.clear();
+    this.categoriesOf.clear();
+    this.roots.clear();
+    this.typeCounts.clear();
+  }
+
+  /**
+   * Add a newly registered object to the secondary indexes.
+   */
+  private addToIndexes(object: MudObject): void {
+    for (const category of builtInCategories(object)) {
+      this.fileUnder(object, category);
+    }
+    if (!object.environment) this.roots.add(object);
+    const typeName = object.constructor.name;
+    this.typeCounts.set(typeName, (this.typeCounts.get(typeName) ?? 0) + 1);
+  }
+
+  /**
+   * Remove an object leaving the registry from the secondary indexes.
+   */
+  private removeFromIndexes(object: MudObject): void {
+    for (const category of this.categoriesOf.get(object) ?? []) {
+      const members = this.categories.get(category);
+      members?.delete(object);
+      if (members?.size === 0) this.categories.delete(category);
+      this.notifyCategory(category, object, false);
+    }
+    this.categoriesOf.delete(object);
+    this.roots.delete(object);
+    const typeName = object.constructor.name;
+    const count = (this.typeCounts.get(typeName) ?? 0) - 1;
+    if (count > 0) {
+      this.typeCounts.set(typeName, count);
+    } else {
+      this.typeCounts.delete(typeName);
+    }
+  }
+
+  private fileUnder(object: MudObject, category: string): void {
+    let members = this.categories.get(category);
+    if (!members) {
+      members = new Set();
+      this.categories.set(category, members);
+    }
+    if (members.has(object)) return;
+    members.add(object);
+    let filed = this.categoriesOf.get(object);
+    if (!filed) {
+      filed = new Set();
+      this.categoriesOf.set(object, filed);
+    }
+    filed.add(category);
+    this.notifyCategory(category, object, true);
+  }
+
+  private unfileFrom(object: MudObject, category: string): void {
+    const members = this.categories.get(category);
+    members?.delete(object);
+    if (members?.size === 0) this.categories.delete(category);
+    const filed = this.categoriesOf.get(object);
+    filed?.delete(category);
+    if (filed?.size === 0) this.categoriesOf.delete(object);
+    this.notifyCategory(category, object, false);
+  }
+
+  private notifyCategory(category: string, object: MudObject, added: boolean): void {
+    const listeners = this.categoryListeners.get(category);
+    if (!listeners) return;
+    for (const listener of Array.from(listeners)) {
+      listener(object, added);
+    }
   }
 
   /**
@@ -302,17 +620,15 @@ export class ObjectRegistry {
     blueprints: number;
     clones: number;
     byType: Record<string, number>;
+    byCategory: Record<string, number>;
+    rootObjects: number;
     largestInventories: Array<{ objectId: string; count: number }>;
     blueprintCloneCounts: Array<{ path: string; clones: number }>;
   } {
-    const byType: Record<string, number> = {};
+    const byType = Object.fromEntries(this.typeCounts);
     const inventories: Array<{ objectId: string; count: number }> = [];
 
     for (const obj of this.objects.values()) {
-      // Count by constructor name (type)
-      const typeName = obj.constructor.name;
-      byType[typeName] = (byType[typeName] || 0) + 1;
-
       // Track inventory sizes
       if (obj.inventory && obj.inventory.length > 0) {
         inventories.push({ objectId: obj.objectId, count: obj.inventory.length });
@@ -337,6 +653,8 @@ export class ObjectRegistry {
       blueprints: this.blueprints.size,
       clones: this.objects.size - this.blueprints.size,
       byType,
+      byCategory: this.getCategoryCounts(),
+      rootObjects: this.roots.size,
       largestInventories,
       blueprintCloneCounts: topBlueprints,
     };
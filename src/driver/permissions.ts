@@ -64,6 +64,8 @@ export class Permissions {
   private levels: Map<string, PermissionLevel> = new Map();
   private domains: Map<string, string[]> = new Map();
   private commandPaths: Map<string, string[]> = new Map();
+  /** Bumped on every command path change, so resolved command tables can be reused until then */
+  private commandPathsRevision: number = 0;
   private auditLog: AuditEntry[] = [];
   private maxAuditEntries: number = 10000;
 
@@ -517,6 +519,7 @@ export class Permissions {
    */
   setCommandPaths(playerName: string, paths: string[]): void {
     this.commandPaths.set(playerName.toLowerCase(), [...paths]);
+    this.commandPathsRevision++;
   }
 
   /**
@@ -530,6 +533,7 @@ export class Permissions {
     if (!paths.includes(path)) {
       paths.push(path);
       this.commandPaths.set(name, paths);
+      this.commandPathsRevision++;
     }
   }
 
@@ -545,6 +549,7 @@ export class Permissions {
     if (index >= 0) {
       paths.splice(index, 1);
       this.commandPaths.set(name, paths);
+      this.commandPathsRevision++;
     }
   }
 
@@ -553,7 +558,17 @@ export class Permissions {
    * @param playerName The player's name
    */
   clearCommandPaths(playerName: string): void {
-    this.commandPaths.delete(playerName.toLowerCase());
+    if (this.commandPaths.delete(playerName.toLowerCase())) {
+      this.commandPathsRevision++;
+    }
+  }
+
+  /**
+   * Revision of the command path grants; changes whenever any player's
+   * command paths change.
+   */
+  getCommandPathsRevision(): number {
+    return this.commandPathsRevision;
   }
 
   /**
@@ -709,6 +724,7 @@ export class Permissions {
       for (const [name, paths] of Object.entries(data.commandPaths)) {
         this.commandPaths.set(name.toLowerCase(), paths);
       }
+      this.commandPathsRevision++;
     }
 
     if (data.protectedPaths) {
@@ -8,6 +8,7 @@
 
 import type { PersistenceAdapter } from './adapter.js';
 import { FilesystemAdapter } from './filesystem-adapter.js';
+import type { SaveFormat } from './save-codec.js';
 
 /**
  * Adapter configuration.
@@ -17,6 +18,16 @@ export interface AdapterConfig {
   dataPath: string;
   supabaseUrl?: string;
   supabaseServiceKey?: string;
+  /** How long Supabase generic data writes wait to be batched, in milliseconds */
+  supabaseWriteWindowMs?: number;
+  /** Generic data entries kept in the Supabase read cache (0 disables it) */
+  supabaseCacheSize?: number;
+  /** Player save format (filesystem adapter; Supabase stores JSONB rows) */
+  playerFormat?: SaveFormat;
+  /** Journal player saves as deltas (filesystem adapter) */
+  playerJournal?: boolean;
+  /** Journal entries between snapshot rewrites (filesystem adapter) */
+  playerJournalCompactEntries?: number;
 }
 
 let adapterInstance: PersistenceAdapter | null = null;
@@ -38,7 +49,7 @@ export function getAdapter(config?: Partial<AdapterConfig>): PersistenceAdapter
       );
     }
 
-    adapterInstance = new FilesystemAdapter({ dataPath });
+    adapterInstance = createFilesystemAdapter(dataPath, config);
   }
   return adapterInstance;
 }
@@ -64,14 +75,31 @@ export async function createAdapter(config?: Partial<AdapterConfig>): Promise<Pe
     }
 
     const { SupabaseAdapter } = await import('./supabase-adapter.js');
-    adapterInstance = new SupabaseAdapter({ supabaseUrl, supabaseServiceKey });
+    adapterInstance = new SupabaseAdapter({
+      supabaseUrl,
+      supabaseServiceKey,
+      writeWindowMs: config?.supabaseWriteWindowMs,
+      cacheSize: config?.supabaseCacheSize,
+    });
   } else {
-    adapterInstance = new FilesystemAdapter({ dataPath });
+    adapterInstance = createFilesystemAdapter(dataPath, config);
   }
 
   return adapterInstance;
 }
 
+function createFilesystemAdapter(
+  dataPath: string,
+  config?: Partial<AdapterConfig>
+): FilesystemAdapter {
+  return new FilesystemAdapter({
+    dataPath,
+    playerFormat: config?.playerFormat,
+    journal: config?.playerJournal,
+    journalCompactEntries: config?.playerJournalCompactEntries,
+  });
+}
+
 /**
  * Reset the global adapter. Used for testing.
  */
@@ -35,6 +35,12 @@ export interface PersistenceAdapter {
   /** Save player data (already serialized by caller) */
   savePlayer(data: PlayerSaveData): Promise<void>;
 
+  /**
+   * Save several players as one batch. Optional; the save pipeline falls back
+   * to savePlayer() per player when absent.
+   */
+  savePlayers?(batch: PlayerSaveData[]): Promise<void>;
+
   /** Load a player's saved data by name */
   loadPlayer(name: string): Promise<PlayerSaveData | null>;
 
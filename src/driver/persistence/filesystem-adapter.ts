@@ -4,13 +4,56 @@
  * Preserves all original FileStore behavior: atomic writes, .bak backups,
  * directory auto-creation, and player name sanitization. Adds generic
  * data store methods for daemon persistence.
+ *
+ * Player saves are written in the configured SaveFormat: pretty-printed
+ * `<name>.json` by default, or a compact `<name>.sav` (see save-codec.ts).
+ * Loads accept either file, and a save in one format retires the other
+ * file to `.bak`, so switching formats migrates players as they save.
+ *
+ * With `journal` enabled, a save whose snapshot already exists appends only
+ * the changed fields to `<name>.journal` (see player-journal.ts) and the
+ * snapshot is rewritten every `journalCompactEntries` saves, or once the log
+ * outgrows it. Loads always replay a matching journal, so turning journal
+ * mode off is safe.
  */
 
-import { readFile, writeFile, access, mkdir, readdir, rename, copyFile, unlink } from 'fs/promises';
+import {
+  readFile,
+  writeFile,
+  access,
+  mkdir,
+  readdir,
+  rename,
+  copyFile,
+  unlink,
+  open,
+} from 'fs/promises';
 import { join, dirname } from 'path';
 import { constants } from 'fs';
 import type { PersistenceAdapter, PermissionsData } from './adapter.js';
 import type { PlayerSaveData, WorldState } from './serializer.js';
+import {
+  encodeSave,
+  decodeSave,
+  isJsonSaveFormat,
+  JSON_SAVE_FORMAT,
+  type SaveFormat,
+} from './save-codec.js';
+import {
+  diffSave,
+  journalEntry,
+  journalHeader,
+  replayJournal,
+  type JournalOp,
+} from './player-journal.js';
+
+/** Player file extensions: legacy JSON and the compact container */
+const JSON_EXTENSION = '.json';
+const COMPACT_EXTENSION = '.sav';
+const JOURNAL_EXTENSION = '.journal';
+
+/** Players whose journaled state is kept in memory for diffing */
+const JOURNAL_CACHE_SIZE = 1000;
 
 /**
  * Filesystem adapter configuration.
@@ -24,6 +67,62 @@ export interface FilesystemAdapterConfig {
   worldStateFile: string;
   /** Permissions filename */
   permissionsFile: string;
+  /** Encoding and compression for player saves */
+  playerFormat: SaveFormat;
+  /** Append player changes to a journal instead of rewriting the snapshot */
+  journal: boolean;
+  /** Journal entries after which the snapshot is rewritten */
+  journalCompactEntries: number;
+}
+
+/**
+ * Journal mode statistics.
+ */
+export interface PlayerJournalStats {
+  /** Saves written as journal entries */
+  appends: number;
+  /** Saves written as full snapshots */
+  compactions: number;
+  /** Saves with no changes besides their timestamps, which wrote nothing */
+  unchanged: number;
+  /** Bytes appended to journals */
+  journalBytes: number;
+  /** Bytes written as snapshots */
+  snapshotBytes: number;
+}
+
+/**
+ * Last durable state of a journaled player, the base for the next diff.
+ */
+interface JournalState {
+  state: PlayerSaveData;
+  /** savedAt of the snapshot the journal extends */
+  base: number;
+  /** Entries in the journal (0 when there is no journal) */
+  entries: number;
+  /** Journal size in bytes */
+  bytes: number;
+  /** Snapshot size in bytes */
+  snapshotBytes: number;
+  /** The journal has a torn tail (or a failed append) and must be folded into a snapshot */
+  mustCompact: boolean;
+}
+
+/**
+ * Whether a journal op only moves a save's timestamps (savedAt and
+ * state.timestamp), which the serializer sets on every save.
+ */
+function isStampOp(op: JournalOp): boolean {
+  const [first, second] = op.p;
+  if (op.p.length === 1) return first === 'savedAt';
+  return op.p.length === 2 && first === 'state' && second === 'timestamp';
+}
+
+/**
+ * Copy a save as the JSON value it is stored as.
+ */
+function toJsonValue(data: PlayerSaveData): PlayerSaveData {
+  return JSON.parse(JSON.stringify(data)) as PlayerSaveData;
 }
 
 /**
@@ -31,6 +130,15 @@ export interface FilesystemAdapterConfig {
  */
 export class FilesystemAdapter implements PersistenceAdapter {
   private config: FilesystemAdapterConfig;
+  /** Lowercased player name -> journaled state, least recently used first */
+  private journalCache: Map<string, JournalState> = new Map();
+  private journalStats: PlayerJournalStats = {
+    appends: 0,
+    compactions: 0,
+    unchanged: 0,
+    journalBytes: 0,
+    snapshotBytes: 0,
+  };
 
   constructor(config: Partial<FilesystemAdapterConfig> = {}) {
     this.config = {
@@ -38,6 +146,9 @@ export class FilesystemAdapter implements PersistenceAdapter {
       playersDir: config.playersDir ?? 'players',
       worldStateFile: config.worldStateFile ?? 'world-state.json',
       permissionsFile: config.permissionsFile ?? 'permissions.json',
+      playerFormat: config.playerFormat ?? JSON_SAVE_FORMAT,
+      journal: config.journal ?? false,
+      journalCompactEntries: Math.max(1, config.journalCompactEntries ?? 50),
     };
   }
 
@@ -58,30 +169,89 @@ export class FilesystemAdapter implements PersistenceAdapter {
     const filePath = this.getPlayerPath(data.name);
     await this.ensureDirectory(dirname(filePath));
 
-    const json = JSON.stringify(data, null, 2);
-    await this.writeJsonAtomic(filePath, json, true);
+    if (this.config.journal) {
+      if (await this.saveJournaled(data)) {
+        await this.syncDirectory(dirname(filePath));
+      }
+      return;
+    }
+
+    const contents = await encodeSave(data, this.config.playerFormat);
+    await this.writeFileAtomic(filePath, contents, true);
+    await this.retireOtherFormat(data.name);
+    await this.discardJournal(data.name);
   }
 
-  async loadPlayer(name: string): Promise<PlayerSaveData | null> {
-    const filePath = this.getPlayerPath(name);
+  /**
+   * Save a batch of players with one durability barrier: each file is written
+   * and fsynced to a temp file, then all are renamed into place and the
+   * players directory is fsynced once.
+   */
+  async savePlayers(batch: PlayerSaveData[]): Promise<void> {
+    if (batch.length === 0) return;
+    const dir = join(this.config.dataPath, this.config.playersDir);
+    await this.ensureDirectory(dir);
+
+    if (this.config.journal) {
+      const created = await Promise.all(batch.map((data) => this.saveJournaled(data)));
+      if (created.some(Boolean)) {
+        await this.syncDirectory(dir);
+      }
+      return;
+    }
 
+    const stamp = `${process.pid}-${Date.now()}`;
+    const written: Array<{ filePath: string; tempPath: string }> = [];
     try {
-      await access(filePath, constants.F_OK);
-      const json = await readFile(filePath, 'utf-8');
-      return JSON.parse(json) as PlayerSaveData;
-    } catch {
-      return null;
+      await Promise.all(
+        batch.map(async (data, index) => {
+          const filePath = this.getPlayerPath(data.name);
+          const tempPath = `${filePath}.tmp-${stamp}-${index}`;
+          written.push({ filePath, tempPath });
+          await this.backup(filePath);
+          await this.writeDurable(tempPath, await encodeSave(data, this.config.playerFormat));
+        })
+      );
+      for (const { filePath, tempPath } of written) {
+        await rename(tempPath, filePath);
+      }
+    } catch (error) {
+      await Promise.all(written.map(({ tempPath }) => unlink(tempPath).catch(() => {})));
+      throw error;
     }
+    for (const data of batch) {
+      await this.retireOtherFormat(data.name);
+      await this.discardJournal(data.name);
+    }
+    await this.syncDirectory(dir);
+  }
+
+  async loadPlayer(name: string): Promise<PlayerSaveData | null> {
+    const loaded = await this.readPlayer(name);
+    if (!loaded) return null;
+    if (this.config.journal) {
+      this.cacheJournalState(name, { ...loaded, state: toJsonValue(loaded.state) });
+    }
+    return loaded.state;
+  }
+
+  /**
+   * Journal mode statistics.
+   */
+  getJournalStats(): PlayerJournalStats {
+    return { ...this.journalStats };
   }
 
   async playerExists(name: string): Promise<boolean> {
-    const filePath = this.getPlayerPath(name);
-    try {
-      await access(filePath, constants.F_OK);
-      return true;
-    } catch {
-      return false;
+    for (const filePath of this.getPlayerPaths(name)) {
+      try {
+        await access(filePath, constants.F_OK);
+        return true;
+      } catch {
+        // Try the next format
+      }
     }
+    return false;
   }
 
   async listPlayers(): Promise<string[]> {
@@ -90,20 +260,181 @@ export class FilesystemAdapter implements PersistenceAdapter {
     try {
       await access(dir, constants.F_OK);
       const files = await readdir(dir);
-      return files.filter((f) => f.endsWith('.json')).map((f) => f.replace('.json', ''));
+      const names = new Set<string>();
+      for (const file of files) {
+        for (const extension of [JSON_EXTENSION, COMPACT_EXTENSION]) {
+          if (file.endsWith(extension)) names.add(file.slice(0, -extension.length));
+        }
+      }
+      return [...names];
     } catch {
       return [];
     }
   }
 
   async deletePlayer(name: string): Promise<boolean> {
+    await this.discardJournal(name);
+    let deleted = false;
+    for (const filePath of this.getPlayerPaths(name)) {
+      try {
+        await unlink(filePath);
+        deleted = true;
+      } catch {
+        // Not saved in this format
+      }
+    }
+    return deleted;
+  }
+
+  // ========== Player Journal ==========
+
+  /**
+   * Save a player in journal mode: append the changes since the last durable
+   * state, or write a full snapshot when there is no usable base or the
+   * journal is due for compaction.
+   * @returns Whether a new file was created (the directory needs an fsync)
+   */
+  private async saveJournaled(data: PlayerSaveData): Promise<boolean> {
+    const key = data.name.toLowerCase();
+    const next = toJsonValue(data);
+    let current = this.journalCache.get(key);
+    if (!current) {
+      const loaded = await this.readPlayer(data.name);
+      current = loaded ?? undefined;
+    }
+
+    if (
+      !current ||
+      current.mustCompact ||
+      current.entries >= this.config.journalCompactEntries ||
+      current.bytes >= current.snapshotBytes
+    ) {
+      await this.compactJournal(data.name, next);
+      return false;
+    }
+
+    // A save that only moves its timestamps keeps the stored ones
+    const ops = diffSave(current.state, next);
+    if (ops.every(isStampOp)) {
+      this.journalStats.unchanged++;
+      this.cacheJournalState(data.name, current);
+      return false;
+    }
+
+    // A new journal starts with its header and replaces any stale file
+    const starting = current.bytes === 0;
+    const text = (starting ? journalHeader(current.base) : '') + journalEntry(ops);
+    try {
+      await this.appendDurable(this.getPlayerPath(data.name, JOURNAL_EXTENSION), text, starting);
+    } catch (error) {
+      // Part of the entry may be on disk (e.g. ENOSPC), so the next save
+      // writes a full snapshot instead of appending after it
+      this.cacheJournalState(data.name, { ...current, mustCompact: true });
+      throw error;
+    }
+
+    const bytes = Buffer.byteLength(text);
+    this.journalStats.appends++;
+    this.journalStats.journalBytes += bytes;
+    this.cacheJournalState(data.name, {
+      ...current,
+      state: next,
+      entries: current.entries + 1,
+      bytes: current.bytes + bytes,
+    });
+    return starting;
+  }
+
+  /**
+   * Write a full snapshot durably, then drop the journal it supersedes.
+   */
+  private async compactJournal(name: string, data: PlayerSaveData): Promise<void> {
     const filePath = this.getPlayerPath(name);
+    const tempPath = `${filePath}.tmp-${process.pid}-${Date.now()}`;
+    const contents = await encodeSave(data, this.config.playerFormat);
+    try {
+      await this.backup(filePath);
+      await this.writeDurable(tempPath, contents);
+      await rename(tempPath, filePath);
+    } catch (error) {
+      await unlink(tempPath).catch(() => {});
+      throw error;
+    }
+    // The snapshot must be durable before the journal disappears
+    await this.syncDirectory(dirname(filePath));
+    await this.discardJournal(name);
+    await this.retireOtherFormat(name);
+
+    this.journalStats.compactions++;
+    this.journalStats.snapshotBytes += contents.length;
+    this.cacheJournalState(name, {
+      state: data,
+      base: data.savedAt,
+      entries: 0,
+      bytes: 0,
+      snapshotBytes: contents.length,
+      mustCompact: false,
+    });
+  }
+
+  /**
+   * Load a player's snapshot and replay its journal.
+   */
+  private async readPlayer(name: string): Promise<JournalState | null> {
+    // Current format first, then a save not yet migrated from the other one
+    for (const filePath of this.getPlayerPaths(name)) {
+      let contents: Buffer;
+      let snapshot: PlayerSaveData;
+      try {
+        contents = await readFile(filePath);
+        snapshot = await decodeSave<PlayerSaveData>(contents);
+      } catch {
+        // Missing or unreadable; try the next format
+        continue;
+      }
 
+      let log: string;
+      try {
+        log = await readFile(this.getPlayerPath(name, JOURNAL_EXTENSION), 'utf-8');
+      } catch {
+        log = '';
+      }
+      const replay = log
+        ? replayJournal(snapshot, log, snapshot.savedAt)
+        : { state: snapshot, entries: 0, stale: true, torn: false };
+      return {
+        state: replay.state,
+        base: snapshot.savedAt,
+        entries: replay.entries,
+        // A stale journal is overwritten when the next one starts
+        bytes: replay.stale ? 0 : Buffer.byteLength(log),
+        snapshotBytes: contents.length,
+        // Torn logs and saves in the other format are rewritten on next save
+        mustCompact: replay.torn || filePath !== this.getPlayerPath(name),
+      };
+    }
+    return null;
+  }
+
+  private cacheJournalState(name: string, state: JournalState): void {
+    const key = name.toLowerCase();
+    this.journalCache.delete(key);
+    this.journalCache.set(key, state);
+    if (this.journalCache.size > JOURNAL_CACHE_SIZE) {
+      const oldest = this.journalCache.keys().next().value;
+      if (oldest !== undefined) this.journalCache.delete(oldest);
+    }
+  }
+
+  /**
+   * Remove a player's journal, e.g. after a full snapshot was written.
+   */
+  private async discardJournal(name: string): Promise<void> {
+    this.journalCache.delete(name.toLowerCase());
     try {
-      await unlink(filePath);
-      return true;
+      await unlink(this.getPlayerPath(name, JOURNAL_EXTENSION));
     } catch {
-      return false;
+      // No journal
     }
   }
 
@@ -114,7 +445,7 @@ export class FilesystemAdapter implements PersistenceAdapter {
     await this.ensureDirectory(dirname(filePath));
 
     const json = JSON.stringify(state, null, 2);
-    await this.writeJsonAtomic(filePath, json, true);
+    await this.writeFileAtomic(filePath, json, true);
   }
 
   async loadWorldState(): Promise<WorldState | null> {
@@ -136,7 +467,7 @@ export class FilesystemAdapter implements PersistenceAdapter {
     await this.ensureDirectory(dirname(filePath));
 
     const json = JSON.stringify(data, null, 2);
-    await this.writeJsonAtomic(filePath, json, true);
+    await this.writeFileAtomic(filePath, json, true);
   }
 
   async loadPermissions(): Promise<PermissionsData | null> {
@@ -207,9 +538,22 @@ export class FilesystemAdapter implements PersistenceAdapter {
 
   // ========== Path Helpers ==========
 
-  private getPlayerPath(name: string): string {
+  private getPlayerPath(name: string, extension: string = this.playerExtension()): string {
     const safeName = name.toLowerCase().replace(/[^a-z0-9_-]/g, '_');
-    return join(this.config.dataPath, this.config.playersDir, `${safeName}.json`);
+    return join(this.config.dataPath, this.config.playersDir, `${safeName}${extension}`);
+  }
+
+  /**
+   * Candidate save files for a player, current format first.
+   */
+  private getPlayerPaths(name: string): string[] {
+    const current = this.playerExtension();
+    const other = current === JSON_EXTENSION ? COMPACT_EXTENSION : JSON_EXTENSION;
+    return [this.getPlayerPath(name, current), this.getPlayerPath(name, other)];
+  }
+
+  private playerExtension(): string {
+    return isJsonSaveFormat(this.config.playerFormat) ? JSON_EXTENSION : COMPACT_EXTENSION;
   }
 
   private getWorldStatePath(): string {
@@ -243,24 +587,23 @@ export class FilesystemAdapter implements PersistenceAdapter {
   }
 
   /**
-   * Write JSON atomically to avoid partial writes on crashes.
+   * Write a file atomically to avoid partial writes on crashes.
    * Optionally keeps a .bak copy of the previous version.
    */
-  private async writeJsonAtomic(filePath: string, json: string, keepBackup: boolean): Promise<void> {
+  private async writeFileAtomic(
+    filePath: string,
+    contents: string | Buffer,
+    keepBackup: boolean
+  ): Promise<void> {
     const tempPath = `${filePath}.tmp-${process.pid}-${Date.now()}`;
 
     try {
       await this.ensureDirectory(dirname(filePath));
       if (keepBackup) {
-        try {
-          await access(filePath, constants.F_OK);
-          await copyFile(filePath, `${filePath}.bak`);
-        } catch {
-          // No existing file yet; nothing to back up.
-        }
+        await this.backup(filePath);
       }
 
-      await writeFile(tempPath, json, 'utf-8');
+      await writeFile(tempPath, contents, 'utf-8');
       await rename(tempPath, filePath);
     } catch (error) {
       try {
@@ -271,4 +614,72 @@ export class FilesystemAdapter implements PersistenceAdapter {
       throw error;
     }
   }
+
+  /**
+   * Move a player's save in the other format aside once the current format
+   * has been written, so it cannot shadow newer data.
+   */
+  private async retireOtherFormat(name: string): Promise<void> {
+    const stale = this.getPlayerPaths(name)[1]!;
+    try {
+      await rename(stale, `${stale}.bak`);
+    } catch {
+      // Nothing to migrate
+    }
+  }
+
+  /**
+   * Keep a .bak copy of the current version of a file, if there is one.
+   */
+  private async backup(filePath: string): Promise<void> {
+    try {
+      await access(filePath, constants.F_OK);
+      await copyFile(filePath, `${filePath}.bak`);
+    } catch {
+      // No existing file yet; nothing to back up.
+    }
+  }
+
+  /**
+   * Write a file and flush it to disk before returning.
+   */
+  private async writeDurable(filePath: string, contents: Buffer): Promise<void> {
+    const handle = await open(filePath, 'w');
+    try {
+      await handle.writeFile(contents);
+      await handle.sync();
+    } finally {
+      await handle.close();
+    }
+  }
+
+  /**
+   * Append to a file (or replace it) and flush it to disk before returning.
+   */
+  private async appendDurable(filePath: string, text: string, replace: boolean): Promise<void> {
+    const handle = await open(filePath, replace ? 'w' : 'a');
+    try {
+      await handle.writeFile(text, 'utf-8');
+      await handle.datasync();
+    } finally {
+      await handle.close();
+    }
+  }
+
+  /**
+   * Flush a directory entry table so renames into it survive a crash.
+   * Not supported on every platform (e.g. Windows), so failures are ignored.
+   */
+  private async syncDirectory(dir: string): Promise<void> {
+    try {
+      const handle = await open(dir, 'r');
+      try {
+        await handle.sync();
+      } finally {
+        await handle.close();
+      }
+    } catch {
+      // Best effort
+    }
+  }
 }
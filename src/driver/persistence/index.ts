@@ -11,3 +11,6 @@ export * from './serializer.js';
 export * from './file-store.js';
 export * from './filesystem-adapter.js';
 export * from './loader.js';
+export * from './save-pipeline.js';
+export * from './save-codec.js';
+export * from './player-journal.js';
@@ -0,0 +1,185 @@
+/**
+ * PlayerJournal - Delta encoding for journaled player saves.
+ *
+ * In journal mode a player's save is a full snapshot plus a per-player log
+ * (`<name>.journal`) of the changes made since. The log starts with a header
+ * naming the snapshot it extends (by its savedAt), followed by one JSON line
+ * per save holding the operations that turn the previous state into the new
+ * one. Loading replays the lines onto the snapshot. A log whose header does
+ * not match the snapshot is left over from before a compaction and is
+ * ignored; a torn last line (crash mid-append) ends the replay.
+ */
+
+/** Path of a value inside a save: object keys and array indices */
+export type JournalPath = Array<string | number>;
+
+/**
+ * One change: set the value at a path, or delete it.
+ */
+export interface JournalOp {
+  p: JournalPath;
+  v?: unknown;
+  d?: 1;
+}
+
+export interface ReplayResult<T> {
+  /** The snapshot with every valid entry applied */
+  state: T;
+  /** Entries applied */
+  entries: number;
+  /** Whether the log belongs to an older snapshot */
+  stale: boolean;
+  /** Whether replay stopped at an unreadable line */
+  torn: boolean;
+}
+
+function isPlainObject(value: unknown): value is Record<string, unknown> {
+  return value !== null && typeof value === 'object' && !Array.isArray(value);
+}
+
+/**
+ * Compute the operations that turn prev into next. Both must be JSON values
+ * (as produced by JSON.parse). Objects and same-length arrays are compared
+ * member by member; anything else that differs is replaced whole.
+ */
+export function diffSave(prev: unknown, next: unknown, path: JournalPath = []): JournalOp[] {
+  const ops: JournalOp[] = [];
+  diffInto(prev, next, path, ops);
+  return ops;
+}
+
+function diffInto(prev: unknown, next: unknown, path: JournalPath, ops: JournalOp[]): void {
+  if (prev === next) return;
+
+  if (isPlainObject(prev) && isPlainObject(next)) {
+    for (const key of Object.keys(next)) {
+      if (Object.prototype.hasOwnProperty.call(prev, key)) {
+        diffInto(prev[key], next[key], [...path, key], ops);
+      } else {
+        ops.push({ p: [...path, key], v: next[key] });
+      }
+    }
+    for (const key of Object.keys(prev)) {
+      if (!Object.prototype.hasOwnProperty.call(next, key)) {
+        ops.push({ p: [...path, key], d: 1 });
+      }
+    }
+    return;
+  }
+
+  if (Array.isArray(prev) && Array.isArray(next) && prev.length === next.length) {
+    for (let i = 0; i < next.length; i++) {
+      diffInto(prev[i], next[i], [...path, i], ops);
+    }
+    return;
+  }
+
+  ops.push({ p: path, v: next });
+}
+
+/**
+ * Apply operations in order.
+ * @returns The updated value (a new value only when an op replaces the root)
+ */
+export function applyOps<T>(target: T, ops: JournalOp[]): T {
+  let root: unknown = target;
+  for (const op of ops) {
+    if (op.p.length === 0) {
+      root = op.v;
+      continue;
+    }
+
+    let parent = root as Record<string | number, unknown>;
+    for (let i = 0; i < op.p.length - 1; i++) {
+      const key = op.p[i]!;
+      let child = parent[key];
+      if (child === null || typeof child !== 'object') {
+        child = typeof op.p[i + 1] === 'number' ? [] : {};
+        setKey(parent, key, child);
+      }
+      parent = child as Record<string | number, unknown>;
+    }
+
+    const last = op.p[op.p.length - 1]!;
+    if (op.d) {
+      delete parent[last];
+    } else {
+      setKey(parent, last, op.v);
+    }
+  }
+  return root as T;
+}
+
+/**
+ * Assign a key as an own property, including '__proto__' as JSON.parse does.
+ */
+function setKey(
+  target: Record<string | number, unknown>,
+  key: string | number,
+  value: unknown
+): void {
+  if (key === '__proto__') {
+    Object.defineProperty(target, key, {
+      value,
+      enumerable: true,
+      writable: true,
+      configurable: true,
+    });
+  } else {
+    target[key] = value;
+  }
+}
+
+/**
+ * First line of a log extending the snapshot saved at base.
+ */
+export function journalHeader(base: number): string {
+  return JSON.stringify({ base }) + '\n';
+}
+
+/**
+ * One log line.
+ */
+export function journalEntry(ops: JournalOp[]): string {
+  return JSON.stringify({ ops }) + '\n';
+}
+
+/**
+ * Replay a log onto a snapshot.
+ * @param snapshot The loaded snapshot (modified in place)
+ * @param log The log file contents
+ * @param base savedAt of the snapshot
+ */
+export function replayJournal<T>(snapshot: T, log: string, base: number): ReplayResult<T> {
+  const lines = log.split('\n');
+  // Every complete line ends in a newline; anything after the last one is torn
+  const tail = lines.pop();
+  let state = snapshot;
+  let entries = 0;
+
+  let header: { base?: unknown } | null = null;
+  try {
+    header = JSON.parse(lines[0] ?? '') as { base?: unknown };
+  } catch {
+    // Torn header: nothing was ever appended after it
+  }
+  if (!header || header.base !== base) {
+    return { state, entries, stale: true, torn: false };
+  }
+
+  for (let i = 1; i < lines.length; i++) {
+    const line = lines[i]!;
+    let entry: { ops?: unknown };
+    try {
+      entry = JSON.parse(line) as { ops?: unknown };
+    } catch {
+      return { state, entries, stale: false, torn: true };
+    }
+    if (!Array.isArray(entry.ops)) {
+      return { state, entries, stale: false, torn: true };
+    }
+    state = applyOps(state, entry.ops as JournalOp[]);
+    entries++;
+  }
+  return { state, entries, stale: false, torn: tail !== '' };
+}
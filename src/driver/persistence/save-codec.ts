@@ -0,0 +1,464 @@
+/**
+ * SaveCodec - Compact encodings for save files.
+ *
+ * Saves can be written as pretty-printed JSON (the original format) or as a
+ * framed binary container:
+ *
+ *   magic "MFSV" | version u8 | encoding u8 | compression u8 | length u32 | payload
+ *
+ * where the payload is MessagePack (or compact JSON) optionally compressed
+ * with gzip or brotli, and length is the uncompressed payload size, used to
+ * detect truncated files. Decoding recognizes both forms, so existing JSON
+ * saves keep loading after the format is changed.
+ *
+ * The MessagePack codec covers exactly what JSON can represent and follows
+ * JSON.stringify semantics (toJSON, dropped undefined properties, non-finite
+ * numbers as null), so a save decodes to the same value in either format.
+ */
+
+import { promisify } from 'util';
+import { gzip, gunzip, brotliCompress, brotliDecompress, constants as zlibConstants } from 'zlib';
+
+const gzipAsync = promisify(gzip);
+const gunzipAsync = promisify(gunzip);
+const brotliCompressAsync = promisify(brotliCompress);
+const brotliDecompressAsync = promisify(brotliDecompress);
+
+export type SaveEncoding = 'json' | 'msgpack';
+export type SaveCompression = 'none' | 'gzip' | 'brotli';
+
+export interface SaveFormat {
+  encoding: SaveEncoding;
+  compression: SaveCompression;
+}
+
+/** The original format: pretty-printed JSON with no container */
+export const JSON_SAVE_FORMAT: SaveFormat = { encoding: 'json', compression: 'none' };
+
+const MAGIC = Buffer.from('MFSV');
+const VERSION = 1;
+const HEADER_SIZE = MAGIC.length + 3 + 4;
+
+const ENCODING_IDS: Record<SaveEncoding, number> = { json: 0, msgpack: 1 };
+const COMPRESSION_IDS: Record<SaveCompression, number> = { none: 0, gzip: 1, brotli: 2 };
+
+/**
+ * Whether a format writes the legacy pretty-printed JSON file.
+ */
+export function isJsonSaveFormat(format: SaveFormat): boolean {
+  return format.encoding === 'json' && format.compression === 'none';
+}
+
+/**
+ * Whether a buffer holds a framed save (as opposed to plain JSON).
+ */
+export function isFramedSave(buffer: Buffer): boolean {
+  return buffer.length >= HEADER_SIZE && buffer.subarray(0, MAGIC.length).equals(MAGIC);
+}
+
+/**
+ * Encode a save in the given format.
+ */
+export async function encodeSave(value: unknown, format: SaveFormat): Promise<Buffer> {
+  if (isJsonSaveFormat(format)) {
+    return Buffer.from(JSON.stringify(value, null, 2), 'utf-8');
+  }
+
+  const payload =
+    format.encoding === 'msgpack'
+      ? encodeMsgpack(value)
+      : Buffer.from(JSON.stringify(value), 'utf-8');
+
+  let body: Buffer;
+  switch (format.compression) {
+    case 'gzip':
+      body = await gzipAsync(payload);
+      break;
+    case 'brotli':
+      // Default quality (11) is far too slow for saves that happen in play
+      body = await brotliCompressAsync(payload, {
+        params: {
+          [zlibConstants.BROTLI_PARAM_QUALITY]: 5,
+          [zlibConstants.BROTLI_PARAM_SIZE_HINT]: payload.length,
+        },
+      });
+      break;
+    default:
+      body = payload;
+  }
+
+  const header = Buffer.alloc(HEADER_SIZE);
+  MAGIC.copy(header, 0);
+  header.writeUInt8(VERSION, 4);
+  header.writeUInt8(ENCODING_IDS[format.encoding], 5);
+  header.writeUInt8(COMPRESSION_IDS[format.compression], 6);
+  header.writeUInt32BE(payload.length, 7);
+  return Buffer.concat([header, body]);
+}
+
+/**
+ * Decode a save written in any format, including plain JSON.
+ * @throws If the container is damaged or uses an unknown format
+ */
+export async function decodeSave<T = unknown>(buffer: Buffer): Promise<T> {
+  if (!isFramedSave(buffer)) {
+    return JSON.parse(buffer.toString('utf-8')) as T;
+  }
+
+  const version = buffer.readUInt8(4);
+  if (version !== VERSION) {
+    throw new Error(`Unsupported save version: ${version}`);
+  }
+  const encoding = buffer.readUInt8(5);
+  const compression = buffer.readUInt8(6);
+  const length = buffer.readUInt32BE(7);
+  const body = buffer.subarray(HEADER_SIZE);
+
+  let payload: Buffer;
+  switch (compression) {
+    case COMPRESSION_IDS.none:
+      payload = body;
+      break;
+    case COMPRESSION_IDS.gzip:
+      payload = await gunzipAsync(body);
+      break;
+    case COMPRESSION_IDS.brotli:
+      payload = await brotliDecompressAsync(body);
+      break;
+    default:
+      throw new Error(`Unknown save compression: ${compression}`);
+  }
+  if (payload.length !== length) {
+    throw new Error(`Truncated save: expected ${length} bytes, got ${payload.length}`);
+  }
+
+  switch (encoding) {
+    case ENCODING_IDS.msgpack:
+      return decodeMsgpack(payload) as T;
+    case ENCODING_IDS.json:
+      return JSON.parse(payload.toString('utf-8')) as T;
+    default:
+      throw new Error(`Unknown save encoding: ${encoding}`);
+  }
+}
+
+// ========== MessagePack ==========
+
+/**
+ * Growable output buffer.
+ */
+class Writer {
+  buffer: Buffer = Buffer.allocUnsafe(4096);
+  offset = 0;
+
+  ensure(bytes: number): void {
+    if (this.offset + bytes <= this.buffer.length) return;
+    let size = this.buffer.length * 2;
+    while (size < this.offset + bytes) size *= 2;
+    const grown = Buffer.allocUnsafe(size);
+    this.buffer.copy(grown, 0, 0, this.offset);
+    this.buffer = grown;
+  }
+
+  byte(value: number): void {
+    this.ensure(1);
+    this.buffer[this.offset++] = value;
+  }
+
+  /** A type byte followed by an unsigned length of 1, 2 or 4 bytes */
+  sized(type: number, width: 1 | 2 | 4, value: number): void {
+    this.ensure(1 + width);
+    this.buffer[this.offset++] = type;
+    if (width === 1) this.buffer.writeUInt8(value, this.offset);
+    else if (width === 2) this.buffer.writeUInt16BE(value, this.offset);
+    else this.buffer.writeUInt32BE(value, this.offset);
+    this.offset += width;
+  }
+}
+
+/**
+ * Encode a JSON-compatible value as MessagePack.
+ */
+export function encodeMsgpack(value: unknown): Buffer {
+  const writer = new Writer();
+  writeValue(writer, value, true);
+  return writer.buffer.subarray(0, writer.offset);
+}
+
+/**
+ * Write one value. Returns false (writing nothing) for values JSON omits
+ * from objects: undefined, functions and symbols.
+ */
+function writeValue(writer: Writer, value: unknown, inArray: boolean): boolean {
+  if (value !== null && typeof value === 'object') {
+    const toJSON = (value as { toJSON?: () => unknown }).toJSON;
+    if (typeof toJSON === 'function') {
+      value = toJSON.call(value);
+    }
+  }
+
+  switch (typeof value) {
+    case 'string':
+      writeString(writer, value);
+      return true;
+    case 'number':
+      writeNumber(writer, value);
+      return true;
+    case 'boolean':
+      writer.byte(value ? 0xc3 : 0xc2);
+      return true;
+    case 'object':
+      if (value === null) {
+        writer.byte(0xc0);
+      } else if (Array.isArray(value)) {
+        writeArray(writer, value);
+      } else {
+        writeMap(writer, value as Record<string, unknown>);
+      }
+      return true;
+    case 'bigint':
+      throw new TypeError('Do not know how to serialize a BigInt');
+    default:
+      // undefined, function, symbol: null in arrays, omitted from objects
+      if (inArray) writer.byte(0xc0);
+      return inArray;
+  }
+}
+
+/** Strings up to this length take the ASCII fast paths (keys, paths, ids) */
+const SHORT_STRING = 31;
+
+function writeString(writer: Writer, value: string): void {
+  if (value.length <= SHORT_STRING && writeShortAscii(writer, value)) return;
+
+  const length = Buffer.byteLength(value, 'utf-8');
+  if (length < 32) {
+    writer.byte(0xa0 | length);
+  } else if (length < 0x100) {
+    writer.sized(0xd9, 1, length);
+  } else if (length < 0x10000) {
+    writer.sized(0xda, 2, length);
+  } else {
+    writer.sized(0xdb, 4, length);
+  }
+  writer.ensure(length);
+  writer.offset += writer.buffer.write(value, writer.offset, length, 'utf-8');
+}
+
+/**
+ * Write a short ASCII string as a fixstr byte by byte, which is much cheaper
+ * than Buffer.byteLength plus Buffer.write for the many short keys in a save.
+ * @returns false (writing nothing) if the string is not ASCII
+ */
+function writeShortAscii(writer: Writer, value: string): boolean {
+  for (let i = 0; i < value.length; i++) {
+    if (value.charCodeAt(i) >= 0x80) return false;
+  }
+  writer.ensure(1 + value.length);
+  const { buffer } = writer;
+  buffer[writer.offset++] = 0xa0 | value.length;
+  for (let i = 0; i < value.length; i++) {
+    buffer[writer.offset++] = value.charCodeAt(i);
+  }
+  return true;
+}
+
+function writeNumber(writer: Writer, value: number): void {
+  if (!Number.isFinite(value)) {
+    writer.byte(0xc0);
+  } else if (Number.isInteger(value) && value >= 0 && value < 0x80) {
+    writer.byte(value);
+  } else if (Number.isInteger(value) && value < 0 && value >= -32) {
+    writer.byte(value & 0xff);
+  } else if (Number.isInteger(value) && value >= 0 && value <= 0xffffffff) {
+    if (value < 0x100) writer.sized(0xcc, 1, value);
+    else if (value < 0x10000) writer.sized(0xcd, 2, value);
+    else writer.sized(0xce, 4, value);
+  } else if (Number.isInteger(value) && value >= -0x80000000 && value < 0) {
+    writer.ensure(5);
+    writer.buffer[writer.offset++] = 0xd2;
+    writer.buffer.writeInt32BE(value, writer.offset);
+    writer.offset += 4;
+  } else {
+    writer.ensure(9);
+    writer.buffer[writer.offset++] = 0xcb;
+    writer.buffer.writeDoubleBE(value, writer.offset);
+    writer.offset += 8;
+  }
+}
+
+function writeArray(writer: Writer, value: unknown[]): void {
+  const length = value.length;
+  if (length < 16) writer.byte(0x90 | length);
+  else if (length < 0x10000) writer.sized(0xdc, 2, length);
+  else writer.sized(0xdd, 4, length);
+  for (const item of value) {
+    writeValue(writer, item, true);
+  }
+}
+
+function writeMap(writer: Writer, value: Record<string, unknown>): void {
+  // Reserve the widest header, then patch in the count of entries written
+  const start = writer.offset;
+  writer.sized(0xdf, 4, 0);
+  let count = 0;
+  for (const key of Object.keys(value)) {
+    const keyStart = writer.offset;
+    writeString(writer, key);
+    if (writeValue(writer, value[key], false)) {
+      count++;
+    } else {
+      writer.offset = keyStart;
+    }
+  }
+
+  if (count < 16) {
+    // Shift the entries left over the unused header bytes
+    writer.buffer.copy(writer.buffer, start + 1, start + 5, writer.offset);
+    writer.buffer[start] = 0x80 | count;
+    writer.offset -= 4;
+  } else if (count < 0x10000) {
+    writer.buffer.copy(writer.buffer, start + 3, start + 5, writer.offset);
+    writer.buffer[start] = 0xde;
+    writer.buffer.writeUInt16BE(count, start + 1);
+    writer.offset -= 2;
+  } else {
+    writer.buffer.writeUInt32BE(count, start + 1);
+  }
+}
+
+/**
+ * Decode MessagePack produced by encodeMsgpack().
+ * @throws On malformed input or types outside the JSON subset
+ */
+export function decodeMsgpack(buffer: Buffer): unknown {
+  const reader = { buffer, offset: 0 };
+  const value = readValue(reader);
+  if (reader.offset !== buffer.length) {
+    throw new Error('Trailing bytes after MessagePack value');
+  }
+  return value;
+}
+
+interface Reader {
+  buffer: Buffer;
+  offset: number;
+}
+
+function readValue(reader: Reader): unknown {
+  const { buffer } = reader;
+  if (reader.offset >= buffer.length) {
+    throw new Error('Unexpected end of MessagePack data');
+  }
+  const type = buffer[reader.offset++]!;
+
+  if (type < 0x80) return type;
+  if (type >= 0xe0) return type - 0x100;
+  if ((type & 0xe0) === 0xa0) return readString(reader, type & 0x1f);
+  if ((type & 0xf0) === 0x90) return readArray(reader, type & 0x0f);
+  if ((type & 0xf0) === 0x80) return readMap(reader, type & 0x0f);
+
+  switch (type) {
+    case 0xc0:
+      return null;
+    case 0xc2:
+      return false;
+    case 0xc3:
+      return true;
+    case 0xcc:
+      return readUInt(reader, 1);
+    case 0xcd:
+      return readUInt(reader, 2);
+    case 0xce:
+      return readUInt(reader, 4);
+    case 0xd2: {
+      const value = buffer.readInt32BE(reader.offset);
+      reader.offset += 4;
+      return value;
+    }
+    case 0xcb: {
+      const value = buffer.readDoubleBE(reader.offset);
+      reader.offset += 8;
+      return value;
+    }
+    case 0xd9:
+      return readString(reader, readUInt(reader, 1));
+    case 0xda:
+      return readString(reader, readUInt(reader, 2));
+    case 0xdb:
+      return readString(reader, readUInt(reader, 4));
+    case 0xdc:
+      return readArray(reader, readUInt(reader, 2));
+    case 0xdd:
+      return readArray(reader, readUInt(reader, 4));
+    case 0xde:
+      return readMap(reader, readUInt(reader, 2));
+    case 0xdf:
+      return readMap(reader, readUInt(reader, 4));
+    default:
+      throw new Error(`Unsupported MessagePack type 0x${type.toString(16)}`);
+  }
+}
+
+function readUInt(reader: Reader, width: 1 | 2 | 4): number {
+  const { buffer, offset } = reader;
+  reader.offset += width;
+  if (width === 1) return buffer.readUInt8(offset);
+  if (width === 2) return buffer.readUInt16BE(offset);
+  return buffer.readUInt32BE(offset);
+}
+
+function readString(reader: Reader, length: number): string {
+  const { buffer } = reader;
+  const end = reader.offset + length;
+  if (end > buffer.length) {
+    throw new Error('Unexpected end of MessagePack data');
+  }
+
+  if (length <= SHORT_STRING) {
+    // ASCII fast path; falls back to the UTF-8 decoder on the first high byte
+    let value = '';
+    let i = reader.offset;
+    for (; i < end && buffer[i]! < 0x80; i++) {
+      value += String.fromCharCode(buffer[i]!);
+    }
+    if (i === end) {
+      reader.offset = end;
+      return value;
+    }
+  }
+
+  const value = buffer.toString('utf-8', reader.offset, end);
+  reader.offset = end;
+  return value;
+}
+
+function readArray(reader: Reader, length: number): unknown[] {
+  const value = new Array<unknown>(length);
+  for (let i = 0; i < length; i++) {
+    value[i] = readValue(reader);
+  }
+  return value;
+}
+
+function readMap(reader: Reader, length: number): Record<string, unknown> {
+  const value: Record<string, unknown> = {};
+  for (let i = 0; i < length; i++) {
+    const key = readValue(reader);
+    if (typeof key !== 'string') {
+      throw new Error('MessagePack map key is not a string');
+    }
+    if (key === '__proto__') {
+      // An own property, as JSON.parse creates, rather than a prototype change
+      Object.defineProperty(value, key, {
+        value: readValue(reader),
+        enumerable: true,
+        writable: true,
+        configurable: true,
+      });
+    } else {
+      value[key] = readValue(reader);
+    }
+  }
+  return value;
+}
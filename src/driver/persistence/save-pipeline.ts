@@ -0,0 +1,327 @@
+/**
+ * SavePipeline - Write-behind queue for player saves.
+ *
+ * Callers hand over a snapshot (already walked by Serializer.serializePlayer)
+ * and return immediately. Snapshots wait up to windowMs in a per-player slot,
+ * so repeated saves of the same player inside the window collapse into one
+ * write of the newest snapshot. A flush writes the queue in batches through
+ * the adapter's savePlayers() when it has one (one durable batch write), or
+ * savePlayer() per player otherwise.
+ *
+ * flush() and flushPlayer() wait for the write, for callers that must know
+ * the save landed (the save command, shutdown, destroying a player object).
+ * Failed writes stay queued and are retried on the next flush unless a newer
+ * snapshot replaced them.
+ */
+
+import type { PersistenceAdapter } from './adapter.js';
+import type { PlayerSaveData } from './serializer.js';
+import { getAdapter } from './adapter-factory.js';
+import { getMetrics } from '../metrics.js';
+import { getLogger } from '../logger.js';
+
+export interface SavePipelineConfig {
+  /** How long a save waits for newer saves of the same player, in milliseconds */
+  windowMs: number;
+  /** Maximum players written per batch */
+  batchSize: number;
+}
+
+/**
+ * Storage operations used by the pipeline.
+ */
+export type PlayerSaveStore = Pick<PersistenceAdapter, 'savePlayer' | 'savePlayers'>;
+
+export interface SavePipelineStats {
+  /** Players with a snapshot waiting to be written */
+  queueDepth: number;
+  /** Saves requested */
+  requested: number;
+  /** Saves replaced by a newer snapshot before being written */
+  coalesced: number;
+  /** Snapshots written */
+  written: number;
+  /** Failed write attempts */
+  failed: number;
+  /** Batches written */
+  batches: number;
+  /** Longest time a written snapshot waited in the queue, in milliseconds */
+  maxQueuedMs: number;
+}
+
+interface QueuedSave {
+  data: PlayerSaveData;
+  /** When the first unwritten save of this player was requested */
+  queuedAt: number;
+  /** flushPlayer() callers waiting on this snapshot */
+  waiters: Array<{ resolve: () => void; reject: (error: unknown) => void }>;
+}
+
+/**
+ * Coalescing, batched write-behind queue for player saves.
+ */
+export class SavePipeline {
+  private config: SavePipelineConfig;
+  private storeProvider: () => PlayerSaveStore;
+  /** Lowercased player name -> newest unwritten snapshot */
+  private queue: Map<string, QueuedSave> = new Map();
+  /** Snapshots being written right now */
+  private inFlight: Map<string, PlayerSaveData> = new Map();
+  private timer: NodeJS.Timeout | null = null;
+  /** The flush in progress, so concurrent flushes queue behind it */
+  private flushing: Promise<void> | null = null;
+  private stats = {
+    requested: 0,
+    coalesced: 0,
+    written: 0,
+    failed: 0,
+    batches: 0,
+    maxQueuedMs: 0,
+  };
+
+  constructor(
+    config: Partial<SavePipelineConfig> = {},
+    storeProvider: () => PlayerSaveStore = getAdapter
+  ) {
+    this.config = {
+      windowMs: config.windowMs ?? 1000,
+      batchSize: Math.max(1, config.batchSize ?? 50),
+    };
+    this.storeProvider = storeProvider;
+  }
+
+  /**
+   * Queue a player snapshot. A queued snapshot of the same player is
+   * replaced, and the write happens when the window closes.
+   * @param data Snapshot from Serializer.serializePlayer()
+   */
+  enqueue(data: PlayerSaveData): void {
+    const key = data.name.toLowerCase();
+    this.stats.requested++;
+
+    const queued = this.queue.get(key);
+    if (queued) {
+      queued.data = data;
+      this.stats.coalesced++;
+    } else {
+      this.queue.set(key, { data, queuedAt: Date.now(), waiters: [] });
+    }
+    this.scheduleFlush();
+  }
+
+  /**
+   * Whether a player has a snapshot waiting to be written.
+   * @param name Player name
+   */
+  isQueued(name: string): boolean {
+    return this.queue.has(name.toLowerCase());
+  }
+
+  /**
+   * The newest snapshot of a player not yet written, so loads see their own
+   * saves. Returns a copy.
+   * @param name Player name
+   */
+  peek(name: string): PlayerSaveData | undefined {
+    const key = name.toLowerCase();
+    const data = this.queue.get(key)?.data ?? this.inFlight.get(key);
+    return data ? structuredClone(data) : undefined;
+  }
+
+  /**
+   * Lowercased names of players with a snapshot not yet written.
+   */
+  queuedNames(): string[] {
+    return [...new Set([...this.queue.keys(), ...this.inFlight.keys()])];
+  }
+
+  /**
+   * Drop a player's queued snapshot (e.g. when the player is deleted).
+   * @param name Player name
+   * @returns true if a snapshot was queued
+   */
+  discard(name: string): boolean {
+    const key = name.toLowerCase();
+    const queued = this.queue.get(key);
+    if (!queued) return false;
+    this.queue.delete(key);
+    for (const waiter of queued.waiters) waiter.resolve();
+    return true;
+  }
+
+  /**
+   * Write one player's queued snapshot now, together with the rest of the
+   * queue, and wait until it is written.
+   * @param name Player name
+   */
+  async flushPlayer(name: string): Promise<void> {
+    const queued = this.queue.get(name.toLowerCase());
+    if (!queued) {
+      // Possibly being written right now
+      await this.flushing;
+      return;
+    }
+    const written = new Promise<void>((resolve, reject) => {
+      queued.waiters.push({ resolve, reject });
+    });
+    void this.flush().catch(() => {
+      // Reported to the waiter
+    });
+    await written;
+  }
+
+  /**
+   * Write everything queued and wait until it is written.
+   * Rejects if any snapshot failed to write (it stays queued).
+   */
+  async flush(): Promise<void> {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+
+    while (this.flushing) {
+      await this.flushing.catch(() => {});
+    }
+    if (this.queue.size === 0) return;
+
+    this.flushing = this.writeQueue();
+    try {
+      await this.flushing;
+    } finally {
+      this.flushing = null;
+      if (this.queue.size > 0 && !this.timer) {
+        this.scheduleFlush();
+      }
+    }
+  }
+
+  /**
+   * Cancel the pending timer. Queued snapshots stay queued; call flush()
+   * first to write them.
+   */
+  stop(): void {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+  }
+
+  /**
+   * Get pipeline statistics.
+   */
+  getStats(): SavePipelineStats {
+    return {
+      queueDepth: this.queue.size,
+      ...this.stats,
+    };
+  }
+
+  private scheduleFlush(): void {
+    if (this.timer) return;
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      this.flush().catch(() => {
+        // Logged by writeBatch; failed saves stay queued for the next flush
+      });
+    }, this.config.windowMs);
+  }
+
+  /**
+   * Take the whole queue and write it in batches.
+   */
+  private async writeQueue(): Promise<void> {
+    const entries = Array.from(this.queue.entries());
+    this.queue.clear();
+    for (const [key, queued] of entries) {
+      this.inFlight.set(key, queued.data);
+    }
+
+    let firstError: unknown = null;
+    try {
+      for (let i = 0; i < entries.length; i += this.config.batchSize) {
+        const error = await this.writeBatch(entries.slice(i, i + this.config.batchSize));
+        firstError ??= error;
+      }
+    } finally {
+      this.inFlight.clear();
+    }
+    if (firstError) throw firstError;
+  }
+
+  /**
+   * Write one batch. On failure the batch goes back in the queue, except
+   * players that were saved again meanwhile.
+   * @returns The write error, if any
+   */
+  private async writeBatch(batch: Array<[string, QueuedSave]>): Promise<unknown> {
+    const store = this.storeProvider();
+    const start = performance.now();
+
+    try {
+      const snapshots = batch.map(([, queued]) => queued.data);
+      if (store.savePlayers) {
+        await store.savePlayers(snapshots);
+      } else {
+        await Promise.all(snapshots.map((data) => store.savePlayer(data)));
+      }
+    } catch (error) {
+      this.stats.failed += batch.length;
+      getLogger().error(
+        { error, players: batch.map(([key]) => key) },
+        'Failed to write player saves; will retry'
+      );
+      for (const [key, queued] of batch) {
+        const newer = this.queue.get(key);
+        if (newer) {
+          // A newer snapshot supersedes the failed one
+          newer.queuedAt = queued.queuedAt;
+        } else {
+          this.queue.set(key, queued);
+        }
+        for (const waiter of queued.waiters.splice(0)) waiter.reject(error);
+      }
+      return error;
+    }
+
+    const now = Date.now();
+    getMetrics().recordPlayerSaveBatch(performance.now() - start, batch.length);
+    this.stats.batches++;
+    this.stats.written += batch.length;
+    for (const [, queued] of batch) {
+      this.stats.maxQueuedMs = Math.max(this.stats.maxQueuedMs, now - queued.queuedAt);
+      for (const waiter of queued.waiters) waiter.resolve();
+    }
+    return null;
+  }
+}
+
+// Singleton instance
+let pipelineInstance: SavePipeline | null = null;
+
+/**
+ * Get the global save pipeline, creating one with defaults if needed.
+ */
+export function getSavePipeline(): SavePipeline {
+  if (!pipelineInstance) {
+    pipelineInstance = new SavePipeline();
+  }
+  return pipelineInstance;
+}
+
+/**
+ * Create the global save pipeline with the given configuration.
+ */
+export function initializeSavePipeline(config: Partial<SavePipelineConfig>): SavePipeline {
+  pipelineInstance?.stop();
+  pipelineInstance = new SavePipeline(config);
+  return pipelineInstance;
+}
+
+/**
+ * Reset the global save pipeline. Used for testing.
+ */
+export function resetSavePipeline(): void {
+  pipelineInstance?.stop();
+  pipelineInstance = null;
+}
@@ -111,6 +111,27 @@ export class Serializer {
     }
   }
 
+  /**
+   * Restore a snapshot from serialize() into a fresh instance of the same
+   * object. serialize() flattens the object's property map into
+   * state.properties, so keys that are not fields of the object are put
+   * back through setProperty().
+   * @param state The serialized state
+   * @param object The freshly loaded object
+   */
+  restore(state: SerializedState, object: MudObject): void {
+    const target = object as unknown as Record<string, unknown> & {
+      setProperty?: (key: string, value: unknown) => void;
+    };
+    for (const [key, value] of Object.entries(state.properties)) {
+      if (typeof target.setProperty === 'function' && !(key in target)) {
+        target.setProperty(key, this.deserializeValue(value));
+      } else {
+        target[key] = this.deserializeValue(value);
+      }
+    }
+  }
+
   /**
    * Serialize a player for saving.
    * @param player The player object
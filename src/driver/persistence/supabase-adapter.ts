@@ -7,6 +7,13 @@
  *
  * Requires @supabase/supabase-js as a dependency (dynamically imported
  * by adapter-factory.ts to avoid requiring it when not in use).
+ *
+ * Generic data rows (game_state, bots) are written through a coalescing
+ * queue: saves within writeWindowMs are merged per key and flushed as one
+ * multi-row upsert per table, and the returned promise settles when the row
+ * is written. Generic data reads go through an LRU read-through cache that
+ * writes update and deletes invalidate, so repeated loadData()/dataExists()
+ * calls from daemons do not each cost a round trip. Reads see queued writes.
  */
 
 import type { PersistenceAdapter, PermissionsData } from './adapter.js';
@@ -22,6 +29,56 @@ export interface SupabaseAdapterConfig {
   supabaseUrl: string;
   supabaseServiceKey: string;
   storageBucket?: string;
+  /** How long generic data writes wait to be batched, in milliseconds (default 50) */
+  writeWindowMs?: number;
+  /** Generic data entries kept in the read cache; 0 disables it (default 1000) */
+  cacheSize?: number;
+  /** Use this client instead of creating one (e.g. a stub in tests) */
+  client?: SupabaseClient;
+}
+
+/**
+ * Write queue and read cache statistics.
+ */
+export interface SupabaseAdapterStats {
+  /** Entries in the read cache */
+  cacheSize: number;
+  /** Reads answered from the cache or the write queue */
+  cacheHits: number;
+  /** Reads that went to Supabase */
+  cacheMisses: number;
+  /** Rows waiting to be written */
+  pendingWrites: number;
+  /** Writes replaced by a newer write of the same key before being sent */
+  coalescedWrites: number;
+  /** Upsert requests sent by the write queue */
+  writeBatches: number;
+  /** Rows written by the write queue */
+  rowsWritten: number;
+}
+
+/** Maximum rows per upsert request */
+const WRITE_BATCH_ROWS = 500;
+
+/**
+ * A generic data row waiting in the write queue.
+ */
+interface PendingWrite {
+  table: string;
+  onConflict: string;
+  row: Record<string, unknown>;
+  data: unknown;
+  waiters: Array<{ resolve: () => void; reject: (error: unknown) => void }>;
+}
+
+/**
+ * What the read cache knows about a namespace/key. value is only meaningful
+ * when loaded is true (a dataExists() result alone does not load the value).
+ */
+interface CacheEntry {
+  exists: boolean;
+  loaded: boolean;
+  value: unknown;
 }
 
 /**
@@ -31,23 +88,62 @@ export class SupabaseAdapter implements PersistenceAdapter {
   private client: SupabaseClient | null = null;
   private config: SupabaseAdapterConfig;
   private storageBucket: string;
+  private writeWindowMs: number;
+  private cacheSize: number;
+  /** Cache key -> newest unwritten row */
+  private pendingWrites: Map<string, PendingWrite> = new Map();
+  private writeTimer: NodeJS.Timeout | null = null;
+  /** Flushes run one after another so a key's writes land in order */
+  private writeChain: Promise<void> = Promise.resolve();
+  /** Cache key -> entry, least recently used first */
+  private cache: Map<string, CacheEntry> = new Map();
+  /** Bumped on every write, so reads that raced one are not cached */
+  private generation = 0;
+  private stats = {
+    cacheHits: 0,
+    cacheMisses: 0,
+    coalescedWrites: 0,
+    writeBatches: 0,
+    rowsWritten: 0,
+  };
 
   constructor(config: SupabaseAdapterConfig) {
     this.config = config;
     this.storageBucket = config.storageBucket ?? 'game-media';
+    this.writeWindowMs = config.writeWindowMs ?? 50;
+    this.cacheSize = Math.max(0, config.cacheSize ?? 1000);
   }
 
   // ========== Lifecycle ==========
 
   async initialize(): Promise<void> {
+    if (this.config.client) {
+      this.client = this.config.client;
+      return;
+    }
     const { createClient } = await import('@supabase/supabase-js');
     this.client = createClient(this.config.supabaseUrl, this.config.supabaseServiceKey);
   }
 
   async shutdown(): Promise<void> {
+    await this.flushWrites().catch(() => {
+      // Already reported to the callers of saveData()
+    });
+    this.cache.clear();
     this.client = null;
   }
 
+  /**
+   * Get write queue and read cache statistics.
+   */
+  getStats(): SupabaseAdapterStats {
+    return {
+      cacheSize: this.cache.size,
+      pendingWrites: this.pendingWrites.size,
+      ...this.stats,
+    };
+  }
+
   private getClient(): SupabaseClient {
     if (!this.client) {
       throw new Error('SupabaseAdapter not initialized. Call initialize() first.');
@@ -59,26 +155,46 @@ export class SupabaseAdapter implements PersistenceAdapter {
 
   async savePlayer(data: PlayerSaveData): Promise<void> {
     const client = this.getClient();
-    const state = data.state;
-    const props = state?.properties ?? {};
 
     const { error } = await client
       .from('players')
-      .upsert({
-        name: data.name.toLowerCase(),
-        level: (props.level as number) ?? 1,
-        race: (props.race as string) ?? 'human',
-        location: data.location,
-        last_login: new Date().toISOString(),
-        play_time: (props.playTime as number) ?? 0,
-        data,
-        saved_at: new Date(data.savedAt).toISOString(),
-        updated_at: new Date().toISOString(),
-      }, { onConflict: 'name' });
+      .upsert(this.playerRow(data), { onConflict: 'name' });
 
     if (error) throw new Error(`Failed to save player ${data.name}: ${error.message}`);
   }
 
+  /**
+   * Save a batch of players with a single upsert.
+   */
+  async savePlayers(batch: PlayerSaveData[]): Promise<void> {
+    if (batch.length === 0) return;
+    const client = this.getClient();
+
+    const { error } = await client
+      .from('players')
+      .upsert(batch.map((data) => this.playerRow(data)), { onConflict: 'name' });
+
+    if (error) throw new Error(`Failed to save ${batch.length} players: ${error.message}`);
+  }
+
+  /**
+   * Row for the players table.
+   */
+  private playerRow(data: PlayerSaveData): Record<string, unknown> {
+    const props = data.state?.properties ?? {};
+    return {
+      name: data.name.toLowerCase(),
+      level: (props.level as number) ?? 1,
+      race: (props.race as string) ?? 'human',
+      location: data.location,
+      last_login: new Date().toISOString(),
+      play_time: (props.playTime as number) ?? 0,
+      data,
+      saved_at: new Date(data.savedAt).toISOString(),
+      updated_at: new Date().toISOString(),
+    };
+  }
+
   async loadPlayer(name: string): Promise<PlayerSaveData | null> {
     const client = this.getClient();
     const safeName = name.toLowerCase();
@@ -205,27 +321,64 @@ export class SupabaseAdapter implements PersistenceAdapter {
 
   async saveData(namespace: string, key: string, data: unknown): Promise<void> {
     const table = this.resolveTable(namespace);
+    const cacheKey = this.cacheKey(namespace, key);
+    this.generation++;
 
     if (table === 'game_state') {
-      await this.saveGameState(namespace, key, data);
-    } else if (table === 'portraits' || table === 'object_images') {
-      await this.saveImageData(namespace, key, data);
+      return this.queueWrite(cacheKey, table, 'key', data, (copy) =>
+        this.gameStateRow(namespace, key, copy)
+      );
     } else if (table === 'bots') {
-      await this.saveBotData(key, data);
-    } else if (table === 'emotes') {
-      await this.saveEmoteData(data);
-    } else if (table === 'lore_entries') {
-      await this.saveLoreData(data);
-    } else if (table === 'announcements') {
-      await this.saveAnnouncementData(data);
-    } else if (table === 'grudges') {
-      await this.saveGrudgeData(data);
+      return this.queueWrite(cacheKey, table, 'bot_id', data, (copy) => this.botRow(key, copy));
+    }
+
+    // Whole-table and image writes go straight through
+    this.cache.delete(cacheKey);
+    try {
+      if (table === 'portraits' || table === 'object_images') {
+        await this.saveImageData(namespace, key, data);
+      } else if (table === 'emotes') {
+        await this.saveEmoteData(data);
+      } else if (table === 'lore_entries') {
+        await this.saveLoreData(data);
+      } else if (table === 'announcements') {
+        await this.saveAnnouncementData(data);
+      } else if (table === 'grudges') {
+        await this.saveGrudgeData(data);
+      }
+    } finally {
+      this.generation++;
+      this.cache.delete(cacheKey);
     }
   }
 
   async loadData<T = unknown>(namespace: string, key: string): Promise<T | null> {
     const table = this.resolveTable(namespace);
+    const cacheKey = this.cacheKey(namespace, key);
 
+    const pending = this.pendingWrites.get(cacheKey);
+    if (pending) {
+      this.stats.cacheHits++;
+      return structuredClone(pending.data) as T;
+    }
+    // Images are large and read rarely; they are not cached
+    const cacheable = table !== 'portraits' && table !== 'object_images';
+    const cached = cacheable ? this.cacheGet(cacheKey) : undefined;
+    if (cached && (cached.loaded || !cached.exists)) {
+      this.stats.cacheHits++;
+      return structuredClone(cached.value ?? null) as T | null;
+    }
+
+    this.stats.cacheMisses++;
+    const generation = this.generation;
+    const value = await this.fetchData<T>(table, namespace, key);
+    if (cacheable && generation === this.generation) {
+      this.cacheSet(cacheKey, { exists: value !== null, loaded: true, value: structuredClone(value) });
+    }
+    return value;
+  }
+
+  private async fetchData<T>(table: string, namespace: string, key: string): Promise<T | null> {
     if (table === 'game_state') {
       return this.loadGameState<T>(namespace, key);
     } else if (table === 'portraits' || table === 'object_images') {
@@ -247,6 +400,33 @@ export class SupabaseAdapter implements PersistenceAdapter {
 
   async dataExists(namespace: string, key: string): Promise<boolean> {
     const table = this.resolveTable(namespace);
+    const cacheKey = this.cacheKey(namespace, key);
+    // Not tracked per key, so nothing to cache (and loadData must not see a miss)
+    if (this.isWholeTable(table)) {
+      return this.fetchExists(table, namespace, key);
+    }
+
+    if (this.pendingWrites.has(cacheKey)) {
+      this.stats.cacheHits++;
+      return true;
+    }
+    const cached = this.cacheGet(cacheKey);
+    if (cached) {
+      this.stats.cacheHits++;
+      return cached.exists;
+    }
+
+    this.stats.cacheMisses++;
+    const generation = this.generation;
+    const exists = await this.fetchExists(table, namespace, key);
+    if (generation === this.generation) {
+      // A missing row is fully known; an existing one still needs loading
+      this.cacheSet(cacheKey, { exists, loaded: !exists, value: null });
+    }
+    return exists;
+  }
+
+  private async fetchExists(table: string, namespace: string, key: string): Promise<boolean> {
     const client = this.getClient();
 
     if (table === 'portraits') {
@@ -282,6 +462,28 @@ export class SupabaseAdapter implements PersistenceAdapter {
   }
 
   async deleteData(namespace: string, key: string): Promise<boolean> {
+    const cacheKey = this.cacheKey(namespace, key);
+
+    // A queued write must not recreate the row after the delete
+    const pending = this.pendingWrites.get(cacheKey);
+    if (pending) {
+      this.pendingWrites.delete(cacheKey);
+      for (const waiter of pending.waiters) waiter.resolve();
+    }
+    this.generation++;
+    this.cache.delete(cacheKey);
+    // Let a flush already sending this key finish first
+    await this.writeChain;
+
+    try {
+      return (await this.deleteRow(namespace, key)) || pending !== undefined;
+    } finally {
+      this.generation++;
+      this.cache.delete(cacheKey);
+    }
+  }
+
+  private async deleteRow(namespace: string, key: string): Promise<boolean> {
     const table = this.resolveTable(namespace);
     const client = this.getClient();
 
@@ -312,6 +514,15 @@ export class SupabaseAdapter implements PersistenceAdapter {
   }
 
   async listKeys(namespace: string): Promise<string[]> {
+    const keys = await this.fetchKeys(namespace);
+    const prefix = this.cacheKey(namespace, '');
+    const queued = [...this.pendingWrites.keys()]
+      .filter((cacheKey) => cacheKey.startsWith(prefix))
+      .map((cacheKey) => cacheKey.slice(prefix.length));
+    return queued.length > 0 ? [...new Set([...keys, ...queued])] : keys;
+  }
+
+  private async fetchKeys(namespace: string): Promise<string[]> {
     const table = this.resolveTable(namespace);
     const client = this.getClient();
 
@@ -338,6 +549,157 @@ export class SupabaseAdapter implements PersistenceAdapter {
     return [];
   }
 
+  // ========== Write Queue ==========
+
+  /**
+   * Queue a row for the next batched upsert. A queued row with the same key
+   * is replaced. Resolves once the row is written.
+   * The row is built from a copy of the data, so callers that keep changing
+   * their object before the flush don't change what gets written.
+   */
+  private queueWrite(
+    cacheKey: string,
+    table: string,
+    onConflict: string,
+    data: unknown,
+    toRow: (copy: unknown) => Record<string, unknown>
+  ): Promise<void> {
+    const copy = structuredClone(data);
+    const row = toRow(copy);
+    this.cacheSet(cacheKey, { exists: true, loaded: true, value: copy });
+
+    return new Promise<void>((resolve, reject) => {
+      const queued = this.pendingWrites.get(cacheKey);
+      if (queued) {
+        this.stats.coalescedWrites++;
+        queued.row = row;
+        queued.data = copy;
+        queued.waiters.push({ resolve, reject });
+      } else {
+        this.pendingWrites.set(cacheKey, {
+          table,
+          onConflict,
+          row,
+          data: copy,
+          waiters: [{ resolve, reject }],
+        });
+      }
+      if (!this.writeTimer) {
+        this.writeTimer = setTimeout(() => {
+          this.writeTimer = null;
+          this.flushWrites().catch(() => {
+            // Reported to the callers of saveData()
+          });
+        }, this.writeWindowMs);
+      }
+    });
+  }
+
+  /**
+   * Write every queued row now. Rejects if any row failed to write.
+   */
+  async flushWrites(): Promise<void> {
+    if (this.writeTimer) {
+      clearTimeout(this.writeTimer);
+      this.writeTimer = null;
+    }
+    const batch = Array.from(this.pendingWrites.entries());
+    this.pendingWrites.clear();
+
+    const flush = this.writeChain.then(() => this.writeRows(batch));
+    this.writeChain = flush.catch(() => {});
+    await flush;
+  }
+
+  /**
+   * Upsert queued rows with one request per table (per WRITE_BATCH_ROWS).
+   */
+  private async writeRows(batch: Array<[string, PendingWrite]>): Promise<void> {
+    const groups = new Map<string, Array<[string, PendingWrite]>>();
+    for (const entry of batch) {
+      const group = groups.get(entry[1].table);
+      if (group) group.push(entry);
+      else groups.set(entry[1].table, [entry]);
+    }
+
+    let firstError: unknown = null;
+    for (const [table, rows] of groups) {
+      for (let i = 0; i < rows.length; i += WRITE_BATCH_ROWS) {
+        const chunk = rows.slice(i, i + WRITE_BATCH_ROWS);
+        const onConflict = chunk[0]![1].onConflict;
+        try {
+          const { error } = await this.getClient()
+            .from(table)
+            .upsert(chunk.map(([, pending]) => pending.row), { onConflict });
+          if (error) {
+            throw new Error(`Failed to save ${chunk.length} ${table} rows: ${error.message}`);
+          }
+        } catch (error) {
+          firstError ??= error;
+          this.generation++;
+          for (const [cacheKey, pending] of chunk) {
+            // The cache holds the unwritten value; forget it
+            if (!this.pendingWrites.has(cacheKey)) this.cache.delete(cacheKey);
+            for (const waiter of pending.waiters) waiter.reject(error);
+          }
+          continue;
+        }
+        // Reads that started before the write must not be cached
+        this.generation++;
+        this.stats.writeBatches++;
+        this.stats.rowsWritten += chunk.length;
+        for (const [, pending] of chunk) {
+          for (const waiter of pending.waiters) waiter.resolve();
+        }
+      }
+    }
+    if (firstError) throw firstError;
+  }
+
+  // ========== Read Cache ==========
+
+  /**
+   * Key shared by the write queue and read cache. Namespaces stored as one
+   * whole table ignore the key, as loadData() does.
+   */
+  private cacheKey(namespace: string, key: string): string {
+    return this.isWholeTable(this.resolveTable(namespace))
+      ? `${namespace}\0`
+      : `${namespace}\0${key}`;
+  }
+
+  /**
+   * Tables holding a whole namespace, saved and loaded in one piece.
+   */
+  private isWholeTable(table: string): boolean {
+    return (
+      table === 'emotes' ||
+      table === 'lore_entries' ||
+      table === 'announcements' ||
+      table === 'grudges'
+    );
+  }
+
+  private cacheGet(cacheKey: string): CacheEntry | undefined {
+    const entry = this.cache.get(cacheKey);
+    if (entry) {
+      // Mark as most recently used
+      this.cache.delete(cacheKey);
+      this.cache.set(cacheKey, entry);
+    }
+    return entry;
+  }
+
+  private cacheSet(cacheKey: string, entry: CacheEntry): void {
+    if (this.cacheSize === 0) return;
+    this.cache.delete(cacheKey);
+    this.cache.set(cacheKey, entry);
+    if (this.cache.size > this.cacheSize) {
+      const oldest = this.cache.keys().next().value;
+      if (oldest !== undefined) this.cache.delete(oldest);
+    }
+  }
+
   // ========== Namespace-to-Table Routing ==========
 
   private resolveTable(namespace: string): string {
@@ -360,15 +722,19 @@ export class SupabaseAdapter implements PersistenceAdapter {
 
     const { error } = await client
       .from('game_state')
-      .upsert({
-        key: compositeKey,
-        data,
-        updated_at: new Date().toISOString(),
-      }, { onConflict: 'key' });
+      .upsert(this.gameStateRow(namespace, key, data), { onConflict: 'key' });
 
     if (error) throw new Error(`Failed to save game state ${compositeKey}: ${error.message}`);
   }
 
+  private gameStateRow(namespace: string, key: string, data: unknown): Record<string, unknown> {
+    return {
+      key: `${namespace}.${key}`,
+      data,
+      updated_at: new Date().toISOString(),
+    };
+  }
+
   private async loadGameState<T>(namespace: string, key: string): Promise<T | null> {
     const client = this.getClient();
     const compositeKey = `${namespace}.${key}`;
@@ -387,18 +753,12 @@ export class SupabaseAdapter implements PersistenceAdapter {
     return (data?.data as T) ?? null;
   }
 
-  private async saveBotData(botId: string, data: unknown): Promise<void> {
-    const client = this.getClient();
-
-    const { error } = await client
-      .from('bots')
-      .upsert({
-        bot_id: botId,
-        data,
-        updated_at: new Date().toISOString(),
-      }, { onConflict: 'bot_id' });
-
-    if (error) throw new Error(`Failed to save bot ${botId}: ${error.message}`);
+  private botRow(botId: string, data: unknown): Record<string, unknown> {
+    return {
+      bot_id: botId,
+      data,
+      updated_at: new Date().toISOString(),
+    };
   }
 
   private async loadBotData<T>(botId: string): Promise<T | null> {
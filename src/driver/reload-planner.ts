@@ -0,0 +1,253 @@
+/**
+ * ReloadPlanner - Plans cascading hot reloads from the mudlib import graph.
+ *
+ * Reloading /std/living alone leaves npc, player and every other subclass
+ * extending the old class until restart. The planner walks the import graph
+ * from a changed module to everything that imports it, directly or
+ * transitively, and keeps the modules that lead to something live (a loaded
+ * blueprint or command). Those are ordered into levels: a module only
+ * imports modules from earlier levels, so each level can be evaluated
+ * concurrently once the previous one is done. Modules that lead to nothing
+ * live (including the root, if nothing live imports it) are only marked
+ * stale and re-evaluated when next loaded.
+ *
+ * The graph comes from scanning source files for static imports; an
+ * ImportScanner re-reads only files whose mtime changed.
+ */
+
+import { readdir, readFile, stat } from 'fs/promises';
+import { posix, resolve } from 'path';
+import { parseImports } from './preload-engine.js';
+
+/**
+ * A cascading reload, in evaluation order.
+ */
+export interface ReloadPlan {
+  /** The changed module */
+  root: string;
+  /** Modules to evaluate; a level only imports modules from earlier levels */
+  levels: string[][];
+  /** Loaded blueprints among the planned modules */
+  blueprints: string[];
+  /** Loaded commands among the planned modules */
+  commands: string[];
+  /** Affected modules with nothing live; marked stale instead of evaluated */
+  stale: string[];
+  /** Dependents left alone because they are excluded (e.g. stateful daemons) */
+  excluded: string[];
+  /** Members of import cycles; each cycle is one level, bound to its peers' old versions */
+  cycles: string[];
+}
+
+/**
+ * Import edges between mudlib paths (no extension, leading slash).
+ */
+export interface ImportGraph {
+  /** Modules that import a module */
+  getDependents(objectPath: string): string[];
+  /** Modules a module imports */
+  getDependencies(objectPath: string): string[];
+}
+
+export interface PlanOptions {
+  /** Whether a path has a loaded blueprint */
+  isBlueprint(objectPath: string): boolean;
+  /** Whether a path is a loaded command */
+  isCommand(objectPath: string): boolean;
+  /** Whether the cascade must not reload a path (or anything only reached through it) */
+  isExcluded(objectPath: string): boolean;
+}
+
+/**
+ * Plan the reload of a changed module and its dependents.
+ */
+export function planReload(root: string, graph: ImportGraph, options: PlanOptions): ReloadPlan {
+  // Everything that imports the root, directly or transitively
+  const affected = new Set<string>([root]);
+  const excluded = new Set<string>();
+  const queue = [root];
+  while (queue.length > 0) {
+    for (const dependent of graph.getDependents(queue.shift()!)) {
+      if (affected.has(dependent) || excluded.has(dependent)) continue;
+      if (options.isExcluded(dependent)) {
+        excluded.add(dependent);
+        continue;
+      }
+      affected.add(dependent);
+      queue.push(dependent);
+    }
+  }
+
+  // Keep the modules on an import path from the root to something live
+  // (the root itself is on every such path)
+  const live = [...affected].filter((path) => options.isBlueprint(path) || options.isCommand(path));
+  const planned = new Set<string>();
+  const walk = [...live];
+  while (walk.length > 0) {
+    const path = walk.pop()!;
+    if (planned.has(path)) continue;
+    planned.add(path);
+    for (const dependency of graph.getDependencies(path)) {
+      if (affected.has(dependency) && !planned.has(dependency)) walk.push(dependency);
+    }
+  }
+
+  // Import cycles are evaluated together; their members bind to each
+  // other's previous versions
+  const components = stronglyConnected(planned, graph);
+  const componentOf = new Map<string, number>();
+  components.forEach((members, index) => {
+    for (const member of members) componentOf.set(member, index);
+  });
+
+  // Kahn's algorithm over the components, one level at a time
+  const pending = components.map(() => 0);
+  const downstream = components.map(() => new Set<number>());
+  components.forEach((members, index) => {
+    const upstream = new Set<number>();
+    for (const member of members) {
+      for (const dependency of graph.getDependencies(member)) {
+        const component = componentOf.get(dependency);
+        if (component !== undefined && component !== index) upstream.add(component);
+      }
+    }
+    pending[index] = upstream.size;
+    for (const component of upstream) downstream[component]!.add(index);
+  });
+
+  const levels: string[][] = [];
+  let ready = components.map((_, index) => index).filter((index) => pending[index] === 0);
+  while (ready.length > 0) {
+    levels.push(ready.flatMap((index) => components[index]!).sort());
+    const next: number[] = [];
+    for (const index of ready) {
+      for (const dependent of downstream[index]!) {
+        if (--pending[dependent]! === 0) next.push(dependent);
+      }
+    }
+    ready = next;
+  }
+
+  const order = levels.flat();
+  return {
+    root,
+    levels,
+    blueprints: order.filter((path) => options.isBlueprint(path)),
+    commands: order.filter((path) => options.isCommand(path)),
+    stale: [...affected].filter((path) => !planned.has(path)).sort(),
+    excluded: [...excluded].sort(),
+    cycles: components
+      .filter((members) => members.length > 1)
+      .flat()
+      .sort(),
+  };
+}
+
+/**
+ * Tarjan's strongly connected components of the import graph restricted to
+ * a set of modules.
+ */
+function stronglyConnected(nodes: Set<string>, graph: ImportGraph): string[][] {
+  const index = new Map<string, number>();
+  const low = new Map<string, number>();
+  const stack: string[] = [];
+  const onStack = new Set<string>();
+  const components: string[][] = [];
+
+  const visit = (node: string): void => {
+    const id = index.size;
+    index.set(node, id);
+    low.set(node, id);
+    stack.push(node);
+    onStack.add(node);
+
+    for (const dependency of graph.getDependencies(node)) {
+      if (!nodes.has(dependency)) continue;
+      if (!index.has(dependency)) {
+        visit(dependency);
+        low.set(node, Math.min(low.get(node)!, low.get(dependency)!));
+      } else if (onStack.has(dependency)) {
+        low.set(node, Math.min(low.get(node)!, index.get(dependency)!));
+      }
+    }
+
+    if (low.get(node) === id) {
+      const component: string[] = [];
+      let member: string;
+      do {
+        member = stack.pop()!;
+        onStack.delete(member);
+        component.push(member);
+      } while (member !== node);
+      components.push(component);
+    }
+  };
+
+  for (const node of nodes) {
+    if (!index.has(node)) visit(node);
+  }
+  return components;
+}
+
+/**
+ * Incrementally scans mudlib sources for their static imports.
+ */
+export class ImportScanner {
+  private mudlibPath: string;
+  private skipDirs: string[];
+  /** Object path -> last scanned mtime and imports */
+  private files: Map<string, { mtimeMs: number; imports: string[] }> = new Map();
+
+  /**
+   * @param mudlibPath Root directory for mudlib files
+   * @param skipDirs Top-level directories that hold no code (e.g. saved data)
+   */
+  constructor(mudlibPath: string, skipDirs: string[] = ['data']) {
+    this.mudlibPath = mudlibPath;
+    this.skipDirs = skipDirs;
+  }
+
+  /**
+   * Rescan the mudlib.
+   * @returns Imports of files that are new or changed since the last scan, and removed files
+   */
+  async scan(): Promise<{ changed: Map<string, string[]>; removed: string[] }> {
+    const entries = (await readdir(this.mudlibPath, { recursive: true })) as string[];
+    const paths = entries
+      .map((entry) => entry.replace(/\\/g, '/'))
+      .filter(
+        (entry) =>
+          entry.endsWith('.ts') &&
+          !entry.endsWith('.d.ts') &&
+          !this.skipDirs.some((dir) => entry.startsWith(dir + '/'))
+      )
+      .map((entry) => '/' + entry.slice(0, -3));
+
+    const changed = new Map<string, string[]>();
+    await Promise.all(
+      paths.map(async (objectPath) => {
+        const file = resolve(this.mudlibPath, objectPath.slice(1) + '.ts');
+        try {
+          const { mtimeMs } = await stat(file);
+          if (this.files.get(objectPath)?.mtimeMs === mtimeMs) return;
+          const imports = parseImports(await readFile(file, 'utf-8'))
+            .filter((spec) => spec.startsWith('./') || spec.startsWith('../'))
+            .map((spec) =>
+              posix.join(posix.dirname(objectPath), spec).replace(/\.(js|ts)$/, '')
+            );
+          this.files.set(objectPath, { mtimeMs, imports });
+          changed.set(objectPath, imports);
+        } catch {
+          // Removed between readdir and stat; picked up by the next scan
+        }
+      })
+    );
+
+    const present = new Set(paths);
+    const removed = [...this.files.keys()].filter((objectPath) => !present.has(objectPath));
+    for (const objectPath of removed) {
+      this.files.delete(objectPath);
+    }
+    return { changed, removed };
+  }
+}
@@ -2,24 +2,87 @@
  * Scheduler - Manages heartbeats and delayed calls (callOut).
  *
  * Provides timing services for the MUD:
- * - Heartbeat: Regular calls to objects that register for them
+ * - Heartbeat: Regular calls to objects that register for them, at a
+ *   per-object rate class (each class has its own wheel)
  * - callOut: Delayed execution of callbacks
  */
 
 import type { MudObject } from './types.js';
 import { getMetrics } from './metrics.js';
 import { getLogger } from './logger.js';
+import { TimerHeap } from './timer-heap.js';
+import { HeartbeatWheel, type HeartbeatSlotStats } from './heartbeat-wheel.js';
 
 const logger = getLogger();
 
 /**
- * Maximum number of heartbeats to execute in parallel.
+ * Longest delay setTimeout accepts (~24.8 days). Longer callOuts re-arm.
  */
-const HEARTBEAT_CONCURRENCY = 10;
+const MAX_TIMER_DELAY_MS = 0x7fffffff;
+
+/**
+ * How heartbeats are dispatched.
+ * - batch: every object runs at the same instant once per interval
+ * - staggered: objects are spread across phase slots within the interval
+ */
+export type HeartbeatMode = 'batch' | 'staggered';
+
+/**
+ * Named heartbeat rate classes.
+ * - normal: the configured heartbeat interval (players, NPCs)
+ * - slow: every 10 seconds (campfires, ambient objects)
+ * - idle: every 60 seconds (rarely changing objects)
+ */
+export type HeartbeatClass = 'normal' | 'slow' | 'idle';
+
+/**
+ * A heartbeat rate: a named class or an explicit interval in milliseconds.
+ */
+export type HeartbeatRate = HeartbeatClass | number;
+
+/**
+ * Intervals of the fixed rate classes ('normal' follows heartbeatIntervalMs).
+ */
+export const HEARTBEAT_CLASS_INTERVALS: Readonly<Record<Exclude<HeartbeatClass, 'normal'>, number>> =
+  {
+    slow: 10000,
+    idle: 60000,
+  };
+
+/**
+ * Shortest explicit heartbeat interval accepted. Explicit intervals are also
+ * rounded to a multiple of this, which bounds the number of distinct wheels.
+ */
+export const MIN_HEARTBEAT_INTERVAL_MS = 250;
+
+/**
+ * Upper bound on phase slots for long-interval wheels.
+ */
+const MAX_HEARTBEAT_SLOTS = 600;
+
+/**
+ * Load summary for one heartbeat rate class.
+ */
+export interface HeartbeatClassStats {
+  /** Class name ('normal', 'slow', 'idle', or '<ms>ms' for explicit intervals) */
+  name: string;
+  /** Interval between heartbeats in milliseconds */
+  intervalMs: number;
+  /** Objects actively ticking in this class */
+  objects: number;
+  /** Number of phase slots */
+  slots: number;
+}
 
 export interface SchedulerConfig {
   /** Heartbeat interval in milliseconds */
   heartbeatIntervalMs: number;
+  /** Heartbeat dispatch mode */
+  heartbeatMode: HeartbeatMode;
+  /** Number of phase slots per interval (staggered mode) */
+  heartbeatSlots: number;
+  /** Heartbeat work allowed before yielding to the event loop, in ms (staggered mode) */
+  heartbeatSliceBudgetMs: number;
 }
 
 export interface CallOutEntry {
@@ -35,22 +98,45 @@ export interface CallOutEntry {
   intervalMs?: number | undefined;
 }
 
+/**
+ * CallOut entry as stored in the deadline heap.
+ */
+interface QueuedCallOut extends CallOutEntry {
+  /** Position in the callOut heap (-1 when not queued) */
+  heapIndex: number;
+}
+
 /**
  * Manages heartbeats and scheduled callbacks.
  */
 export class Scheduler {
   private config: SchedulerConfig;
-  private heartbeatObjects: Set<MudObject> = new Set();
-  private callOuts: Map<number, CallOutEntry> = new Map();
+  /** One wheel per heartbeat rate class, created on first use and dropped once empty */
+  private heartbeatWheels: Map<string, HeartbeatWheel> = new Map();
+  /** Rate class of every registered heartbeat object (active or dormant) */
+  private heartbeatClassOf: Map<MudObject, string> = new Map();
+  /** Heartbeat objects parked out of their wheel, mapped to when they went dormant */
+  private dormantHeartbeats: Map<MudObject, number> = new Map();
+  private callOuts: Map<number, QueuedCallOut> = new Map();
+  private callOutQueue: TimerHeap<QueuedCallOut> = new TimerHeap();
   private nextCallOutId: number = 1;
-  private heartbeatTimer: NodeJS.Timeout | null = null;
   private callOutTimer: NodeJS.Timeout | null = null;
+  /** When the armed callOut timer will fire */
+  private callOutTimerAt: number = Infinity;
+  /** True while due callOuts are being executed */
+  private executingCallOuts: boolean = false;
   private running: boolean = false;
 
   constructor(config: Partial<SchedulerConfig> = {}) {
     this.config = {
       heartbeatIntervalMs: config.heartbeatIntervalMs ?? 2000,
+      heartbeatMode: config.heartbeatMode ?? 'staggered',
+      heartbeatSlots: config.heartbeatSlots ?? 20,
+      heartbeatSliceBudgetMs: config.heartbeatSliceBudgetMs ?? 10,
     };
+
+    // The normal class always exists; other classes are created on demand
+    this.getHeartbeatWheel('normal');
   }
 
   /**
@@ -59,8 +145,10 @@ export class Scheduler {
   start(): void {
     if (this.running) return;
     this.running = true;
-    this.scheduleHeartbeat();
-    this.scheduleCallOutCheck();
+    for (const wheel of this.heartbeatWheels.values()) {
+      wheel.start();
+    }
+    this.armCallOutTimer();
   }
 
   /**
@@ -68,32 +156,106 @@ export class Scheduler {
    */
   stop(): void {
     this.running = false;
-    if (this.heartbeatTimer) {
-      clearTimeout(this.heartbeatTimer);
-      this.heartbeatTimer = null;
-    }
-    if (this.callOutTimer) {
-      clearTimeout(this.callOutTimer);
-      this.callOutTimer = null;
+    for (const wheel of this.heartbeatWheels.values()) {
+      wheel.stop();
     }
+    this.disarmCallOutTimer();
   }
 
   /**
    * Register an object for heartbeat calls.
+   * Re-registering with a different rate moves the object to that class.
+   * @param rate Rate class name or explicit interval in ms (default 'normal')
+   * @throws Error if the rate is not a known class or a valid interval
    */
-  setHeartbeat(object: MudObject, enable: boolean): void {
-    if (enable) {
-      this.heartbeatObjects.add(object);
-    } else {
-      this.heartbeatObjects.delete(object);
+  setHeartbeat(object: MudObject, enable: boolean, rate: HeartbeatRate = 'normal'): void {
+    if (!enable) {
+      this.removeHeartbeat(object);
+      return;
     }
+
+    const className = this.resolveHeartbeatClass(rate);
+    const current = this.heartbeatClassOf.get(object);
+    if (current === className) return;
+
+    this.heartbeatClassOf.set(object, className);
+    // Dormant objects join their new class when they wake
+    if (this.dormantHeartbeats.has(object)) return;
+    if (current !== undefined) {
+      this.removeFromWheel(object, current);
+    }
+    this.getHeartbeatWheel(className).add(object);
+  }
+
+  /**
+   * Get the heartbeat interval of an object in milliseconds.
+   * @returns The interval, or 0 if the object has no heartbeat
+   */
+  getHeartbeatInterval(object: MudObject): number {
+    const className = this.heartbeatClassOf.get(object);
+    return className === undefined ? 0 : this.classIntervalMs(className);
+  }
+
+  /**
+   * Get the rate class name of an object's heartbeat.
+   */
+  getHeartbeatClass(object: MudObject): string | undefined {
+    return this.heartbeatClassOf.get(object);
+  }
+
+  /**
+   * Move a heartbeat object out of (or back into) the active heartbeat set.
+   * Dormant objects keep their registration but are not ticked. When woken,
+   * the object gets onHeartbeatWake(dormantMs) if defined, then an immediate
+   * catch-up heartbeat.
+   * @returns true if the object changed state
+   */
+  setHeartbeatDormant(object: MudObject, dormant: boolean): boolean {
+    const className = this.heartbeatClassOf.get(object);
+    if (className === undefined) return false;
+
+    if (dormant) {
+      if (!this.removeFromWheel(object, className)) return false;
+      this.dormantHeartbeats.set(object, Date.now());
+      return true;
+    }
+
+    const since = this.dormantHeartbeats.get(object);
+    if (since === undefined) return false;
+    this.dormantHeartbeats.delete(object);
+    this.getHeartbeatWheel(className).add(object);
+    void this.executeCatchUpHeartbeat(object, Date.now() - since);
+    return true;
+  }
+
+  /**
+   * Check if a heartbeat object is currently dormant.
+   */
+  isHeartbeatDormant(object: MudObject): boolean {
+    return this.dormantHeartbeats.has(object);
+  }
+
+  /**
+   * Iterate heartbeat objects that are actively ticking.
+   */
+  *activeHeartbeatObjects(): IterableIterator<MudObject> {
+    for (const wheel of this.heartbeatWheels.values()) {
+      yield* wheel.objects();
+    }
+  }
+
+  /**
+   * Iterate dormant heartbeat objects.
+   */
+  dormantHeartbeatObjects(): IterableIterator<MudObject> {
+    return this.dormantHeartbeats.keys();
   }
 
   /**
    * Check if an object has heartbeat enabled.
    */
   hasHeartbeat(object: MudObject): boolean {
-    return this.heartbeatObjects.has(object);
+    return this.heartbeatClassOf.has(object);
   }
 
   /**
@@ -104,13 +266,14 @@ export class Scheduler {
    */
   callOut(callback: () => void | Promise<void>, delayMs: number): number {
     const id = this.nextCallOutId++;
-    const entry: CallOutEntry = {
+    const entry: QueuedCallOut = {
       id,
       callback,
       executeAt: Date.now() + delayMs,
       recurring: false,
+      heapIndex: -1,
     };
-    this.callOuts.set(id, entry);
+    this.enqueueCallOut(entry);
     return id;
   }
 
@@ -122,14 +285,15 @@ export class Scheduler {
    */
   callOutRepeat(callback: () => void | Promise<void>, intervalMs: number): number {
     const id = this.nextCallOutId++;
-    const entry: CallOutEntry = {
+    const entry: QueuedCallOut = {
       id,
       callback,
       executeAt: Date.now() + intervalMs,
       recurring: true,
       intervalMs,
+      heapIndex: -1,
     };
-    this.callOuts.set(id, entry);
+    this.enqueueCallOut(entry);
     return id;
   }
 
@@ -139,7 +303,11 @@ export class Scheduler {
    * @returns true if cancelled, false if not found
    */
   removeCallOut(id: number): boolean {
-    return this.callOuts.delete(id);
+    const entry = this.callOuts.get(id);
+    if (!entry) return false;
+    this.callOuts.delete(id);
+    this.callOutQueue.remove(entry);
+    return true;
   }
 
   /**
@@ -153,48 +321,61 @@ export class Scheduler {
    * Get the number of registered heartbeat objects.
    */
   get heartbeatCount(): number {
-    return this.heartbeatObjects.size;
+    return this.heartbeatClassOf.size;
   }
 
   /**
-   * Get the number of pending callOuts.
+   * Get the number of dormant heartbeat objects.
    */
-  get callOutCount(): number {
-    return this.callOuts.size;
+  get dormantHeartbeatCount(): number {
+    return this.dormantHeartbeats.size;
   }
 
   /**
-   * Check if the scheduler is running.
+   * Get the heartbeat dispatch mode.
    */
-  get isRunning(): boolean {
-    return this.running;
+  get heartbeatMode(): HeartbeatMode {
+    return this.config.heartbeatMode;
   }
 
   /**
-   * Schedule the next heartbeat.
+   * Get the configured 'normal' heartbeat interval in milliseconds.
    */
-  private scheduleHeartbeat(): void {
-    if (!this.running) return;
+  get heartbeatIntervalMs(): number {
+    return this.config.heartbeatIntervalMs;
+  }
 
-    this.heartbeatTimer = setTimeout(async () => {
-      await this.executeHeartbeats();
-      this.scheduleHeartbeat();
-    }, this.config.heartbeatIntervalMs);
+  /**
+   * Get per-slot heartbeat load of one rate class (one slot in batch mode).
+   */
+  getHeartbeatSlotStats(className: string = 'normal'): HeartbeatSlotStats[] {
+    return this.heartbeatWheels.get(className)?.getSlotStats() ?? [];
   }
 
   /**
-   * Execute heartbeat for all registered objects.
-   * Runs in parallel with concurrency limit to prevent slow heartbeats from blocking others.
+   * Get a load summary for every rate class in use.
    */
-  private async executeHeartbeats(): Promise<void> {
-    const objects = Array.from(this.heartbeatObjects);
-    const metrics = getMetrics();
+  getHeartbeatClassStats(): HeartbeatClassStats[] {
+    return Array.from(this.heartbeatWheels, ([name, wheel]) => ({
+      name,
+      intervalMs: this.classIntervalMs(name),
+      objects: wheel.size,
+      slots: wheel.slotCount,
+    }));
+  }
 
-    // Process in chunks of HEARTBEAT_CONCURRENCY
-    for (let i = 0; i < objects.length; i += HEARTBEAT_CONCURRENCY) {
-      const chunk = objects.slice(i, i + HEARTBEAT_CONCURRENCY);
-      await Promise.all(chunk.map((obj) => this.executeSingleHeartbeat(obj, metrics)));
-    }
+  /**
+   * Get the number of pending callOuts.
+   */
+  get callOutCount(): number {
+    return this.callOuts.size;
+  }
+
+  /**
+   * Check if the scheduler is running.
+   */
+  get isRunning(): boolean {
+    return this.running;
   }
 
   /**
@@ -202,7 +383,8 @@ export class Scheduler {
    */
   private async executeSingleHeartbeat(
     object: MudObject,
-    metrics: ReturnType<typeof getMetrics>
+    metrics: ReturnType<typeof getMetrics>,
+    className?: string
   ): Promise<void> {
     const start = Date.now();
     try {
@@ -214,26 +396,166 @@ export class Scheduler {
         await objWithHeartbeat.heartbeat();
       }
       const elapsed = Date.now() - start;
-      metrics.recordHeartbeat(elapsed, object.objectId);
+      metrics.recordHeartbeat(elapsed, object.objectId, className);
     } catch (error) {
       const elapsed = Date.now() - start;
-      metrics.recordHeartbeat(elapsed, object.objectId);
+      metrics.recordHeartbeat(elapsed, object.objectId, className);
       // Log error but continue with other objects
       logger.error({ error, objectId: object.objectId }, 'Heartbeat error');
     }
   }
 
   /**
-   * Schedule the next callOut check.
+   * Run the wake hook and an immediate heartbeat for an object leaving dormancy.
    */
-  private scheduleCallOutCheck(): void {
-    if (!this.running) return;
+  private async executeCatchUpHeartbeat(object: MudObject, dormantMs: number): Promise<void> {
+    const objWithWake = object as MudObject & {
+      onHeartbeatWake?: (dormantMs: number) => void | Promise<void>;
+    };
+    try {
+      if (typeof objWithWake.onHeartbeatWake === 'function') {
+        await objWithWake.onHeartbeatWake(dormantMs);
+      }
+    } catch (error) {
+      logger.error({ error, objectId: object.objectId }, 'Heartbeat wake error');
+    }
+    await this.executeSingleHeartbeat(object, getMetrics(), this.heartbeatClassOf.get(object));
+  }
 
-    // Check every 100ms for callOuts to execute
+  /**
+   * Map a rate to its class name. Explicit intervals matching a named
+   * class share that class's wheel.
+   */
+  private resolveHeartbeatClass(rate: HeartbeatRate): string {
+    if (typeof rate === 'number') {
+      if (!Number.isFinite(rate) || rate < MIN_HEARTBEAT_INTERVAL_MS) {
+        throw new Error(
+          `Heartbeat interval must be at least ${MIN_HEARTBEAT_INTERVAL_MS}ms, got ${rate}`
+        );
+      }
+      const intervalMs =
+        Math.round(rate / MIN_HEARTBEAT_INTERVAL_MS) * MIN_HEARTBEAT_INTERVAL_MS;
+      if (intervalMs === this.config.heartbeatIntervalMs) return 'normal';
+      for (const [name, classMs] of Object.entries(HEARTBEAT_CLASS_INTERVALS)) {
+        if (intervalMs === classMs) return name;
+      }
+      return `${intervalMs}ms`;
+    }
+    if (rate === 'normal' || Object.hasOwn(HEARTBEAT_CLASS_INTERVALS, rate)) {
+      return rate;
+    }
+    throw new Error(`Unknown heartbeat rate class: ${String(rate)}`);
+  }
+
+  /**
+   * Interval of a resolved class name.
+   */
+  private classIntervalMs(className: string): number {
+    if (className === 'normal') return this.config.heartbeatIntervalMs;
+    const named = HEARTBEAT_CLASS_INTERVALS[className as keyof typeof HEARTBEAT_CLASS_INTERVALS];
+    return named ?? parseInt(className, 10);
+  }
+
+  /**
+   * Get (or create) the wheel for a rate class. Slower classes get more
+   * slots so every wheel ticks at roughly the same slot width.
+   */
+  private getHeartbeatWheel(className: string): HeartbeatWheel {
+    let wheel = this.heartbeatWheels.get(className);
+    if (wheel) return wheel;
+
+    const intervalMs = this.classIntervalMs(className);
+    let slotCount = 1; // Batch mode: everything in a class runs once per interval
+    if (this.config.heartbeatMode === 'staggered') {
+      const slotWidthMs = this.config.heartbeatIntervalMs / this.config.heartbeatSlots;
+      slotCount = Math.min(MAX_HEARTBEAT_SLOTS, Math.max(1, Math.round(intervalMs / slotWidthMs)));
+    }
+
+    wheel = new HeartbeatWheel(
+      { intervalMs, slotCount, sliceBudgetMs: this.config.heartbeatSliceBudgetMs },
+      (object) => this.executeSingleHeartbeat(object, getMetrics(), className)
+    );
+    wheel.onTick = (durationMs) => getMetrics().recordHeartbeatTick(durationMs);
+    this.heartbeatWheels.set(className, wheel);
+    if (this.running) {
+      wheel.start();
+    }
+    return wheel;
+  }
+
+  /**
+   * Drop an object's heartbeat registration entirely.
+   */
+  private removeHeartbeat(object: MudObject): void {
+    const className = this.heartbeatClassOf.get(object);
+    if (className === undefined) return;
+    this.heartbeatClassOf.delete(object);
+    this.removeFromWheel(object, className);
+    this.dormantHeartbeats.delete(object);
+  }
+
+  /**
+   * Take an object off its class wheel. Any class but 'normal' can be an
+   * arbitrary interval, so a wheel left empty is stopped and dropped rather
+   * than left ticking.
+   * @returns true if the object was on the wheel
+   */
+  private removeFromWheel(object: MudObject, className: string): boolean {
+    const wheel = this.heartbeatWheels.get(className);
+    if (!wheel?.remove(object)) return false;
+    if (wheel.size === 0 && className !== 'normal') {
+      wheel.stop();
+      this.heartbeatWheels.delete(className);
+    }
+    return true;
+  }
+
+  /**
+   * Add a callOut to the deadline heap, waking the timer earlier if needed.
+   */
+  private enqueueCallOut(entry: QueuedCallOut): void {
+    this.callOuts.set(entry.id, entry);
+    this.callOutQueue.push(entry);
+    this.armCallOutTimer();
+  }
+
+  /**
+   * Arm the callOut timer for the earliest pending deadline.
+   * Only one timer is ever pending; it is replaced when an earlier callOut arrives.
+   */
+  private armCallOutTimer(): void {
+    if (!this.running || this.executingCallOuts) return;
+
+    const next = this.callOutQueue.peek();
+    if (!next) {
+      this.disarmCallOutTimer();
+      return;
+    }
+
+    // Already armed for this deadline (or an earlier one)
+    if (this.callOutTimer && this.callOutTimerAt <= next.executeAt) return;
+
+    this.disarmCallOutTimer();
+    const now = Date.now();
+    const delay = Math.min(Math.max(0, next.executeAt - now), MAX_TIMER_DELAY_MS);
+    this.callOutTimerAt = now + delay;
     this.callOutTimer = setTimeout(async () => {
+      this.callOutTimer = null;
+      this.callOutTimerAt = Infinity;
       await this.executeCallOuts();
-      this.scheduleCallOutCheck();
-    }, 100);
+      this.armCallOutTimer();
+    }, delay);
+  }
+
+  /**
+   * Cancel the pending callOut timer, if any.
+   */
+  private disarmCallOutTimer(): void {
+    if (this.callOutTimer) {
+      clearTimeout(this.callOutTimer);
+      this.callOutTimer = null;
+    }
+    this.callOutTimerAt = Infinity;
   }
 
   /**
@@ -241,45 +563,73 @@ export class Scheduler {
    */
   private async executeCallOuts(): Promise<void> {
     const now = Date.now();
-    const toExecute: CallOutEntry[] = [];
+    const toExecute: QueuedCallOut[] = [];
     const metrics = getMetrics();
 
-    // Find all callOuts that are due
-    for (const entry of this.callOuts.values()) {
-      if (entry.executeAt <= now) {
-        toExecute.push(entry);
-      }
+    // Pop every callOut that is due; later ones stay in the heap untouched
+    let head = this.callOutQueue.peek();
+    while (head && head.executeAt <= now) {
+      this.callOutQueue.pop();
+      toExecute.push(head);
+      head = this.callOutQueue.peek();
     }
 
-    // Execute and handle recurring
-    for (const entry of toExecute) {
-      const start = Date.now();
-      try {
-        await entry.callback();
-        const elapsed = Date.now() - start;
-        metrics.recordCallOut(elapsed, `callOut#${entry.id}`);
-      } catch (error) {
-        const elapsed = Date.now() - start;
-        metrics.recordCallOut(elapsed, `callOut#${entry.id}`);
-        logger.error({ error }, 'CallOut error');
-      }
-
-      if (entry.recurring && entry.intervalMs) {
-        // Reschedule recurring callOut
-        entry.executeAt = now + entry.intervalMs;
-      } else {
-        // Remove one-time callOut
-        this.callOuts.delete(entry.id);
+    this.executingCallOuts = true;
+    try {
+      // Execute and handle recurring
+      for (const entry of toExecute) {
+        // Cancelled by an earlier callback in this batch
+        if (this.callOuts.get(entry.id) !== entry) continue;
+
+        const start = Date.now();
+        metrics.recordCallOutLateness(start - entry.executeAt);
+        try {
+          await entry.callback();
+          const elapsed = Date.now() - start;
+          metrics.recordCallOut(elapsed, `callOut#${entry.id}`);
+        } catch (error) {
+          const elapsed = Date.now() - start;
+          metrics.recordCallOut(elapsed, `callOut#${entry.id}`);
+          logger.error({ error }, 'CallOut error');
+        }
+
+        // The callback may have cancelled itself
+        if (this.callOuts.get(entry.id) !== entry) continue;
+
+        if (entry.recurring && entry.intervalMs) {
+          // Reschedule on the original cadence, skipping missed intervals
+          entry.executeAt += entry.intervalMs;
+          if (entry.executeAt <= now) {
+            entry.executeAt = now + entry.intervalMs;
+          }
+          this.callOutQueue.push(entry);
+        } else {
+          // Remove one-time callOut
+          this.callOuts.delete(entry.id);
+        }
       }
+    } finally {
+      this.executingCallOuts = false;
     }
   }
 
   /**
-   * Clear all callOuts and heartbeats.
+   * Clear all callOuts and heartbeats. Class wheels other than 'normal' are
+   * stopped and dropped, as removeFromWheel() does when one empties.
    */
   clear(): void {
-    this.heartbeatObjects.clear();
+    for (const [className, wheel] of this.heartbeatWheels) {
+      wheel.clear();
+      if (className !== 'normal') {
+        wheel.stop();
+        this.heartbeatWheels.delete(className);
+      }
+    }
+    this.heartbeatClassOf.clear();
+    this.dormantHeartbeats.clear();
     this.callOuts.clear();
+    this.callOutQueue.clear();
+    this.disarmCallOutTimer();
   }
 
   /**
@@ -288,8 +638,8 @@ export class Scheduler {
    * @param object The object being destroyed
    */
   cleanupForObject(object: MudObject): void {
-    // Remove from heartbeat set
-    this.heartbeatObjects.delete(object);
+    // Remove from its heartbeat wheel (or the dormant set)
+    this.removeHeartbeat(object);
   }
 }
 
@@ -61,13 +61,119 @@ function getPropertyDescriptorFromChain(
   return undefined;
 }
 
+type AnyFunction = (...args: unknown[]) => unknown;
+
+/**
+ * A bound function cached for one property, valid while the property still
+ * resolves to the same function on the same owner.
+ */
+interface BoundEntry {
+  owner: object;
+  source: AnyFunction;
+  bound: AnyFunction;
+}
+
+const NO_CANDIDATES: readonly Shadow[] = [];
+
+/**
+ * Precomputed shadow resolution for one shadowed object.
+ *
+ * Records, for every property name any attached shadow defines, which
+ * shadows define it (in priority order). Properties no shadow defines skip
+ * the shadow walk entirely. Bound functions are cached per property so
+ * repeated method access doesn't allocate. The table is rebuilt lazily after
+ * shadows are added or removed; isActive is still checked on every access.
+ */
+export class ShadowDispatch {
+  private getShadows: () => Shadow[];
+  private overrides: Map<string, readonly Shadow[]> | null = null;
+  private bound: Map<string | symbol, BoundEntry> = new Map();
+
+  constructor(getShadows: () => Shadow[]) {
+    this.getShadows = getShadows;
+  }
+
+  /**
+   * Discard the resolution table and bound functions.
+   */
+  invalidate(): void {
+    this.overrides = null;
+    this.bound.clear();
+  }
+
+  /**
+   * Shadows that define a property, highest priority first.
+   */
+  candidatesFor(prop: string): readonly Shadow[] {
+    return (this.overrides ??= this.build()).get(prop) ?? NO_CANDIDATES;
+  }
+
+  /**
+   * Find the first active shadow overriding a property.
+   */
+  resolve(prop: string): { shadow: Shadow; value: unknown } | undefined {
+    for (const shadow of this.candidatesFor(prop)) {
+      if (!shadow.isActive) continue;
+      const value = shadow[prop];
+      if (value !== undefined) {
+        return { shadow, value };
+      }
+    }
+    return undefined;
+  }
+
+  /**
+   * Get a function bound to its owner, reusing the previous binding when
+   * the property still resolves to the same function.
+   */
+  bind(prop: string | symbol, owner: object, source: AnyFunction): AnyFunction {
+    const entry = this.bound.get(prop);
+    if (entry && entry.owner === owner && entry.source === source) {
+      return entry.bound;
+    }
+    const bound = source.bind(owner) as AnyFunction;
+    this.bound.set(prop, { owner, source, bound });
+    return bound;
+  }
+
+  private build(): Map<string, readonly Shadow[]> {
+    const table = new Map<string, Shadow[]>();
+    // Shadows are kept sorted by priority, so candidate lists are too
+    for (const shadow of this.getShadows()) {
+      for (const prop of shadowPropertyNames(shadow)) {
+        let candidates = table.get(prop);
+        if (!candidates) {
+          candidates = [];
+          table.set(prop, candidates);
+        }
+        candidates.push(shadow);
+      }
+    }
+    return table;
+  }
+}
+
+/**
+ * All string property names a shadow exposes, own and inherited.
+ */
+function shadowPropertyNames(shadow: Shadow): Set<string> {
+  const names = new Set<string>();
+  let current: object | null = shadow;
+  while (current && current !== Object.prototype) {
+    for (const name of Object.getOwnPropertyNames(current)) {
+      if (name !== 'constructor') {
+        names.add(name);
+      }
+    }
+    current = Object.getPrototypeOf(current);
+  }
+  return names;
+}
+
 /**
  * Create a Proxy handler for shadow interception.
  */
-function createShadowHandler(
-  target: MudObject,
-  getShadows: () => Shadow[]
-): ProxyHandler<MudObject> {
+function createShadowHandler(dispatch: ShadowDispatch): ProxyHandler<MudObject> {
   return {
     get(obj: MudObject, prop: string | symbol, receiver: unknown): unknown {
       // Check for proxy marker - indicates this is already a proxy
@@ -80,38 +186,23 @@ function createShadowHandler(
         return obj;
       }
 
-      // Skip symbol properties and unshadowable properties
-      if (typeof prop === 'symbol' || UNSHADOWABLE_PROPERTIES.has(prop)) {
-        const value = Reflect.get(obj, prop, receiver);
-        // Bind functions to the original object
-        if (typeof value === 'function') {
-          return value.bind(obj);
-        }
-        return value;
-      }
-
-      // Get current shadows and check each in priority order
-      const shadows = getShadows();
-      for (const shadow of shadows) {
-        if (!shadow.isActive) continue;
-
-        // Check if shadow has this property
-        const shadowValue = shadow[prop];
-        if (shadowValue !== undefined) {
-          // If it's a function, bind to shadow context
-          if (typeof shadowValue === 'function') {
-            return function (this: unknown, ...args: unknown[]): unknown {
-              return shadowValue.call(shadow, ...args);
-            };
+      // Symbol and unshadowable properties, or properties no shadow defines,
+      // go straight to the original object
+      if (typeof prop !== 'symbol' && !UNSHADOWABLE_PROPERTIES.has(prop)) {
+        const override = dispatch.resolve(prop);
+        if (override) {
+          // Shadow methods run with the shadow as `this`
+          if (typeof override.value === 'function') {
+            return dispatch.bind(prop, override.shadow, override.value as AnyFunction);
           }
-          return shadowValue;
+          return override.value;
         }
       }
 
-      // No shadow override - use original value
+      // No shadow override - use original value, bound to the original object
       const value = Reflect.get(obj, prop, receiver);
       if (typeof value === 'function') {
-        return value.bind(obj);
+        return dispatch.bind(prop, obj, value as AnyFunction);
       }
       return value;
     },
@@ -150,6 +241,31 @@ export class ShadowRegistry {
   /** Map objectId -> Proxy (cached for performance) */
   private proxyCache: Map<string, MudObject> = new Map();
 
+  /**
+   * Map objectId -> precomputed resolution table. Kept for the object's
+   * lifetime so proxies handed out earlier see later shadow changes.
+   */
+  private dispatch: Map<string, ShadowDispatch> = new Map();
+
+  /**
+   * Get (or create) the resolution table for an object.
+   */
+  private getDispatch(objectId: string): ShadowDispatch {
+    let dispatch = this.dispatch.get(objectId);
+    if (!dispatch) {
+      dispatch = new ShadowDispatch(() => this.getShadows(objectId));
+      this.dispatch.set(objectId, dispatch);
+    }
+    return dispatch;
+  }
+
+  /**
+   * Drop precomputed resolution after the object's shadows changed.
+   */
+  private invalidateDispatch(objectId: string): void {
+    this.dispatch.get(objectId)?.invalidate();
+  }
+
   /**
    * Install shadow-aware property descriptors on a target object.
    * This allows internal property access (this.property) to check shadows.
@@ -162,6 +278,7 @@ export class ShadowRegistry {
     if (existing) return;
 
     const originalDescriptors: Record<string, PropertyDescriptor> = {};
+    const dispatch = this.getDispatch(objectId);
 
     for (const prop of SHADOWABLE_PROPERTIES) {
       // Get the original descriptor from the prototype chain
@@ -172,25 +289,19 @@ export class ShadowRegistry {
       originalDescriptors[prop] = originalDescriptor;
 
       // Create shadow-aware getter
-      const getShadows = this.getShadows.bind(this);
       const originalGetter = originalDescriptor.get;
       const originalSetter = originalDescriptor.set;
 
       const newDescriptor: PropertyDescriptor = {
         get(): unknown {
           // Check shadows first
-          const shadows = getShadows(objectId);
-          for (const shadow of shadows) {
-            if (!shadow.isActive) continue;
-
-            const shadowValue = (shadow as Record<string, unknown>)[prop];
-            if (shadowValue !== undefined) {
-              // If it's a getter function on the shadow, call it
-              if (typeof shadowValue === 'function') {
-                return shadowValue.call(shadow);
-              }
-              return shadowValue;
+          const override = dispatch.resolve(prop);
+          if (override) {
+            // If it's a getter function on the shadow, call it
+            if (typeof override.value === 'function') {
+              return override.value.call(override.shadow);
             }
+            return override.value;
           }
 
           // Fall back to original getter
@@ -229,15 +340,12 @@ export class ShadowRegistry {
       }
 
       // Create shadow-aware method wrapper
-      const getShadows = this.getShadows.bind(this);
-
       (target as unknown as Record<string, unknown>)[methodName] = function (
         this: unknown,
         ...args: unknown[]
       ): unknown {
-        // Check shadows first
-        const shadows = getShadows(objectId);
-        for (const shadow of shadows) {
+        // Check shadows first (only those defining this method)
+        for (const shadow of dispatch.candidatesFor(methodName)) {
           if (!shadow.isActive) continue;
 
           const shadowMethod = (shadow as Record<string, unknown>)[methodName];
@@ -322,8 +430,9 @@ export class ShadowRegistry {
       this.installShadowDescriptors(original, objectId);
     }
 
-    // Invalidate proxy cache for this object
+    // Invalidate proxy cache and resolution table for this object
     this.proxyCache.delete(objectId);
+    this.invalidateDispatch(objectId);
 
     // Call onAttach hook
     if (shadow.onAttach) {
@@ -383,8 +492,9 @@ export class ShadowRegistry {
       this.restoreShadowDescriptors(original);
     }
 
-    // Invalidate proxy cache
+    // Invalidate proxy cache and resolution table
     this.proxyCache.delete(objectId);
+    this.invalidateDispatch(objectId);
 
     return true;
   }
@@ -419,6 +529,14 @@ export class ShadowRegistry {
     return shadows !== undefined && shadows.length > 0;
   }
 
+  /**
+   * Check if any object currently has shadows. Lets callers skip per-object
+   * proxy lookups entirely in the common unshadowed case.
+   */
+  hasAnyShadows(): boolean {
+    return this.shadows.size > 0;
+  }
+
   /**
    * Clear all shadows from an object.
    * @param target The object to clear shadows from
@@ -447,6 +565,7 @@ export class ShadowRegistry {
     // Remove all shadows
     this.shadows.delete(objectId);
     this.proxyCache.delete(objectId);
+    this.invalidateDispatch(objectId);
 
     // Restore original property descriptors
     this.restoreShadowDescriptors(original);
@@ -480,7 +599,7 @@ export class ShadowRegistry {
     }
 
     // Create new proxy
-    const handler = createShadowHandler(object, () => this.getShadows(objectId));
+    const handler = createShadowHandler(this.getDispatch(objectId));
     const proxy = new Proxy(object, handler) as MudObject;
 
     // Cache it
@@ -518,6 +637,7 @@ export class ShadowRegistry {
     if (!objectShadows || objectShadows.length === 0) {
       this.shadows.delete(objectId);
       this.proxyCache.delete(objectId);
+      this.dispatch.delete(objectId);
       return;
     }
 
@@ -538,6 +658,8 @@ export class ShadowRegistry {
 
     this.shadows.delete(objectId);
     this.proxyCache.delete(objectId);
+    this.dispatch.get(objectId)?.invalidate();
+    this.dispatch.delete(objectId);
 
     // Restore original property descriptors if we have the target
     if (target) {
@@ -586,6 +708,7 @@ export class ShadowRegistry {
   clear(): void {
     this.shadows.clear();
     this.proxyCache.clear();
+    this.dispatch.clear();
   }
 }
 
@@ -96,6 +96,10 @@ export const UNSHADOWABLE_PROPERTIES: Set<string | symbol> = new Set([
   '_setupAsClone',
   '_environment',
   '_inventory',
+  '_inventoryView',
+  '_occupants',
+  '_occupantViews',
+  '_occupantCategories',
   '_objectPath',
   '_objectId',
   '_isClone',
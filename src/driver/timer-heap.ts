@@ -0,0 +1,144 @@
+/**
+ * TimerHeap - Indexed binary min-heap of timed entries.
+ *
+ * Orders entries by their due time (ties broken by id, so entries scheduled
+ * for the same instant fire in insertion order). Each entry tracks its own
+ * position in the heap, which makes removal of an arbitrary entry O(log n)
+ * instead of requiring a linear search.
+ */
+
+/**
+ * An entry that can be stored in a TimerHeap.
+ */
+export interface TimerHeapEntry {
+  /** Unique, monotonically increasing ID (used as a tie-breaker) */
+  id: number;
+  /** When the entry is due (timestamp) */
+  executeAt: number;
+  /** Position in the heap array, or -1 when not queued. Managed by the heap. */
+  heapIndex: number;
+}
+
+/**
+ * Binary min-heap keyed on executeAt.
+ */
+export class TimerHeap<T extends TimerHeapEntry> {
+  private heap: T[] = [];
+
+  /**
+   * Number of queued entries.
+   */
+  get size(): number {
+    return this.heap.length;
+  }
+
+  /**
+   * Get the entry with the earliest due time without removing it.
+   */
+  peek(): T | undefined {
+    return this.heap[0];
+  }
+
+  /**
+   * Add an entry to the heap.
+   */
+  push(entry: T): void {
+    entry.heapIndex = this.heap.length;
+    this.heap.push(entry);
+    this.siftUp(entry.heapIndex);
+  }
+
+  /**
+   * Remove and return the entry with the earliest due time.
+   */
+  pop(): T | undefined {
+    const top = this.heap[0];
+    if (!top) return undefined;
+    this.removeAt(0);
+    return top;
+  }
+
+  /**
+   * Remove a specific entry from the heap.
+   * @returns true if the entry was queued and has been removed
+   */
+  remove(entry: T): boolean {
+    const index = entry.heapIndex;
+    if (index < 0 || this.heap[index] !== entry) {
+      return false;
+    }
+    this.removeAt(index);
+    return true;
+  }
+
+  /**
+   * Remove all entries.
+   */
+  clear(): void {
+    for (const entry of this.heap) {
+      entry.heapIndex = -1;
+    }
+    this.heap = [];
+  }
+
+  private removeAt(index: number): void {
+    const removed = this.heap[index]!;
+    const last = this.heap.pop()!;
+    removed.heapIndex = -1;
+
+    if (index < this.heap.length) {
+      this.heap[index] = last;
+      last.heapIndex = index;
+      // The moved entry may need to travel either direction
+      if (!this.siftUp(index)) {
+        this.siftDown(index);
+      }
+    }
+  }
+
+  private less(a: T, b: T): boolean {
+    return a.executeAt < b.executeAt || (a.executeAt === b.executeAt && a.id < b.id);
+  }
+
+  private swap(i: number, j: number): void {
+    const a = this.heap[i]!;
+    const b = this.heap[j]!;
+    this.heap[i] = b;
+    this.heap[j] = a;
+    a.heapIndex = j;
+    b.heapIndex = i;
+  }
+
+  /**
+   * @returns true if the entry moved
+   */
+  private siftUp(index: number): boolean {
+    let i = index;
+    while (i > 0) {
+      const parent = (i - 1) >> 1;
+      if (!this.less(this.heap[i]!, this.heap[parent]!)) break;
+      this.swap(i, parent);
+      i = parent;
+    }
+    return i !== index;
+  }
+
+  private siftDown(index: number): void {
+    const length = this.heap.length;
+    let i = index;
+    for (;;) {
+      const left = 2 * i + 1;
+      const right = left + 1;
+      let smallest = i;
+      if (left < length && this.less(this.heap[left]!, this.heap[smallest]!)) {
+        smallest = left;
+      }
+      if (right < length && this.less(this.heap[right]!, this.heap[smallest]!)) {
+        smallest = right;
+      }
+      if (smallest === i) break;
+      this.swap(i, smallest);
+      i = smallest;
+    }
+  }
+}
@@ -2,10 +2,19 @@
  * ScriptRunner - Executes scripts in a sandboxed environment with resource limits.
  *
  * Handles compilation, execution, timeout enforcement, and error capture.
+ *
+ * Compiled scripts are cached per isolate by content hash, and V8 code cache
+ * data is shared across isolates so a script compiled once compiles cheaply
+ * in every other isolate. In warm-context mode each isolate also keeps an
+ * initialized context that is reused across runs and recycled after
+ * contextMaxRuns runs or any failed run.
  */
 
+import { createHash } from 'node:crypto';
+import type ivm from 'isolated-vm';
 import { IsolatePool, getIsolatePool, type PooledIsolate } from './isolate-pool.js';
 import { Sandbox, type ExposedFunction } from './sandbox.js';
+import { getMetrics } from '../driver/metrics.js';
 
 export interface ScriptRunnerConfig {
   /** Default timeout for script execution in milliseconds */
@@ -14,6 +23,30 @@ export interface ScriptRunnerConfig {
   memoryLimitMb: number;
   /** Maximum number of isolates in the pool */
   maxIsolates: number;
+  /**
+   * Reuse an initialized context across runs instead of creating one per
+   * run. Globals defined by one run are visible to later runs on the same
+   * context, so only enable this for trusted callers.
+   */
+  warmContexts: boolean;
+  /** Recycle a warm context after this many runs */
+  contextMaxRuns: number;
+  /** Maximum compiled scripts cached per isolate (and code cache entries) */
+  scriptCacheSize: number;
+}
+
+/**
+ * Per-isolate state kept between runs.
+ */
+interface IsolateState {
+  /** Compiled scripts by content hash, least recently used first */
+  scripts: Map<string, ivm.Script>;
+  /** Initialized context ready for the next run (warm mode only) */
+  warm: Sandbox | null;
+  /** Runs executed on the current warm context */
+  warmRuns: number;
+  /** Exposed-function version the warm context was built with */
+  warmVersion: number;
 }
 
 export interface ExecutionResult<T = unknown> {
@@ -38,12 +71,23 @@ export class ScriptRunner {
   private config: ScriptRunnerConfig;
   private pool: IsolatePool;
   private exposedFunctions: ExposedFunction[] = [];
+  /** Bumped when exposed functions change, so warm contexts get rebuilt */
+  private functionsVersion: number = 0;
+  private isolateState: WeakMap<ivm.Isolate, IsolateState> = new WeakMap();
+  /** V8 code cache data by content hash, shared by all isolates */
+  private codeCache: Map<string, ivm.ExternalCopy<ArrayBuffer>> = new Map();
+  private scriptCacheHits: number = 0;
+  private scriptCacheMisses: number = 0;
+  private contextsCreated: number = 0;
 
   constructor(config: Partial<ScriptRunnerConfig> = {}) {
     this.config = {
       defaultTimeoutMs: config.defaultTimeoutMs ?? 5000,
       memoryLimitMb: config.memoryLimitMb ?? 128,
       maxIsolates: config.maxIsolates ?? 4,
+      warmContexts: config.warmContexts ?? false,
+      contextMaxRuns: Math.max(1, config.contextMaxRuns ?? 100),
+      scriptCacheSize: Math.max(1, config.scriptCacheSize ?? 64),
     };
 
     this.pool = getIsolatePool({
@@ -57,6 +101,7 @@ export class ScriptRunner {
    */
   registerFunction(func: ExposedFunction): void {
     this.exposedFunctions.push(func);
+    this.functionsVersion++;
   }
 
   /**
@@ -67,27 +112,33 @@ export class ScriptRunner {
   async run<T = unknown>(code: string, timeoutMs?: number): Promise<ExecutionResult<T>> {
     const startTime = Date.now();
     const timeout = timeoutMs ?? this.config.defaultTimeoutMs;
+    const hash = createHash('sha256').update(code).digest('hex');
 
     let pooledIsolate: PooledIsolate | null = null;
+    let state: IsolateState | null = null;
     let sandbox: Sandbox | null = null;
+    let succeeded = false;
 
     try {
       // Acquire an isolate from the pool
       pooledIsolate = await this.pool.acquire();
+      state = this.getIsolateState(pooledIsolate.isolate);
 
-      // Create sandbox
-      sandbox = new Sandbox(pooledIsolate.isolate);
-
-      // Register all exposed functions
-      for (const func of this.exposedFunctions) {
-        sandbox.registerFunction(func);
+      // Take the warm context, or create a fresh one
+      sandbox = this.config.warmContexts ? state.warm : null;
+      if (sandbox && state.warmVersion !== this.functionsVersion) {
+        sandbox.dispose();
+        sandbox = null;
       }
+      if (!sandbox) {
+        sandbox = await this.createSandbox(pooledIsolate.isolate);
+        state.warmRuns = 0;
+        state.warmVersion = this.functionsVersion;
+      }
+      state.warm = null;
 
-      // Initialize the sandbox
-      await sandbox.initialize();
-
-      // Compile the script
-      const script = await pooledIsolate.isolate.compileScript(code);
+      // Compile the script (or reuse a cached compilation)
+      const script = await this.compile(pooledIsolate.isolate, state, code, hash);
 
       // Execute with timeout
       const result = await script.run(sandbox.getContext(), {
@@ -96,6 +147,7 @@ export class ScriptRunner {
 
       // Get the result value
       const value = result !== undefined ? (result as T) : undefined;
+      succeeded = true;
 
       return {
         success: true,
@@ -105,14 +157,98 @@ export class ScriptRunner {
     } catch (error) {
       return this.handleError<T>(error, startTime);
     } finally {
-      // Clean up
-      if (sandbox) {
-        sandbox.dispose();
+      // Keep a healthy warm context for the next run; dispose everything else
+      if (sandbox && state && pooledIsolate) {
+        if (pooledIsolate.isolate.isDisposed) {
+          this.isolateState.delete(pooledIsolate.isolate);
+        } else if (
+          this.config.warmContexts &&
+          succeeded &&
+          ++state.warmRuns < this.config.contextMaxRuns
+        ) {
+          state.warm = sandbox;
+        } else {
+          sandbox.dispose();
+        }
       }
       if (pooledIsolate) {
         this.pool.release(pooledIsolate);
       }
+      // Identify the run by hash so script source never reaches perf output
+      getMetrics().recordScriptRun(Date.now() - startTime, `script ${hash.slice(0, 12)}`);
+    }
+  }
+
+  /**
+   * Create and initialize a sandbox with all exposed functions.
+   */
+  private async createSandbox(isolate: ivm.Isolate): Promise<Sandbox> {
+    const sandbox = new Sandbox(isolate);
+    for (const func of this.exposedFunctions) {
+      sandbox.registerFunction(func);
     }
+    await sandbox.initialize();
+    this.contextsCreated++;
+    return sandbox;
+  }
+
+  /**
+   * Get the cached state for an isolate, creating it on first use.
+   */
+  private getIsolateState(isolate: ivm.Isolate): IsolateState {
+    let state = this.isolateState.get(isolate);
+    if (!state) {
+      state = { scripts: new Map(), warm: null, warmRuns: 0, warmVersion: this.functionsVersion };
+      this.isolateState.set(isolate, state);
+    }
+    return state;
+  }
+
+  /**
+   * Compile a script in an isolate, reusing a previous compilation of the
+   * same source (keyed by its sha256 hash) when possible.
+   */
+  private async compile(
+    isolate: ivm.Isolate,
+    state: IsolateState,
+    code: string,
+    hash: string
+  ): Promise<ivm.Script> {
+
+    const cached = state.scripts.get(hash);
+    if (cached) {
+      // Move to the most recently used end
+      state.scripts.delete(hash);
+      state.scripts.set(hash, cached);
+      this.scriptCacheHits++;
+      return cached;
+    }
+    this.scriptCacheMisses++;
+
+    const cachedData = this.codeCache.get(hash);
+    const script = cachedData
+      ? await isolate.compileScript(code, { cachedData })
+      : await isolate.compileScript(code, { produceCachedData: true });
+
+    if (cachedData && script.cachedDataRejected) {
+      this.codeCache.delete(hash);
+      cachedData.release();
+    } else if (!cachedData && script.cachedData) {
+      this.codeCache.set(hash, script.cachedData);
+      if (this.codeCache.size > this.config.scriptCacheSize) {
+        const [oldest, data] = this.codeCache.entries().next().value!;
+        this.codeCache.delete(oldest);
+        data.release();
+      }
+    }
+
+    state.scripts.set(hash, script);
+    if (state.scripts.size > this.config.scriptCacheSize) {
+      const [oldest, evicted] = state.scripts.entries().next().value!;
+      state.scripts.delete(oldest);
+      evicted.release();
+    }
+    return script;
   }
 
   /**
@@ -188,16 +324,33 @@ export class ScriptRunner {
   }
 
   /**
-   * Get pool statistics.
+   * Get pool and cache statistics.
    */
-  getStats(): ReturnType<IsolatePool['getStats']> {
-    return this.pool.getStats();
+  getStats(): ReturnType<IsolatePool['getStats']> & {
+    warmContexts: boolean;
+    contextsCreated: number;
+    scriptCacheHits: number;
+    scriptCacheMisses: number;
+    codeCacheEntries: number;
+  } {
+    return {
+      ...this.pool.getStats(),
+      warmContexts: this.config.warmContexts,
+      contextsCreated: this.contextsCreated,
+      scriptCacheHits: this.scriptCacheHits,
+      scriptCacheMisses: this.scriptCacheMisses,
+      codeCacheEntries: this.codeCache.size,
+    };
   }
 
   /**
    * Dispose the script runner and its pool.
    */
   dispose(): void {
+    for (const data of this.codeCache.values()) {
+      data.release();
+    }
+    this.codeCache.clear();
     this.pool.dispose();
   }
 }
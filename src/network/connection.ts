@@ -8,6 +8,8 @@
 import type { WebSocket } from 'ws';
 import { EventEmitter } from 'events';
 import { getLogger } from '../driver/logger.js';
+import { getCommandTracer } from '../driver/command-tracer.js';
+import { getMetrics } from '../driver/metrics.js';
 
 // Protocol message types - canonical definitions in shared module
 import type {
@@ -78,6 +80,16 @@ export interface ConnectionEvents {
   backpressure: (bufferedAmount: number) => void;
 }
 
+/**
+ * Output coalescing settings.
+ */
+export interface OutputCoalescingConfig {
+  /** Hold output and send it as one frame instead of a frame per message */
+  enabled: boolean;
+  /** How long output is held in ms; 0 sends it at the end of the event-loop turn */
+  windowMs: number;
+}
+
 type EventArgs<T, K extends keyof T> = T[K] extends (...args: infer A) => void ? A : never;
 
 /**
@@ -122,6 +134,8 @@ const MAX_MESSAGE_BUFFER_SIZE = 50;
 const BUFFER_LOG_INTERVAL_MS = 1000;
 const TCP_DRAIN_LOG_INTERVAL_MS = 1000;
 const BACKPRESSURE_WARN_INTERVAL_MS = 10_000;
+/** Held output is sent at once when it reaches this size (64KB) */
+const MAX_COALESCED_FRAME_SIZE = 64 * 1024;
 
 /**
  * A single client connection.
@@ -151,6 +165,15 @@ export class Connection extends EventEmitter {
   // Message buffer for session resume replay
   private _messageBuffer: string[] = [];
 
+  // Output held for coalescing into one frame
+  private _output: OutputCoalescingConfig;
+  private _outBuffer: string[] = [];
+  private _outBytes: number = 0;
+  private _outMessages: number = 0;
+  private _outFlush: ReturnType<typeof setTimeout> | ReturnType<typeof setImmediate> | null = null;
+  private _messagesSent: number = 0;
+  private _framesSent: number = 0;
+
   /**
    * Typed event subscription helper.
    */
@@ -172,12 +195,21 @@ export class Connection extends EventEmitter {
     return this.emit(event as string, ...args);
   }
 
-  constructor(socket: WebSocket, id: string, remoteAddress: string = 'unknown') {
+  constructor(
+    socket: WebSocket,
+    id: string,
+    remoteAddress: string = 'unknown',
+    output: Partial<OutputCoalescingConfig> = {}
+  ) {
     super();
     this.socket = socket;
     this._id = id;
     this._remoteAddress = remoteAddress;
     this._connectedAt = new Date();
+    this._output = {
+      enabled: output.enabled ?? true,
+      windowMs: output.windowMs ?? 0,
+    };
 
     logger.debug({ id, remoteAddress }, 'Connection created');
 
@@ -413,7 +445,7 @@ export class Connection extends EventEmitter {
       return;
     }
 
-    const bufferedAmount = this.socket.bufferedAmount || 0;
+    const bufferedAmount = this.queuedBytes();
     const messageSize = Buffer.byteLength(message, 'utf8');
 
     // Track max buffer and log at every 100KB threshold crossed
@@ -493,18 +525,128 @@ export class Connection extends EventEmitter {
       this._backpressureWarned = false;
     }
 
-    try {
-      this.socket.send(message);
-
+    if (this.writeOutput(message, messageSize)) {
       // Buffer messages for session resume replay (only if player is bound)
       if (this._player) {
         this.bufferMessage(message);
       }
+    }
+  }
+
+  /**
+   * Write a message, holding it for the next frame when coalescing.
+   *
+   * Clients split every frame into lines and handle each line as a text or
+   * protocol message, so messages are joined with a newline wherever the
+   * previous one doesn't end in one. The client sees the same lines in the
+   * same order as it would from a frame per message.
+   * @returns false if the write failed
+   */
+  private writeOutput(message: string, messageSize: number): boolean {
+    if (!this._output.enabled) {
+      return this.writeFrame(message, messageSize, 1);
+    }
+    if (message.length === 0) {
+      return true; // An empty frame has no lines
+    }
+
+    const previous = this._outBuffer[this._outBuffer.length - 1];
+    if (previous !== undefined && !previous.endsWith('\n')) {
+      this._outBuffer.push('\n');
+      this._outBytes++;
+    }
+    this._outBuffer.push(message);
+    this._outBytes += messageSize;
+    this._outMessages++;
+
+    if (this._outBytes >= MAX_COALESCED_FRAME_SIZE) {
+      this.flush();
+    } else if (this._outFlush === null) {
+      this._outFlush =
+        this._output.windowMs > 0
+          ? setTimeout(() => {
+              this._outFlush = null;
+              this.flush();
+            }, this._output.windowMs)
+          : setImmediate(() => {
+              this._outFlush = null;
+              this.flush();
+            });
+    }
+    return true;
+  }
+
+  /**
+   * Send held output now as one frame.
+   * The driver calls this when a command finishes so its output isn't delayed.
+   */
+  flush(): void {
+    this.cancelOutputFlush();
+    if (this._outBuffer.length === 0) {
+      return;
+    }
+
+    const frame = this._outBuffer.join('');
+    const frameSize = this._outBytes;
+    const messages = this._outMessages;
+    this._outBuffer = [];
+    this._outBytes = 0;
+    this._outMessages = 0;
+
+    if (this._state === 'open') {
+      this.writeFrame(frame, frameSize, messages);
+    }
+  }
+
+  /**
+   * Write one frame to the socket.
+   * @param messages Messages in the frame
+   */
+  private writeFrame(frame: string, frameSize: number, messages: number): boolean {
+    try {
+      const trace = getCommandTracer().current();
+      const started = trace ? performance.now() : 0;
+      this.socket.send(frame);
+      trace?.recordSend(frameSize, performance.now() - started, messages);
+      this._messagesSent += messages;
+      this._framesSent++;
+      getMetrics().recordOutputFrame(messages);
+      return true;
     } catch (error) {
       this.emitEvent('error', error as Error);
+      return false;
     }
   }
 
+  /**
+   * Cancel a pending flush of held output.
+   */
+  private cancelOutputFlush(): void {
+    if (this._outFlush !== null) {
+      if (this._output.windowMs > 0) {
+        clearTimeout(this._outFlush as ReturnType<typeof setTimeout>);
+      } else {
+        clearImmediate(this._outFlush as ReturnType<typeof setImmediate>);
+      }
+      this._outFlush = null;
+    }
+  }
+
+  /**
+   * Bytes waiting to go out: the socket buffer plus held output.
+   */
+  private queuedBytes(): number {
+    return (this.socket.bufferedAmount || 0) + this._outBytes;
+  }
+
+  /**
+   * Messages and frames written to this connection so far.
+   * Without coalescing every message is a frame.
+   */
+  getOutputStats(): { messages: number; frames: number } {
+    return { messages: this._messagesSent, frames: this._framesSent };
+  }
+
   /**
    * Add a message to the replay buffer.
    * Maintains a circular buffer of recent messages.
@@ -569,19 +711,14 @@ export class Connection extends EventEmitter {
       return;
     }
 
-    // Drain regular messages
-    while (
-      this._pendingMessages.length > 0 &&
-      (this.socket.bufferedAmount || 0) < BACKPRESSURE_THRESHOLD
-    ) {
+    // Drain regular messages, coalesced into as few frames as fit
+    while (this._pendingMessages.length > 0 && this.queuedBytes() < BACKPRESSURE_THRESHOLD) {
       const message = this._pendingMessages.shift()!;
-      try {
-        this.socket.send(message);
-      } catch (error) {
-        this.emitEvent('error', error as Error);
+      if (!this.writeOutput(message, Buffer.byteLength(message, 'utf8'))) {
         break;
       }
     }
+    this.flush();
 
     // Schedule another drain if we still have messages
     if (this._pendingMessages.length > 0) {
@@ -639,7 +776,7 @@ export class Connection extends EventEmitter {
       return false; // Silently skip - will refresh when visible
     }
 
-    const bufferedAmount = this.socket.bufferedAmount || 0;
+    const bufferedAmount = this.queuedBytes();
 
     // Guardrail: never send oversized protocol frames.
     // ENGAGE overlays can legitimately carry larger image payloads.
@@ -672,13 +809,7 @@ export class Connection extends EventEmitter {
       this._backpressureWarned = false;
     }
 
-    try {
-      this.socket.send(message);
-      return true;
-    } catch (error) {
-      this.emitEvent('error', error as Error);
-      return false;
-    }
+    return this.writeOutput(message, messageSize);
   }
 
   /**
@@ -877,15 +1008,11 @@ export class Connection extends EventEmitter {
    * Checks buffer before sending to avoid adding to an already full buffer.
    */
   sendTimePong(timestamp: string): void {
-    const bufferedAmount = this.socket.bufferedAmount || 0;
-    if (bufferedAmount > HARD_STOP_BUFFER_SIZE) {
+    if (this._state !== 'open' || this.queuedBytes() > HARD_STOP_BUFFER_SIZE) {
       return; // Don't add to buffer if it's already too full
     }
-    try {
-      this.socket.send(`\x00[TIME_PONG]${timestamp}`);
-    } catch {
-      // Ignore send errors
-    }
+    const message = `\x00[TIME_PONG]${timestamp}`;
+    this.writeOutput(message, Buffer.byteLength(message, 'utf8'));
   }
 
   /**
@@ -1019,6 +1146,8 @@ export class Connection extends EventEmitter {
     const closeReason = reason || 'Connection closed';
     logger.debug({ id: this._id, player: playerName, code: closeCode, reason: closeReason }, 'Closing connection');
 
+    // Send held output (e.g. a goodbye message) ahead of the close frame
+    this.flush();
     this.setState('closing');
 
     // Clean up resources
@@ -1038,6 +1167,7 @@ export class Connection extends EventEmitter {
   private cleanup(): void {
     // Clear pending drain timeout
     this.clearDrainTimeout();
+    this.cancelOutputFlush();
 
     // Remove all listeners from the socket to prevent memory leaks
     this.socket.removeAllListeners();
@@ -1048,6 +1178,9 @@ export class Connection extends EventEmitter {
     // Clear message buffers
     this._messageBuffer = [];
     this._pendingMessages = [];
+    this._outBuffer = [];
+    this._outBytes = 0;
+    this._outMessages = 0;
     this._inputBuffer = '';
   }
 
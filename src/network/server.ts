@@ -10,7 +10,7 @@ import fastifyWebsocket from '@fastify/websocket';
 import { WebSocket } from 'ws';
 import { join, resolve } from 'path';
 import { readFile, writeFile, mkdir } from 'fs/promises';
-import { Connection } from './connection.js';
+import { Connection, type OutputCoalescingConfig } from './connection.js';
 import { ConnectionManager, getConnectionManager } from './connection-manager.js';
 import { EventEmitter } from 'events';
 import type { Logger } from 'pino';
@@ -38,6 +38,10 @@ export interface ServerConfig {
   wsHeartbeatIntervalMs?: number;
   /** Maximum missed pong responses before terminating connection (default: 2) */
   wsMaxMissedPongs?: number;
+  /** Coalesce each connection's output into fewer frames (default: true) */
+  wsOutputCoalesce?: boolean;
+  /** How long output is held for coalescing in ms; 0 is the end of the event-loop turn (default: 0) */
+  wsOutputCoalesceMs?: number;
 }
 
 /**
@@ -76,6 +80,7 @@ export class Server extends EventEmitter {
   private heartbeatInterval: ReturnType<typeof setInterval> | null = null;
   private heartbeatIntervalMs: number;
   private maxMissedPongs: number;
+  private outputCoalescing: OutputCoalescingConfig;
   private readonly apiRateLimitPerMinute: number;
   private readonly wsRateLimitPerMinute: number;
   private apiRateLimitMap: Map<string, { count: number; windowStart: number }> = new Map();
@@ -112,6 +117,10 @@ export class Server extends EventEmitter {
     // Initialize WebSocket heartbeat settings from config
     this.heartbeatIntervalMs = config.wsHeartbeatIntervalMs ?? DEFAULT_HEARTBEAT_INTERVAL_MS;
     this.maxMissedPongs = config.wsMaxMissedPongs ?? DEFAULT_MAX_MISSED_PONGS;
+    this.outputCoalescing = {
+      enabled: config.wsOutputCoalesce ?? true,
+      windowMs: config.wsOutputCoalesceMs ?? 0,
+    };
     this.apiRateLimitPerMinute = Number.parseInt(process.env['API_RATE_LIMIT_PER_MINUTE'] ?? '120', 10);
     this.wsRateLimitPerMinute = Number.parseInt(process.env['WS_CONNECT_RATE_LIMIT_PER_MINUTE'] ?? '40', 10);
 
@@ -359,6 +368,7 @@ export class Server extends EventEmitter {
           'corpse.npcDecayMinutes': { value: 5, description: 'Minutes before NPC corpses decay', type: 'number', min: 1, max: 60, category: 'Corpses' },
           'reset.intervalMinutes': { value: 15, description: 'Minutes between room resets', type: 'number', min: 5, max: 120, category: 'Room Resets' },
           'reset.cleanupDroppedItems': { value: true, description: 'Clean up non-player-owned items during room reset', type: 'boolean', category: 'Room Resets' },
+          'reset.batchBudgetMs': { value: 10, description: 'Milliseconds of room resets to run per batch (resets are spread over the interval)', type: 'number', min: 1, max: 100, category: 'Room Resets' },
           'time.enabled': { value: true, description: 'Enable the day/night cycle (affects outdoor room lighting)', type: 'boolean', category: 'Day/Night Cycle' },
           'time.cycleDurationMinutes': { value: 60, description: 'Real minutes per game day (60 = 1 real hour per 24 game hours)', type: 'number', min: 1, max: 1440, category: 'Day/Night Cycle' },
           'giphy.enabled': { value: true, description: 'Enable Giphy GIF sharing on channels', type: 'boolean', category: 'Giphy' },
@@ -498,7 +508,7 @@ export class Server extends EventEmitter {
       return;
     }
 
-    const connection = new Connection(socket, id, remoteAddress);
+    const connection = new Connection(socket, id, remoteAddress, this.outputCoalescing);
     this.connectionManager.add(connection);
 
     // Forward events with error boundaries to prevent exceptions from affecting other connections
@@ -178,6 +178,35 @@ describe('BaseMudObject', () => {
     });
   });
 
+  describe('occupants', () => {
+    it('should track inventory members by category', () => {
+      const room = new TestRoom();
+      const player = new TestPlayer();
+      Object.assign(player, { isLiving: true, isPlayer: true });
+      const sword = new TestItem();
+
+      player.moveTo(room);
+      sword.moveTo(room);
+
+      expect(room.getOccupants('player')).toEqual([player]);
+      expect(room.getOccupants('living')).toEqual([player]);
+      expect(room.getOccupants('item')).toEqual([sword]);
+
+      player.moveTo(null);
+      expect(room.getOccupants('player')).toHaveLength(0);
+      expect(room.getOccupants('living')).toHaveLength(0);
+    });
+
+    it('should reuse the cached view while nothing is shadowed', () => {
+      const room = new TestRoom();
+      new TestItem().moveTo(room);
+
+      const items = room.getOccupants('item');
+      expect(room.getOccupants('item')).toBe(items);
+      expect(Object.isFrozen(items)).toBe(true);
+    });
+  });
+
   describe('actions', () => {
     let item: TestItem;
 
@@ -0,0 +1,73 @@
+import { describe, it, expect } from 'vitest';
+import { VerbTrie, buildCommandTable } from '../../src/driver/command-table.js';
+
+interface TestCommand {
+  file: string;
+  directory: string;
+}
+
+describe('VerbTrie', () => {
+  it('looks up exact verbs', () => {
+    const trie = new VerbTrie<number>();
+    trie.set('look', 1);
+    trie.set('l', 2);
+
+    expect(trie.get('look')).toBe(1);
+    expect(trie.get('l')).toBe(2);
+    expect(trie.get('lo')).toBeUndefined();
+    expect(trie.get('looking')).toBeUndefined();
+    expect(trie.size).toBe(2);
+  });
+
+  it('lists verbs with a prefix in alphabetical order', () => {
+    const trie = new VerbTrie<boolean>();
+    for (const verb of ['say', 'score', 'sc', 'look', 'save']) {
+      trie.set(verb, true);
+    }
+
+    expect(trie.withPrefix('s')).toEqual(['save', 'say', 'sc', 'score']);
+    expect(trie.withPrefix('sc')).toEqual(['sc', 'score']);
+    expect(trie.withPrefix('s', 2)).toEqual(['save', 'say']);
+    expect(trie.withPrefix('x')).toEqual([]);
+  });
+
+  it('replaces a verb without counting it twice', () => {
+    const trie = new VerbTrie<string>();
+    trie.set('look', 'old');
+    trie.set('look', 'new');
+
+    expect(trie.get('look')).toBe('new');
+    expect(trie.size).toBe(1);
+  });
+});
+
+describe('buildCommandTable', () => {
+  const playerLook: TestCommand = { file: 'player/_look', directory: 'player' };
+  const builderLook: TestCommand = { file: 'builder/_look', directory: 'builder' };
+  const goto: TestCommand = { file: 'builder/_goto', directory: 'builder' };
+  const bash: TestCommand = { file: 'guilds/fighter/_bash', directory: 'guilds/fighter' };
+  const candidates = new Map<string, TestCommand[]>([
+    ['look', [builderLook, playerLook]],
+    ['l', [builderLook, playerLook]],
+    ['goto', [goto]],
+    ['bash', [bash]],
+  ]);
+
+  it('resolves each verb to the first candidate the profile may use', () => {
+    const allowed = new Set(['player', 'guilds/fighter']);
+    const table = buildCommandTable(candidates, (c) => allowed.has(c.directory));
+
+    expect(table.verbs.get('look')).toBe(playerLook);
+    expect(table.verbs.get('bash')).toBe(bash);
+    expect(table.verbs.has('goto')).toBe(false);
+    expect(table.trie.withPrefix('')).toEqual(['bash', 'l', 'look']);
+  });
+
+  it('lists every usable command, including shadowed ones', () => {
+    const allowed = new Set(['player', 'builder']);
+    const table = buildCommandTable(candidates, (c) => allowed.has(c.directory));
+
+    expect(table.verbs.get('look')).toBe(builderLook);
+    expect(table.usable).toEqual([builderLook, playerLook, goto]);
+  });
+});
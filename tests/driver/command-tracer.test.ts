@@ -0,0 +1,120 @@
+import { describe, it, expect, beforeEach } from 'vitest';
+import { CommandTracer, toChromeTrace } from '../../src/driver/command-tracer.js';
+
+/**
+ * Wait for a number of milliseconds.
+ */
+function sleep(ms: number): Promise<void> {
+  return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+describe('CommandTracer', () => {
+  let tracer: CommandTracer;
+
+  beforeEach(() => {
+    tracer = new CommandTracer({ samplePercent: 100, slowThresholdMs: 20, maxSlowTraces: 2 });
+  });
+
+  it('records spans added across awaits', async () => {
+    const record = await tracer.trace('alice', 'look', async () => {
+      const endAlias = tracer.span('parse', 'alias');
+      endAlias();
+      await sleep(1);
+      const endExecute = tracer.span('execute', 'look');
+      tracer.current()?.recordSend(120, 0.5, 3);
+      await sleep(1);
+      endExecute();
+    });
+
+    expect(record).not.toBeNull();
+    expect(record!.player).toBe('alice');
+    expect(record!.spans.map((span) => `${span.phase}:${span.name}`)).toEqual([
+      'parse:alias',
+      'execute:look',
+      'send:output (3 messages, 1 frames)',
+    ]);
+    expect(record!.sends).toEqual({ count: 3, frames: 1, bytes: 120 });
+    expect(record!.phases.send).toBe(0.5);
+    expect(record!.phases.execute).toBeGreaterThan(0);
+    expect(tracer.current()).toBeUndefined();
+  });
+
+  it('ends open spans with the command and counts only top-level spans per phase', async () => {
+    const record = await tracer.trace('alice', 'smile', async () => {
+      tracer.span('resolve', 'channels and actions');
+      const endNested = tracer.span('execute', 'nested');
+      await sleep(2);
+      endNested();
+    });
+
+    const [fallback, nested] = record!.spans;
+    expect(fallback!.startMs + fallback!.durationMs).toBeCloseTo(record!.durationMs, 5);
+    expect(nested!.depth).toBe(1);
+    expect(record!.phases.execute).toBe(0);
+    expect(record!.phases.resolve).toBe(fallback!.durationMs);
+  });
+
+  it('keeps slow traces in a bounded ring', async () => {
+    await tracer.trace('alice', 'fast', async () => {});
+    for (const input of ['slow1', 'slow2', 'slow3']) {
+      await tracer.trace('bob', input, () => sleep(25));
+    }
+
+    expect(tracer.getSlowTraces().map((trace) => trace.input)).toEqual(['slow2', 'slow3']);
+    expect(tracer.getRecentTraces()).toHaveLength(4);
+    expect(tracer.getStats()).toMatchObject({ traced: 4, slow: 3, skipped: 0 });
+  });
+
+  it('runs unsampled commands without a trace', async () => {
+    tracer.setSamplePercent(0);
+    let inside: unknown = 'unset';
+
+    const record = await tracer.trace('alice', 'look', async () => {
+      inside = tracer.current();
+      tracer.span('execute', 'look')();
+    });
+
+    expect(record).toBeNull();
+    expect(inside).toBeUndefined();
+    expect(tracer.getStats()).toMatchObject({ traced: 0, skipped: 1 });
+  });
+
+  it('records the trace when the command throws', async () => {
+    await expect(
+      tracer.trace('alice', 'boom', async () => {
+        throw new Error('boom');
+      })
+    ).rejects.toThrow('boom');
+
+    expect(tracer.getRecentTraces().map((trace) => trace.input)).toEqual(['boom']);
+  });
+});
+
+describe('toChromeTrace', () => {
+  it('emits a thread per player and nested complete events in microseconds', async () => {
+    const tracer = new CommandTracer({ samplePercent: 100 });
+    await tracer.trace('alice', 'look', async () => {
+      tracer.span('execute', 'look')();
+    });
+    await tracer.trace('bob', 'say meet me at the docks', async () => {});
+    await tracer.trace('alice', 'inv', async () => {});
+
+    const { traceEvents, displayTimeUnit } = toChromeTrace(tracer.getRecentTraces());
+
+    expect(displayTimeUnit).toBe('ms');
+    const threads = traceEvents.filter((event) => event.ph === 'M');
+    expect(threads.map((event) => [event.tid, event.args['name']])).toEqual([
+      [1, 'alice'],
+      [2, 'bob'],
+    ]);
+
+    const look = traceEvents.find((event) => event.cat === 'command' && event.name === 'look')!;
+    const span = traceEvents.find((event) => event.cat === 'execute')!;
+    expect(look.tid).toBe(1);
+    expect(look.ts).toBe(tracer.getRecentTraces()[0]!.timestamp * 1000);
+    expect(span.ts).toBeGreaterThanOrEqual(look.ts);
+    expect(span.ts + span.dur!).toBeLessThanOrEqual(look.ts + look.dur! + 1);
+    expect(traceEvents.find((event) => event.name === 'inv')!.tid).toBe(1);
+    expect(traceEvents.find((event) => event.tid === 2 && event.ph === 'X')!.name).toBe('say');
+  });
+});
@@ -0,0 +1,182 @@
+import { describe, it, expect, beforeEach, afterEach } from 'vitest';
+import { CompileCache, mudlibTransformOptions } from '../../src/driver/compile-cache.js';
+import { Compiler } from '../../src/driver/compiler.js';
+import { mkdir, readdir, rm, stat, utimes, writeFile } from 'fs/promises';
+import { join } from 'path';
+import { randomUUID } from 'crypto';
+
+const OPTIONS = { loader: 'ts', format: 'esm', target: 'es2022', sourcemap: 'external' } as const;
+
+async function listEntries(dir: string): Promise<string[]> {
+  const files: string[] = [];
+  for (const shard of await readdir(dir)) {
+    for (const file of await readdir(join(dir, shard))) {
+      files.push(join(dir, shard, file));
+    }
+  }
+  return files;
+}
+
+describe('CompileCache', () => {
+  let cacheDir: string;
+  let cache: CompileCache;
+
+  beforeEach(() => {
+    cacheDir = `./test-compile-cache-${randomUUID().slice(0, 8)}`;
+    cache = new CompileCache({ cacheDir });
+  });
+
+  afterEach(async () => {
+    await rm(cacheDir, { recursive: true, force: true });
+  });
+
+  describe('transform', () => {
+    it('should transpile on a miss and serve the stored output on a hit', async () => {
+      const source = 'export const answer: number = 42;';
+
+      const first = await cache.transform(source, '/std/answer.ts', OPTIONS);
+      const second = await cache.transform(source, '/std/answer.ts', OPTIONS);
+
+      expect(first.cached).toBe(false);
+      expect(second.cached).toBe(true);
+      expect(second.code).toBe(first.code);
+      expect(second.map).toBe(first.map);
+      expect(second.code).not.toContain(': number');
+      expect(JSON.parse(second.map).sources).toEqual(['/std/answer.ts']);
+    });
+
+    it('should survive a restart', async () => {
+      const source = 'export const x = 1;';
+      await cache.transform(source, 'x.ts', OPTIONS);
+
+      const restarted = new CompileCache({ cacheDir });
+      const result = await restarted.transform(source, 'x.ts', OPTIONS);
+
+      expect(result.cached).toBe(true);
+    });
+
+    it('should key on source, file name and options', async () => {
+      await cache.transform('export const x = 1;', 'x.ts', OPTIONS);
+
+      expect((await cache.transform('export const x = 2;', 'x.ts', OPTIONS)).cached).toBe(false);
+      expect((await cache.transform('export const x = 1;', 'y.ts', OPTIONS)).cached).toBe(false);
+      expect(
+        (await cache.transform('export const x = 1;', 'x.ts', { ...OPTIONS, target: 'es2020' })).cached
+      ).toBe(false);
+    });
+
+    it('should not cache failed transforms', async () => {
+      await expect(cache.transform('const x = ;', 'bad.ts', OPTIONS)).rejects.toBeDefined();
+      await expect(cache.transform('const x = ;', 'bad.ts', OPTIONS)).rejects.toBeDefined();
+
+      expect(cache.getStats().hits).toBe(0);
+    });
+
+    it('should treat a corrupt entry as a miss', async () => {
+      const source = 'export const x = 1;';
+      await cache.transform(source, 'x.ts', OPTIONS);
+      const [entry] = await listEntries(cacheDir);
+      await writeFile(entry!, '{not json');
+
+      const result = await cache.transform(source, 'x.ts', OPTIONS);
+
+      expect(result.cached).toBe(false);
+      expect(result.code).toContain('x = 1');
+    });
+
+    it('should bypass the disk when disabled', async () => {
+      const disabled = new CompileCache({ cacheDir, enabled: false });
+
+      await disabled.transform('export const x = 1;', 'x.ts', OPTIONS);
+      const result = await disabled.transform('export const x = 1;', 'x.ts', OPTIONS);
+
+      expect(result.cached).toBe(false);
+      await expect(readdir(cacheDir)).rejects.toThrow();
+    });
+  });
+
+  describe('prune', () => {
+    it('should delete the least recently used entries past maxBytes', async () => {
+      await cache.transform('export const a = 1;', 'a.ts', OPTIONS);
+      await cache.transform('export const b = 2;', 'b.ts', OPTIONS);
+      await cache.transform('export const c = 3;', 'c.ts', OPTIONS);
+      const files = await listEntries(cacheDir);
+      const sizes = await Promise.all(files.map(async (file) => (await stat(file)).size));
+      // Age every entry, then use "a" again so "b" and "c" are the oldest
+      const old = new Date(Date.now() - 60 * 60 * 1000);
+      await Promise.all(files.map((file) => utimes(file, old, old)));
+      await cache.transform('export const a = 1;', 'a.ts', OPTIONS);
+      await new Promise((resolve) => setTimeout(resolve, 20));
+
+      const small = new CompileCache({ cacheDir, maxBytes: Math.max(...sizes) + 1 });
+      const result = await small.prune();
+
+      expect(result.removed).toBe(2);
+      expect(await listEntries(cacheDir)).toHaveLength(1);
+      expect((await small.transform('export const a = 1;', 'a.ts', OPTIONS)).cached).toBe(true);
+    });
+
+    it('should keep everything when unlimited and clean up stale temp files', async () => {
+      await cache.transform('export const x = 1;', 'x.ts', OPTIONS);
+      const [entry] = await listEntries(cacheDir);
+      const tmp = `${entry}.123.456.tmp`;
+      await writeFile(tmp, '{');
+      const old = new Date(Date.now() - 60 * 60 * 1000);
+      await utimes(tmp, old, old);
+
+      const unlimited = new CompileCache({ cacheDir, maxBytes: 0 });
+      const result = await unlimited.prune();
+
+      expect(result.removed).toBe(1);
+      expect(await listEntries(cacheDir)).toEqual([entry]);
+    });
+
+    it('should do nothing when the directory does not exist', async () => {
+      const result = await cache.prune();
+
+      expect(result).toEqual({ removed: 0, removedBytes: 0, keptBytes: 0 });
+    });
+  });
+
+  describe('getStats', () => {
+    it('should report hit rate and time saved', async () => {
+      await cache.transform('export const x = 1;', 'x.ts', OPTIONS);
+      await cache.transform('export const x = 1;', 'x.ts', OPTIONS);
+      cache.recordLookup(true, 5);
+      cache.recordLookup(false, 3);
+
+      const stats = cache.getStats();
+
+      expect(stats.hits).toBe(2);
+      expect(stats.misses).toBe(2);
+      expect(stats.hitRate).toBe(50);
+      expect(stats.savedMs).toBeGreaterThanOrEqual(5);
+    });
+  });
+
+  describe('mudlibTransformOptions', () => {
+    it('should use the mudlib tsconfig when present', async () => {
+      const mudlibPath = join(cacheDir, 'mudlib');
+      await mkdir(mudlibPath, { recursive: true });
+      await writeFile(join(mudlibPath, 'tsconfig.json'), '{"compilerOptions":{"target":"ES2022"}}');
+
+      const options = mudlibTransformOptions(mudlibPath);
+
+      expect(options.tsconfigRaw).toContain('ES2022');
+      expect(options.sourcemap).toBe('external');
+    });
+  });
+
+  describe('Compiler integration', () => {
+    it('should compile through the cache it is given', async () => {
+      const compiler = new Compiler({ mudlibPath: cacheDir, cache });
+
+      await compiler.compileSource('export const x: number = 1;', 'x.ts');
+      const result = await compiler.compileSource('export const x: number = 1;', 'x.ts');
+
+      expect(result.success).toBe(true);
+      expect(result.code).toContain('sourceMappingURL');
+      expect(cache.getStats().hits).toBe(1);
+    });
+  });
+});
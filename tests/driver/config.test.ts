@@ -31,6 +31,7 @@ describe('loadConfig', () => {
     expect(config.maxIsolates).toBe(2);
     expect(config.scriptTimeoutMs).toBe(5000);
     expect(config.heartbeatIntervalMs).toBe(2000);
+    expect(config.heartbeatMode).toBe('staggered');
     expect(config.autoSaveIntervalMs).toBe(300000);
     expect(config.devMode).toBe(true);
     expect(config.hotReload).toBe(true);
@@ -102,17 +103,40 @@ describe('validateConfig', () => {
     shutdownTimeoutMs: 15000,
     mudlibPath: './mudlib',
     masterObject: '/master',
+    preloadConcurrency: 8,
+    lazyWorld: false,
     logLevel: 'info',
     logPretty: true,
     logHttpRequests: false,
+    commandTraceSamplePercent: 5,
+    commandTraceSlowMs: 50,
     isolateMemoryMb: 64,
     maxIsolates: 2,
     scriptTimeoutMs: 5000,
     heartbeatIntervalMs: 2000,
+    heartbeatMode: 'staggered',
+    heartbeatSlots: 20,
+    heartbeatSliceBudgetMs: 10,
+    heartbeatDormancy: true,
+    heartbeatDormancyRadius: 1,
+    heartbeatDormancySweepMs: 5000,
+    objectCleanup: false,
+    objectCleanupIdleMs: 3600000,
+    objectCleanupSweepMs: 60000,
     autoSaveIntervalMs: 300000,
+    playerSaveWindowMs: 1000,
+    playerSaveBatchSize: 50,
+    playerSaveEncoding: 'json',
+    playerSaveCompression: 'none',
+    playerSaveJournal: false,
+    playerSaveJournalCompact: 50,
     dataPath: './mudlib/data',
     devMode: true,
     hotReload: true,
+    hotReloadCascade: false,
+    compileCache: true,
+    compileCacheDir: './.cache/compile',
+    compileCacheMaxMb: 256,
     claudeApiKey: '',
     claudeModel: 'claude-sonnet-4-20250514',
     claudeMaxTokens: 1024,
@@ -146,6 +170,8 @@ describe('validateConfig', () => {
     discordChannelId: '',
     wsHeartbeatIntervalMs: 25000,
     wsMaxMissedPongs: 20,
+    wsOutputCoalesce: true,
+    wsOutputCoalesceMs: 0,
     wsSessionTokenTtlMs: 15 * 60 * 1000,
     wsSessionSecret: '',
     wsSessionValidateIp: false,
@@ -202,6 +228,33 @@ describe('validateConfig', () => {
     expect(errors[0]).toContain('Heartbeat interval too low');
   });
 
+  it('should return error for preload concurrency too low', () => {
+    const config = { ...validConfig, preloadConcurrency: 0 };
+
+    const errors = validateConfig(config);
+
+    expect(errors).toHaveLength(1);
+    expect(errors[0]).toContain('Preload concurrency too low');
+  });
+
+  it('should return error for command trace sample percent out of range', () => {
+    const config = { ...validConfig, commandTraceSamplePercent: 150 };
+
+    const errors = validateConfig(config);
+
+    expect(errors).toHaveLength(1);
+    expect(errors[0]).toContain('Invalid command trace sample percent');
+  });
+
+  it('should return error for output coalescing window out of range', () => {
+    const config = { ...validConfig, wsOutputCoalesceMs: 250 };
+
+    const errors = validateConfig(config);
+
+    expect(errors).toHaveLength(1);
+    expect(errors[0]).toContain('Invalid output coalescing window');
+  });
+
   it('should return multiple errors for multiple invalid values', () => {
     const config = {
       ...validConfig,
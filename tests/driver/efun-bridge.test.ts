@@ -302,5 +302,22 @@ describe('EfunBridge', () => {
       expect(typeof efuns.callOut).toBe('function');
       expect(typeof efuns.removeCallOut).toBe('function');
     });
+
+    it('should return the same frozen table on every call', () => {
+      const efuns = efunBridge.getEfuns();
+
+      expect(efunBridge.getEfuns()).toBe(efuns);
+      expect(Object.isFrozen(efuns)).toBe(true);
+      expect(efuns.upper).toBe(efunBridge.getEfuns().upper);
+    });
+
+    it('should rebuild the table on refreshEfuns', () => {
+      const before = efunBridge.getEfuns();
+      const after = efunBridge.refreshEfuns();
+
+      expect(after).not.toBe(before);
+      expect(efunBridge.getEfuns()).toBe(after);
+      expect((after.upper as (s: string) => string)('x')).toBe('X');
+    });
   });
 });
@@ -2,20 +2,39 @@
  * Tests for object management efuns.
  */
 
-import { describe, it, expect, beforeEach, afterEach } from 'vitest';
+import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
 import { createTestEnvironment, createMockPlayer } from '../../helpers/efun-test-utils.js';
 import type { EfunBridge } from '../../../src/driver/efun-bridge.js';
 import { BaseMudObject } from '../../../src/driver/base-object.js';
 import { getRegistry } from '../../../src/driver/object-registry.js';
+import { getPermissions } from '../../../src/driver/permissions.js';
+import { mkdir, writeFile } from 'fs/promises';
+import { join } from 'path';
+
+const ROOM_SOURCE = `
+export default class TestRoom {
+  objectPath = '';
+  objectId = '';
+  _setupAsBlueprint(path) {
+    this.objectPath = path;
+    this.objectId = path;
+  }
+  async resolveExit() {
+    return undefined;
+  }
+}
+`;
 
 describe('Object Efuns', () => {
   let efunBridge: EfunBridge;
   let cleanup: () => Promise<void>;
+  let testMudlibPath: string;
 
   beforeEach(async () => {
     const env = await createTestEnvironment();
     efunBridge = env.efunBridge;
     cleanup = env.cleanup;
+    testMudlibPath = env.testMudlibPath;
   });
 
   afterEach(async () => {
@@ -55,6 +74,58 @@ describe('Object Efuns', () => {
     });
   });
 
+  describe('lazy room loading', () => {
+    beforeEach(async () => {
+      await mkdir(join(testMudlibPath, 'areas'), { recursive: true });
+      for (const name of ['a', 'b', 'c']) {
+        await writeFile(join(testMudlibPath, 'areas', `${name}.ts`), ROOM_SOURCE);
+      }
+    });
+
+    it('should load blueprints in the background on prefetch', async () => {
+      efunBridge.prefetchObjects(['/areas/a', '/areas/b']);
+
+      expect(efunBridge.findObject('/areas/a')).toBeUndefined();
+      await vi.waitFor(() => {
+        expect(efunBridge.findObject('/areas/a')).toBeDefined();
+        expect(efunBridge.findObject('/areas/b')).toBeDefined();
+      });
+    });
+
+    it('should never load a room that findObject misses', async () => {
+      expect(efunBridge.findObject('/areas/a')).toBeUndefined();
+      await new Promise((resolve) => setTimeout(resolve, 50));
+
+      expect(efunBridge.findObject('/areas/a')).toBeUndefined();
+    });
+
+    it('should ignore prefetch failures', async () => {
+      efunBridge.prefetchObjects(['/areas/missing', '/areas/a']);
+
+      await vi.waitFor(() => expect(efunBridge.findObject('/areas/a')).toBeDefined());
+    });
+
+    it('should report loaded rooms in getMemoryStats', async () => {
+      const builder = createMockPlayer('/players/builder', { name: 'builder', level: 1 });
+      efunBridge.setContext({ thisPlayer: builder, thisObject: builder });
+      getPermissions().setLevel('builder', 1);
+
+      await efunBridge.loadBlueprint('/areas/a');
+      efunBridge.prefetchObjects(['/areas/b', '/areas/c']);
+      await vi.waitFor(() => expect(efunBridge.findObject('/areas/c')).toBeDefined());
+
+      const stats = efunBridge.getMemoryStats();
+
+      expect(stats.rooms).toMatchObject({
+        lazyWorld: false,
+        loaded: 3,
+        loadedOnDemand: 1,
+        prefetched: 2,
+        prefetchFailures: 0,
+      });
+    });
+  });
+
   describe('getAllObjects', () => {
     it('should return empty array when no objects', () => {
       const objects = efunBridge.getAllObjects();
@@ -8,6 +8,7 @@ import type { EfunBridge } from '../../../src/driver/efun-bridge.js';
 import { mkdir, writeFile, access } from 'fs/promises';
 import { join } from 'path';
 import { resetAdapter } from '../../../src/driver/persistence/adapter-factory.js';
+import { resetSavePipeline } from '../../../src/driver/persistence/save-pipeline.js';
 import { getPermissions } from '../../../src/driver/permissions.js';
 import { constants } from 'fs';
 import type { MudObject } from '../../../src/driver/types.js';
@@ -20,6 +21,7 @@ describe('Persistence Efuns', () => {
   beforeEach(async () => {
     // Reset the file store singleton so each test gets a fresh one
     resetAdapter();
+    resetSavePipeline();
 
     const env = await createTestEnvironment();
     efunBridge = env.efunBridge;
@@ -32,6 +34,7 @@ describe('Persistence Efuns', () => {
 
   afterEach(async () => {
     resetAdapter();
+    resetSavePipeline();
     await cleanup();
   });
 
@@ -67,6 +70,28 @@ describe('Persistence Efuns', () => {
     });
   });
 
+  describe('write-behind saves', () => {
+    it('should write the save once flushed', async () => {
+      const player = createMockPlayer('/players/flushed', { name: 'flushed' });
+
+      await efunBridge.savePlayer(player, { flush: true });
+
+      const filePath = join(testMudlibPath, 'data', 'players', 'flushed.json');
+      await access(filePath, constants.F_OK);
+    });
+
+    it('should capture state when the save is requested', async () => {
+      const player = createMockPlayer('/players/snapshot', { name: 'snapshot' });
+      (player as typeof player & { gold: number }).gold = 10;
+      await efunBridge.savePlayer(player);
+
+      (player as typeof player & { gold: number }).gold = 0;
+
+      const data = await efunBridge.loadPlayerData('snapshot');
+      expect(data?.state?.properties?.gold).toBe(10);
+    });
+  });
+
   describe('loadPlayerData', () => {
     it('should load saved player data', async () => {
       const player = createMockPlayer('/players/loadtest', { name: 'loadtest' });
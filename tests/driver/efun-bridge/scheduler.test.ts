@@ -119,7 +119,7 @@ describe('Scheduler Efuns', () => {
 
       efunBridge.callOut(callback, 0);
 
-      // The scheduler polls every 100ms, so we need to wait for that
+      // Zero-delay callOuts fire on the next timer turn
       await vi.advanceTimersByTimeAsync(100);
 
       expect(callback).toHaveBeenCalled();
@@ -187,7 +187,7 @@ describe('Scheduler Efuns', () => {
         efunBridge.callOut(fn, delay);
       });
 
-      // Max delay is 990ms + 100ms polling buffer
+      // Max delay is 990ms plus a buffer
       await vi.advanceTimersByTimeAsync(1200);
 
       callbacks.forEach(({ fn }) => {
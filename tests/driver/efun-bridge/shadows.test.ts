@@ -240,6 +240,26 @@ describe('Shadow Efuns', () => {
 
       expect(wrapped).toHaveLength(2);
     });
+
+    it('should return the input array when nothing is shadowed', () => {
+      const objects = [createObject('/test/obj1'), createObject('/test/obj2')];
+
+      expect(efunBridge.wrapShadowedObjects(objects)).toBe(objects);
+    });
+
+    it('should wrap shadowed members once any shadow exists', async () => {
+      const target = createObject('/test/target');
+      const plain = createObject('/test/plain');
+      getRegistry().register(target);
+      getRegistry().register(plain);
+      await efunBridge.addShadow(target, createShadow('/shadows/test-shadow'));
+
+      const wrapped = efunBridge.wrapShadowedObjects([target, plain]);
+
+      expect(efunBridge.getOriginalObject(wrapped[0]!)).toBe(target);
+      expect(wrapped[0]).not.toBe(target);
+      expect(wrapped[1]).toBe(plain);
+    });
   });
 
   describe('getShadowStats', () => {
@@ -0,0 +1,72 @@
+/**
+ * Efun call overhead.
+ *
+ * Compares fetching the efun table (previously rebuilt with fresh bindings
+ * on every getEfuns() call) and the object-list efuns against their previous
+ * copy-and-wrap implementations, in a world with no shadows.
+ *
+ * Run with: npm run bench
+ */
+import { bench, describe } from 'vitest';
+import { EfunBridge } from '../../src/driver/efun-bridge.js';
+import { BaseMudObject } from '../../src/driver/base-object.js';
+import { getRegistry } from '../../src/driver/object-registry.js';
+import { getShadowRegistry } from '../../src/driver/shadow-registry.js';
+import type { MudObject } from '../../src/driver/types.js';
+
+const CALLS = 1000;
+const ITEMS = 100;
+const OBJECTS = 5000;
+
+const bridge = new EfunBridge({ mudlibPath: './mudlib' });
+const shadows = getShadowRegistry();
+
+const room = new BaseMudObject();
+room._setupAsBlueprint('/bench/room');
+for (let i = 0; i < ITEMS; i++) {
+  new BaseMudObject().moveTo(room);
+}
+
+const registry = getRegistry();
+for (let i = 0; i < OBJECTS; i++) {
+  const obj = new BaseMudObject();
+  obj._setupAsBlueprint(`/bench/obj_${i}`);
+  registry.register(obj);
+}
+
+/**
+ * The previous wrapObjects: always map through the shadow registry.
+ */
+function legacyWrap(objs: MudObject[]): MudObject[] {
+  return objs.map((obj) => shadows.wrapWithProxy(obj));
+}
+
+describe(`${CALLS} getEfuns() calls`, () => {
+  bench('rebuild per call', () => {
+    for (let i = 0; i < CALLS; i++) bridge.refreshEfuns();
+  });
+
+  bench('cached frozen table', () => {
+    for (let i = 0; i < CALLS; i++) bridge.getEfuns();
+  });
+});
+
+describe(`${CALLS} allInventory() calls on a ${ITEMS}-item room`, () => {
+  bench('copy and wrap', () => {
+    for (let i = 0; i < CALLS; i++) legacyWrap([...room.inventory]);
+  });
+
+  bench('efun', () => {
+    for (let i = 0; i < CALLS; i++) bridge.allInventory(room);
+  });
+});
+
+describe(`getAllObjects() with ${OBJECTS} objects`, () => {
+  bench('copy and wrap', () => {
+    legacyWrap(Array.from(registry.getAllObjects()));
+  });
+
+  bench('efun', () => {
+    bridge.getAllObjects();
+  });
+});
@@ -0,0 +1,176 @@
+import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
+import { HeartbeatDormancy } from '../../src/driver/heartbeat-dormancy.js';
+import { Scheduler } from '../../src/driver/scheduler.js';
+import { BaseMudObject } from '../../src/driver/base-object.js';
+import type { MudObject } from '../../src/driver/types.js';
+
+class TestRoom extends BaseMudObject {
+  exits: Array<{ destination: string | MudObject }> = [];
+
+  getExits(): Array<{ destination: string | MudObject }> {
+    return this.exits;
+  }
+}
+
+class TestNpc extends BaseMudObject {
+  heartbeatCount = 0;
+  wokenAfterMs: number | null = null;
+  sleepy = true;
+
+  heartbeat(): void {
+    this.heartbeatCount++;
+  }
+
+  allowsHeartbeatDormancy(): boolean {
+    return this.sleepy;
+  }
+
+  onHeartbeatWake(dormantMs: number): void {
+    this.wokenAfterMs = dormantMs;
+  }
+}
+
+function createRoom(path: string): TestRoom {
+  const room = new TestRoom();
+  room._setupAsBlueprint(path);
+  return room;
+}
+
+function createNpc(id: string, room: MudObject): TestNpc {
+  const npc = new TestNpc();
+  npc._setupAsBlueprint(id);
+  npc.moveTo(room);
+  return npc;
+}
+
+describe('HeartbeatDormancy', () => {
+  let scheduler: Scheduler;
+  let rooms: Map<string, TestRoom>;
+  let players: MudObject[];
+  let dormancy: HeartbeatDormancy;
+
+  beforeEach(() => {
+    scheduler = new Scheduler({ heartbeatIntervalMs: 100 });
+    rooms = new Map();
+    players = [];
+
+    // Three rooms in a line: a <-> b <-> c
+    for (const path of ['/rooms/a', '/rooms/b', '/rooms/c']) {
+      rooms.set(path, createRoom(path));
+    }
+    rooms.get('/rooms/a')!.exits = [{ destination: '/rooms/b' }];
+    rooms.get('/rooms/b')!.exits = [{ destination: '/rooms/a' }, { destination: '/rooms/c' }];
+    rooms.get('/rooms/c')!.exits = [{ destination: '/rooms/b' }];
+
+    dormancy = new HeartbeatDormancy(
+      scheduler,
+      { radius: 1, sweepIntervalMs: 1000 },
+      {
+        getPlayers: () => players,
+        findObject: (path) => rooms.get(path),
+      }
+    );
+  });
+
+  afterEach(() => {
+    dormancy.stop();
+    scheduler.stop();
+    scheduler.clear();
+  });
+
+  it('should park heartbeats in rooms with no player nearby', () => {
+    const npc = createNpc('/npc/far', rooms.get('/rooms/c')!);
+    scheduler.setHeartbeat(npc, true);
+
+    const result = dormancy.sweep();
+
+    expect(result.slept).toBe(1);
+    expect(scheduler.isHeartbeatDormant(npc)).toBe(true);
+    expect(scheduler.hasHeartbeat(npc)).toBe(true);
+    expect(scheduler.dormantHeartbeatCount).toBe(1);
+  });
+
+  it('should keep rooms within the radius awake', () => {
+    const player = createNpc('/player/bob', rooms.get('/rooms/a')!);
+    players.push(player);
+    const near = createNpc('/npc/near', rooms.get('/rooms/b')!);
+    const far = createNpc('/npc/far', rooms.get('/rooms/c')!);
+    scheduler.setHeartbeat(near, true);
+    scheduler.setHeartbeat(far, true);
+
+    dormancy.sweep();
+
+    expect(scheduler.isHeartbeatDormant(near)).toBe(false);
+    expect(scheduler.isHeartbeatDormant(far)).toBe(true);
+  });
+
+  it('should not park objects that do not opt in', () => {
+    const obj = new BaseMudObject();
+    obj._setupAsBlueprint('/obj/clock');
+    obj.moveTo(rooms.get('/rooms/c')!);
+    scheduler.setHeartbeat(obj, true);
+    const busy = createNpc('/npc/busy', rooms.get('/rooms/c')!);
+    busy.sleepy = false;
+    scheduler.setHeartbeat(busy, true);
+
+    dormancy.sweep();
+
+    expect(scheduler.dormantHeartbeatCount).toBe(0);
+  });
+
+  it('should wake with a catch-up tick when a player arrives nearby', async () => {
+    vi.useFakeTimers();
+    try {
+      const npc = createNpc('/npc/far', rooms.get('/rooms/c')!);
+      scheduler.setHeartbeat(npc, true);
+      dormancy.sweep();
+
+      await vi.advanceTimersByTimeAsync(5000);
+      const player = createNpc('/player/bob', rooms.get('/rooms/b')!);
+
+      expect(dormancy.wakeNear(player)).toBe(1);
+      await vi.advanceTimersByTimeAsync(0);
+
+      expect(scheduler.isHeartbeatDormant(npc)).toBe(false);
+      expect(npc.heartbeatCount).toBe(1);
+      expect(npc.wokenAfterMs).toBe(5000);
+    } finally {
+      vi.useRealTimers();
+    }
+  });
+
+  it('should wake on sweep once a player is nearby', () => {
+    const npc = createNpc('/npc/far', rooms.get('/rooms/c')!);
+    scheduler.setHeartbeat(npc, true);
+    dormancy.sweep();
+
+    players.push(createNpc('/player/bob', rooms.get('/rooms/c')!));
+    const result = dormancy.sweep();
+
+    expect(result.woken).toBe(1);
+    expect(scheduler.isHeartbeatDormant(npc)).toBe(false);
+  });
+
+  it('should not tick dormant objects', async () => {
+    const npc = createNpc('/npc/far', rooms.get('/rooms/c')!);
+    scheduler.setHeartbeat(npc, true);
+    dormancy.sweep();
+    scheduler.start();
+
+    await new Promise((resolve) => setTimeout(resolve, 250));
+
+    expect(npc.heartbeatCount).toBe(0);
+  });
+
+  it('should forget objects unregistered while dormant', () => {
+    const npc = createNpc('/npc/far', rooms.get('/rooms/c')!);
+    scheduler.setHeartbeat(npc, true);
+    dormancy.sweep();
+
+    scheduler.setHeartbeat(npc, false);
+    dormancy.sweep();
+
+    expect(dormancy.dormantCount).toBe(0);
+    expect(scheduler.hasHeartbeat(npc)).toBe(false);
+  });
+});
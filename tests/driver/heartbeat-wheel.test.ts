@@ -0,0 +1,148 @@
+import { describe, it, expect, afterEach, vi } from 'vitest';
+import {
+  HeartbeatWheel,
+  hashToSlot,
+  type HeartbeatRunner,
+} from '../../src/driver/heartbeat-wheel.js';
+import { BaseMudObject } from '../../src/driver/base-object.js';
+import type { MudObject } from '../../src/driver/types.js';
+
+function createObject(path: string): MudObject {
+  const obj = new BaseMudObject();
+  obj._setupAsBlueprint(path);
+  return obj;
+}
+
+function createWheel(
+  intervalMs: number,
+  slotCount: number,
+  runner: HeartbeatRunner = async () => {},
+  sliceBudgetMs = 10
+): HeartbeatWheel {
+  return new HeartbeatWheel({ intervalMs, slotCount, sliceBudgetMs }, runner);
+}
+
+describe('HeartbeatWheel', () => {
+  afterEach(() => {
+    vi.useRealTimers();
+  });
+
+  describe('hashToSlot', () => {
+    it('should be stable for the same objectId', () => {
+      expect(hashToSlot('/std/npc#42', 20)).toBe(hashToSlot('/std/npc#42', 20));
+    });
+
+    it('should spread objects across slots', () => {
+      const counts = new Array(10).fill(0);
+      for (let i = 0; i < 1000; i++) {
+        counts[hashToSlot(`/std/npc#${i}`, 10)]++;
+      }
+
+      for (const count of counts) {
+        expect(count).toBeGreaterThan(50);
+        expect(count).toBeLessThan(150);
+      }
+    });
+  });
+
+  it('should track membership', () => {
+    const wheel = createWheel(1000, 4);
+    const obj = createObject('/test/a');
+
+    wheel.add(obj);
+    wheel.add(obj);
+    expect(wheel.size).toBe(1);
+    expect(wheel.has(obj)).toBe(true);
+
+    expect(wheel.remove(obj)).toBe(true);
+    expect(wheel.remove(obj)).toBe(false);
+    expect(wheel.size).toBe(0);
+  });
+
+  it('should run only the objects in the requested slot', async () => {
+    const ran: MudObject[] = [];
+    const wheel = createWheel(1000, 8, async (obj) => {
+      ran.push(obj);
+    });
+    const objects = Array.from({ length: 40 }, (_, i) => createObject(`/test/obj${i}`));
+    objects.forEach((obj) => wheel.add(obj));
+
+    await wheel.runSlot(3);
+
+    const expected = objects.filter((obj) => hashToSlot(obj.objectId, 8) === 3);
+    expect(ran).toEqual(expected);
+  });
+
+  it('should skip objects removed while the slot is running', async () => {
+    const ran: string[] = [];
+    const objects = Array.from({ length: 30 }, (_, i) => createObject(`/test/same${i}`));
+    const wheel = createWheel(1000, 1, async (obj) => {
+      ran.push(obj.objectId);
+      // First object removes the last one
+      if (obj === objects[0]) wheel.remove(objects[29]!);
+    });
+    objects.forEach((obj) => wheel.add(obj));
+
+    await wheel.runSlot(0);
+
+    expect(ran).toHaveLength(29);
+    expect(ran).not.toContain(objects[29]!.objectId);
+  });
+
+  it('should yield when the slice budget is exceeded', async () => {
+    vi.useFakeTimers();
+    const wheel = createWheel(
+      1000,
+      1,
+      async () => {
+        // Simulate 1ms of work per heartbeat
+        vi.setSystemTime(Date.now() + 1);
+      },
+      5
+    );
+    for (let i = 0; i < 50; i++) {
+      wheel.add(createObject(`/test/busy${i}`));
+    }
+
+    const done = wheel.runSlot(0);
+    await vi.runAllTimersAsync();
+    await done;
+
+    const [stats] = wheel.getSlotStats();
+    expect(stats!.yields).toBeGreaterThan(0);
+    expect(stats!.objects).toBe(50);
+  });
+
+  it('should tick each slot once per interval', async () => {
+    vi.useFakeTimers();
+    const counts = new Map<string, number>();
+    const wheel = createWheel(1000, 10, async (obj) => {
+      counts.set(obj.objectId, (counts.get(obj.objectId) ?? 0) + 1);
+    });
+    for (let i = 0; i < 100; i++) {
+      wheel.add(createObject(`/test/tick${i}`));
+    }
+
+    wheel.start();
+    await vi.advanceTimersByTimeAsync(1000);
+    wheel.stop();
+
+    expect(counts.size).toBe(100);
+    for (const count of counts.values()) {
+      expect(count).toBe(1);
+    }
+  });
+
+  it('should report per-tick durations', async () => {
+    vi.useFakeTimers();
+    const onTick = vi.fn();
+    const wheel = createWheel(100, 4);
+    wheel.onTick = onTick;
+
+    wheel.start();
+    await vi.advanceTimersByTimeAsync(100);
+    wheel.stop();
+
+    expect(onTick).toHaveBeenCalledTimes(4);
+  });
+});
@@ -1,6 +1,7 @@
-import { describe, it, expect, beforeEach, afterEach } from 'vitest';
+import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
 import { HotReload } from '../../src/driver/hot-reload.js';
-import { ObjectRegistry, resetRegistry } from '../../src/driver/object-registry.js';
+import { ObjectRegistry, getRegistry, resetRegistry } from '../../src/driver/object-registry.js';
+import { MudlibLoader, resetMudlibLoader } from '../../src/driver/mudlib-loader.js';
 import { BaseMudObject } from '../../src/driver/base-object.js';
 import { writeFile, mkdir, rm } from 'fs/promises';
 import { join } from 'path';
@@ -161,6 +162,141 @@ describe('HotReload', () => {
     });
   });
 
+  describe('reloadWithDependents', () => {
+    const base = (text: string) => `
+export class Base {
+  objectPath = '';
+  objectId = '';
+  isClone = false;
+  blueprint: unknown = null;
+  inventory: unknown[] = [];
+  environment = null;
+  async onCreate() {}
+  async onClone() {}
+  _setupAsBlueprint(path: string) { this.objectPath = path; this.objectId = path; }
+  _setupAsClone(path: string, id: string, blueprint: unknown) {
+    this.objectPath = path;
+    this.objectId = id;
+    this.isClone = true;
+    this.blueprint = blueprint;
+  }
+  describe(): string { return '${text}'; }
+}
+`;
+    const sub = `
+import { Base } from './base.ts';
+export default class Sub extends Base {
+  name(): string { return 'sub:' + this.describe(); }
+}
+`;
+    let loader: MudlibLoader;
+    let cascade: HotReload;
+
+    beforeEach(async () => {
+      resetMudlibLoader();
+      await writeFile(join(testDir, 'std', 'base.ts'), base('old'));
+      await writeFile(join(testDir, 'std', 'sub.ts'), sub);
+      await writeFile(
+        join(testDir, 'std', 'unused.ts'),
+        `import { Base } from './base.ts';\nexport class Unused extends Base {}\n`
+      );
+      loader = new MudlibLoader({ mudlibPath: testDir });
+      cascade = new HotReload({ mudlibPath: testDir }, getRegistry());
+      cascade.setLoader(loader);
+      await loader.loadObject('/std/sub');
+    });
+
+    afterEach(() => {
+      resetMudlibLoader();
+    });
+
+    it('should reload subclasses against the new base class', async () => {
+      await writeFile(join(testDir, 'std', 'base.ts'), base('new'));
+
+      const result = await cascade.reloadWithDependents('/std/base');
+
+      expect(result.success).toBe(true);
+      expect(result.plan.levels).toEqual([['/std/base'], ['/std/sub']]);
+      expect(result.plan.blueprints).toEqual(['/std/sub']);
+      expect(result.plan.stale).toEqual(['/std/unused']);
+      expect(result.blueprints.map((bp) => bp.path)).toEqual(['/std/sub']);
+      expect(result.timing.totalMs).toBeGreaterThanOrEqual(result.timing.swapMs);
+      const reloaded = getRegistry().find('/std/sub') as unknown as { name(): string };
+      expect(reloaded.name()).toBe('sub:new');
+    });
+
+    it('should move existing clones onto the new classes', async () => {
+      await writeFile(
+        join(testDir, 'std', 'checker.ts'),
+        `import { Base } from './base.ts';
+export default class Checker extends Base {
+  accepts(obj: unknown): boolean { return obj instanceof Base; }
+}
+`
+      );
+      await loader.loadObject('/std/checker');
+      const clone = (await loader.cloneObject('/std/sub')) as unknown as { name(): string };
+      await writeFile(join(testDir, 'std', 'base.ts'), base('new'));
+
+      const result = await cascade.reloadWithDependents('/std/base');
+
+      expect(result.success).toBe(true);
+      expect(result.blueprints.find((bp) => bp.path === '/std/sub')!.rebasedClones).toBe(1);
+      const checker = getRegistry().find('/std/checker') as unknown as {
+        accepts(obj: unknown): boolean;
+      };
+      expect(checker.accepts(clone)).toBe(true);
+      expect(clone.name()).toBe('sub:new');
+    });
+
+    it('should swap nothing when a dependent fails', async () => {
+      const original = getRegistry().find('/std/sub');
+      await writeFile(join(testDir, 'std', 'base.ts'), base('new'));
+      await writeFile(join(testDir, 'std', 'sub.ts'), sub.replace('name():', 'name(:'));
+
+      const result = await cascade.reloadWithDependents('/std/base');
+
+      expect(result.success).toBe(false);
+      expect(result.failedPath).toBe('/std/sub');
+      expect(result.blueprints).toHaveLength(0);
+      expect(getRegistry().find('/std/sub')).toBe(original);
+    });
+
+    it('should put swapped blueprints back when a swap throws', async () => {
+      await writeFile(join(testDir, 'std', 'other.ts'), sub.replace('Sub', 'Other'));
+      await loader.loadObject('/std/other');
+      const clone = (await loader.cloneObject('/std/sub')) as unknown as { name(): string };
+      const originals = ['/std/sub', '/std/other'].map((path) => getRegistry().find(path));
+      await writeFile(join(testDir, 'std', 'base.ts'), base('new'));
+      const registry = getRegistry();
+      const swap = registry.swapBlueprint.bind(registry);
+      let calls = 0;
+      vi.spyOn(registry, 'swapBlueprint').mockImplementation((...args) => {
+        if (++calls === 2) throw new Error('swap failed');
+        return swap(...args);
+      });
+
+      const result = await cascade.reloadWithDependents('/std/base');
+
+      expect(result.success).toBe(false);
+      expect(result.error).toContain('swap failed');
+      expect(result.blueprints).toHaveLength(0);
+      expect(['/std/sub', '/std/other'].map((path) => registry.find(path))).toEqual(originals);
+      expect(clone.name()).toBe('sub:old');
+    });
+
+    it('should only plan on a dry run', async () => {
+      const original = getRegistry().find('/std/sub');
+      await writeFile(join(testDir, 'std', 'base.ts'), base('new'));
+
+      const result = await cascade.reloadWithDependents('/std/base', { dryRun: true });
+
+      expect(result.success).toBe(true);
+      expect(result.plan.levels.flat()).toEqual(['/std/base', '/std/sub']);
+      expect(getRegistry().find('/std/sub')).toBe(original);
+    });
+  });
+
   describe('file watching', () => {
     it('should start and stop watching', () => {
       expect(hotReload.isWatching).toBe(false);
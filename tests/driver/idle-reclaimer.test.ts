@@ -0,0 +1,196 @@
+import { describe, it, expect, beforeEach } from 'vitest';
+import { IdleReclaimer, type ReclaimStore } from '../../src/driver/idle-reclaimer.js';
+import { ObjectRegistry } from '../../src/driver/object-registry.js';
+import { BaseMudObject } from '../../src/driver/base-object.js';
+import type { MudObject } from '../../src/driver/types.js';
+
+class TestRoom extends BaseMudObject {
+  treasure: number = 0;
+  agree = true;
+  dirty = true;
+  dependents: MudObject[] = [];
+  cleanUpCalls: number[] = [];
+
+  cleanUp(idleMs: number): boolean {
+    this.cleanUpCalls.push(idleMs);
+    return this.agree;
+  }
+
+  getCleanupDependents(): MudObject[] {
+    return this.dependents;
+  }
+
+  hasDirtyState(): boolean {
+    return this.dirty;
+  }
+
+  markStateClean(): void {
+    this.dirty = false;
+  }
+}
+
+class TestItem extends BaseMudObject {}
+
+class TestPlayer extends BaseMudObject {
+  isPlayer = true;
+}
+
+/**
+ * In-memory store double.
+ */
+class MemoryStore implements ReclaimStore {
+  data: Map<string, unknown> = new Map();
+
+  async saveData(namespace: string, key: string, data: unknown): Promise<void> {
+    this.data.set(`${namespace}/${key}`, JSON.parse(JSON.stringify(data)));
+  }
+
+  async loadData<T = unknown>(namespace: string, key: string): Promise<T | null> {
+    return (this.data.get(`${namespace}/${key}`) as T) ?? null;
+  }
+
+  async deleteData(namespace: string, key: string): Promise<boolean> {
+    return this.data.delete(`${namespace}/${key}`);
+  }
+
+  async listKeys(namespace: string): Promise<string[]> {
+    return [...this.data.keys()]
+      .filter((k) => k.startsWith(`${namespace}/`))
+      .map((k) => k.slice(namespace.length + 1));
+  }
+}
+
+describe('IdleReclaimer', () => {
+  let registry: ObjectRegistry;
+  let store: MemoryStore;
+  let reclaimer: IdleReclaimer;
+
+  function loadRoom(path: string): TestRoom {
+    const room = new TestRoom();
+    room._setupAsBlueprint(path);
+    registry.registerBlueprint(path, TestRoom, room);
+    return room;
+  }
+
+  async function cloneInto(path: string, room: MudObject): Promise<MudObject> {
+    if (!registry.findBlueprint(path)) {
+      const blueprint = new TestItem();
+      blueprint._setupAsBlueprint(path);
+      registry.registerBlueprint(path, TestItem, blueprint);
+    }
+    const clone = (await registry.clone(path))!;
+    await clone.moveTo(room);
+    return clone;
+  }
+
+  beforeEach(() => {
+    registry = new ObjectRegistry();
+    store = new MemoryStore();
+    reclaimer = new IdleReclaimer(registry, store, { idleMs: 1000 });
+  });
+
+  describe('sweep', () => {
+    it('should unload rooms that agree and keep the rest', async () => {
+      const idle = loadRoom('/areas/idle');
+      const busy = loadRoom('/areas/busy');
+      busy.agree = false;
+
+      const result = await reclaimer.sweep();
+
+      expect(result).toEqual({ checked: 2, reclaimed: 1, destroyed: 1 });
+      expect(idle.cleanUpCalls).toEqual([1000]);
+      expect(registry.find('/areas/idle')).toBeUndefined();
+      expect(registry.find('/areas/busy')).toBe(busy);
+      expect(reclaimer.isUnloaded('/areas/idle')).toBe(true);
+    });
+
+    it('should skip objects without cleanUp and blueprints with clones', async () => {
+      const item = new TestItem();
+      item._setupAsBlueprint('/std/item');
+      registry.registerBlueprint('/std/item', TestItem, item);
+      loadRoom('/std/room');
+      await registry.clone('/std/room');
+
+      const result = await reclaimer.sweep();
+
+      expect(result.checked).toBe(0);
+      expect(registry.find('/std/room')).toBeDefined();
+    });
+  });
+
+  describe('reclaim', () => {
+    it('should destroy contents and dependents along with the room', async () => {
+      const room = loadRoom('/areas/cave');
+      const other = loadRoom('/areas/elsewhere');
+      const rock = await cloneInto('/items/rock', room);
+      const npc = await cloneInto('/npcs/goblin', other);
+      room.dependents = [npc];
+
+      const destroyed = await reclaimer.reclaim('/areas/cave');
+
+      expect(destroyed).toBe(3);
+      expect(registry.find(rock.objectId)).toBeUndefined();
+      expect(registry.find(npc.objectId)).toBeUndefined();
+      expect(other.inventory).toHaveLength(0);
+      expect(reclaimer.getStats()).toMatchObject({ reclaimed: 1, destroyed: 3 });
+    });
+
+    it('should refuse when a player or another blueprint would be destroyed', async () => {
+      const room = loadRoom('/areas/cave');
+      const player = new TestPlayer();
+      player._setupAsBlueprint('/players/bob');
+      await player.moveTo(room);
+
+      expect(await reclaimer.reclaim('/areas/cave')).toBe(0);
+
+      await player.moveTo(null);
+      const vehicle = loadRoom('/vehicles/boat');
+      await vehicle.moveTo(room);
+
+      expect(await reclaimer.reclaim('/areas/cave')).toBe(0);
+      expect(registry.find('/areas/cave')).toBe(room);
+    });
+  });
+
+  describe('onLoaded', () => {
+    it('should restore dirty state into the next instance', async () => {
+      const room = loadRoom('/areas/vault');
+      room.treasure = 7;
+      await reclaimer.reclaim('/areas/vault');
+
+      expect(store.data.size).toBe(1);
+      expect(reclaimer.getStats().saved).toBe(1);
+
+      const reloaded = loadRoom('/areas/vault');
+      await reclaimer.onLoaded(reloaded);
+
+      expect(reloaded.treasure).toBe(7);
+      expect(store.data.size).toBe(0);
+      expect(reclaimer.getStats()).toMatchObject({ reloaded: 1, saved: 0, unloaded: 0 });
+    });
+
+    it('should not save rooms whose state is clean', async () => {
+      const room = loadRoom('/areas/plain');
+      await reclaimer.onLoaded(room);
+      room.treasure = 3;
+
+      await reclaimer.reclaim('/areas/plain');
+
+      expect(store.data.size).toBe(0);
+    });
+
+    it('should restore state saved by a previous run', async () => {
+      const room = loadRoom('/areas/vault');
+      room.treasure = 11;
+      await reclaimer.reclaim('/areas/vault');
+
+      const restarted = new IdleReclaimer(new ObjectRegistry(), store, {});
+      await restarted.initialize();
+      const reloaded = new TestRoom();
+      reloaded._setupAsBlueprint('/areas/vault');
+      await restarted.onLoaded(reloaded);
+
+      expect(reloaded.treasure).toBe(11);
+    });
+  });
+});
@@ -3,6 +3,7 @@ import { mkdir, rm, writeFile } from 'fs/promises';
 import { join } from 'path';
 import { MudlibLoader, resetMudlibLoader } from '../../src/driver/mudlib-loader.js';
 import { resetRegistry } from '../../src/driver/object-registry.js';
+import { getModuleReloader } from '../../src/driver/module-reloader.js';
 
 const TEST_MUDLIB = './test-mudlib-loader';
 
@@ -40,4 +41,51 @@ export default class DummyObject {
     const obj = await loader.loadObject('/std/dummy');
     expect((obj as { objectPath: string }).objectPath).toBe('/std/dummy');
   });
+
+  it('shares one instance between concurrent loads of the same object', async () => {
+    const loader = new MudlibLoader({ mudlibPath: TEST_MUDLIB });
+    const [a, b] = await Promise.all([
+      loader.loadObject('/std/dummy'),
+      loader.loadObject('/std/dummy'),
+    ]);
+    expect(a).toBe(b);
+  });
+
+  it('reloads an object against its already-loaded imports', async () => {
+    await writeFile(
+      join(TEST_MUDLIB, 'std', 'greeting.ts'),
+      `export const shared = { count: 0 };\nexport function greet() { return 'hello'; }\n`,
+      'utf-8'
+    );
+    const source = (suffix: string) => `
+import { greet, shared } from './greeting.ts';
+export default class Greeter {
+  shared = shared;
+  _setupAsBlueprint(path: string) {}
+  speak(): string { return greet() + '${suffix}'; }
+}
+`;
+    await writeFile(join(TEST_MUDLIB, 'std', 'greeter.ts'), source('!'), 'utf-8');
+
+    const loader = new MudlibLoader({ mudlibPath: TEST_MUDLIB });
+    const original = await loader.loadObject<never>('/std/greeter');
+    await writeFile(join(TEST_MUDLIB, 'std', 'greeter.ts'), source('?'), 'utf-8');
+
+    const result = await loader.reloadObject('/std/greeter');
+    const reloaded = await loader.loadObject<never>('/std/greeter');
+
+    expect(result.success).toBe(true);
+    expect((reloaded as { speak(): string }).speak()).toBe('hello?');
+    // The new version shares the imported module instead of a fresh copy
+    expect((reloaded as { shared: object }).shared).toBe((original as { shared: object }).shared);
+    expect(getModuleReloader().getStats()).toMatchObject({ loaded: 1, pinned: 0 });
+  });
+
+  it('preloads objects and reports a timeline', async () => {
+    const loader = new MudlibLoader({ mudlibPath: TEST_MUDLIB });
+    const report = await loader.preload(['/std/dummy', '/std/missing'], { concurrency: 2 });
+    expect(report.loaded).toBe(1);
+    expect(report.failed).toEqual(['/std/missing']);
+    expect(report.entries.map((entry) => entry.path)).toEqual(['/std/dummy', '/std/missing']);
+  });
 });
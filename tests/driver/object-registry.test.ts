@@ -1,6 +1,9 @@
 import { describe, it, expect, beforeEach, vi } from 'vitest';
-import { ObjectRegistry, resetRegistry } from '../../src/driver/object-registry.js';
+import { ObjectRegistry, getRegistry, resetRegistry } from '../../src/driver/object-registry.js';
 import { BaseMudObject } from '../../src/driver/base-object.js';
+import type { MudObject } from '../../src/driver/types.js';
+import { Room } from '../../mudlib/std/room.js';
+import { MudObject as MudlibObject } from '../../mudlib/std/object.js';
 
 // Test fixture: Simple object class
 class TestObject extends BaseMudObject {
@@ -262,6 +265,38 @@ describe('ObjectRegistry', () => {
     });
   });
 
+  describe('updateBlueprint', () => {
+    it('should move the occupants of a mudlib room onto the new instance', async () => {
+      const room = new Room();
+      room._setupAsBlueprint('/areas/square');
+      registry.registerBlueprint('/areas/square', Room as never, room as never);
+      const visitor = new MudlibObject();
+      (visitor as MudlibObject & { receive: () => void }).receive = vi.fn();
+      const item = new MudlibObject();
+      visitor.moveTo(room);
+      item.moveTo(room);
+
+      const reloaded = new Room();
+      reloaded._setupAsBlueprint('/areas/square');
+      const result = await registry.updateBlueprint(
+        '/areas/square',
+        Room as never,
+        reloaded as never
+      );
+
+      expect(result.migratedObjects).toBe(2);
+      expect(room.inventory).toHaveLength(0);
+      expect(room.listeners).toHaveLength(0);
+      expect(reloaded.inventory).toEqual([visitor, item]);
+      expect(reloaded.listeners).toEqual([visitor]);
+      expect(visitor.environment).toBe(reloaded);
+
+      item.moveTo(null);
+      expect(reloaded.inventory).toEqual([visitor]);
+      expect(reloaded.contains(item)).toBe(false);
+    });
+  });
+
   describe('getAllObjects', () => {
     it('should iterate over all objects', () => {
       const obj1 = new TestObject();
@@ -278,4 +313,132 @@ describe('ObjectRegistry', () => {
       expect(all).toContain(obj2);
     });
   });
+
+  describe('secondary indexes', () => {
+    // Rooms are recognized by resolveExit()
+    class ExitRoom extends BaseMudObject {
+      resolveExit(): undefined {
+        return undefined;
+      }
+    }
+
+    class TestNpc extends BaseMudObject {
+      isLiving = true;
+      isNPC = true;
+    }
+
+    function registerBlueprint(path: string, ctor: new () => BaseMudObject): BaseMudObject {
+      const instance = new ctor();
+      instance._setupAsBlueprint(path);
+      registry.registerBlueprint(path, ctor, instance);
+      return instance;
+    }
+
+    it('should file objects under built-in categories', async () => {
+      const room = registerBlueprint('/areas/room', ExitRoom);
+      registerBlueprint('/std/item', TestItem);
+      registerBlueprint('/npcs/orc', TestNpc);
+      const orc = await registry.clone('/npcs/orc');
+      const clone = await registry.clone('/areas/room');
+
+      expect(Array.from(registry.getByCategory('room'))).toEqual([room, clone]);
+      expect(registry.countByCategory('npc')).toBe(2);
+      expect(Array.from(registry.getByCategory('living'))).toContain(orc);
+      expect(registry.countByCategory('player')).toBe(0);
+      expect(registry.getStats().byCategory).toEqual({ room: 2, npc: 2, living: 2 });
+    });
+
+    it('should drop destroyed and replaced objects', async () => {
+      registerBlueprint('/areas/room', ExitRoom);
+      const clone = (await registry.clone('/areas/room'))!;
+
+      await registry.destroy(clone);
+      const reloaded = new ExitRoom();
+      reloaded._setupAsBlueprint('/areas/room');
+      await registry.updateBlueprint('/areas/room', ExitRoom, reloaded);
+
+      expect(Array.from(registry.getByCategory('room'))).toEqual([reloaded]);
+
+      await registry.unregisterBlueprint('/areas/room');
+      expect(registry.countByCategory('room')).toBe(0);
+      expect(registry.getCategoryCounts()).toEqual({});
+    });
+
+    it('should add and remove tags', async () => {
+      const item = registerBlueprint('/std/item', TestItem);
+      const unregistered = new TestItem();
+      unregistered._setupAsBlueprint('/std/other');
+
+      expect(registry.addTag(item, 'shop')).toBe(true);
+      expect(registry.addTag(unregistered, 'shop')).toBe(false);
+      expect(Array.from(registry.getByCategory('shop'))).toEqual([item]);
+
+      expect(registry.removeTag(item, 'shop')).toBe(true);
+      expect(registry.removeTag(item, 'shop')).toBe(false);
+      expect(registry.countByCategory('shop')).toBe(0);
+
+      registry.addTag(item, 'shop');
+      await registry.destroy(item);
+      expect(registry.countByCategory('shop')).toBe(0);
+    });
+
+    it('should tell category listeners about joins and leaves', async () => {
+      const changes: Array<[string, boolean]> = [];
+      const stop = registry.onCategoryChange('room', (obj, added) => {
+        changes.push([obj.objectId, added]);
+      });
+
+      registerBlueprint('/areas/room', ExitRoom);
+      const clone = (await registry.clone('/areas/room'))!;
+      registerBlueprint('/std/item', TestItem);
+      await registry.destroy(clone);
+      stop();
+      registerBlueprint('/areas/other', ExitRoom);
+
+      expect(changes).toEqual([
+        ['/areas/room', true],
+        [clone.objectId, true],
+        [clone.objectId, false],
+      ]);
+    });
+
+    it('should list the live clones of a blueprint', async () => {
+      registerBlueprint('/std/item', TestItem);
+      const first = (await registry.clone('/std/item'))!;
+      const second = (await registry.clone('/std/item'))!;
+      await registry.destroy(first);
+
+      expect(registry.getClones('/std/item')).toEqual([second]);
+      expect(registry.getClones('/std/missing')).toEqual([]);
+    });
+
+    it('should track objects without an environment as they move', async () => {
+      // Objects report moves to the shared registry
+      registry = getRegistry();
+      const room = registerBlueprint('/areas/room', ExitRoom);
+      registerBlueprint('/std/item', TestItem);
+      const clone = (await registry.clone('/std/item'))!;
+      const roots = (): MudObject[] => Array.from(registry.getRootObjects());
+
+      expect(roots()).toContain(clone);
+
+      await clone.moveTo(room);
+      expect(roots()).not.toContain(clone);
+
+      await clone.moveTo(null);
+      expect(roots()).toContain(clone);
+
+      await registry.destroy(clone);
+      expect(registry.rootCount).toBe(2);
+    });
+
+    it('should count objects by type', async () => {
+      registerBlueprint('/std/item', TestItem);
+      await registry.clone('/std/item');
+      const clone = (await registry.clone('/std/item'))!;
+      await registry.destroy(clone);
+
+      expect(registry.getStats().byType).toEqual({ TestItem: 2 });
+    });
+  });
 });
@@ -316,6 +316,31 @@ describe('Permissions', () => {
     });
   });
 
+  describe('Command Paths', () => {
+    it('should merge custom paths with level defaults', () => {
+      permissions.addCommandPath('alice', 'guilds/fighter');
+
+      const paths = permissions.getEffectiveCommandPaths('Alice', PermissionLevel.Player);
+      expect(paths).toContain('player');
+      expect(paths).toContain('guilds/fighter');
+    });
+
+    it('should bump the revision only when paths change', () => {
+      const start = permissions.getCommandPathsRevision();
+
+      permissions.addCommandPath('alice', 'guilds/fighter');
+      permissions.addCommandPath('alice', 'guilds/fighter');
+      expect(permissions.getCommandPathsRevision()).toBe(start + 1);
+
+      permissions.removeCommandPath('alice', 'guilds/mage');
+      permissions.clearCommandPaths('bob');
+      expect(permissions.getCommandPathsRevision()).toBe(start + 1);
+
+      permissions.clearCommandPaths('alice');
+      expect(permissions.getCommandPathsRevision()).toBe(start + 2);
+    });
+  });
+
   describe('getLevelName', () => {
     it('should return correct level names', () => {
       expect(permissions.getLevelName(PermissionLevel.Player)).toBe('Player');
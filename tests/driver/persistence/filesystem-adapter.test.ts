@@ -4,7 +4,7 @@
  */
 
 import { describe, it, expect, beforeEach, afterEach } from 'vitest';
-import { rm, readFile, access } from 'fs/promises';
+import { rm, readFile, access, mkdir } from 'fs/promises';
 import { join } from 'path';
 import { constants } from 'fs';
 import { FilesystemAdapter } from '../../../src/driver/persistence/filesystem-adapter.js';
@@ -79,6 +79,133 @@ describe('FilesystemAdapter', () => {
     });
   });
 
+  describe('batched player saves', () => {
+    it('should write every player in the batch and keep backups', async () => {
+      await adapter.savePlayer(createPlayerData('alice'));
+      await adapter.savePlayers([createPlayerData('alice'), createPlayerData('bob')]);
+
+      expect((await adapter.loadPlayer('alice'))?.name).toBe('alice');
+      expect((await adapter.loadPlayer('bob'))?.name).toBe('bob');
+      await access(join(TEST_DATA_PATH, 'players', 'alice.json.bak'), constants.F_OK);
+      expect((await adapter.listPlayers()).sort()).toEqual(['alice', 'bob']);
+    });
+  });
+
+  describe('compact player format', () => {
+    it('should migrate JSON saves to the compact format on save', async () => {
+      await adapter.savePlayer(createPlayerData('migrant'));
+      const compact = new FilesystemAdapter({
+        dataPath: TEST_DATA_PATH,
+        playerFormat: { encoding: 'msgpack', compression: 'gzip' },
+      });
+
+      const legacy = await compact.loadPlayer('migrant');
+      expect(legacy?.name).toBe('migrant');
+
+      await compact.savePlayer(legacy!);
+
+      const playersDir = join(TEST_DATA_PATH, 'players');
+      await access(join(playersDir, 'migrant.sav'), constants.F_OK);
+      await access(join(playersDir, 'migrant.json.bak'), constants.F_OK);
+      await expect(access(join(playersDir, 'migrant.json'), constants.F_OK)).rejects.toThrow();
+      expect(await compact.loadPlayer('migrant')).toEqual(legacy);
+      expect(await compact.listPlayers()).toEqual(['migrant']);
+    });
+  });
+
+  describe('journaled player saves', () => {
+    it('should append changes and fold them into the snapshot', async () => {
+      const journaled = new FilesystemAdapter({
+        dataPath: TEST_DATA_PATH,
+        journal: true,
+        journalCompactEntries: 3,
+      });
+      const playersDir = join(TEST_DATA_PATH, 'players');
+      const data = createPlayerData('diary');
+      data.state.properties['notes'] = 'x'.repeat(500);
+      await journaled.savePlayer(data);
+
+      data.state.properties['level'] = 2;
+      await journaled.savePlayer(data);
+      await journaled.savePlayer(data);
+      data.state.properties['level'] = 3;
+      await journaled.savePlayers([data]);
+
+      const log = await readFile(join(playersDir, 'diary.journal'), 'utf-8');
+      expect(log.trim().split('\n')).toHaveLength(3);
+      expect(journaled.getJournalStats()).toMatchObject({
+        appends: 2,
+        compactions: 1,
+        unchanged: 1,
+      });
+      // A fresh adapter (e.g. after a restart) replays the journal
+      const restarted = new FilesystemAdapter({ dataPath: TEST_DATA_PATH });
+      expect(await restarted.loadPlayer('diary')).toEqual(data);
+
+      data.state.properties['level'] = 4;
+      await journaled.savePlayer(data);
+      await journaled.savePlayer({ ...data, savedAt: data.savedAt + 1 });
+
+      await expect(access(join(playersDir, 'diary.journal'), constants.F_OK)).rejects.toThrow();
+      expect(journaled.getJournalStats().compactions).toBe(2);
+      expect((await journaled.loadPlayer('diary'))?.state.properties['level']).toBe(4);
+    });
+
+    it('should write nothing when only the timestamps moved', async () => {
+      const journaled = new FilesystemAdapter({ dataPath: TEST_DATA_PATH, journal: true });
+      const data = createPlayerData('idler');
+      data.state.properties['notes'] = 'x'.repeat(500);
+      await journaled.savePlayer(data);
+
+      await journaled.savePlayer({
+        ...data,
+        state: { ...data.state, timestamp: data.state.timestamp + 1000 },
+        savedAt: data.savedAt + 1000,
+      });
+
+      const playersDir = join(TEST_DATA_PATH, 'players');
+      await expect(access(join(playersDir, 'idler.journal'), constants.F_OK)).rejects.toThrow();
+      expect(journaled.getJournalStats()).toMatchObject({ appends: 0, unchanged: 1 });
+    });
+
+    it('should write a snapshot after a failed append', async () => {
+      const journaled = new FilesystemAdapter({ dataPath: TEST_DATA_PATH, journal: true });
+      const playersDir = join(TEST_DATA_PATH, 'players');
+      const data = createPlayerData('unlucky');
+      data.state.properties['notes'] = 'x'.repeat(500);
+      await journaled.savePlayer(data);
+
+      // A directory in the journal's place makes the append fail
+      await mkdir(join(playersDir, 'unlucky.journal'));
+      data.state.properties['level'] = 2;
+      await expect(journaled.savePlayer(data)).rejects.toThrow();
+      await rm(join(playersDir, 'unlucky.journal'), { recursive: true });
+
+      data.state.properties['level'] = 3;
+      await journaled.savePlayer(data);
+
+      await expect(access(join(playersDir, 'unlucky.journal'), constants.F_OK)).rejects.toThrow();
+      expect(journaled.getJournalStats()).toMatchObject({ appends: 0, compactions: 2 });
+      expect((await adapter.loadPlayer('unlucky'))?.state.properties['level']).toBe(3);
+    });
+
+    it('should discard the journal when saving without journal mode', async () => {
+      const journaled = new FilesystemAdapter({ dataPath: TEST_DATA_PATH, journal: true });
+      const data = createPlayerData('switcher');
+      data.state.properties['notes'] = 'x'.repeat(500);
+      await journaled.savePlayer(data);
+      data.state.properties['level'] = 5;
+      await journaled.savePlayer(data);
+
+      data.state.properties['level'] = 6;
+      await adapter.savePlayer(data);
+
+      const playersDir = join(TEST_DATA_PATH, 'players');
+      await expect(access(join(playersDir, 'switcher.journal'), constants.F_OK)).rejects.toThrow();
+      expect((await adapter.loadPlayer('switcher'))?.state.properties['level']).toBe(6);
+    });
+  });
+
   describe('key sanitization', () => {
     it('should sanitize player names', async () => {
       await adapter.savePlayer(createPlayerData('Test-Player_123'));
@@ -0,0 +1,93 @@
+import { describe, it, expect } from 'vitest';
+import {
+  diffSave,
+  applyOps,
+  journalHeader,
+  journalEntry,
+  replayJournal,
+} from '../../../src/driver/persistence/player-journal.js';
+
+function copy<T>(value: T): T {
+  return JSON.parse(JSON.stringify(value)) as T;
+}
+
+const before = {
+  name: 'alice',
+  savedAt: 1,
+  state: {
+    properties: { hp: 100, gold: 5, title: 'the Brave', skills: [1, 2, 3] },
+    inventory: [{ path: '/std/sword', count: 1 }],
+  },
+};
+
+describe('player journal', () => {
+  it('should diff only the changed fields', () => {
+    const after = copy(before);
+    after.savedAt = 2;
+    after.state.properties.gold = 6;
+
+    expect(diffSave(before, after)).toEqual([
+      { p: ['savedAt'], v: 2 },
+      { p: ['state', 'properties', 'gold'], v: 6 },
+    ]);
+  });
+
+  it('should reproduce the new save by applying the diff', () => {
+    const after = copy(before) as Record<string, unknown> & typeof before;
+    after.state.properties.skills = [1, 2];
+    after.state.inventory[0]!.count = 2;
+    delete (after.state.properties as Partial<typeof before.state.properties>).title;
+    after['extra'] = { nested: [null] };
+
+    const ops = diffSave(before, after);
+
+    expect(applyOps(copy(before), copy(ops))).toEqual(after);
+  });
+
+  it('should return no operations for an unchanged save', () => {
+    expect(diffSave(before, copy(before))).toEqual([]);
+  });
+
+  it('should keep __proto__ keys as data', () => {
+    const after = JSON.parse('{"__proto__":{"polluted":true}}') as object;
+
+    const result = applyOps({}, diffSave({}, after));
+
+    expect(Object.getPrototypeOf(result)).toBe(Object.prototype);
+    expect(Object.keys(result)).toEqual(['__proto__']);
+  });
+
+  it('should replay entries onto the snapshot they extend', () => {
+    const log =
+      journalHeader(1) +
+      journalEntry([{ p: ['state', 'properties', 'hp'], v: 90 }]) +
+      journalEntry([{ p: ['state', 'properties', 'hp'], v: 80 }]);
+
+    const result = replayJournal(copy(before), log, 1);
+
+    expect(result.entries).toBe(2);
+    expect(result.stale).toBe(false);
+    expect(result.torn).toBe(false);
+    expect(result.state.state.properties.hp).toBe(80);
+  });
+
+  it('should ignore a journal left over from an older snapshot', () => {
+    const log = journalHeader(0) + journalEntry([{ p: ['name'], v: 'bob' }]);
+
+    const result = replayJournal(copy(before), log, 1);
+
+    expect(result.stale).toBe(true);
+    expect(result.state.name).toBe('alice');
+  });
+
+  it('should stop at a torn last entry', () => {
+    const full = journalEntry([{ p: ['state', 'properties', 'gold'], v: 7 }]);
+    const log = journalHeader(1) + full + full.slice(0, 10);
+
+    const result = replayJournal(copy(before), log, 1);
+
+    expect(result.entries).toBe(1);
+    expect(result.torn).toBe(true);
+    expect(result.state.state.properties.gold).toBe(7);
+  });
+});
@@ -0,0 +1,59 @@
+import { describe, it, expect } from 'vitest';
+import {
+  encodeSave,
+  decodeSave,
+  encodeMsgpack,
+  decodeMsgpack,
+  isFramedSave,
+  type SaveFormat,
+} from '../../../src/driver/persistence/save-codec.js';
+
+const sample = {
+  name: 'Alice',
+  small: 7,
+  negative: -12,
+  wide: 70000,
+  deep: -70000,
+  huge: 2 ** 40,
+  ratio: 0.25,
+  unicode: 'café ⚔',
+  long: 'x'.repeat(300),
+  flags: [true, false, null],
+  skipped: undefined,
+  nested: Object.fromEntries(Array.from({ length: 20 }, (_, i) => [`key${i}`, i])),
+};
+
+const FORMATS: SaveFormat[] = [
+  { encoding: 'json', compression: 'none' },
+  { encoding: 'json', compression: 'gzip' },
+  { encoding: 'msgpack', compression: 'none' },
+  { encoding: 'msgpack', compression: 'gzip' },
+  { encoding: 'msgpack', compression: 'brotli' },
+];
+
+describe('save codec', () => {
+  it('should round-trip MessagePack with JSON semantics', () => {
+    const value = { ...sample, list: [1, undefined, 'a'], when: new Date(0), nan: NaN };
+
+    expect(decodeMsgpack(encodeMsgpack(value))).toEqual(JSON.parse(JSON.stringify(value)));
+  });
+
+  it.each(FORMATS)('should round-trip $encoding/$compression saves', async (format) => {
+    const encoded = await encodeSave(sample, format);
+
+    expect(await decodeSave(encoded)).toEqual(JSON.parse(JSON.stringify(sample)));
+    expect(isFramedSave(encoded)).toBe(format.encoding !== 'json' || format.compression !== 'none');
+  });
+
+  it('should keep plain JSON saves readable', async () => {
+    const encoded = await encodeSave(sample, { encoding: 'json', compression: 'none' });
+
+    expect(encoded.toString('utf-8')).toBe(JSON.stringify(sample, null, 2));
+  });
+
+  it('should reject truncated saves', async () => {
+    const encoded = await encodeSave(sample, { encoding: 'msgpack', compression: 'none' });
+
+    await expect(decodeSave(encoded.subarray(0, encoded.length - 5))).rejects.toThrow();
+  });
+});
@@ -0,0 +1,114 @@
+/**
+ * Player save formats.
+ *
+ * Compares encode and decode time of the original pretty-printed JSON with
+ * the compact formats on a synthetic player carrying 1,000 items, quest and
+ * exploration state, effects and an embedded base64 portrait. Encoded sizes
+ * are printed once before the benchmarks run.
+ *
+ * Run with: npm run bench
+ */
+import { bench, describe } from 'vitest';
+import { randomBytes } from 'crypto';
+import {
+  encodeSave,
+  decodeSave,
+  type SaveFormat,
+} from '../../../src/driver/persistence/save-codec.js';
+import type { PlayerSaveData } from '../../../src/driver/persistence/serializer.js';
+
+const ITEMS = 1000;
+
+const FORMATS: Record<string, SaveFormat> = {
+  'json (pretty)': { encoding: 'json', compression: 'none' },
+  'json + gzip': { encoding: 'json', compression: 'gzip' },
+  msgpack: { encoding: 'msgpack', compression: 'none' },
+  'msgpack + gzip': { encoding: 'msgpack', compression: 'gzip' },
+  'msgpack + brotli': { encoding: 'msgpack', compression: 'brotli' },
+};
+
+function syntheticPlayer(): PlayerSaveData {
+  const generatedItems = Array.from({ length: ITEMS }, (_, i) => ({
+    id: `gen_${i}`,
+    blueprint: `/std/weapon`,
+    name: `Runed Blade #${i}`,
+    quality: ['common', 'uncommon', 'rare', 'epic'][i % 4],
+    level: 1 + (i % 50),
+    damage: { min: i % 7, max: 10 + (i % 13) },
+    weight: 2.5 + (i % 10) / 10,
+    affixes: [
+      { stat: 'strength', value: i % 5 },
+      { stat: 'critChance', value: (i % 100) / 1000 },
+    ],
+  }));
+
+  const properties: Record<string, unknown> = {
+    name: 'Benchmark',
+    level: 42,
+    race: 'elf',
+    playTime: 123456789,
+    inventory: generatedItems.map((item) => `/std/weapon#${item.id}`),
+    equipment: [
+      { slot: 'main_hand', inventoryIndex: 0 },
+      { slot: 'off_hand', inventoryIndex: 1 },
+    ],
+    generatedItems,
+    effects: Array.from({ length: 20 }, (_, i) => ({
+      id: `effect_${i}`,
+      name: 'Poison',
+      type: 'dot',
+      duration: 30000 - i * 100,
+      magnitude: 5,
+      tickInterval: 2000,
+    })),
+    exploration: {
+      explored: Array.from({ length: 2000 }, (_, i) => `/areas/valdoria/room_${i}`),
+      revealed: Array.from({ length: 500 }, (_, i) => `/areas/wilds/room_${i}`),
+    },
+    questData: Object.fromEntries(
+      Array.from({ length: 100 }, (_, i) => [`quest_${i}`, { stage: i % 5, kills: i * 3 }])
+    ),
+    avatar: `data:image/png;base64,${randomBytes(48 * 1024).toString('base64')}`,
+  };
+
+  return {
+    name: 'benchmark',
+    location: '/areas/valdoria/aldric/center',
+    state: {
+      objectPath: '/std/player#1',
+      isClone: true,
+      properties,
+      timestamp: Date.now(),
+    },
+    savedAt: Date.now(),
+  };
+}
+
+const player = syntheticPlayer();
+const encoded: Record<string, Buffer> = {};
+for (const [label, format] of Object.entries(FORMATS)) {
+  encoded[label] = await encodeSave(player, format);
+}
+
+const baseline = encoded['json (pretty)']!.length;
+console.log(`\nSave size for a ${ITEMS}-item player:`);
+for (const [label, buffer] of Object.entries(encoded)) {
+  const ratio = ((buffer.length / baseline) * 100).toFixed(1);
+  console.log(`  ${label.padEnd(18)} ${String(buffer.length).padStart(9)} bytes  ${ratio}%`);
+}
+
+describe(`encode a ${ITEMS}-item player`, () => {
+  for (const [label, format] of Object.entries(FORMATS)) {
+    bench(label, async () => {
+      await encodeSave(player, format);
+    });
+  }
+});
+
+describe(`decode a ${ITEMS}-item player`, () => {
+  for (const label of Object.keys(FORMATS)) {
+    bench(label, async () => {
+      await decodeSave(encoded[label]!);
+    });
+  }
+});
@@ -0,0 +1,123 @@
+import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
+import {
+  SavePipeline,
+  type PlayerSaveStore,
+} from '../../../src/driver/persistence/save-pipeline.js';
+import type { PlayerSaveData } from '../../../src/driver/persistence/serializer.js';
+
+function snapshot(name: string, level: number): PlayerSaveData {
+  return {
+    name,
+    location: '/areas/void/void',
+    state: {
+      objectPath: '/std/player#1',
+      isClone: true,
+      properties: { name, level },
+      timestamp: Date.now(),
+    },
+    savedAt: Date.now(),
+  };
+}
+
+/**
+ * Store double recording each batch write.
+ */
+class BatchStore implements PlayerSaveStore {
+  batches: PlayerSaveData[][] = [];
+  failNext = false;
+
+  async savePlayer(data: PlayerSaveData): Promise<void> {
+    await this.savePlayers([data]);
+  }
+
+  async savePlayers(batch: PlayerSaveData[]): Promise<void> {
+    if (this.failNext) {
+      this.failNext = false;
+      throw new Error('disk full');
+    }
+    this.batches.push(batch);
+  }
+}
+
+describe('SavePipeline', () => {
+  let store: BatchStore;
+  let pipeline: SavePipeline;
+
+  beforeEach(() => {
+    vi.useFakeTimers();
+    store = new BatchStore();
+    pipeline = new SavePipeline({ windowMs: 1000, batchSize: 2 }, () => store);
+  });
+
+  afterEach(() => {
+    pipeline.stop();
+    vi.useRealTimers();
+  });
+
+  it('should coalesce saves of a player within the window', async () => {
+    pipeline.enqueue(snapshot('Alice', 1));
+    pipeline.enqueue(snapshot('alice', 2));
+    pipeline.enqueue(snapshot('Alice', 3));
+
+    expect(store.batches).toHaveLength(0);
+    await vi.advanceTimersByTimeAsync(1000);
+
+    expect(store.batches).toHaveLength(1);
+    expect(store.batches[0]!.map((data) => data.state.properties['level'])).toEqual([3]);
+    expect(pipeline.getStats()).toMatchObject({
+      queueDepth: 0,
+      requested: 3,
+      coalesced: 2,
+      written: 1,
+      batches: 1,
+    });
+  });
+
+  it('should split the queue into batches', async () => {
+    for (const name of ['a', 'b', 'c']) {
+      pipeline.enqueue(snapshot(name, 1));
+    }
+
+    await pipeline.flush();
+
+    expect(store.batches.map((batch) => batch.length)).toEqual([2, 1]);
+  });
+
+  it('should serve unwritten saves to loads', async () => {
+    pipeline.enqueue(snapshot('Bob', 4));
+
+    expect(pipeline.peek('bob')?.state.properties['level']).toBe(4);
+    await pipeline.flush();
+    expect(pipeline.peek('bob')).toBeUndefined();
+  });
+
+  it('should resolve flushPlayer once the save is written', async () => {
+    pipeline.enqueue(snapshot('Carol', 1));
+
+    await pipeline.flushPlayer('carol');
+
+    expect(store.batches).toHaveLength(1);
+    expect(pipeline.isQueued('carol')).toBe(false);
+  });
+
+  it('should keep failed saves queued unless superseded', async () => {
+    pipeline.enqueue(snapshot('Dave', 1));
+    store.failNext = true;
+
+    await expect(pipeline.flushPlayer('dave')).rejects.toThrow('disk full');
+    expect(pipeline.isQueued('dave')).toBe(true);
+    expect(pipeline.getStats().failed).toBe(1);
+
+    await pipeline.flush();
+    expect(store.batches[0]![0]!.name).toBe('Dave');
+  });
+
+  it('should drop discarded saves', async () => {
+    pipeline.enqueue(snapshot('Eve', 1));
+
+    expect(pipeline.discard('eve')).toBe(true);
+    await pipeline.flush();
+
+    expect(store.batches).toHaveLength(0);
+  });
+});
@@ -0,0 +1,247 @@
+/**
+ * SupabaseAdapter write batching and read cache tests, run against an
+ * in-memory stub of the Supabase query builder.
+ */
+
+import { describe, it, expect, beforeEach, afterEach } from 'vitest';
+import { SupabaseAdapter } from '../../../src/driver/persistence/supabase-adapter.js';
+
+type Row = Record<string, unknown>;
+
+/**
+ * Just enough of the Supabase client for the generic data tables.
+ */
+class StubClient {
+  tables: Map<string, Row[]> = new Map();
+  /** Requests made, as `table.operation` */
+  calls: string[] = [];
+  failUpserts = false;
+
+  rows(table: string): Row[] {
+    let rows = this.tables.get(table);
+    if (!rows) {
+      rows = [];
+      this.tables.set(table, rows);
+    }
+    return rows;
+  }
+
+  from(table: string) {
+    return {
+      upsert: async (value: Row | Row[], options: { onConflict: string }) => {
+        this.calls.push(`${table}.upsert`);
+        if (this.failUpserts) return { error: { message: 'unavailable' } };
+        const columns = options.onConflict.split(',');
+        for (const row of Array.isArray(value) ? value : [value]) {
+          const rows = this.rows(table);
+          const index = rows.findIndex((r) => columns.every((c) => r[c] === row[c]));
+          if (index >= 0) rows[index] = row;
+          else rows.push(row);
+        }
+        return { error: null };
+      },
+      select: (_columns: string, options?: { head?: boolean }) =>
+        new StubQuery(this, table, options?.head ? 'count' : 'select'),
+      delete: () => new StubQuery(this, table, 'delete'),
+    };
+  }
+}
+
+class StubQuery implements PromiseLike<unknown> {
+  private filters: Array<(row: Row) => boolean> = [];
+  private one = false;
+
+  constructor(
+    private client: StubClient,
+    private table: string,
+    private operation: 'select' | 'count' | 'delete'
+  ) {}
+
+  eq(column: string, value: unknown): this {
+    this.filters.push((row) => row[column] === value);
+    return this;
+  }
+
+  like(column: string, pattern: string): this {
+    const prefix = pattern.replace(/%$/, '');
+    this.filters.push((row) => String(row[column]).startsWith(prefix));
+    return this;
+  }
+
+  single(): this {
+    this.one = true;
+    return this;
+  }
+
+  then<A, B>(
+    onFulfilled?: ((value: unknown) => A | PromiseLike<A>) | null,
+    onRejected?: ((reason: unknown) => B | PromiseLike<B>) | null
+  ): PromiseLike<A | B> {
+    return Promise.resolve(this.run()).then(onFulfilled, onRejected);
+  }
+
+  private run(): unknown {
+    this.client.calls.push(`${this.table}.${this.operation}`);
+    const rows = this.client.rows(this.table);
+    const matches = rows.filter((row) => this.filters.every((filter) => filter(row)));
+
+    if (this.operation === 'delete') {
+      this.client.tables.set(
+        this.table,
+        rows.filter((row) => !matches.includes(row))
+      );
+      return { count: matches.length, error: null };
+    }
+    if (this.operation === 'count') {
+      return { count: matches.length, error: null };
+    }
+    if (this.one) {
+      return matches[0]
+        ? { data: matches[0], error: null }
+        : { data: null, error: { code: 'PGRST116', message: 'not found' } };
+    }
+    return { data: matches, error: null };
+  }
+}
+
+describe('SupabaseAdapter', () => {
+  let client: StubClient;
+  let adapter: SupabaseAdapter;
+
+  beforeEach(async () => {
+    client = new StubClient();
+    adapter = new SupabaseAdapter({
+      supabaseUrl: 'http://localhost',
+      supabaseServiceKey: 'test',
+      writeWindowMs: 0,
+      client: client as never,
+    });
+    await adapter.initialize();
+  });
+
+  afterEach(async () => {
+    await adapter.shutdown();
+  });
+
+  describe('write batching', () => {
+    it('should coalesce writes into one upsert per table', async () => {
+      await Promise.all([
+        adapter.saveData('config', 'motd', { text: 'one' }),
+        adapter.saveData('config', 'motd', { text: 'two' }),
+        adapter.saveData('config', 'rules', { text: 'three' }),
+        adapter.saveData('bots', 'guard', { name: 'Guard' }),
+      ]);
+
+      expect(client.calls.sort()).toEqual(['bots.upsert', 'game_state.upsert']);
+      expect(client.rows('game_state').map((row) => row['data'])).toEqual([
+        { text: 'two' },
+        { text: 'three' },
+      ]);
+      expect(adapter.getStats()).toMatchObject({
+        coalescedWrites: 1,
+        writeBatches: 2,
+        rowsWritten: 3,
+      });
+    });
+
+    it('should let reads see queued writes', async () => {
+      const saved = adapter.saveData('config', 'motd', { text: 'queued' });
+
+      expect(await adapter.loadData('config', 'motd')).toEqual({ text: 'queued' });
+      expect(await adapter.dataExists('config', 'motd')).toBe(true);
+      expect(await adapter.listKeys('config')).toEqual(['motd']);
+      await saved;
+    });
+
+    it('should drop a queued write when the key is deleted', async () => {
+      const saved = adapter.saveData('config', 'motd', { text: 'gone' });
+
+      expect(await adapter.deleteData('config', 'motd')).toBe(true);
+      await saved;
+      await adapter.flushWrites();
+
+      expect(client.calls).not.toContain('game_state.upsert');
+      expect(await adapter.loadData('config', 'motd')).toBeNull();
+    });
+
+    it('should write the data as it was when saved', async () => {
+      const state = { text: 'saved' };
+      const saved = adapter.saveData('config', 'motd', state);
+      state.text = 'changed after save';
+      await saved;
+
+      expect(client.rows('game_state')[0]!['data']).toEqual({ text: 'saved' });
+    });
+
+    it('should reject and forget the value when the write fails', async () => {
+      client.failUpserts = true;
+
+      await expect(adapter.saveData('config', 'motd', { text: 'lost' })).rejects.toThrow(
+        'unavailable'
+      );
+
+      expect(await adapter.loadData('config', 'motd')).toBeNull();
+    });
+  });
+
+  describe('read cache', () => {
+    beforeEach(() => {
+      client.rows('game_state').push({ key: 'config.motd', data: { text: 'stored' } });
+    });
+
+    it('should answer repeated reads from the cache', async () => {
+      expect(await adapter.loadData('config', 'motd')).toEqual({ text: 'stored' });
+      expect(await adapter.loadData('config', 'motd')).toEqual({ text: 'stored' });
+      expect(await adapter.dataExists('config', 'motd')).toBe(true);
+
+      expect(client.calls).toEqual(['game_state.select']);
+      expect(adapter.getStats()).toMatchObject({ cacheHits: 2, cacheMisses: 1 });
+    });
+
+    it('should return copies that callers can change', async () => {
+      const loaded = await adapter.loadData<{ text: string }>('config', 'motd');
+      loaded!.text = 'changed';
+
+      expect(await adapter.loadData('config', 'motd')).toEqual({ text: 'stored' });
+    });
+
+    it('should cache missing keys', async () => {
+      expect(await adapter.dataExists('config', 'missing')).toBe(false);
+      expect(await adapter.loadData('config', 'missing')).toBeNull();
+
+      expect(client.calls).toEqual(['game_state.count']);
+    });
+
+    it('should update on write and invalidate on delete', async () => {
+      await adapter.loadData('config', 'motd');
+      await adapter.saveData('config', 'motd', { text: 'updated' });
+      expect(await adapter.loadData('config', 'motd')).toEqual({ text: 'updated' });
+
+      await adapter.deleteData('config', 'motd');
+      expect(await adapter.loadData('config', 'motd')).toBeNull();
+      expect(client.calls.filter((call) => call === 'game_state.select')).toHaveLength(2);
+    });
+
+    it('should evict the least recently used entry', async () => {
+      const small = new SupabaseAdapter({
+        supabaseUrl: 'http://localhost',
+        supabaseServiceKey: 'test',
+        cacheSize: 2,
+        client: client as never,
+      });
+      await small.initialize();
+
+      await small.loadData('config', 'motd');
+      await small.dataExists('config', 'a');
+      await small.loadData('config', 'motd');
+      await small.dataExists('config', 'b');
+      client.calls = [];
+
+      await small.loadData('config', 'motd');
+      await small.dataExists('config', 'a');
+
+      expect(client.calls).toEqual(['game_state.count']);
+      await small.shutdown();
+    });
+  });
+});
@@ -0,0 +1,174 @@
+import { describe, it, expect, beforeEach, afterEach } from 'vitest';
+import { mkdir, rm, writeFile } from 'fs/promises';
+import { dirname, join } from 'path';
+import { randomUUID } from 'crypto';
+import {
+  PreloadEngine,
+  parseImports,
+  type PreloadLoader,
+} from '../../src/driver/preload-engine.js';
+
+/**
+ * Loader double that records start/finish order and tracks concurrency.
+ */
+class FakeLoader implements PreloadLoader {
+  events: string[] = [];
+  active = 0;
+  maxActive = 0;
+  failing = new Set<string>();
+
+  async loadModule(path: string): Promise<unknown> {
+    this.active++;
+    this.maxActive = Math.max(this.maxActive, this.active);
+    this.events.push(`start ${path}`);
+    await new Promise((r) => setTimeout(r, 5));
+    return {};
+  }
+
+  async loadObject(path: string): Promise<unknown> {
+    await new Promise((r) => setTimeout(r, 5));
+    this.active--;
+    this.events.push(`end ${path}`);
+    if (this.failing.has(path)) {
+      throw new Error(`boom ${path}`);
+    }
+    return {};
+  }
+}
+
+describe('PreloadEngine', () => {
+  let mudlibPath: string;
+  let loader: FakeLoader;
+
+  async function writeModule(path: string, source: string = ''): Promise<void> {
+    const file = join(mudlibPath, `${path.slice(1)}.ts`);
+    await mkdir(dirname(file), { recursive: true });
+    await writeFile(file, source, 'utf-8');
+  }
+
+  beforeEach(() => {
+    mudlibPath = `./test-preload-${randomUUID().slice(0, 8)}`;
+    loader = new FakeLoader();
+  });
+
+  afterEach(async () => {
+    await rm(mudlibPath, { recursive: true, force: true });
+  });
+
+  describe('parseImports', () => {
+    it('should return runtime imports and skip type-only imports', () => {
+      const source = `
+import { Room } from '../lib/std.js';
+import type { Player } from '../std/player.js';
+import './side-effect.js';
+export { Item } from "./item.js";
+const x = "import { y } from 'nope'";
+`;
+
+      expect(parseImports(source)).toEqual(['../lib/std.js', './side-effect.js', './item.js']);
+    });
+  });
+
+  describe('run', () => {
+    it('should load independent objects concurrently within the bound', async () => {
+      const paths = ['/std/a', '/std/b', '/std/c', '/std/d', '/std/e'];
+      for (const path of paths) await writeModule(path);
+
+      const report = await new PreloadEngine(loader, mudlibPath, { concurrency: 2 }).run(paths);
+
+      expect(report.loaded).toBe(5);
+      expect(loader.maxActive).toBe(2);
+      expect(report.totalMs).toBeLessThan(report.serialMs);
+    });
+
+    it('should load sequentially with a concurrency of 1', async () => {
+      const paths = ['/std/a', '/std/b', '/std/c'];
+      for (const path of paths) await writeModule(path);
+
+      await new PreloadEngine(loader, mudlibPath, { concurrency: 1 }).run(paths);
+
+      expect(loader.events).toEqual([
+        'start /std/a',
+        'end /std/a',
+        'start /std/b',
+        'end /std/b',
+        'start /std/c',
+        'end /std/c',
+      ]);
+    });
+
+    it('should start an object only after the preloaded objects it imports', async () => {
+      await writeModule('/std/base');
+      // /std/room imports /std/base through an unrequested library module
+      await writeModule('/lib/std', `export { Base } from '../std/base.js';`);
+      await writeModule('/std/room', `import { Base } from '../lib/std.js';`);
+      await writeModule('/std/other');
+
+      const report = await new PreloadEngine(loader, mudlibPath, { concurrency: 4 }).run([
+        '/std/room',
+        '/std/other',
+        '/std/base',
+      ]);
+
+      expect(loader.events.indexOf('start /std/room')).toBeGreaterThan(
+        loader.events.indexOf('end /std/base')
+      );
+      expect(report.entries.find((e) => e.path === '/std/room')!.dependsOn).toEqual(['/std/base']);
+      expect(report.criticalPath).toEqual(['/std/base', '/std/room']);
+    });
+
+    it('should run top-level directories as ordered phases', async () => {
+      const paths = ['/std/a', '/std/b', '/daemons/c', '/areas/d'];
+      for (const path of paths) await writeModule(path);
+
+      const report = await new PreloadEngine(loader, mudlibPath, { concurrency: 8 }).run(paths);
+
+      const startOf = (path: string): number => loader.events.indexOf(`start ${path}`);
+      const endOf = (path: string): number => loader.events.indexOf(`end ${path}`);
+      expect(startOf('/daemons/c')).toBeGreaterThan(Math.max(endOf('/std/a'), endOf('/std/b')));
+      expect(startOf('/areas/d')).toBeGreaterThan(endOf('/daemons/c'));
+      expect(report.entries.map((e) => e.phase)).toEqual([0, 0, 1, 2]);
+      expect(report.criticalPath).toHaveLength(3);
+    });
+
+    it('should not deadlock on import cycles', async () => {
+      await writeModule('/std/a', `import { B } from './b.js';`);
+      await writeModule('/std/b', `import { A } from './a.js';`);
+
+      const report = await new PreloadEngine(loader, mudlibPath, { concurrency: 4 }).run([
+        '/std/a',
+        '/std/b',
+      ]);
+
+      expect(report.loaded).toBe(2);
+      expect(loader.events[0]).toBe('start /std/a');
+    });
+
+    it('should report failures and keep loading dependents', async () => {
+      await writeModule('/std/base');
+      await writeModule('/std/room', `import { Base } from './base.js';`);
+      loader.failing.add('/std/base');
+
+      const report = await new PreloadEngine(loader, mudlibPath, { concurrency: 2 }).run([
+        '/std/base',
+        '/std/room',
+      ]);
+
+      expect(report.failed).toEqual(['/std/base']);
+      expect(report.loaded).toBe(1);
+      expect(report.entries[0]!.error).toBe('boom /std/base');
+    });
+
+    it('should record import and create time for each object', async () => {
+      await writeModule('/std/a');
+
+      const report = await new PreloadEngine(loader, mudlibPath).run(['/std/a', '/std/a']);
+
+      expect(report.entries).toHaveLength(1);
+      const [entry] = report.entries;
+      expect(entry!.importMs).toBeGreaterThan(0);
+      expect(entry!.createMs).toBeGreaterThan(0);
+      expect(entry!.endMs).toBeGreaterThanOrEqual(entry!.startMs + entry!.importMs);
+    });
+  });
+});
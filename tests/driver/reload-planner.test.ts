@@ -0,0 +1,125 @@
+import { describe, it, expect, beforeEach, afterEach } from 'vitest';
+import { mkdir, rm, utimes, writeFile } from 'fs/promises';
+import { join } from 'path';
+import { ImportScanner, planReload, type ImportGraph } from '../../src/driver/reload-planner.js';
+
+/**
+ * Build a graph from module -> imports.
+ */
+function graphOf(imports: Record<string, string[]>): ImportGraph {
+  const dependents = new Map<string, string[]>();
+  for (const [path, deps] of Object.entries(imports)) {
+    for (const dep of deps) {
+      dependents.set(dep, [...(dependents.get(dep) ?? []), path]);
+    }
+  }
+  return {
+    getDependents: (path) => dependents.get(path) ?? [],
+    getDependencies: (path) => imports[path] ?? [],
+  };
+}
+
+describe('planReload', () => {
+  const graph = graphOf({
+    '/std/npc': ['/std/living'],
+    '/std/player': ['/std/living'],
+    '/std/pet': ['/std/npc'],
+    '/std/index': ['/std/living', '/std/npc', '/std/player', '/std/pet'],
+    '/areas/town/guard': ['/std/index'],
+    '/areas/town/cat': ['/std/pet'],
+    '/daemons/combat': ['/std/living'],
+    '/cmds/player/_kill': ['/std/living'],
+  });
+  const loaded = new Set(['/std/player', '/areas/town/guard']);
+  const options = {
+    isBlueprint: (path: string) => loaded.has(path),
+    isCommand: (path: string) => path.startsWith('/cmds/'),
+    isExcluded: (path: string) => path.startsWith('/daemons/'),
+  };
+
+  it('orders dependents into levels after their imports', () => {
+    const plan = planReload('/std/living', graph, options);
+
+    expect(plan.levels).toEqual([
+      ['/std/living'],
+      ['/cmds/player/_kill', '/std/npc', '/std/player'],
+      ['/std/pet'],
+      ['/std/index'],
+      ['/areas/town/guard'],
+    ]);
+    expect(plan.blueprints).toEqual(['/std/player', '/areas/town/guard']);
+    expect(plan.commands).toEqual(['/cmds/player/_kill']);
+  });
+
+  it('marks dependents with nothing loaded stale and skips excluded ones', () => {
+    const plan = planReload('/std/living', graph, options);
+
+    expect(plan.stale).toEqual(['/areas/town/cat']);
+    expect(plan.excluded).toEqual(['/daemons/combat']);
+  });
+
+  it('plans nothing when nothing loaded uses the module', () => {
+    const plan = planReload('/std/pet', graph, {
+      ...options,
+      isBlueprint: () => false,
+      isCommand: () => false,
+    });
+
+    expect(plan.levels).toEqual([]);
+    expect(plan.stale).toEqual(['/areas/town/cat', '/areas/town/guard', '/std/index', '/std/pet']);
+  });
+
+  it('evaluates an import cycle as one level', () => {
+    const cyclic = graphOf({
+      '/std/a': ['/std/root', '/std/b'],
+      '/std/b': ['/std/a'],
+      '/std/c': ['/std/b'],
+    });
+    const plan = planReload('/std/root', cyclic, {
+      isBlueprint: (path) => path === '/std/c',
+      isCommand: () => false,
+      isExcluded: () => false,
+    });
+
+    expect(plan.levels).toEqual([['/std/root'], ['/std/a', '/std/b'], ['/std/c']]);
+    expect(plan.cycles).toEqual(['/std/a', '/std/b']);
+  });
+});
+
+describe('ImportScanner', () => {
+  const root = './test-mudlib-planner';
+
+  beforeEach(async () => {
+    await rm(root, { recursive: true, force: true });
+    await mkdir(join(root, 'std'), { recursive: true });
+    await mkdir(join(root, 'data'), { recursive: true });
+    await writeFile(join(root, 'std', 'living.ts'), `import { MudObject } from './object.js';\n`);
+    await writeFile(
+      join(root, 'std', 'npc.ts'),
+      `import { Living } from './living.js';\nimport type { Stats } from './types.js';\n`
+    );
+    await writeFile(join(root, 'data', 'save.ts'), `import './living.js';\n`);
+  });
+
+  afterEach(async () => {
+    await rm(root, { recursive: true, force: true });
+  });
+
+  it('scans runtime imports and rescans only changed files', async () => {
+    const scanner = new ImportScanner(root);
+
+    const first = await scanner.scan();
+    expect(Object.fromEntries(first.changed)).toEqual({
+      '/std/living': ['/std/object'],
+      '/std/npc': ['/std/living'],
+    });
+
+    await writeFile(join(root, 'std', 'npc.ts'), `import { Living } from '../std/living.js';\n`);
+    await utimes(join(root, 'std', 'npc.ts'), new Date(), new Date(Date.now() + 5000));
+    await rm(join(root, 'std', 'living.ts'));
+
+    const second = await scanner.scan();
+    expect(Object.fromEntries(second.changed)).toEqual({ '/std/npc': ['/std/living'] });
+    expect(second.removed).toEqual(['/std/living']);
+  });
+});
@@ -1,6 +1,7 @@
 import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
 import { Scheduler, resetScheduler } from '../../src/driver/scheduler.js';
 import { BaseMudObject } from '../../src/driver/base-object.js';
+import { getMetrics, resetMetrics } from '../../src/driver/metrics.js';
 
 class TestObject extends BaseMudObject {
   heartbeatCount = 0;
@@ -73,6 +74,173 @@ describe('Scheduler', () => {
     });
   });
 
+  describe('heartbeat modes', () => {
+    afterEach(() => {
+      vi.useRealTimers();
+    });
+
+    it('should use a single slot in batch mode', () => {
+      const batch = new Scheduler({ heartbeatIntervalMs: 100, heartbeatMode: 'batch' });
+
+      expect(batch.heartbeatMode).toBe('batch');
+      expect(batch.getHeartbeatSlotStats()).toHaveLength(1);
+    });
+
+    it('should spread heartbeats across the interval in staggered mode', async () => {
+      vi.useFakeTimers();
+      const staggered = new Scheduler({
+        heartbeatIntervalMs: 1000,
+        heartbeatMode: 'staggered',
+        heartbeatSlots: 10,
+      });
+      const objects = Array.from({ length: 50 }, (_, i) => {
+        const obj = new TestObject();
+        obj._setupAsBlueprint(`/test/staggered${i}`);
+        staggered.setHeartbeat(obj, true);
+        return obj;
+      });
+      staggered.start();
+
+      // Halfway through the interval only some slots have ticked
+      await vi.advanceTimersByTimeAsync(500);
+      const halfway = objects.filter((obj) => obj.heartbeatCount > 0).length;
+      expect(halfway).toBeGreaterThan(0);
+      expect(halfway).toBeLessThan(objects.length);
+
+      await vi.advanceTimersByTimeAsync(500);
+      staggered.stop();
+
+      expect(objects.every((obj) => obj.heartbeatCount === 1)).toBe(true);
+      const slots = staggered.getHeartbeatSlotStats();
+      expect(slots).toHaveLength(10);
+      expect(slots.reduce((sum, slot) => sum + slot.objects, 0)).toBe(50);
+    });
+  });
+
+  describe('heartbeat rate classes', () => {
+    afterEach(() => {
+      vi.useRealTimers();
+    });
+
+    it('should default to the normal class', () => {
+      const obj = new TestObject();
+      scheduler.setHeartbeat(obj, true);
+
+      expect(scheduler.getHeartbeatClass(obj)).toBe('normal');
+      expect(scheduler.getHeartbeatInterval(obj)).toBe(100);
+    });
+
+    it('should resolve named classes and explicit intervals', () => {
+      const slow = new TestObject();
+      const idle = new TestObject();
+      const custom = new TestObject();
+      const matching = new TestObject();
+
+      scheduler.setHeartbeat(slow, true, 'slow');
+      scheduler.setHeartbeat(idle, true, 'idle');
+      scheduler.setHeartbeat(custom, true, 3000);
+      scheduler.setHeartbeat(matching, true, 10000);
+
+      expect(scheduler.getHeartbeatInterval(slow)).toBe(10000);
+      expect(scheduler.getHeartbeatInterval(idle)).toBe(60000);
+      expect(scheduler.getHeartbeatClass(custom)).toBe('3000ms');
+      expect(scheduler.getHeartbeatInterval(custom)).toBe(3000);
+      // An interval equal to a named class shares its wheel
+      expect(scheduler.getHeartbeatClass(matching)).toBe('slow');
+      expect(scheduler.heartbeatCount).toBe(4);
+    });
+
+    it('should reject unknown classes and too-short intervals', () => {
+      const obj = new TestObject();
+
+      expect(() => scheduler.setHeartbeat(obj, true, 'turbo' as 'slow')).toThrow();
+      expect(() => scheduler.setHeartbeat(obj, true, 10)).toThrow();
+      expect(scheduler.hasHeartbeat(obj)).toBe(false);
+    });
+
+    it('should move an object between classes', () => {
+      const obj = new TestObject();
+      scheduler.setHeartbeat(obj, true);
+      scheduler.setHeartbeat(obj, true, 'slow');
+
+      const byName = new Map(scheduler.getHeartbeatClassStats().map((c) => [c.name, c]));
+      expect(byName.get('normal')?.objects).toBe(0);
+      expect(byName.get('slow')?.objects).toBe(1);
+      expect(scheduler.heartbeatCount).toBe(1);
+
+      scheduler.setHeartbeat(obj, false);
+      expect(scheduler.hasHeartbeat(obj)).toBe(false);
+      expect(scheduler.getHeartbeatInterval(obj)).toBe(0);
+    });
+
+    it('should stop and drop a wheel once its class is empty', async () => {
+      vi.useFakeTimers();
+      const obj = new TestObject();
+      obj._setupAsBlueprint('/test/rate-empty');
+      scheduler.start();
+      const classNames = () => scheduler.getHeartbeatClassStats().map((c) => c.name);
+
+      scheduler.setHeartbeat(obj, true, 3000);
+      scheduler.setHeartbeat(obj, true, 'slow');
+      expect(classNames()).toEqual(['normal', 'slow']);
+
+      scheduler.setHeartbeatDormant(obj, true);
+      expect(classNames()).toEqual(['normal']);
+      scheduler.setHeartbeatDormant(obj, false);
+      expect(classNames()).toEqual(['normal', 'slow']);
+
+      scheduler.setHeartbeat(obj, false);
+      expect(classNames()).toEqual(['normal']);
+      expect(vi.getTimerCount()).toBe(1);
+    });
+
+    it('should tick each class at its own rate', async () => {
+      vi.useFakeTimers();
+      const fast = new TestObject();
+      fast._setupAsBlueprint('/test/rate-fast');
+      const slow = new TestObject();
+      slow._setupAsBlueprint('/test/rate-slow');
+
+      scheduler.setHeartbeat(fast, true);
+      scheduler.setHeartbeat(slow, true, 1000);
+      scheduler.start();
+
+      await vi.advanceTimersByTimeAsync(2000);
+      scheduler.stop();
+
+      expect(fast.heartbeatCount).toBe(20);
+      expect(slow.heartbeatCount).toBe(2);
+    });
+
+    it('should keep the class across dormancy', () => {
+      const obj = new TestObject();
+      scheduler.setHeartbeat(obj, true, 'idle');
+
+      expect(scheduler.setHeartbeatDormant(obj, true)).toBe(true);
+      expect(scheduler.getHeartbeatInterval(obj)).toBe(60000);
+      expect(scheduler.setHeartbeatDormant(obj, false)).toBe(true);
+
+      const idle = scheduler.getHeartbeatClassStats().find((c) => c.name === 'idle');
+      expect(idle?.objects).toBe(1);
+    });
+
+    it('should record heartbeat cost per class', async () => {
+      resetMetrics();
+      vi.useFakeTimers();
+      const obj = new TestObject();
+      obj._setupAsBlueprint('/test/rate-metrics');
+      scheduler.setHeartbeat(obj, true, 'slow');
+      scheduler.start();
+
+      await vi.advanceTimersByTimeAsync(10000);
+      scheduler.stop();
+
+      const classes = getMetrics().getFormattedMetrics().heartbeatClasses;
+      expect(classes['slow']?.count).toBe(1);
+      expect(classes['normal']).toBeUndefined();
+    });
+  });
+
   describe('callOut', () => {
     it('should schedule a callback', () => {
       const callback = vi.fn();
@@ -108,7 +276,7 @@ describe('Scheduler', () => {
       scheduler.callOutRepeat(callback, 50);
       scheduler.start();
 
-      // Scheduler checks every 100ms, so wait long enough for multiple checks
+      // Wait long enough for several intervals
       await new Promise((resolve) => setTimeout(resolve, 350));
 
       // Should have been called multiple times
@@ -117,6 +285,83 @@ describe('Scheduler', () => {
     });
   });
 
+  describe('callOut timing', () => {
+    beforeEach(() => {
+      vi.useFakeTimers();
+      resetMetrics();
+    });
+
+    afterEach(() => {
+      vi.useRealTimers();
+    });
+
+    it('should fire at the deadline instead of the next polling tick', async () => {
+      const callback = vi.fn();
+      scheduler.start();
+      scheduler.callOut(callback, 30);
+
+      await vi.advanceTimersByTimeAsync(29);
+      expect(callback).not.toHaveBeenCalled();
+
+      await vi.advanceTimersByTimeAsync(1);
+      expect(callback).toHaveBeenCalledTimes(1);
+    });
+
+    it('should wake early for a callOut scheduled before the armed deadline', async () => {
+      const late = vi.fn();
+      const early = vi.fn();
+      scheduler.start();
+      scheduler.callOut(late, 5000);
+      scheduler.callOut(early, 20);
+
+      await vi.advanceTimersByTimeAsync(20);
+
+      expect(early).toHaveBeenCalled();
+      expect(late).not.toHaveBeenCalled();
+    });
+
+    it('should not run a callOut cancelled by an earlier callback in the same batch', async () => {
+      const second = vi.fn();
+      scheduler.start();
+      let secondId = 0;
+      scheduler.callOut(() => {
+        scheduler.removeCallOut(secondId);
+      }, 10);
+      secondId = scheduler.callOut(second, 10);
+
+      await vi.advanceTimersByTimeAsync(50);
+
+      expect(second).not.toHaveBeenCalled();
+      expect(scheduler.callOutCount).toBe(0);
+    });
+
+    it('should allow a recurring callOut to cancel itself', async () => {
+      let count = 0;
+      scheduler.start();
+      const id = scheduler.callOutRepeat(() => {
+        count++;
+        if (count === 3) scheduler.removeCallOut(id);
+      }, 10);
+
+      await vi.advanceTimersByTimeAsync(100);
+
+      expect(count).toBe(3);
+      expect(scheduler.callOutCount).toBe(0);
+    });
+
+    it('should record callOut lateness', async () => {
+      scheduler.start();
+      scheduler.callOut(() => {}, 10);
+      scheduler.callOut(() => {}, 20);
+
+      await vi.advanceTimersByTimeAsync(50);
+
+      const snapshot = getMetrics().getSnapshot();
+      expect(snapshot.callOutLateness.count).toBe(2);
+      expect(snapshot.callOutLateness.max).toBeLessThan(10);
+    });
+  });
+
   describe('removeCallOut', () => {
     it('should cancel a scheduled callOut', async () => {
       const callback = vi.fn();
@@ -200,5 +445,22 @@ describe('Scheduler', () => {
       expect(scheduler.heartbeatCount).toBe(0);
       expect(scheduler.callOutCount).toBe(0);
     });
+
+    it('should stop and drop every class wheel but normal', () => {
+      vi.useFakeTimers();
+      const obj = new TestObject();
+      obj._setupAsBlueprint('/test/clear-rates');
+      const other = new TestObject();
+      other._setupAsBlueprint('/test/clear-rates-2');
+      scheduler.start();
+      scheduler.setHeartbeat(obj, true, 'slow');
+      scheduler.setHeartbeat(other, true, 3000);
+
+      scheduler.clear();
+
+      expect(scheduler.getHeartbeatClassStats().map((c) => c.name)).toEqual(['normal']);
+      expect(vi.getTimerCount()).toBe(1);
+      vi.useRealTimers();
+    });
   });
 });
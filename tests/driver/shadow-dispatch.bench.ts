@@ -0,0 +1,94 @@
+/**
+ * Property and method access through a shadow proxy.
+ *
+ * Compares the precomputed per-object resolution table against the previous
+ * handler, which walked every shadow and re-bound functions on each access.
+ * The object carries three shadows; only one of them overrides `name`.
+ *
+ * Run with: npm run bench
+ */
+import { bench, describe } from 'vitest';
+import { ShadowRegistry } from '../../src/driver/shadow-registry.js';
+import { type Shadow, UNSHADOWABLE_PROPERTIES } from '../../src/driver/shadow-types.js';
+import { BaseMudObject } from '../../src/driver/base-object.js';
+import type { MudObject } from '../../src/driver/types.js';
+
+const ACCESSES = 10000;
+
+class Target extends BaseMudObject {
+  hp = 100;
+
+  getHp(): number {
+    return this.hp;
+  }
+}
+
+function makeShadow(shadowType: string, priority: number, overrides: object = {}): Shadow {
+  return Object.assign(
+    {
+      shadowId: `${shadowType}_bench`,
+      shadowType,
+      priority,
+      isActive: true,
+      target: null,
+    },
+    overrides
+  ) as Shadow;
+}
+
+/**
+ * The pre-table handler: scan all shadows and bind on every access.
+ */
+function legacyProxy(target: MudObject, shadows: Shadow[]): MudObject {
+  return new Proxy(target, {
+    get(obj, prop, receiver): unknown {
+      if (typeof prop === 'symbol' || UNSHADOWABLE_PROPERTIES.has(prop)) {
+        const value = Reflect.get(obj, prop, receiver);
+        return typeof value === 'function' ? value.bind(obj) : value;
+      }
+      for (const shadow of shadows) {
+        if (!shadow.isActive) continue;
+        const shadowValue = shadow[prop];
+        if (shadowValue !== undefined) {
+          return typeof shadowValue === 'function' ? shadowValue.bind(shadow) : shadowValue;
+        }
+      }
+      const value = Reflect.get(obj, prop, receiver);
+      return typeof value === 'function' ? value.bind(obj) : value;
+    },
+  });
+}
+
+describe(`${ACCESSES} accesses through a 3-shadow proxy`, async () => {
+  const registry = new ShadowRegistry();
+  const target = new Target();
+  target._setupAsBlueprint('/bench/target');
+
+  const shadows = [
+    makeShadow('invis', 30, { shortDesc: 'something' }),
+    makeShadow('disguise', 20, { name: 'stranger' }),
+    makeShadow('curse', 10, { getNaturalAttack: () => null }),
+  ];
+  for (const shadow of shadows) {
+    await registry.addShadow(target, shadow);
+  }
+
+  const legacy = legacyProxy(target, registry.getShadows(target.objectId)) as Target;
+  const current = registry.wrapWithProxy(target) as Target;
+
+  bench('legacy: shadowed property', () => {
+    for (let i = 0; i < ACCESSES; i++) void legacy.name;
+  });
+
+  bench('table: shadowed property', () => {
+    for (let i = 0; i < ACCESSES; i++) void current.name;
+  });
+
+  bench('legacy: un-shadowed method call', () => {
+    for (let i = 0; i < ACCESSES; i++) legacy.getHp();
+  });
+
+  bench('table: un-shadowed method call', () => {
+    for (let i = 0; i < ACCESSES; i++) current.getHp();
+  });
+});
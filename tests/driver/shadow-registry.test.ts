@@ -469,6 +469,58 @@ describe('ShadowRegistry', () => {
 
       expect(obj.value).toBe(999);
     });
+
+    it('should return the same bound function on repeated method access', async () => {
+      const obj = new TestObject();
+      obj._setupAsBlueprint('/test/obj');
+      await registry.addShadow(obj, new TestShadow());
+      const wrapped = registry.wrapWithProxy(obj) as TestObject;
+
+      // Shadowed method
+      expect(wrapped.greet).toBe(wrapped.greet);
+      // Original method
+      expect(wrapped.getFullName).toBe(wrapped.getFullName);
+      expect(wrapped.getFullName()).toBe('TestName the Tester');
+    });
+
+    it('should pick up shadows toggled active after the first access', async () => {
+      const obj = new TestObject();
+      obj._setupAsBlueprint('/test/obj');
+      const shadow = new TestShadow();
+      await registry.addShadow(obj, shadow);
+      const wrapped = registry.wrapWithProxy(obj) as TestObject;
+
+      expect(wrapped.greet()).toBe('Hello from shadow!');
+      shadow.isActive = false;
+      expect(wrapped.greet()).toBe('Hello, I am TestName!');
+      shadow.isActive = true;
+      expect(wrapped.greet()).toBe('Hello from shadow!');
+    });
+
+    it('should re-resolve through an existing proxy after shadows change', async () => {
+      const obj = new TestObject();
+      obj._setupAsBlueprint('/test/obj');
+      const low = new LowPriorityShadow();
+      await registry.addShadow(obj, low);
+      const wrapped = registry.wrapWithProxy(obj) as TestObject;
+
+      expect(wrapped.name).toBe('LowPriorityName');
+
+      const high = new HighPriorityShadow();
+      await registry.addShadow(obj, high);
+      expect(wrapped.name).toBe('HighPriorityName');
+      expect(obj.name).toBe('HighPriorityName');
+
+      await registry.removeShadow(obj, high);
+      expect(wrapped.name).toBe('LowPriorityName');
+
+      await registry.removeShadow(obj, low);
+      expect(wrapped.name).toBe('TestName');
+
+      // Re-shadowing after all shadows were removed still reaches old proxies
+      await registry.addShadow(obj, new TestShadow());
+      expect(wrapped.greet()).toBe('Hello from shadow!');
+    });
   });
 
   describe('getOriginal', () => {
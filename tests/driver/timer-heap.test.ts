@@ -0,0 +1,80 @@
+import { describe, it, expect, beforeEach } from 'vitest';
+import { TimerHeap, type TimerHeapEntry } from '../../src/driver/timer-heap.js';
+
+function entry(id: number, executeAt: number): TimerHeapEntry {
+  return { id, executeAt, heapIndex: -1 };
+}
+
+describe('TimerHeap', () => {
+  let heap: TimerHeap<TimerHeapEntry>;
+
+  beforeEach(() => {
+    heap = new TimerHeap();
+  });
+
+  it('should pop entries in deadline order', () => {
+    heap.push(entry(1, 300));
+    heap.push(entry(2, 100));
+    heap.push(entry(3, 200));
+
+    expect(heap.pop()?.id).toBe(2);
+    expect(heap.pop()?.id).toBe(3);
+    expect(heap.pop()?.id).toBe(1);
+    expect(heap.pop()).toBeUndefined();
+  });
+
+  it('should break deadline ties by id', () => {
+    heap.push(entry(3, 100));
+    heap.push(entry(1, 100));
+    heap.push(entry(2, 100));
+
+    expect([heap.pop()?.id, heap.pop()?.id, heap.pop()?.id]).toEqual([1, 2, 3]);
+  });
+
+  it('should peek without removing', () => {
+    heap.push(entry(1, 50));
+
+    expect(heap.peek()?.id).toBe(1);
+    expect(heap.size).toBe(1);
+  });
+
+  it('should remove an arbitrary entry and keep order', () => {
+    const entries = Array.from({ length: 50 }, (_, i) => entry(i + 1, (i * 37) % 101));
+    entries.forEach((e) => heap.push(e));
+
+    const removed = entries.filter((_, i) => i % 3 === 0);
+    for (const e of removed) {
+      expect(heap.remove(e)).toBe(true);
+      expect(e.heapIndex).toBe(-1);
+    }
+
+    const popped: number[] = [];
+    let next = heap.pop();
+    while (next) {
+      popped.push(next.executeAt);
+      next = heap.pop();
+    }
+
+    expect(popped.length).toBe(entries.length - removed.length);
+    expect(popped).toEqual([...popped].sort((a, b) => a - b));
+  });
+
+  it('should return false when removing an entry that is not queued', () => {
+    const e = entry(1, 100);
+    heap.push(e);
+    heap.pop();
+
+    expect(heap.remove(e)).toBe(false);
+  });
+
+  it('should clear all entries', () => {
+    const e = entry(1, 100);
+    heap.push(e);
+    heap.push(entry(2, 200));
+
+    heap.clear();
+
+    expect(heap.size).toBe(0);
+    expect(e.heapIndex).toBe(-1);
+  });
+});
@@ -1,6 +1,7 @@
 import { describe, it, expect, beforeEach, afterEach } from 'vitest';
 import { ScriptRunner, resetScriptRunner } from '../../src/isolation/script-runner.js';
 import { resetIsolatePool } from '../../src/isolation/isolate-pool.js';
+import { getMetrics, resetMetrics } from '../../src/driver/metrics.js';
 
 describe('ScriptRunner', () => {
   let runner: ScriptRunner;
@@ -211,6 +212,96 @@ describe('ScriptRunner', () => {
     });
   });
 
+  describe('metrics', () => {
+    it('should identify slow scripts by hash, not by source', async () => {
+      resetMetrics();
+      await runner.run(`
+        const secret = 'tell bob hi';
+        const end = Date.now() + 80;
+        while (Date.now() < end) {}
+      `);
+
+      const slow = getMetrics().getSnapshot().slowOperations.filter((op) => op.type === 'script');
+      expect(slow).toHaveLength(1);
+      expect(slow[0]!.identifier).toMatch(/^script [0-9a-f]{12}$/);
+    });
+  });
+
+  describe('compiled script cache', () => {
+    it('should reuse compilations of identical source', async () => {
+      await runner.run<number>('6 * 7');
+      const result = await runner.run<number>('6 * 7');
+
+      expect(result.value).toBe(42);
+      const stats = runner.getStats();
+      expect(stats.scriptCacheMisses).toBe(1);
+      expect(stats.scriptCacheHits).toBe(1);
+      expect(stats.codeCacheEntries).toBe(1);
+    });
+
+    it('should still run cached scripts in a fresh context', async () => {
+      const code = 'var counter = (typeof counter === "number" ? counter : 0) + 1; counter';
+      await runner.run<number>(code);
+      const result = await runner.run<number>(code);
+
+      expect(result.value).toBe(1);
+      expect(runner.getStats().scriptCacheHits).toBe(1);
+    });
+  });
+
+  describe('warm contexts', () => {
+    let warm: ScriptRunner;
+
+    beforeEach(() => {
+      runner.dispose();
+      resetIsolatePool();
+      warm = new ScriptRunner({
+        defaultTimeoutMs: 1000,
+        memoryLimitMb: 64,
+        maxIsolates: 1,
+        warmContexts: true,
+        contextMaxRuns: 3,
+      });
+    });
+
+    afterEach(() => {
+      warm.dispose();
+    });
+
+    it('should reuse the initialized context across runs', async () => {
+      await warm.run('1');
+      await warm.run('2');
+
+      expect(warm.getStats().contextsCreated).toBe(1);
+    });
+
+    it('should recycle the context after contextMaxRuns runs', async () => {
+      await warm.run('var seen = 1;');
+      expect((await warm.run('typeof seen')).value).toBe('number');
+      await warm.run('3');
+      // Fourth run gets a new context
+      expect((await warm.run('typeof seen')).value).toBe('undefined');
+      expect(warm.getStats().contextsCreated).toBe(2);
+    });
+
+    it('should discard the context after a failed run', async () => {
+      await warm.run('var leftover = 1;');
+      await warm.run('while(true) {}', 50);
+      const result = await warm.run('typeof leftover');
+
+      expect(result.value).toBe('undefined');
+    });
+
+    it('should rebuild warm contexts when functions are registered', async () => {
+      await warm.run('1');
+      warm.registerFunction({ name: 'late', implementation: () => 'here' });
+      const result = await warm.run<string>('late()');
+
+      expect(result.success).toBe(true);
+      expect(result.value).toBe('here');
+    });
+  });
+
   describe('multiple executions', () => {
     it('should handle sequential executions', async () => {
       const results = await Promise.all([
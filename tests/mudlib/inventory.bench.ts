@@ -0,0 +1,67 @@
+/**
+ * MudObject inventory move cost in a crowded container.
+ *
+ * Performs 10k moves out of and back into a room holding 1k items, comparing
+ * the Set-backed inventory against the previous indexOf/splice array.
+ *
+ * Run with: npm run bench
+ */
+import { bench, describe } from 'vitest';
+import { MudObject } from '../../mudlib/std/object.js';
+
+const ITEMS = 1000;
+const MOVES = 10000;
+
+/**
+ * The pre-Set container: a plain array with indexOf/splice removal.
+ */
+class ArrayContainer {
+  readonly contents: object[] = [];
+
+  remove(obj: object): void {
+    const idx = this.contents.indexOf(obj);
+    if (idx >= 0) {
+      this.contents.splice(idx, 1);
+    }
+  }
+
+  add(obj: object): void {
+    this.contents.push(obj);
+  }
+}
+
+describe(`${MOVES} moves in a ${ITEMS}-item room`, () => {
+  const room = new MudObject();
+  const bag = new MudObject();
+  const items = Array.from({ length: ITEMS }, () => {
+    const item = new MudObject();
+    item.moveTo(room);
+    return item;
+  });
+
+  const arrayRoom = new ArrayContainer();
+  const arrayBag = new ArrayContainer();
+  const plainItems = Array.from({ length: ITEMS }, () => {
+    const item = {};
+    arrayRoom.add(item);
+    return item;
+  });
+
+  bench('array indexOf/splice', () => {
+    for (let i = 0; i < MOVES; i++) {
+      const item = plainItems[(i * 7) % ITEMS]!;
+      arrayRoom.remove(item);
+      arrayBag.add(item);
+      arrayBag.remove(item);
+      arrayRoom.add(item);
+    }
+  });
+
+  bench('MudObject (Set-backed)', () => {
+    for (let i = 0; i < MOVES; i++) {
+      const item = items[(i * 7) % ITEMS]!;
+      item.moveTo(bag);
+      item.moveTo(room);
+    }
+  });
+});
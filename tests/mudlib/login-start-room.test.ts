@@ -0,0 +1,36 @@
+import { describe, it, expect, beforeEach } from 'vitest';
+import { LoginDaemon } from '../../mudlib/daemons/login.js';
+
+type LoadRoom = { loadRoom: (path: string) => Promise<unknown> };
+
+describe('LoginDaemon start room with a lazy world', () => {
+  const square = { objectPath: '/areas/valdoria/aldric/center' };
+  let loaded: string[];
+
+  beforeEach(() => {
+    loaded = [];
+    // Nothing under /areas is preloaded, so lookups always miss
+    (globalThis as unknown as { efuns: Record<string, unknown> }).efuns = {
+      isLazyWorld: () => true,
+      findObject: () => undefined,
+      loadBlueprint: async (path: string) => {
+        loaded.push(path);
+        if (path === square.objectPath) return square;
+        throw new Error(`Cannot find module ${path}`);
+      },
+    };
+  });
+
+  it('loads a room that was never loaded', async () => {
+    const daemon = new LoginDaemon() as unknown as LoadRoom;
+
+    expect(await daemon.loadRoom(square.objectPath)).toBe(square);
+    expect(loaded).toEqual([square.objectPath]);
+  });
+
+  it('returns nothing for a room that fails to load, so login can fall back', async () => {
+    const daemon = new LoginDaemon() as unknown as LoadRoom;
+
+    expect(await daemon.loadRoom('/areas/removed/room')).toBeUndefined();
+  });
+});
@@ -0,0 +1,35 @@
+import { describe, it, expect } from 'vitest';
+import { Mercenary } from '../../mudlib/std/mercenary.js';
+import { Pet } from '../../mudlib/std/pet.js';
+
+describe('Companion heartbeat dormancy', () => {
+  it('keeps a hired mercenary awake so it can rejoin or dismiss itself', () => {
+    const merc = new Mercenary();
+    merc.ownerName = 'alice';
+
+    expect(merc.allowsHeartbeatDormancy()).toBe(false);
+
+    merc.following = false;
+    expect(merc.allowsHeartbeatDormancy()).toBe(false);
+  });
+
+  it('keeps a following mercenary awake without an owner', () => {
+    const merc = new Mercenary();
+
+    expect(merc.allowsHeartbeatDormancy()).toBe(false);
+  });
+
+  it('lets an unowned, idle mercenary go dormant like any NPC', () => {
+    const merc = new Mercenary();
+    merc.following = false;
+
+    expect(merc.allowsHeartbeatDormancy()).toBe(true);
+  });
+
+  it('lets an owned pet go dormant since following is not heartbeat-driven', () => {
+    const pet = new Pet();
+    pet.ownerName = 'alice';
+
+    expect(pet.allowsHeartbeatDormancy()).toBe(true);
+  });
+});
@@ -79,6 +79,109 @@ describe('MudObject', () => {
       expect(obj.environment).toBeNull();
       expect(room.inventory).not.toContain(obj);
     });
+
+    it('should keep inventory in arrival order', () => {
+      const room = new MudObject();
+      const a = new MudObject();
+      const b = new MudObject();
+      const c = new MudObject();
+
+      a.moveTo(room);
+      b.moveTo(room);
+      c.moveTo(room);
+      // Re-entering moves an object to the end
+      a.moveTo(room);
+
+      expect(room.inventory).toEqual([b, c, a]);
+    });
+
+    it('should report membership with contains()', () => {
+      const room = new MudObject();
+      const other = new MudObject();
+
+      expect(room.contains(obj)).toBe(false);
+      obj.moveTo(room);
+      expect(room.contains(obj)).toBe(true);
+      obj.moveTo(other);
+      expect(room.contains(obj)).toBe(false);
+      expect(other.contains(obj)).toBe(true);
+    });
+
+    it('should let callers move objects while iterating inventory', () => {
+      const room = new MudObject();
+      const bag = new MudObject();
+      const items = Array.from({ length: 5 }, () => new MudObject());
+      for (const item of items) {
+        item.moveTo(room);
+      }
+
+      for (const item of room.inventory) {
+        item.moveTo(bag);
+      }
+
+      expect(room.inventory).toHaveLength(0);
+      expect(bag.inventory).toEqual(items);
+    });
+  });
+
+  describe('occupants', () => {
+    function makeLiving(flags: { isPlayer?: boolean; isNPC?: boolean } = {}): MudObject {
+      const living = new MudObject();
+      Object.assign(living, { isLiving: true, receive: () => {}, ...flags });
+      return living;
+    }
+
+    it('should file arrivals into category buckets', () => {
+      const player = makeLiving({ isPlayer: true });
+      const npc = makeLiving({ isNPC: true });
+      const item = new MudObject();
+
+      player.moveTo(obj);
+      npc.moveTo(obj);
+      item.moveTo(obj);
+
+      expect(obj.getOccupants('living')).toEqual([player, npc]);
+      expect(obj.getOccupants('player')).toEqual([player]);
+      expect(obj.getOccupants('npc')).toEqual([npc]);
+      expect(obj.getOccupants('item')).toEqual([item]);
+      expect(obj.getLivings()).toEqual([player, npc]);
+      expect(obj.listeners).toEqual([player, npc]);
+    });
+
+    it('should remove departures from every bucket', () => {
+      const other = new MudObject();
+      const npc = makeLiving({ isNPC: true });
+
+      npc.moveTo(obj);
+      npc.moveTo(other);
+
+      expect(obj.getOccupants('npc')).toHaveLength(0);
+      expect(obj.getOccupants('living')).toHaveLength(0);
+      expect(other.getOccupants('npc')).toEqual([npc]);
+    });
+
+    it('should reuse the view until the category changes', () => {
+      const item = new MudObject();
+      item.moveTo(obj);
+
+      const first = obj.getOccupants('item');
+      expect(obj.getOccupants('item')).toBe(first);
+
+      new MudObject().moveTo(obj);
+      expect(obj.getOccupants('item')).not.toBe(first);
+      expect(first).toHaveLength(1);
+    });
+
+    it('should re-file an object when its categories change', () => {
+      const torch = new MudObject();
+      torch.moveTo(obj);
+      expect(obj.getOccupants('lightSource')).toHaveLength(0);
+
+      Object.assign(torch, { isLightSource: true });
+      torch.updateOccupantCategories();
+
+      expect(obj.getOccupants('lightSource')).toEqual([torch]);
+    });
   });
 
   describe('actions', () => {
@@ -2,14 +2,33 @@ import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
 import { ResetDaemon } from '../../mudlib/daemons/reset.js';
 import { Room } from '../../mudlib/std/room.js';
 import { MudObject } from '../../mudlib/std/object.js';
+import { getConfigDaemon, resetConfigDaemon } from '../../mudlib/daemons/config.js';
 
 type MockEfuns = {
   callOut: (callback: () => void | Promise<void>, delayMs: number) => number;
   removeCallOut: (id: number) => boolean;
   destruct: (obj: MudObject) => Promise<void>;
   findObject: (pathOrId: string) => MudObject | undefined;
+  getObjectsByCategory: (category: string) => MudObject[];
+  onObjectCategoryChange: (
+    category: string,
+    callback: (obj: MudObject, added: boolean) => void
+  ) => () => void;
 };
 
+let rooms: Room[];
+let roomListener: ((obj: MudObject, added: boolean) => void) | null;
+
+function onObjectCategoryChange(
+  _category: string,
+  callback: (obj: MudObject, added: boolean) => void
+): () => void {
+  roomListener = callback;
+  return () => {
+    roomListener = null;
+  };
+}
+
 describe('ResetDaemon cleanup', () => {
   let destructMock: ReturnType<typeof vi.fn>;
 
@@ -21,7 +40,10 @@ describe('ResetDaemon cleanup', () => {
       removeCallOut: vi.fn(() => true),
       destruct: destructMock,
       findObject: vi.fn(() => undefined),
+      getObjectsByCategory: vi.fn(() => rooms),
+      onObjectCategoryChange,
     };
+    rooms = [];
 
     (globalThis as unknown as { efuns: MockEfuns }).efuns = efuns;
   });
@@ -52,3 +74,142 @@ describe('ResetDaemon cleanup', () => {
     expect(destructMock).not.toHaveBeenCalledWith(ferry);
   });
 });
+
+describe('ResetDaemon batches', () => {
+  const intervalMs = 15 * 60 * 1000;
+  let daemon: ResetDaemon;
+  let now: number;
+
+  function createRoom(id: string, resetMs: number = 0): Room & { resets: number } {
+    const room = Object.assign(new Room(), { resets: 0 });
+    room._setupAsBlueprint(id);
+    room.onReset = async () => {
+      room.resets++;
+      const end = performance.now() + resetMs;
+      while (performance.now() < end) {
+        // Simulate an expensive reset
+      }
+    };
+    rooms.push(room);
+    roomListener?.(room, true);
+    return room;
+  }
+
+  function unloadRoom(room: Room): void {
+    rooms.splice(rooms.indexOf(room), 1);
+    roomListener?.(room, false);
+  }
+
+  beforeEach(() => {
+    rooms = [];
+    roomListener = null;
+    now = 1_000_000;
+    vi.spyOn(Date, 'now').mockImplementation(() => now);
+    (globalThis as unknown as { efuns: Partial<MockEfuns> }).efuns = {
+      callOut: vi.fn(() => 1),
+      removeCallOut: vi.fn(() => true),
+      destruct: vi.fn(async () => {}),
+      findObject: vi.fn(() => undefined),
+      getObjectsByCategory: vi.fn(() => rooms),
+      onObjectCategoryChange,
+    };
+    resetConfigDaemon();
+    daemon = new ResetDaemon();
+  });
+
+  afterEach(() => {
+    daemon.stop();
+    resetConfigDaemon();
+    vi.restoreAllMocks();
+  });
+
+  it('should spread first resets over the interval', async () => {
+    const random = vi.spyOn(Math, 'random');
+    random.mockReturnValueOnce(0).mockReturnValueOnce(0.5);
+    const early = createRoom('/areas/early');
+    const late = createRoom('/areas/late');
+
+    expect(await daemon.runBatch()).toBe(1);
+    expect(early.resets).toBe(1);
+    expect(late.resets).toBe(0);
+
+    now += intervalMs / 2;
+    expect(await daemon.runBatch()).toBe(1);
+    expect(late.resets).toBe(1);
+    expect(daemon.getTimeUntilReset()).toBe(intervalMs / 2);
+  });
+
+  it('should reschedule a room a full interval after it resets', async () => {
+    vi.spyOn(Math, 'random').mockReturnValue(0);
+    const room = createRoom('/areas/room');
+
+    await daemon.runBatch();
+    now += intervalMs - 1;
+    await daemon.runBatch();
+    expect(room.resets).toBe(1);
+
+    now += 1;
+    await daemon.runBatch();
+    expect(room.resets).toBe(2);
+  });
+
+  it('should stop a batch at the time budget and carry the rest over', async () => {
+    vi.spyOn(Math, 'random').mockReturnValue(0);
+    getConfigDaemon().set('reset.batchBudgetMs', 1);
+    for (let i = 0; i < 3; i++) createRoom(`/areas/slow${i}`, 2);
+
+    expect(await daemon.runBatch()).toBe(1);
+    expect(daemon.getStats().roomsBacklog).toBe(2);
+    expect(daemon.getTimeUntilReset()).toBe(0);
+
+    await daemon.runBatch();
+    await daemon.runBatch();
+
+    expect(rooms.map((room) => (room as Room & { resets: number }).resets)).toEqual([1, 1, 1]);
+    const stats = daemon.getStats();
+    expect(stats.totalResets).toBe(3);
+    expect(stats.roomsBacklog).toBe(0);
+    expect(stats.batches).toBe(3);
+    expect(stats.maxBatchMs).toBeGreaterThanOrEqual(2);
+    expect(stats.avgBatchMs).toBeGreaterThan(0);
+  });
+
+  it('should reset every room on forceReset', async () => {
+    vi.spyOn(Math, 'random').mockReturnValue(0.9);
+    getConfigDaemon().set('reset.batchBudgetMs', 1);
+    for (let i = 0; i < 3; i++) createRoom(`/areas/room${i}`, 2);
+
+    await daemon.forceReset();
+
+    expect(daemon.getStats().totalResets).toBe(3);
+  });
+
+  it('should forget rooms that are no longer loaded', async () => {
+    vi.spyOn(Math, 'random').mockReturnValue(0.5);
+    createRoom('/areas/a');
+    const b = createRoom('/areas/b');
+    await daemon.runBatch();
+    expect(daemon.getStats().roomsTracked).toBe(2);
+
+    unloadRoom(b);
+    now += intervalMs;
+    await daemon.runBatch();
+
+    expect(daemon.getStats().roomsTracked).toBe(1);
+    expect(b.resets).toBe(0);
+  });
+
+  it('should pick up rooms loaded after tracking starts without rescanning', async () => {
+    vi.spyOn(Math, 'random').mockReturnValue(0);
+    const first = createRoom('/areas/first');
+    await daemon.runBatch();
+    const second = createRoom('/areas/second');
+
+    expect(await daemon.runBatch()).toBe(1);
+    expect(first.resets).toBe(1);
+    expect(second.resets).toBe(1);
+    const { efuns } = globalThis as unknown as { efuns: MockEfuns };
+    expect(efuns.getObjectsByCategory).toHaveBeenCalledTimes(1);
+    expect(daemon.getTimeUntilReset()).toBe(intervalMs);
+  });
+});
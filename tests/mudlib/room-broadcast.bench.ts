@@ -0,0 +1,58 @@
+/**
+ * Room.broadcast cost vs room population.
+ *
+ * Compares the listener-indexed broadcast against the previous approach of
+ * scanning the whole inventory. Each room holds 10 listeners plus a varying
+ * number of items (corpses, gold piles, loot).
+ *
+ * Run with: npm run bench
+ */
+import { bench, describe } from 'vitest';
+import { Room } from '../../mudlib/std/room.js';
+import { MudObject } from '../../mudlib/std/object.js';
+
+const LISTENERS = 10;
+
+function populate(items: number): Room {
+  const room = new Room();
+  for (let i = 0; i < LISTENERS; i++) {
+    const listener = new MudObject();
+    (listener as MudObject & { receive: (msg: string) => void }).receive = () => {};
+    listener.moveTo(room);
+  }
+  for (let i = 0; i < items; i++) {
+    new MudObject().moveTo(room);
+  }
+  return room;
+}
+
+/**
+ * The pre-index broadcast: walk every inventory member.
+ */
+function scanBroadcast(room: Room, message: string, exclude: MudObject[]): void {
+  const excludeSet = new Set(exclude);
+  for (const obj of room.inventory) {
+    if (excludeSet.has(obj)) continue;
+    const living = obj as MudObject & { isSleeping?: () => boolean };
+    if (living.isSleeping?.()) continue;
+    const receiver = obj as MudObject & { receive?: (msg: string) => void };
+    if (typeof receiver.receive === 'function') {
+      receiver.receive(message);
+    }
+  }
+}
+
+for (const items of [0, 100, 1000]) {
+  describe(`broadcast: ${LISTENERS} listeners + ${items} items`, () => {
+    const room = populate(items);
+    const speaker = room.listeners[0]!;
+
+    bench('inventory scan', () => {
+      scanBroadcast(room, 'Hello!', [speaker]);
+    });
+
+    bench('listener index', () => {
+      room.broadcast('Hello!', { exclude: [speaker] });
+    });
+  });
+}
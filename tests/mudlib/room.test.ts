@@ -1,4 +1,4 @@
-import { describe, it, expect, beforeEach, vi } from 'vitest';
+import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
 import { Room } from '../../mudlib/std/room.js';
 import { MudObject } from '../../mudlib/std/object.js';
 
@@ -82,6 +82,144 @@ describe('Room', () => {
     });
   });
 
+  describe('resolveExit', () => {
+    const globals = globalThis as unknown as { efuns?: Record<string, unknown> };
+    let loaded: Map<string, Room>;
+    let efunsMock: {
+      findObject: ReturnType<typeof vi.fn>;
+      loadBlueprint: ReturnType<typeof vi.fn>;
+      isLazyWorld: ReturnType<typeof vi.fn>;
+      isPlayer: ReturnType<typeof vi.fn>;
+      prefetchObjects: ReturnType<typeof vi.fn>;
+    };
+
+    beforeEach(() => {
+      loaded = new Map();
+      efunsMock = {
+        findObject: vi.fn((path: string) => loaded.get(path)),
+        loadBlueprint: vi.fn(async (path: string) => {
+          const dest = new Room();
+          dest.addExit('north', '/rooms/beyond');
+          dest.addExit('south', '/rooms/start');
+          loaded.set(path, dest);
+          return dest;
+        }),
+        isLazyWorld: vi.fn(() => true),
+        isPlayer: vi.fn(() => true),
+        prefetchObjects: vi.fn(),
+      };
+      globals.efuns = efunsMock;
+    });
+
+    afterEach(() => {
+      delete globals.efuns;
+    });
+
+    it('should load the destination on demand', async () => {
+      room.addExit('north', '/rooms/next');
+
+      const dest = await room.resolveExit(room.getExit('north')!);
+
+      expect(dest).toBe(loaded.get('/rooms/next'));
+      expect(efunsMock.loadBlueprint).toHaveBeenCalledWith('/rooms/next');
+    });
+
+    it("should prefetch the destination's exits when a player moves in a lazy world", async () => {
+      room.addExit('north', '/rooms/next');
+
+      await room.resolveExit(room.getExit('north')!, new MudObject());
+
+      expect(efunsMock.prefetchObjects).toHaveBeenCalledWith(['/rooms/beyond', '/rooms/start']);
+    });
+
+    it('should not prefetch for non-players or outside a lazy world', async () => {
+      room.addExit('north', '/rooms/next');
+      const exit = room.getExit('north')!;
+
+      efunsMock.isPlayer.mockReturnValue(false);
+      await room.resolveExit(exit, new MudObject());
+      efunsMock.isPlayer.mockReturnValue(true);
+      efunsMock.isLazyWorld.mockReturnValue(false);
+      await room.resolveExit(exit, new MudObject());
+
+      expect(efunsMock.prefetchObjects).not.toHaveBeenCalled();
+    });
+  });
+
+  describe('cleanUp', () => {
+    const globals = globalThis as unknown as { efuns?: Record<string, unknown> };
+    const idleMs = 60000;
+
+    function createPlayer(): MudObject {
+      return Object.assign(new MudObject(), { isPlayer: true });
+    }
+
+    beforeEach(() => {
+      vi.useFakeTimers();
+      room = new Room();
+    });
+
+    afterEach(() => {
+      vi.useRealTimers();
+      delete globals.efuns;
+    });
+
+    it('should agree once no player has been here for the idle period', () => {
+      expect(room.cleanUp(idleMs)).toBe(false);
+
+      vi.advanceTimersByTime(idleMs);
+
+      expect(room.cleanUp(idleMs)).toBe(true);
+    });
+
+    it('should count a player leaving as activity', () => {
+      const player = createPlayer();
+      player.moveTo(room);
+      vi.advanceTimersByTime(idleMs);
+      expect(room.cleanUp(idleMs)).toBe(false);
+
+      player.moveTo(null);
+      expect(room.cleanUp(idleMs)).toBe(false);
+
+      vi.advanceTimersByTime(idleMs);
+      expect(room.cleanUp(idleMs)).toBe(true);
+    });
+
+    it('should refuse while a spawned NPC is with a player elsewhere', () => {
+      const npc = new MudObject();
+      const other = new Room();
+      globals.efuns = { findObject: vi.fn(() => npc) };
+      room.registerSpawnedNpc(npc);
+      npc.moveTo(other);
+      createPlayer().moveTo(other);
+      vi.advanceTimersByTime(idleMs);
+
+      expect(room.getCleanupDependents()).toEqual([npc]);
+      expect(room.cleanUp(idleMs)).toBe(false);
+    });
+
+    it('should refuse while an item it did not spawn is here', () => {
+      const spawned = new MudObject();
+      spawned.spawnRoom = room;
+      spawned.moveTo(room);
+      const dropped = new MudObject();
+      dropped.moveTo(room);
+      vi.advanceTimersByTime(idleMs);
+
+      expect(room.cleanUp(idleMs)).toBe(false);
+
+      dropped.moveTo(null);
+      expect(room.cleanUp(idleMs)).toBe(true);
+    });
+
+    it('should refuse when the room opted out', () => {
+      room.setNoCleanUp();
+      vi.advanceTimersByTime(idleMs);
+
+      expect(room.cleanUp(idleMs)).toBe(false);
+    });
+  });
+
   describe('broadcast', () => {
     it('should broadcast to all objects in room', () => {
       const obj1 = new MudObject();
@@ -136,6 +274,58 @@ describe('Room', () => {
       expect(receive1).toHaveBeenCalled();
       expect(receive2).not.toHaveBeenCalled();
     });
+
+    it('should skip sleeping listeners unless includeSleeping is set', () => {
+      const sleeper = new MudObject();
+      const receive = vi.fn();
+      (sleeper as MudObject & { receive: typeof receive }).receive = receive;
+      (sleeper as MudObject & { isSleeping: () => boolean }).isSleeping = () => true;
+      sleeper.moveTo(room);
+
+      room.broadcast('Psst');
+      expect(receive).not.toHaveBeenCalled();
+
+      room.broadcast('Wake up!', { includeSleeping: true });
+      expect(receive).toHaveBeenCalledWith('Wake up!');
+    });
+  });
+
+  describe('listeners', () => {
+    it('should only index objects that can receive messages', () => {
+      const listener = new MudObject();
+      (listener as MudObject & { receive: () => void }).receive = vi.fn();
+      const item = new MudObject();
+
+      listener.moveTo(room);
+      item.moveTo(room);
+
+      expect(room.inventory).toHaveLength(2);
+      expect(room.listeners).toEqual([listener]);
+    });
+
+    it('should follow listeners between rooms', () => {
+      const other = new Room();
+      const listener = new MudObject();
+      (listener as MudObject & { receive: () => void }).receive = vi.fn();
+
+      listener.moveTo(room);
+      listener.moveTo(other);
+      expect(room.listeners).toHaveLength(0);
+      expect(other.listeners).toEqual([listener]);
+
+      listener.moveTo(null);
+      expect(other.listeners).toHaveLength(0);
+    });
+
+    it('should keep arrival order', () => {
+      const objects = [new MudObject(), new MudObject(), new MudObject()];
+      for (const obj of objects) {
+        (obj as MudObject & { receive: () => void }).receive = vi.fn();
+        obj.moveTo(room);
+      }
+
+      expect(room.listeners).toEqual(objects);
+    });
   });
 
   describe('items', () => {
@@ -170,6 +360,25 @@ describe('Room', () => {
       expect(desc).toContain('no obvious exits');
     });
 
+    it('should list players before NPCs before items', () => {
+      const gem = new MudObject();
+      gem.shortDesc = 'a gem';
+      const npc = new MudObject();
+      npc.shortDesc = 'a guard';
+      Object.assign(npc, { isLiving: true, isNPC: true });
+      const player = new MudObject();
+      player.shortDesc = 'a hero';
+      Object.assign(player, { isLiving: true, isPlayer: true, isConnected: () => true });
+
+      gem.moveTo(room);
+      npc.moveTo(room);
+      player.moveTo(room);
+
+      const desc = room.getFullDescription();
+      expect(desc.indexOf('A hero')).toBeLessThan(desc.indexOf('A guard'));
+      expect(desc.indexOf('A guard')).toBeLessThan(desc.indexOf('A gem'));
+    });
+
     it('should list contents in full description', () => {
       const obj = new MudObject();
       obj.shortDesc = 'a shiny gem';
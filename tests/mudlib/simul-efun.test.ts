@@ -0,0 +1,27 @@
+import { describe, it, expect, vi } from 'vitest';
+import { tell_room } from '../../mudlib/simul_efun.js';
+import { Room } from '../../mudlib/std/room.js';
+import { MudObject } from '../../mudlib/std/object.js';
+
+describe('tell_room', () => {
+  function listener(room: Room): ReturnType<typeof vi.fn> {
+    const obj = new MudObject();
+    const receive = vi.fn();
+    (obj as MudObject & { receive: typeof receive }).receive = receive;
+    obj.moveTo(room);
+    return receive;
+  }
+
+  it('should tell every listener except the excluded ones', () => {
+    const room = new Room();
+    const first = listener(room);
+    const excluded = room.listeners[0]!;
+    const second = listener(room);
+    new MudObject().moveTo(room);
+
+    tell_room(room, 'The ground shakes.', [excluded]);
+
+    expect(first).not.toHaveBeenCalled();
+    expect(second).toHaveBeenCalledWith('The ground shakes.');
+  });
+});
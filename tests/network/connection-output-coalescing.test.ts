@@ -0,0 +1,144 @@
+import { describe, it, expect, vi } from 'vitest';
+import { EventEmitter } from 'events';
+import { Connection, type OutputCoalescingConfig } from '../../src/network/connection.js';
+
+class MockWebSocket extends EventEmitter {
+  readyState = 1;
+  OPEN = 1;
+  bufferedAmount = 0;
+  send = vi.fn();
+  close = vi.fn();
+  terminate = vi.fn();
+  ping = vi.fn();
+}
+
+function createConnection(output: Partial<OutputCoalescingConfig> = {}): {
+  conn: Connection;
+  socket: MockWebSocket;
+} {
+  const socket = new MockWebSocket();
+  const conn = new Connection(
+    socket as unknown as import('ws').WebSocket,
+    'conn-test',
+    '127.0.0.1',
+    output
+  );
+  return { conn, socket };
+}
+
+/**
+ * Split frames into lines the way the clients do.
+ */
+function clientLines(frames: string[]): string[] {
+  const lines: string[] = [];
+  for (const frame of frames) {
+    const parts = frame.split(/\r?\n/);
+    for (let i = 0; i < parts.length; i++) {
+      if (i === parts.length - 1 && parts[i]!.length === 0) continue;
+      lines.push(parts[i]!);
+    }
+  }
+  return lines;
+}
+
+function sentFrames(socket: MockWebSocket): string[] {
+  return socket.send.mock.calls.map((call) => call[0] as string);
+}
+
+/**
+ * Wait for the end of the current event-loop turn.
+ */
+function nextTurn(): Promise<void> {
+  return new Promise((resolve) => setImmediate(resolve));
+}
+
+function sendMixedOutput(conn: Connection): void {
+  conn.send('You swing at the goblin.\n');
+  conn.sendStats({ type: 'delta', hp: 40 });
+  conn.send('The goblin dodges');
+  conn.send('');
+  conn.send('\n');
+  conn.sendLine('The goblin hits you.');
+  conn.sendCombat({ type: 'target_clear' });
+}
+
+describe('Connection output coalescing', () => {
+  it('sends everything from one event-loop turn as one frame', async () => {
+    const { conn, socket } = createConnection();
+
+    conn.sendLine('line one');
+    conn.sendLine('line two');
+    expect(socket.send).not.toHaveBeenCalled();
+
+    await nextTurn();
+
+    expect(sentFrames(socket)).toEqual(['line one\nline two\n']);
+  });
+
+  it('keeps the lines and their order the same as a frame per message', async () => {
+    const separate = createConnection({ enabled: false });
+    sendMixedOutput(separate.conn);
+
+    const coalesced = createConnection();
+    sendMixedOutput(coalesced.conn);
+    await nextTurn();
+
+    expect(sentFrames(separate.socket).length).toBeGreaterThan(1);
+    expect(sentFrames(coalesced.socket)).toHaveLength(1);
+    expect(clientLines(sentFrames(coalesced.socket))).toEqual(
+      clientLines(sentFrames(separate.socket))
+    );
+  });
+
+  it('holds output for the configured window', async () => {
+    const { conn, socket } = createConnection({ windowMs: 20 });
+
+    conn.sendLine('hello');
+    await nextTurn();
+    expect(socket.send).not.toHaveBeenCalled();
+
+    await new Promise((resolve) => setTimeout(resolve, 30));
+    expect(sentFrames(socket)).toEqual(['hello\n']);
+  });
+
+  it('sends held output at once on flush, close and when it grows large', () => {
+    const { conn, socket } = createConnection({ windowMs: 50 });
+
+    conn.sendLine('first');
+    conn.flush();
+    expect(sentFrames(socket)).toEqual(['first\n']);
+
+    conn.sendLine('x'.repeat(70 * 1024));
+    expect(socket.send).toHaveBeenCalledTimes(2);
+
+    conn.sendLine('Goodbye!');
+    conn.close();
+    expect(sentFrames(socket)[2]).toBe('Goodbye!\n');
+    expect(socket.send.mock.invocationCallOrder[2]).toBeLessThan(
+      socket.close.mock.invocationCallOrder[0]!
+    );
+  });
+
+  it('counts messages and frames', async () => {
+    const { conn } = createConnection();
+
+    conn.sendLine('a');
+    conn.sendLine('b');
+    conn.sendLine('c');
+    await nextTurn();
+    conn.sendLine('d');
+    conn.flush();
+
+    expect(conn.getOutputStats()).toEqual({ messages: 4, frames: 2 });
+  });
+
+  it('writes a frame per message when disabled', () => {
+    const { conn, socket } = createConnection({ enabled: false });
+
+    conn.sendLine('a');
+    conn.sendLine('b');
+
+    expect(sentFrames(socket)).toEqual(['a\n', 'b\n']);
+    expect(conn.getOutputStats()).toEqual({ messages: 2, frames: 2 });
+  });
+});
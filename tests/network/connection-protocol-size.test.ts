@@ -50,6 +50,7 @@ describe('Connection protocol frame size guard', () => {
         isPlayer: false,
       },
     });
+    conn.flush();
 
     expect((socket as unknown as MockWebSocket).send).toHaveBeenCalledTimes(1);
   });